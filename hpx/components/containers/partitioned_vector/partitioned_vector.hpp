@@ -996,70 +996,47 @@ namespace hpx
             if (pos_vec.empty())
                 return make_ready_future(std::vector<T>());
 
-            // current partition index of the block
-            size_type part_cur = get_partition(pos_vec[0]);
+            // sort the positions by partition, independently of their order
+            std::vector<size_type> offsets, local_pos, order;
+            group_by_partition(pos_vec, offsets, local_pos, order);
 
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator part_begin =
-                pos_vec.begin();
-
-            // vector holding futures of the values for all blocks
+            // request the values of all positions of one partition at once
             std::vector<future<std::vector<T> > > part_values_future;
-            for (typename std::vector<size_type>::const_iterator it =
-                    pos_vec.begin(); it != pos_vec.end(); ++it)
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
             {
-                // get the partition of the current position
-                size_type part = get_partition(*it);
-
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
+                if (offsets[part] == offsets[part + 1])
                     continue;
 
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
-                else
-                {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // get async values for this block
-                    part_values_future.push_back(get_values(part_cur,
-                        get_local_indices(std::vector<size_type>(part_begin, it))));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    part_begin = it;
-                }
+                part_values_future.push_back(get_values(part,
+                    std::vector<size_type>(local_pos.begin() + offsets[part],
+                        local_pos.begin() + offsets[part + 1])));
             }
 
-            // the end of the vector is also an end of a block
-            // get async values for this block
-            part_values_future.push_back(get_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    part_begin, pos_vec.end()))));
-
             // This helper function unwraps the vectors from each partition
-            // and merge them to one vector
+            // and puts the values back into the order of the given positions
             auto merge_func =
-                [&pos_vec](std::vector<future<std::vector<T> > > && part_values_f)
+                [](std::vector<future<std::vector<T> > > && part_values_f,
+                    std::vector<size_type> const& order)
                     -> std::vector<T>
                 {
-                    std::vector<T> values;
-                    values.reserve(pos_vec.size());
+                    std::vector<T> values(order.size());
 
+                    std::size_t i = 0;
                     for (future<std::vector<T> >& part_f: part_values_f)
                     {
                         std::vector<T> part_values = part_f.get();
-                        std::move(part_values.begin(), part_values.end(),
-                            std::back_inserter(values));
+                        for (T& value: part_values)
+                            values[order[i++]] = std::move(value);
                     }
+                    HPX_ASSERT(i == order.size());
+
                     return values;
                 };
 
             // when all values are here merge them to one vector
             // and return a future to this vector
             return dataflow(launch::async, merge_func,
-                std::move(part_values_future));
+                std::move(part_values_future), std::move(order));
         }
 
         /// Returns the elements at the positions \a pos
@@ -1322,7 +1299,7 @@ namespace hpx
         void set_values(launch::sync_policy, size_type part,
             std::vector<size_type> const& pos, std::vector<T> const& val)
         {
-            set_values(pos, val).get();
+            set_values(part, pos, val).get();
         }
 #if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
         HPX_DEPRECATED(HPX_DEPRECATED_MSG)
@@ -1370,6 +1347,134 @@ namespace hpx
         ///
         future<void>
         set_values(std::vector<size_type> const& pos, std::vector<T> const& val)
+        {
+            return scatter_values(pos, val,
+                [this](size_type part, std::vector<size_type> const& part_pos,
+                    std::vector<T> const& part_val)
+                {
+                    return set_values(part, part_pos, part_val);
+                });
+        }
+
+        void set_values(launch::sync_policy, std::vector<size_type> const& pos,
+            std::vector<T> const& val)
+        {
+            return set_values(pos, val).get();
+        }
+#if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
+        HPX_DEPRECATED(HPX_DEPRECATED_MSG)
+        void set_values_sync(std::vector<size_type> const& pos,
+            std::vector<T> const& val)
+        {
+            return set_values(launch::sync, pos, val);
+        }
+#endif
+
+        /// Asynchronously combine the values \a val with the elements at
+        /// the positions \a pos in the partition \a part.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param pos   Positions of the elements in the partition
+        /// \param val   The values to combine with the elements
+        /// \param op    The operation used to combine each value with its
+        ///              element
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void>
+        reduce_values(size_type part, std::vector<size_type> const& pos,
+            std::vector<T> const& val, partitioned_vector_reduction op)
+        {
+            HPX_ASSERT(pos.size() == val.size());
+
+            if (partitions_[part].local_data_)
+            {
+                partitions_[part].local_data_->reduce_values(pos, val, op);
+                return make_ready_future();
+            }
+
+            return partitioned_vector_partition_client(
+                partitions_[part].partition_).reduce_values(pos, val, op);
+        }
+
+        /// Asynchronously combine the values \a val with the elements at
+        /// the global positions \a pos.
+        ///
+        /// The positions may be given in any order and more than once. All
+        /// positions belonging to the same partition are sent with a single
+        /// request, in the order they appear in \a pos.
+        ///
+        /// \param pos   Global positions of the elements in the vector
+        /// \param val   The values to combine with the elements
+        /// \param op    The operation used to combine each value with its
+        ///              element
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void>
+        reduce_values(std::vector<size_type> const& pos,
+            std::vector<T> const& val, partitioned_vector_reduction op)
+        {
+            return scatter_values(pos, val,
+                [this, op](size_type part, std::vector<size_type> const& part_pos,
+                    std::vector<T> const& part_val)
+                {
+                    return reduce_values(part, part_pos, part_val, op);
+                });
+        }
+
+        void reduce_values(launch::sync_policy,
+            std::vector<size_type> const& pos, std::vector<T> const& val,
+            partitioned_vector_reduction op)
+        {
+            return reduce_values(pos, val, op).get();
+        }
+
+    private:
+        // Sort the given global positions by partition. On return, the local
+        // indices of all positions belonging to partition 'part' are stored
+        // in local_pos[offsets[part], offsets[part + 1]), and 'order' holds
+        // the index into 'pos' each of them came from. Positions of the same
+        // partition keep their relative order.
+        void group_by_partition(std::vector<size_type> const& pos,
+            std::vector<size_type>& offsets, std::vector<size_type>& local_pos,
+            std::vector<size_type>& order) const
+        {
+            std::size_t const num_parts = partitions_.size();
+
+            std::vector<std::size_t> parts;
+            parts.reserve(pos.size());
+
+            offsets.assign(num_parts + 1, 0);
+            for (size_type p: pos)
+            {
+                std::size_t part = get_partition(p);
+                HPX_ASSERT(part < num_parts);
+                parts.push_back(part);
+                ++offsets[part + 1];
+            }
+
+            for (std::size_t part = 0; part != num_parts; ++part)
+                offsets[part + 1] += offsets[part];
+
+            std::vector<size_type> next(offsets.begin(), offsets.end() - 1);
+
+            local_pos.resize(pos.size());
+            order.resize(pos.size());
+            for (std::size_t i = 0; i != pos.size(); ++i)
+            {
+                std::size_t k = next[parts[i]]++;
+                local_pos[k] = get_local_index(pos[i]);
+                order[k] = i;
+            }
+        }
+
+        // Issue one request per partition for the given positions and values
+        template <typename F>
+        future<void> scatter_values(std::vector<size_type> const& pos,
+            std::vector<T> const& val, F && f)
         {
             HPX_ASSERT(pos.size() == val.size());
 
@@ -1378,72 +1483,33 @@ namespace hpx
             if (pos.empty())
                 return make_ready_future();
 
-            // partition index of the current block
-            size_type part_cur = get_partition(pos[0]);
+            std::vector<size_type> offsets, local_pos, order;
+            group_by_partition(pos, offsets, local_pos, order);
 
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator pos_block_begin =
-                pos.begin();
-            typename std::vector<T>::const_iterator val_block_begin = val.begin();
-
-            // vector holding futures of the state for all blocks
+            // vector holding futures of the state for all partitions
             std::vector<future<void> > part_futures;
-
-            // going through the position vector
-            typename std::vector<size_type>::const_iterator pos_it = pos.begin();
-            typename std::vector<T>::const_iterator val_it = val.begin();
-            for (/**/; pos_it != pos.end(); ++pos_it, ++val_it)
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
             {
-                // get the partition of the current position
-                size_type part = get_partition(*pos_it);
-
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
+                size_type first = offsets[part];
+                size_type last = offsets[part + 1];
+                if (first == last)
                     continue;
 
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
-                else
-                {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // set asynchronous values for this block
-                    part_futures.push_back(set_values(part_cur,
-                        get_local_indices(std::vector<size_type>(
-                            pos_block_begin, pos_it)),
-                        std::vector<T>(val_block_begin, val_it)));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    pos_block_begin = pos_it;
-                    val_block_begin = val_it;
-                }
-            }
+                std::vector<T> part_val;
+                part_val.reserve(last - first);
+                for (size_type k = first; k != last; ++k)
+                    part_val.push_back(val[order[k]]);
 
-            // the end of the vector is also an end of a block
-            // get asynchronous values for this block
-            part_futures.push_back(set_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    pos_block_begin, pos.end())),
-                std::vector<T>(val_block_begin, val.end())));
+                part_futures.push_back(f(part,
+                    std::vector<size_type>(local_pos.begin() + first,
+                        local_pos.begin() + last),
+                    part_val));
+            }
 
             return when_all(part_futures);
         }
 
-        void set_values(launch::sync_policy, std::vector<size_type> const& pos,
-            std::vector<T> const& val)
-        {
-            return set_values(pos, val).get();
-        }
-#if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
-        HPX_DEPRECATED(HPX_DEPRECATED_MSG)
-        void set_values_sync(std::vector<size_type> const& pos,
-            std::vector<T> const& val)
-        {
-            return set_values(launch::sync, pos, val);
-        }
-#endif
+    public:
 
 //   //CLEAR
 //   //TODO if number of partitions is kept constant every time then
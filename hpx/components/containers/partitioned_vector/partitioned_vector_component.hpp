@@ -16,6 +16,8 @@
 /// asynchronous API which return the futures.
 
 #include <hpx/config.hpp>
+#include <hpx/error.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
 #include <hpx/runtime/components/server/locking_hook.hpp>
@@ -23,6 +25,8 @@
 #include <hpx/runtime/components/server/component.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/always_void.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
@@ -33,13 +37,92 @@
 #include <cstddef>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace server
 {
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The reductions are compiled for every registered element type,
+        // element types without the required operators report an error at
+        // runtime instead.
+        template <typename T, typename Enable = void>
+        struct has_plus : std::false_type {};
+
+        template <typename T>
+        struct has_plus<T, typename util::always_void<
+                decltype(std::declval<T const&>() + std::declval<T const&>())
+            >::type>
+          : std::true_type
+        {};
+
+        template <typename T, typename Enable = void>
+        struct has_less : std::false_type {};
+
+        template <typename T>
+        struct has_less<T, typename util::always_void<
+                decltype(std::declval<T const&>() < std::declval<T const&>())
+            >::type>
+          : std::true_type
+        {};
+
+        template <typename T>
+        typename std::enable_if<has_plus<T>::value>::type
+        reduce_plus(T& lhs, T const& rhs)
+        {
+            lhs = lhs + rhs;
+        }
+
+        template <typename T>
+        typename std::enable_if<!has_plus<T>::value>::type
+        reduce_plus(T&, T const&)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::server::partitioned_vector::reduce_values",
+                "the element type does not support operator+");
+        }
+
+        template <typename T>
+        typename std::enable_if<has_less<T>::value>::type
+        reduce_min(T& lhs, T const& rhs)
+        {
+            if (rhs < lhs)
+                lhs = rhs;
+        }
+
+        template <typename T>
+        typename std::enable_if<has_less<T>::value>::type
+        reduce_max(T& lhs, T const& rhs)
+        {
+            if (lhs < rhs)
+                lhs = rhs;
+        }
+
+        template <typename T>
+        typename std::enable_if<!has_less<T>::value>::type
+        reduce_min(T&, T const&)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::server::partitioned_vector::reduce_values",
+                "the element type does not support operator<");
+        }
+
+        template <typename T>
+        typename std::enable_if<!has_less<T>::value>::type
+        reduce_max(T&, T const&)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::server::partitioned_vector::reduce_values",
+                "the element type does not support operator<");
+        }
+    }
+
     /// \brief This is the basic wrapper class for stl vector.
     ///
     /// This contain the implementation of the partitioned_vector_partition's
@@ -365,6 +448,58 @@ namespace hpx { namespace server
                 partitioned_vector_partition_[pos[i]] = val[i];
         }
 
+        /// Combine the values of \a val with the elements at positions
+        /// \a pos in the partitioned_vector_partition container.
+        ///
+        /// \param pos   Positions of the elements in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to combine with the elements
+        /// \param op    The operation used to combine each value with its
+        ///              element. Positions may be given more than once, all
+        ///              corresponding values are applied in order.
+        ///
+        /// Concurrent invocations are applied one after the other.
+        ///
+        void reduce_values(std::vector<size_type> const& pos,
+            std::vector<T> const& val, partitioned_vector_reduction op)
+        {
+            HPX_ASSERT(pos.size() == val.size());
+
+            std::lock_guard<lcos::local::spinlock> l(reduce_mtx_);
+
+            switch (op)
+            {
+            case partitioned_vector_reduction::assign:
+                for (std::size_t i = 0; i != pos.size(); ++i)
+                    partitioned_vector_partition_[pos[i]] = val[i];
+                break;
+
+            case partitioned_vector_reduction::plus:
+                for (std::size_t i = 0; i != pos.size(); ++i)
+                    detail::reduce_plus(partitioned_vector_partition_[pos[i]],
+                        val[i]);
+                break;
+
+            case partitioned_vector_reduction::min:
+                for (std::size_t i = 0; i != pos.size(); ++i)
+                    detail::reduce_min(partitioned_vector_partition_[pos[i]],
+                        val[i]);
+                break;
+
+            case partitioned_vector_reduction::max:
+                for (std::size_t i = 0; i != pos.size(); ++i)
+                    detail::reduce_max(partitioned_vector_partition_[pos[i]],
+                        val[i]);
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::server::partitioned_vector::reduce_values",
+                    "unknown reduction operation");
+                break;
+            }
+        }
+
         /// Remove all elements from the vector leaving the
         /// partitioned_vector_partition with size 0.
         ///
@@ -395,10 +530,17 @@ namespace hpx { namespace server
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, reduce_values);
 
 //         HPX_DEFINE_COMPONENT_ACTION(partitioned_vector_partition, clear);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_copied_data);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_data);
+
+    private:
+        // serializes reduce_values, which is not protected by the
+        // locking_hook: it is a direct action, and local partitions are
+        // accessed without invoking an action at all
+        lcos::local::spinlock reduce_mtx_;
     };
 }}
 
@@ -421,6 +563,8 @@ namespace hpx { namespace server
         HPX_PP_CAT(__vector_set_value_action_, name));                        \
     HPX_REGISTER_ACTION_DECLARATION(type::set_values_action,                  \
         HPX_PP_CAT(__vector_set_values_action_, name));                       \
+    HPX_REGISTER_ACTION_DECLARATION(type::reduce_values_action,               \
+        HPX_PP_CAT(__vector_reduce_values_action_, name));                    \
     HPX_REGISTER_ACTION_DECLARATION(type::size_action,                        \
         HPX_PP_CAT(__vector_size_action_, name));                             \
     HPX_REGISTER_ACTION_DECLARATION(type::resize_action,                      \
@@ -462,6 +606,8 @@ namespace hpx { namespace server
         HPX_PP_CAT(__vector_set_value_action_, name));                        \
     HPX_REGISTER_ACTION(type::set_values_action,                              \
         HPX_PP_CAT(__vector_set_values_action_, name));                       \
+    HPX_REGISTER_ACTION(type::reduce_values_action,                           \
+        HPX_PP_CAT(__vector_reduce_values_action_, name));                    \
     HPX_REGISTER_ACTION(type::size_action,                                    \
         HPX_PP_CAT(__vector_size_action_, name));                             \
     HPX_REGISTER_ACTION(type::resize_action,                                  \
@@ -797,6 +943,41 @@ namespace hpx
                 this->get_id(), pos, val);
         }
 
+        /// Combine the values of \a val with the elements at positions
+        /// \a pos in the partitioned_vector_partition container.
+        ///
+        /// \param pos   Positions of the elements in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to combine with the elements
+        /// \param op    The operation used to combine each value with its
+        ///              element
+        ///
+        void reduce_values(launch::sync_policy,
+            std::vector<std::size_t> const& pos, std::vector<T> const& val,
+            partitioned_vector_reduction op)
+        {
+            reduce_values(pos, val, op).get();
+        }
+
+        /// Combine the values of \a val with the elements at positions
+        /// \a pos in the partitioned_vector_partition component.
+        ///
+        /// \param pos   Positions of the elements in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to combine with the elements
+        /// \param op    The operation used to combine each value with its
+        ///              element
+        ///
+        /// \return This returns the hpx::future of type void
+        ///
+        future<void> reduce_values(std::vector<std::size_t> const& pos,
+            std::vector<T> const& val, partitioned_vector_reduction op)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::reduce_values_action>(
+                this->get_id(), pos, val, op);
+        }
+
 //         void clear()
 //         {
 //             HPX_ASSERT(this->get_id());
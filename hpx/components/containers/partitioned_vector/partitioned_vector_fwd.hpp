@@ -17,6 +17,16 @@ namespace hpx
     template <typename T, typename Data>
     class partitioned_vector;       // forward declaration
 
+    /// The operations partitioned_vector::reduce_values can use to combine
+    /// the given values with the elements already stored in the vector.
+    enum class partitioned_vector_reduction
+    {
+        assign = 0,     ///< replace the element by the value
+        plus = 1,       ///< add the value to the element
+        min = 2,        ///< keep the smaller of element and value
+        max = 3         ///< keep the larger of element and value
+    };
+
     template <typename T, typename Data> class local_vector_iterator;
     template <typename T, typename Data> class const_local_vector_iterator;
 
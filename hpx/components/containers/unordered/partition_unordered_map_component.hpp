@@ -17,25 +17,32 @@
 /// classes are asynchronous API which return the futures.
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/lcos/reduce.hpp>
 #include <hpx/runtime/actions/basic_action.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/serialization/map.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/iterator_facade.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
 
+#include <boost/lockfree/detail/prefix.hpp>
+
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -48,29 +55,145 @@ namespace hpx { namespace server
     ///
     /// This contain the implementation of the partition_unordered_map's
     /// component functionality.
+    ///
+    /// The elements are distributed over a number of shards, each of which
+    /// is an stl unordered_map protected by its own lock. All actions of this
+    /// component may run concurrently, actions touching different shards
+    /// don't have to wait for each other.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
         typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
 
         typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
+        // The number of shards is a power of two
+        static const std::size_t num_shards_log2 = 4;
+        static const std::size_t num_shards = std::size_t(1) << num_shards_log2;
+
     private:
-        data_type partition_unordered_map_;
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::lock_guard<mutex_type> lock_type;
+
+        struct shard
+        {
+            mutable mutex_type mtx_;
+            data_type data_;
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        void init_shards(size_type bucket_count)
+        {
+            size_type shard_bucket_count =
+                (bucket_count + num_shards - 1) / num_shards;
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shards_[i].data_ = data_type(shard_bucket_count,
+                    hash_, equal_);
+            }
+        }
+
+        // The partition itself was selected based on the same hash value,
+        // mix its bits to spread the keys over all shards.
+        shard& get_shard(Key const& key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(hash_(key)) *
+                0x9e3779b97f4a7c15ull;
+            return shards_[std::size_t(h >> (64 - num_shards_log2))];
+        }
+
+        Hash hash_;
+        KeyEqual equal_;
+        std::unique_ptr<shard[]> shards_;
+
+        // Iterate over the elements of all shards, one shard after the other
+        template <typename Value, typename BaseIterator>
+        class shard_iterator
+          : public hpx::util::iterator_facade<
+                shard_iterator<Value, BaseIterator>, Value,
+                std::forward_iterator_tag>
+        {
+        public:
+            shard_iterator()
+              : shards_(nullptr), shard_(num_shards)
+            {}
+
+            shard_iterator(shard* shards, std::size_t index)
+              : shards_(shards), shard_(index)
+            {
+                if (shard_ != num_shards)
+                {
+                    it_ = shards_[shard_].data_.begin();
+                    skip_empty();
+                }
+            }
+
+            // allow conversion from iterator to const_iterator
+            template <typename OtherValue, typename OtherIterator>
+            shard_iterator(
+                    shard_iterator<OtherValue, OtherIterator> const& rhs)
+              : shards_(rhs.shards_), shard_(rhs.shard_), it_(rhs.it_)
+            {}
+
+        private:
+            template <typename, typename> friend class shard_iterator;
+            friend class hpx::util::iterator_core_access;
+
+            void skip_empty()
+            {
+                while (it_ == shards_[shard_].data_.end())
+                {
+                    if (++shard_ == num_shards)
+                        break;
+                    it_ = shards_[shard_].data_.begin();
+                }
+            }
+
+            void increment()
+            {
+                ++it_;
+                skip_empty();
+            }
+
+            template <typename OtherValue, typename OtherIterator>
+            bool equal(
+                shard_iterator<OtherValue, OtherIterator> const& rhs) const
+            {
+                return shard_ == rhs.shard_ &&
+                    (shard_ == num_shards || it_ == rhs.it_);
+            }
+
+            Value& dereference() const
+            {
+                return *it_;
+            }
+
+            shard* shards_;
+            std::size_t shard_;
+            BaseIterator it_;
+        };
 
     public:
+        /// The iterators traverse the elements of all shards of this
+        /// partition. They are valid only as long as no other thread
+        /// modifies the partition, i.e. while the partition is locked
+        /// using lock() and unlock() (or std::lock_guard).
+        typedef shard_iterator<
+                typename data_type::value_type,
+                typename data_type::iterator
+            > iterator_type;
+        typedef shard_iterator<
+                typename data_type::value_type const,
+                typename data_type::const_iterator
+            > const_iterator_type;
         ///////////////////////////////////////////////////////////////////////
         // Constructors
         ///////////////////////////////////////////////////////////////////////
@@ -78,37 +201,49 @@ namespace hpx { namespace server
         /// Default Constructor which create partition_unordered_map
         /// with size 0.
         partition_unordered_map()
+          : shards_(new shard[num_shards])
         {
+            init_shards(0);
         }
 
         explicit partition_unordered_map(size_type bucket_count)
-          : partition_unordered_map_(bucket_count)
-        {}
+          : shards_(new shard[num_shards])
+        {
+            init_shards(bucket_count);
+        }
 
         partition_unordered_map(size_type bucket_count, Hash const& hash,
                 KeyEqual const& equal)
-          : partition_unordered_map_(bucket_count, hash, equal)
-        {}
+          : hash_(hash), equal_(equal), shards_(new shard[num_shards])
+        {
+            init_shards(bucket_count);
+        }
 
         // support components::copy
         partition_unordered_map(partition_unordered_map const& rhs)
-          : base_type(rhs),
-            partition_unordered_map_(rhs.partition_unordered_map_)
-        {}
+          : base_type(rhs), hash_(rhs.hash_), equal_(rhs.equal_),
+            shards_(new shard[num_shards])
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                lock_type l(rhs.shards_[i].mtx_);
+                shards_[i].data_ = rhs.shards_[i].data_;
+            }
+        }
 
         partition_unordered_map& operator=(partition_unordered_map const& rhs)
         {
             if (this != &rhs)
             {
                 this->base_type::operator=(rhs);
-                partition_unordered_map_ = rhs.partition_unordered_map_;
+                set_copied_data(rhs.get_copied_data());
             }
             return *this;
         }
 
         partition_unordered_map(partition_unordered_map && rhs)
-          : base_type(std::move(rhs)),
-            partition_unordered_map_(std::move(rhs.partition_unordered_map_))
+          : base_type(std::move(rhs)), hash_(std::move(rhs.hash_)),
+            equal_(std::move(rhs.equal_)), shards_(std::move(rhs.shards_))
         {}
 
         partition_unordered_map& operator=(partition_unordered_map && rhs)
@@ -116,7 +251,9 @@ namespace hpx { namespace server
             if (this != &rhs)
             {
                 this->base_type::operator=(std::move(rhs));
-                partition_unordered_map_ = std::move(rhs.partition_unordered_map_);
+                hash_ = std::move(rhs.hash_);
+                equal_ = std::move(rhs.equal_);
+                shards_ = std::move(rhs.shards_);
             }
             return *this;
         }
@@ -124,38 +261,66 @@ namespace hpx { namespace server
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            data_type result(0, hash_, equal_);
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                lock_type l(shards_[i].mtx_);
+                result.insert(shards_[i].data_.begin(), shards_[i].data_.end());
+            }
+            return result;
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
+            clear();
+            for (typename data_type::value_type& v: d)
+            {
+                shard& s = get_shard(v.first);
+
+                lock_type l(s.mtx_);
+                s.data_[v.first] = std::move(v.second);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Acquire the locks of all shards, this blocks all actions
+        /// accessing this partition until unlock() is called.
+        void lock() const
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+                shards_[i].mtx_.lock();
+        }
+
+        void unlock() const
+        {
+            for (std::size_t i = num_shards; i != 0; --i)
+                shards_[i - 1].mtx_.unlock();
         }
 
         ///////////////////////////////////////////////////////////////////////
         iterator_type begin()
         {
-            return partition_unordered_map_.begin();
+            return iterator_type(shards_.get(), 0);
         }
         const_iterator_type begin() const
         {
-            return partition_unordered_map_.begin();
+            return const_iterator_type(shards_.get(), 0);
         }
         const_iterator_type cbegin() const
         {
-            return partition_unordered_map_.cbegin();
+            return const_iterator_type(shards_.get(), 0);
         }
 
         iterator_type end()
         {
-            return partition_unordered_map_.end();
+            return iterator_type(shards_.get(), num_shards);
         }
         const_iterator_type end() const
         {
-            return partition_unordered_map_.end();
+            return const_iterator_type(shards_.get(), num_shards);
         }
         const_iterator_type cend() const
         {
-            return partition_unordered_map_.cend();
+            return const_iterator_type(shards_.get(), num_shards);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -165,59 +330,61 @@ namespace hpx { namespace server
         /// Returns the number of elements
         size_type size() const
         {
-            return partition_unordered_map_.size();
+            size_type result = 0;
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                lock_type l(shards_[i].mtx_);
+                result += shards_[i].data_.size();
+            }
+            return result;
         }
 
         /// Returns the maximum possible number of elements
         size_type max_size() const
         {
-            return partition_unordered_map_.max_size();
+            return shards_[0].data_.max_size();
         }
 
         /// Returns the number of elements that the container has currently
         /// allocated space for.
         size_type capacity() const
         {
-            return partition_unordered_map_.capacity();
+            size_type result = 0;
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                lock_type l(shards_[i].mtx_);
+                data_type const& data = shards_[i].data_;
+                result += size_type(
+                    data.bucket_count() * data.max_load_factor());
+            }
+            return result;
         }
 
-        /// Checks if the container has no elements, i.e. whether
-        /// begin() == end().
+        /// Checks if the container has no elements
         bool empty() const
         {
-            return partition_unordered_map_.empty();
+            return size() == 0;
         }
 
         ///////////////////////////////////////////////////////////////////////
         // Element access API's
         ///////////////////////////////////////////////////////////////////////
 
-        /// Return the element at the position \a pos in the partition_unordered_map
-        /// container.
+        /// Return the element with the given \a key in the
+        /// partition_unordered_map container.
         ///
-        /// \param pos Position of the element in the partition_unordered_map
+        /// \param key   Key of the element in the partition_unordered_map
+        /// \param erase Remove the element from the container
         ///
-        /// \return Return the value of the element at position represented
-        ///         by \a pos.
+        /// \return Return the value of the element with the given \a key.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            shard& s = get_shard(key);
+
+            lock_type l(s.mtx_);
+            typename data_type::iterator it = s.data_.find(key);
+            if (it == s.data_.end())
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
@@ -228,17 +395,17 @@ namespace hpx { namespace server
             if (!erase)
                 return it->second;
 
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            T result = std::move(it->second);
+            s.data_.erase(it);
+            return result;
         }
 
-        /// Return the element at the position \a pos in the partition_unordered_map
-        /// container.
+        /// Return the elements with the given \a keys in the
+        /// partition_unordered_map container.
         ///
-        /// \param pos Positions of the elements in the partition_unordered_map
+        /// \param keys  Keys of the elements in the partition_unordered_map
         ///
-        /// \return Return the values of the elements at position represented
-        ///         by \a pos.
+        /// \return Return the values of the elements with the given \a keys.
         ///
         std::vector<T> get_values(std::vector<Key> const& keys)
         {
@@ -247,9 +414,11 @@ namespace hpx { namespace server
 
             for (std::size_t i = 0; i != keys.size(); ++i)
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
+                shard& s = get_shard(keys[i]);
+
+                lock_type l(s.mtx_);
+                typename data_type::iterator it = s.data_.find(keys[i]);
+                if (it == s.data_.end())
                 {
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "partition_unordered_map::get_values",
@@ -262,26 +431,58 @@ namespace hpx { namespace server
             return result;
         }
 
+        /// Look up the elements with the given \a keys in the
+        /// partition_unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the partition_unordered_map
+        ///
+        /// \return Return a pair for each of the given \a keys, the first
+        ///         member is true if the key was found and the second member
+        ///         holds the value of the element in this case.
+        ///
+        std::vector<std::pair<bool, T> > find_values(
+            std::vector<Key> const& keys)
+        {
+            std::vector<std::pair<bool, T> > result;
+            result.reserve(keys.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                shard& s = get_shard(keys[i]);
+
+                lock_type l(s.mtx_);
+                typename data_type::iterator it = s.data_.find(keys[i]);
+                if (it == s.data_.end())
+                    result.push_back(std::make_pair(false, T()));
+                else
+                    result.push_back(std::make_pair(true, it->second));
+            }
+            return result;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // Modifiers API's in server class
         ///////////////////////////////////////////////////////////////////////
 
-        /// Copy the value of \a val in the element at position \a pos in the
-        /// partition_unordered_map container.
+        /// Copy the value of \a val in the element with the given \a key in
+        /// the partition_unordered_map container.
         ///
-        /// \param pos   Position of the element in the partition_unordered_map
+        /// \param key   Key of the element in the partition_unordered_map
         ///
         /// \param val   The value to be copied
         ///
-        void set_value(Key const& pos, T const& val)
+        void set_value(Key const& key, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            shard& s = get_shard(key);
+
+            lock_type l(s.mtx_);
+            s.data_[key] = val;
         }
 
-        /// Copy the value of \a val for the elements at positions \a pos in
-        /// the partition_unordered_map container.
+        /// Copy the value of \a val for the elements with the given \a keys
+        /// in the partition_unordered_map container.
         ///
-        /// \param pos   Positions of the elements in the partition_unordered_map
+        /// \param keys  Keys of the elements in the partition_unordered_map
         ///
         /// \param val   The value to be copied
         ///
@@ -289,10 +490,14 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
 
             for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            {
+                shard& s = get_shard(keys[i]);
+
+                lock_type l(s.mtx_);
+                s.data_[keys[i]] = val[i];
+            }
         }
 
         /// Remove all elements from the vector leaving the
@@ -300,13 +505,34 @@ namespace hpx { namespace server
         ///
         void clear()
         {
-            partition_unordered_map_.clear();
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                lock_type l(shards_[i].mtx_);
+                shards_[i].data_.clear();
+            }
         }
 
         /// Erase the given element
         std::size_t erase(Key const& key)
         {
-            return partition_unordered_map_.erase(key);
+            shard& s = get_shard(key);
+
+            lock_type l(s.mtx_);
+            return s.data_.erase(key);
+        }
+
+        /// Erase the elements with the given keys
+        std::size_t erase_values(std::vector<Key> const& keys)
+        {
+            std::size_t erased = 0;
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                shard& s = get_shard(keys[i]);
+
+                lock_type l(s.mtx_);
+                erased += s.data_.erase(keys[i]);
+            }
+            return erased;
         }
 
         /// Macros to define HPX component actions for all exported functions.
@@ -314,11 +540,13 @@ namespace hpx { namespace server
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, find_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, erase);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, erase_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_copied_data);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_copied_data);
@@ -356,6 +584,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_values_action,     \
         HPX_PP_CAT(__unordered_map_get_values_action_, name));                \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::find_values_action,    \
+        HPX_PP_CAT(__unordered_map_find_values_action_, name));               \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_value_action,      \
         HPX_PP_CAT(__unordered_map_set_value_action_, name));                 \
@@ -368,6 +599,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::erase_action,          \
         HPX_PP_CAT(__unordered_map_erase_action_, name));                     \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::erase_values_action,   \
+        HPX_PP_CAT(__unordered_map_erase_values_action_, name));              \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_copied_data_action,\
         HPX_PP_CAT(__unordered_map_get_copied_data_action_, name));           \
@@ -415,6 +649,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_values_action,     \
         HPX_PP_CAT(__unordered_map_get_values_action_, name));                \
+    HPX_REGISTER_ACTION(                                                      \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::find_values_action,    \
+        HPX_PP_CAT(__unordered_map_find_values_action_, name));               \
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_value_action,      \
         HPX_PP_CAT(__unordered_map_set_value_action_, name));                 \
@@ -427,6 +664,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::erase_action,          \
         HPX_PP_CAT(__unordered_map_erase_action_, name));                     \
+    HPX_REGISTER_ACTION(                                                      \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::erase_values_action,   \
+        HPX_PP_CAT(__unordered_map_erase_values_action_, name));              \
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_copied_data_action,\
         HPX_PP_CAT(__unordered_map_get_copied_data_action_, name));           \
@@ -579,6 +819,36 @@ namespace hpx
                 this->get_id(), keys);
         }
 
+        /// Look up the elements with the given \a keys in the
+        /// partition_unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the partition_unordered_map
+        ///
+        /// \return Returns a pair for each of the given keys, the first member
+        ///         is true if the key was found, the second member holds the
+        ///         corresponding value in this case.
+        ///
+        std::vector<std::pair<bool, T> > find_values(launch::sync_policy,
+            std::vector<Key> const& keys) const
+        {
+            return find_values(keys).get();
+        }
+
+        /// Look up the elements with the given \a keys in the
+        /// partition_unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the partition_unordered_map
+        ///
+        /// \return This returns the found values as the hpx::future
+        ///
+        future<std::vector<std::pair<bool, T> > >
+        find_values(std::vector<Key> const& keys) const
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::find_values_action>(
+                this->get_id(), keys);
+        }
+
         /// Copy the value of \a val in the element at position
         /// \a pos in the partition_unordered_map container.
         ///
@@ -685,6 +955,34 @@ namespace hpx
                 this->get_id(), key);
         }
 
+        /// Erase all values with the given keys from the
+        /// partition_unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the partition_unordered_map
+        ///
+        /// \return Returns the number of elements erased
+        ///
+        std::size_t erase_values(launch::sync_policy,
+            std::vector<Key> const& keys)
+        {
+            return erase_values(keys).get();
+        }
+
+        /// Erase all values with the given keys from the
+        /// partition_unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the partition_unordered_map
+        ///
+        /// \return This returns the hpx::future containing the number of
+        ///         elements erased
+        ///
+        future<std::size_t> erase_values(std::vector<Key> const& keys)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::erase_values_action>(
+                this->get_id(), keys);
+        }
+
         /// Get/set all the data of this partition
         future<typename server_type::data_type> get_data() const
         {
@@ -9,7 +9,9 @@
 #define HPX_UNORDERED_MAP_NOV_11_2014_0852PM
 
 #include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
@@ -22,6 +24,10 @@
 #include <hpx/traits/is_distribution_policy.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/cache/concurrent_cache.hpp>
+#include <hpx/util/cache/entries/lru_entry.hpp>
+#include <hpx/util/cache/policies/always.hpp>
+#include <hpx/util/steady_clock.hpp>
 
 #include <hpx/components/containers/container_distribution_policy.hpp>
 #include <hpx/components/containers/unordered/partition_unordered_map_component.hpp>
@@ -33,6 +39,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -304,6 +311,20 @@ namespace hpx
         // global ID's of the underlying partitioned_vector_partitions.
         partitions_vector_type partitions_;
 
+        // The (optional) cache holding copies of values stored in remote
+        // partitions together with the time they were cached, see
+        // enable_cache().
+        typedef std::pair<T, util::steady_clock::time_point> cached_value_type;
+        typedef util::cache::entries::lru_entry<cached_value_type>
+            cache_entry_type;
+        typedef util::cache::concurrent_cache<
+                Key, cache_entry_type, std::less<cache_entry_type>,
+                util::cache::policies::always<cache_entry_type>, Hash
+            > cache_type;
+
+        std::shared_ptr<cache_type> cache_;
+        util::steady_clock::duration max_cache_age_;
+
         ///////////////////////////////////////////////////////////////////////
         // Connect this unordered_map to the existing unordered_mapusing the
         // given symbolic name.
@@ -556,13 +577,18 @@ namespace hpx
         unordered_map(unordered_map && rhs)
           : base_type(std::move(rhs)),
             hash_base_type(std::move(rhs)),
-            partitions_(std::move(rhs.partitions_))
+            partitions_(std::move(rhs.partitions_)),
+            cache_(std::move(rhs.cache_)),
+            max_cache_age_(rhs.max_cache_age_)
         {}
 
         unordered_map& operator=(unordered_map const& rhs)
         {
             if (this != &rhs)
+            {
                 copy_from(rhs);
+                cache_.reset();
+            }
             return *this;
         }
         unordered_map& operator=(unordered_map && rhs)
@@ -573,6 +599,8 @@ namespace hpx
                 this->hash_base_type::operator=(std::move(rhs));
 
                 partitions_ = std::move(rhs.partitions_);
+                cache_ = std::move(rhs.cache_);
+                max_cache_age_ = rhs.max_cache_age_;
             }
             return *this;
         }
@@ -735,6 +763,9 @@ namespace hpx
             }
             else
             {
+                if (cache_)
+                    update_cache(*cache_, pos, val);
+
                 partition_unordered_map_client(part_data.partition_)
                     .set_value(launch::sync, pos, std::forward<T_>(val));
             }
@@ -785,6 +816,9 @@ namespace hpx
                 return make_ready_future();
             }
 
+            if (cache_)
+                update_cache(*cache_, pos, val);
+
             return partition_unordered_map_client(part_data.partition_)
                 .set_value(pos, std::forward<T_>(val));
         }
@@ -840,6 +874,8 @@ namespace hpx
             if (part_data.local_data_)
                 return part_data.local_data_->erase(key);
 
+            invalidate_cache(std::vector<Key>(1, key));
+
             return partition_unordered_map_client(
                 part_data.partition_).erase(launch::sync, key);
         }
@@ -872,10 +908,376 @@ namespace hpx
             if (part_data.local_data_)
                 return make_ready_future(part_data.local_data_->erase(key));
 
+            invalidate_cache(std::vector<Key>(1, key));
+
             return partition_unordered_map_client(
                 part_data.partition_).erase(key);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Batched operations, the keys are grouped by partition and each
+        // partition is accessed at most once per call.
+
+        /// Asynchronously look up the elements with the given \a keys in the
+        /// unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the hpx::future to a vector holding a pair for each
+        ///         of the given keys (in the same order). The first member is
+        ///         true if the key was found, the second member holds the
+        ///         corresponding value in this case.
+        ///
+        future<std::vector<std::pair<bool, T> > >
+        find_many(std::vector<Key> const& keys) const
+        {
+            typedef std::vector<std::pair<bool, T> > result_type;
+
+            if (keys.empty())
+                return make_ready_future(result_type());
+
+            std::vector<std::size_t> offsets, order;
+            std::vector<Key> part_keys;
+            group_by_partition(keys, offsets, part_keys, order);
+
+            // values found in local partitions or in the cache are stored
+            // right away, all others are requested from their partition
+            std::shared_ptr<result_type> result =
+                std::make_shared<result_type>(keys.size());
+
+            std::vector<future<void> > part_futures;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                std::size_t first = offsets[part];
+                std::size_t last = offsets[part + 1];
+                if (first == last)
+                    continue;
+
+                partition_data const& part_data = partitions_[part];
+                if (part_data.local_data_)
+                {
+                    result_type part_result =
+                        part_data.local_data_->find_values(std::vector<Key>(
+                            part_keys.begin() + first, part_keys.begin() + last));
+
+                    for (std::size_t k = first; k != last; ++k)
+                        (*result)[order[k]] = std::move(part_result[k - first]);
+                    continue;
+                }
+
+                std::vector<Key> missed_keys;
+                std::vector<std::size_t> missed_order;
+                for (std::size_t k = first; k != last; ++k)
+                {
+                    T val;
+                    if (cache_ && get_cached_value(part_keys[k], val))
+                    {
+                        (*result)[order[k]] = std::make_pair(true, std::move(val));
+                        continue;
+                    }
+                    missed_keys.push_back(part_keys[k]);
+                    missed_order.push_back(order[k]);
+                }
+
+                if (missed_keys.empty())
+                    continue;
+
+                using util::placeholders::_1;
+                part_futures.push_back(
+                    partition_unordered_map_client(part_data.partition_)
+                        .find_values(missed_keys).then(
+                            util::bind(&unordered_map::find_many_helper,
+                                result, cache_, std::move(missed_keys),
+                                std::move(missed_order), _1)));
+            }
+
+            return dataflow(
+                [result](std::vector<future<void> > && part_futures)
+                    -> result_type
+                {
+                    for (future<void>& f: part_futures)
+                        f.get();
+                    return std::move(*result);
+                },
+                std::move(part_futures));
+        }
+
+        std::vector<std::pair<bool, T> >
+        find_many(launch::sync_policy, std::vector<Key> const& keys) const
+        {
+            return find_many(keys).get();
+        }
+
+        /// Asynchronously insert or overwrite the elements with the given
+        /// \a keys in the unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied, one for each key
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> insert_many(std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(keys.size() == vals.size());
+
+            if (keys.empty())
+                return make_ready_future();
+
+            std::vector<std::size_t> offsets, order;
+            std::vector<Key> part_keys;
+            group_by_partition(keys, offsets, part_keys, order);
+
+            std::vector<future<void> > part_futures;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                std::size_t first = offsets[part];
+                std::size_t last = offsets[part + 1];
+                if (first == last)
+                    continue;
+
+                std::vector<Key> part_k(
+                    part_keys.begin() + first, part_keys.begin() + last);
+                std::vector<T> part_v;
+                part_v.reserve(last - first);
+                for (std::size_t k = first; k != last; ++k)
+                    part_v.push_back(vals[order[k]]);
+
+                partition_data const& part_data = partitions_[part];
+                if (part_data.local_data_)
+                {
+                    part_data.local_data_->set_values(part_k, part_v);
+                    continue;
+                }
+
+                if (cache_)
+                {
+                    for (std::size_t i = 0; i != part_k.size(); ++i)
+                        update_cache(*cache_, part_k[i], part_v[i]);
+                }
+
+                part_futures.push_back(
+                    partition_unordered_map_client(part_data.partition_)
+                        .set_values(part_k, part_v));
+            }
+
+            return dataflow(
+                [](std::vector<future<void> > && part_futures)
+                {
+                    for (future<void>& f: part_futures)
+                        f.get();
+                },
+                std::move(part_futures));
+        }
+
+        void insert_many(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            insert_many(keys, vals).get();
+        }
+
+        /// Asynchronously erase the elements with the given \a keys from the
+        /// unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return This returns the hpx::future containing the number of
+        ///         elements erased
+        ///
+        future<std::size_t> erase_many(std::vector<Key> const& keys)
+        {
+            if (keys.empty())
+                return make_ready_future(std::size_t(0));
+
+            std::vector<std::size_t> offsets, order;
+            std::vector<Key> part_keys;
+            group_by_partition(keys, offsets, part_keys, order);
+
+            std::size_t erased = 0;
+            std::vector<Key> remote_keys;
+            std::vector<future<std::size_t> > part_futures;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                std::size_t first = offsets[part];
+                std::size_t last = offsets[part + 1];
+                if (first == last)
+                    continue;
+
+                std::vector<Key> part_k(
+                    part_keys.begin() + first, part_keys.begin() + last);
+
+                partition_data const& part_data = partitions_[part];
+                if (part_data.local_data_)
+                {
+                    erased += part_data.local_data_->erase_values(part_k);
+                    continue;
+                }
+
+                if (cache_)
+                {
+                    remote_keys.insert(
+                        remote_keys.end(), part_k.begin(), part_k.end());
+                }
+
+                part_futures.push_back(
+                    partition_unordered_map_client(part_data.partition_)
+                        .erase_values(part_k));
+            }
+
+            invalidate_cache(remote_keys);
+
+            return dataflow(
+                [erased](std::vector<future<std::size_t> > && part_futures)
+                    -> std::size_t
+                {
+                    std::size_t result = erased;
+                    for (future<std::size_t>& f: part_futures)
+                        result += f.get();
+                    return result;
+                },
+                std::move(part_futures));
+        }
+
+        std::size_t erase_many(launch::sync_policy, std::vector<Key> const& keys)
+        {
+            return erase_many(keys).get();
+        }
+
+        /// Enable the local read-through cache for values stored in remote
+        /// partitions.
+        ///
+        /// \param max_entries  The maximal number of values held by the cache,
+        ///                     the least recently used ones are evicted first
+        /// \param max_age      The time a cached value is used for, older
+        ///                     values are fetched from their partition again
+        ///
+        /// \warning The cached values are NOT kept coherent with the
+        ///          partitions. Writes performed through this object update
+        ///          or invalidate the cached values, however modifications
+        ///          made through any other unordered_map instance (or on
+        ///          other localities) are not observed. find_many may return
+        ///          values which are outdated by up to \a max_age. Enable the
+        ///          cache only if that is acceptable for all keys looked up
+        ///          through this object.
+        ///
+        /// \note The cache is consulted by find_many only. This function
+        ///       must not be called concurrently with any other operation on
+        ///       this object.
+        ///
+        void enable_cache(std::size_t max_entries,
+            util::steady_duration const& max_age)
+        {
+            cache_ = std::make_shared<cache_type>(max_entries);
+            max_cache_age_ = max_age.value();
+        }
+
+        /// Disable (and drop) the local read-through cache.
+        void disable_cache()
+        {
+            cache_.reset();
+        }
+
+    private:
+        // Sort the given keys by partition. On return, all keys belonging to
+        // partition 'part' are stored in part_keys[offsets[part],
+        // offsets[part + 1]), and 'order' holds the index into 'keys' each of
+        // them came from.
+        void group_by_partition(std::vector<Key> const& keys,
+            std::vector<std::size_t>& offsets, std::vector<Key>& part_keys,
+            std::vector<std::size_t>& order) const
+        {
+            std::size_t const num_parts = partitions_.size();
+
+            std::vector<std::size_t> parts;
+            parts.reserve(keys.size());
+
+            offsets.assign(num_parts + 1, 0);
+            for (Key const& key: keys)
+            {
+                std::size_t part = get_partition(key);
+                parts.push_back(part);
+                ++offsets[part + 1];
+            }
+
+            for (std::size_t part = 0; part != num_parts; ++part)
+                offsets[part + 1] += offsets[part];
+
+            std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+
+            part_keys.resize(keys.size());
+            order.resize(keys.size());
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                std::size_t k = next[parts[i]]++;
+                part_keys[k] = keys[i];
+                order[k] = i;
+            }
+        }
+
+        // Store the values received from a remote partition and add the ones
+        // found to the cache.
+        static void find_many_helper(
+            std::shared_ptr<std::vector<std::pair<bool, T> > > const& result,
+            std::shared_ptr<cache_type> const& cache,
+            std::vector<Key> const& keys, std::vector<std::size_t> const& order,
+            future<std::vector<std::pair<bool, T> > > && f)
+        {
+            std::vector<std::pair<bool, T> > part_result = f.get();
+            HPX_ASSERT(part_result.size() == keys.size());
+
+            for (std::size_t i = 0; i != part_result.size(); ++i)
+            {
+                if (cache && part_result[i].first)
+                    update_cache(*cache, keys[i], part_result[i].second);
+                (*result)[order[i]] = std::move(part_result[i]);
+            }
+        }
+
+        // Store the given value in the cache, it is used until it expires
+        template <typename T_>
+        static void update_cache(cache_type& cache, Key const& key,
+            T_ const& val)
+        {
+            cache.update(key,
+                cached_value_type(val, util::steady_clock::now()));
+        }
+
+        // Retrieve the given value from the cache, expired values are
+        // treated as being missing
+        bool get_cached_value(Key const& key, T& val) const
+        {
+            cached_value_type cached;
+            if (!cache_->get_entry(key, cached) ||
+                util::steady_clock::now() - cached.second > max_cache_age_)
+            {
+                return false;
+            }
+            val = std::move(cached.first);
+            return true;
+        }
+
+        // Remove the given keys from the cache
+        void invalidate_cache(std::vector<Key> const& keys) const
+        {
+            if (!cache_ || keys.empty())
+                return;
+
+            std::unordered_set<
+                    Key, detail::unordered_hasher<Hash>,
+                    detail::unordered_comparator<KeyEqual>
+                > erased(keys.begin(), keys.end(), keys.size(),
+                    this->hasher_, this->equal_);
+
+            cache_->erase(
+                [&erased](typename cache_type::storage_value_type const& v)
+                {
+                    return erased.find(v.first) != erased.end();
+                });
+        }
+
+    public:
+
         ///////////////////////////////////////////////////////////////////////
         typedef segment_unordered_map_iterator<
                 Key, T, Hash, KeyEqual,
@@ -14,11 +14,16 @@
 #include <hpx/components/iostreams/manipulators.hpp>
 #include <hpx/components/iostreams/server/output_stream.hpp>
 #include <hpx/runtime/components/client_base.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/util/register_locks.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #include <boost/atomic.hpp>
 #include <boost/iostreams/stream.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <iostream>
@@ -170,6 +175,85 @@ namespace hpx { namespace iostreams
         using detail::buffer::mtx_;
         boost::atomic<std::uint64_t> generational_count_;
 
+        // Output sent asynchronously is batched: the buffer is sent once it
+        // holds at least batch_size_ bytes or once batch_delay_ microseconds
+        // have passed since the first pending asynchronous flush.
+        std::size_t batch_size_;
+        std::uint64_t batch_delay_;
+        bool flush_scheduled_;
+
+        // Sends the buffer (if not empty) to the destination, unlocks the
+        // given lock. The generational count is drawn while holding the lock
+        // to preserve the order of the written data.
+        template <typename Lock>
+        void send_async(Lock& l)
+        {
+            if (!this->detail::buffer::empty_locked())
+            {
+                // Create the next buffer, returns the previous buffer
+                buffer next = this->detail::buffer::init_locked();
+                std::uint64_t count = generational_count_++;
+
+                // Unlock the mutex before we cleanup.
+                l.unlock();
+
+                // Perform the write operation, then destroy the old buffer and
+                // stream.
+                typedef server::output_stream::write_async_action action_type;
+                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
+                    count, next);
+            }
+            else
+            {
+                l.unlock();     // must unlock in any case
+            }
+        }
+
+        // Sends the buffer if it has grown beyond the batch size, otherwise
+        // makes sure it will be sent after the batch delay, unlocks the
+        // given lock.
+        template <typename Lock>
+        void flush_async(Lock& l)
+        {
+            if (batch_delay_ == 0 ||
+                this->detail::buffer::size_locked() >= batch_size_)
+            {
+                send_async(l);
+                return;
+            }
+
+            if (!flush_scheduled_ && !this->detail::buffer::empty_locked())
+            {
+                flush_scheduled_ = true;
+                l.unlock();
+
+                hpx::apply([this]() { this->flush_delayed(); });
+            }
+            else
+            {
+                l.unlock();     // must unlock in any case
+            }
+        }
+
+        void flush_delayed()
+        {
+            this_thread::sleep_for(std::chrono::microseconds(batch_delay_));
+
+            std::unique_lock<mutex_type> l(*mtx_);
+            hpx::util::ignore_while_checking<std::unique_lock<mutex_type> >
+                il(&l);
+
+            flush_scheduled_ = false;
+
+            // the stream might have been released in the meantime
+            if (!this->base_type::valid())
+            {
+                l.unlock();
+                return;
+            }
+            send_async(l);
+        }
+
         // Performs a lazy streaming operation.
         template <typename T>
         ostream& streaming_operator_lazy(T const& subject)
@@ -187,22 +271,8 @@ namespace hpx { namespace iostreams
             *static_cast<stream_base_type*>(this) << subject;
 
             // If the buffer isn't empty, send it asynchronously to the
-            // destination.
-            if (!this->detail::buffer::empty_locked())
-            {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
-            }
-
+            // destination, possibly batched with subsequent output.
+            flush_async(l);
             return *this;
         } // }}}
 
@@ -218,6 +288,7 @@ namespace hpx { namespace iostreams
             {
                 // Create the next buffer, returns the previous buffer
                 buffer next = this->detail::buffer::init_locked();
+                std::uint64_t count = generational_count_++;
 
                 // Unlock the mutex before we cleanup.
                 l.unlock();
@@ -226,7 +297,7 @@ namespace hpx { namespace iostreams
                 // stream.
                 typedef server::output_stream::write_sync_action action_type;
                 hpx::async<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next).get();
+                    count, next).get();
             }
             else
             {
@@ -241,26 +312,14 @@ namespace hpx { namespace iostreams
         bool flush()
         {
             std::unique_lock<mutex_type> l(*mtx_);
-            if (!this->detail::buffer::empty_locked())
-            {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
 
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // since mtx_ is recursive and apply will do an AGAS lookup,
-                // we need to ignore the lock here in case we are called
-                // recursively
-                hpx::util::ignore_while_checking<std::unique_lock<mutex_type> >
-                    il(&l);
+            // since mtx_ is recursive and apply will do an AGAS lookup,
+            // we need to ignore the lock here in case we are called
+            // recursively
+            hpx::util::ignore_while_checking<std::unique_lock<mutex_type> >
+                il(&l);
 
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
-            }
+            flush_async(l);
             return true;
         }
 
@@ -272,6 +331,13 @@ namespace hpx { namespace iostreams
         template <typename Tag>
         void initialize(Tag tag)
         {
+            batch_size_ = hpx::util::safe_lexical_cast<std::size_t>(
+                hpx::get_config_entry("hpx.iostreams.batch_size", 4096),
+                4096);
+            batch_delay_ = hpx::util::safe_lexical_cast<std::uint64_t>(
+                hpx::get_config_entry("hpx.iostreams.batch_delay", 1000),
+                1000);
+
             *static_cast<base_type*>(this) = detail::create_ostream(tag);
         }
 
@@ -296,6 +362,9 @@ namespace hpx { namespace iostreams
           , buffer()
           , stream_base_type(*this)
           , generational_count_(0)
+          , batch_size_(0)
+          , batch_delay_(0)
+          , flush_scheduled_(false)
         {}
 
         // hpx::flush manipulator
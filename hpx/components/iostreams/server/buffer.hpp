@@ -15,6 +15,7 @@
 
 #include <boost/swap.hpp>
 
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <mutex>
@@ -75,6 +76,11 @@ namespace hpx { namespace iostreams { namespace detail
             return !data_.get() || data_->empty();
         }
 
+        std::size_t size_locked() const
+        {
+            return data_.get() ? data_->size() : 0;
+        }
+
         buffer init()
         {
             std::lock_guard<mutex_type> l(*mtx_);
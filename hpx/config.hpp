@@ -183,6 +183,32 @@
 #  define HPX_AGAS_LOCAL_CACHE_SIZE 4096
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the number of independently locked partitions the tables of
+/// the AGAS primary namespace are split into. Consecutive GIDs are assigned
+/// to different partitions, which allows for operations on unrelated GIDs to
+/// proceed concurrently. It must be a power of two.
+#if !defined(HPX_AGAS_PRIMARY_NAMESPACE_PARTITIONS)
+#  define HPX_AGAS_PRIMARY_NAMESPACE_PARTITIONS 32
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the number of independently locked shards the queues of
+/// pending parcels of a parcelport are split into. Parcels for different
+/// destinations which end up in different shards can be enqueued and
+/// dequeued concurrently.
+#if !defined(HPX_PARCELPORT_PENDING_PARCELS_SHARDS)
+#  define HPX_PARCELPORT_PENDING_PARCELS_SHARDS 16
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of direct actions received as part of the
+/// same message which are executed one after the other on the same HPX-thread
+/// instead of creating a separate HPX-thread for each of them.
+#if !defined(HPX_PARCEL_MAX_INLINE_BATCH_SIZE)
+#  define HPX_PARCEL_MAX_INLINE_BATCH_SIZE 16
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 #if !defined(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS)
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
@@ -378,6 +404,19 @@
 #  define HPX_IDLE_LOOP_COUNT_MAX 200000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Number of times an idle worker polls its queue before it gets parked
+#if !defined(HPX_IDLE_SPIN_COUNT_MAX)
+#  define HPX_IDLE_SPIN_COUNT_MAX 1000
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Maximal time (in microseconds) a parked worker sleeps before it re-checks
+// for work on its own
+#if !defined(HPX_IDLE_BACKOFF_TIME_MAX)
+#  define HPX_IDLE_BACKOFF_TIME_MAX 10000
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Count number of busy thread manager loop executions before forcefully
 // cleaning up terminated thread objects
@@ -17,6 +17,7 @@
 
 #include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/collectives.hpp>
 #include <hpx/lcos/gather.hpp>
 #include <hpx/lcos/latch.hpp>
 #if defined(HPX_HAVE_QUEUE_COMPATIBILITY)
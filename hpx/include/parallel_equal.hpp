@@ -8,6 +8,7 @@
 #define HPX_PARALLEL_EQUAL_JUL_13_2014_1225PM
 
 #include <hpx/parallel/algorithms/equal.hpp>
+#include <hpx/parallel/segmented_algorithms/equal.hpp>
 
 #endif
 
@@ -0,0 +1,885 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file collectives.hpp
+
+#if !defined(HPX_LCOS_COLLECTIVES_OCT_17_2017_0612PM)
+#define HPX_LCOS_COLLECTIVES_OCT_17_2017_0612PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/error.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/component_factory.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/runtime/shutdown_function.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The collective operations in this file exchange plain values between a
+// number of call sites (usually one per locality). As opposed to the flat
+// gather_here/gather_there pair, no site ever receives more than O(log N)
+// messages per operation:
+//
+//  - gather, reduce and scatter use a binomial tree rooted at the given root
+//    site. Site ranks are taken relative to the root, so the first levels of
+//    the tree connect neighboring sites (which usually are localities on the
+//    same node) and only the last levels cross larger distances.
+//  - all_reduce uses recursive doubling. If the number of sites is not a
+//    power of two, the excess sites first fold their value into a neighbor
+//    and receive the final result from it at the end.
+//  - all_gather is a binomial gather to site zero followed by a binomial
+//    broadcast of the gathered values.
+//
+// Each site owns a communicator per base name which is created on first use
+// and kept until the runtime shuts down. It consists of a small component
+// registered under the base name receiving the messages sent to this site,
+// and of the cached ids of all peers this site has sent messages to. The
+// generation is part of every message, it has to be supplied if the same
+// base name is used more than once.
+namespace hpx { namespace lcos { namespace collectives
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Mailbox for all messages received by one site. Every message is
+        // identified by the generation of the operation and the step of the
+        // algorithm it belongs to; the receiving side may ask for the data
+        // before or after it has arrived. Entries are removed as soon as the
+        // data has been handed to the receiving side.
+        template <typename T>
+        class collective_server
+          : public hpx::components::simple_component_base<collective_server<T> >
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef lcos::local::promise<std::vector<T> > promise_type;
+            typedef std::pair<std::size_t, std::size_t> key_type;
+
+        public:
+            collective_server() //-V730
+            {
+                HPX_ASSERT(false);  // shouldn't ever be called
+            }
+
+            collective_server(std::string const& name, std::size_t site)
+              : name_(name), site_(site)
+            {}
+
+            ~collective_server()
+            {
+                hpx::unregister_with_basename(name_, site_);
+            }
+
+            hpx::future<std::vector<T> > get_data(std::size_t generation,
+                std::size_t step)
+            {
+                key_type const key(generation, step);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = arrived_.find(key);
+                if (it != arrived_.end())
+                {
+                    std::vector<T> data = std::move(it->second);
+                    arrived_.erase(it);
+                    return hpx::make_ready_future(std::move(data));
+                }
+                return waiting_[key].get_future();
+            }
+
+            void set_data(std::size_t generation, std::size_t step,
+                std::vector<T> && data)
+            {
+                key_type const key(generation, step);
+
+                promise_type p;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto it = waiting_.find(key);
+                    if (it == waiting_.end())
+                    {
+                        if (!arrived_.emplace(key, std::move(data)).second)
+                        {
+                            HPX_THROW_EXCEPTION(bad_parameter,
+                                "collective_server::set_data",
+                                "received the same message twice, the "
+                                "generation has to be supplied if the base "
+                                "name " + name_ + " is used more than once");
+                        }
+                        return;
+                    }
+                    p = std::move(it->second);
+                    waiting_.erase(it);
+                }
+                p.set_value(std::move(data));
+            }
+
+            HPX_DEFINE_COMPONENT_ACTION(
+                collective_server, set_data, set_data_action);
+
+        private:
+            mutex_type mtx_;
+            std::map<key_type, promise_type> waiting_;
+            std::map<key_type, std::vector<T> > arrived_;
+            std::string name_;
+            std::size_t site_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The steps of the different phases of an operation have to be
+        // distinct, each phase has at most 64 (tree levels) steps.
+        enum collective_phase
+        {
+            gather_phase = 0,
+            broadcast_phase = 64,
+            scatter_phase = 128,
+            reduce_phase = 192,
+            fold_phase = 256,
+            doubling_phase = 320,
+            unfold_phase = 384
+        };
+
+        inline std::size_t floor_log2(std::size_t n)
+        {
+            std::size_t k = 0;
+            while (n >>= 1)
+                ++k;
+            return k;
+        }
+
+        inline void check_sites(char const* function, std::size_t num_sites,
+            std::size_t this_site, std::size_t root_site)
+        {
+            if (num_sites == 0 || this_site >= num_sites ||
+                root_site >= num_sites)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter, function,
+                    "the given site numbers must be smaller than the number "
+                    "of participating sites");
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The end point of one site for all operations performed on a given
+        // base name. It registers the mailbox of this site once and caches
+        // the ids of the mailboxes of the peers it has sent messages to.
+        template <typename T>
+        class communicator
+        {
+            typedef collective_server<T> server_type;
+            typedef lcos::local::spinlock mutex_type;
+
+        public:
+            HPX_NON_COPYABLE(communicator);
+
+            communicator(std::string const& name, std::size_t this_site)
+              : name_(name)
+            {
+                id_ = hpx::new_<server_type>(
+                    hpx::find_here(), name_, this_site).get();
+
+                // Register unmanaged id to avoid cyclic dependencies,
+                // unregister is done in the destructor of the component.
+                if (!hpx::register_with_basename(
+                        name_, hpx::unmanaged(id_), this_site).get())
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::collectives::detail::communicator",
+                        "the given base name for the collective operation "
+                        "was already registered: " + name_);
+                }
+
+                server_ = hpx::get_ptr<server_type>(hpx::launch::sync, id_);
+            }
+
+            hpx::future<void> send(std::size_t site, std::size_t generation,
+                std::size_t step, std::vector<T> && data)
+            {
+                typedef typename server_type::set_data_action action_type;
+                return hpx::async(action_type(), peer(site), generation,
+                    step, std::move(data));
+            }
+
+            hpx::future<std::vector<T> > receive(std::size_t generation,
+                std::size_t step)
+            {
+                return server_->get_data(generation, step);
+            }
+
+        private:
+            hpx::id_type peer(std::size_t site)
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto it = peers_.find(site);
+                    if (it != peers_.end())
+                        return it->second;
+                }
+
+                // look up the peer without holding the lock, concurrent
+                // lookups of the same peer yield the same id
+                hpx::id_type id = hpx::find_from_basename(name_, site).get();
+
+                std::lock_guard<mutex_type> l(mtx_);
+                return peers_.emplace(site, std::move(id)).first->second;
+            }
+
+            std::string name_;
+            hpx::id_type id_;
+            std::shared_ptr<server_type> server_;
+
+            mutex_type mtx_;
+            std::map<std::size_t, hpx::id_type> peers_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // All communicators of this locality for a given value type. A
+        // communicator is created by the first operation of a site on a base
+        // name, all communicators are released before the runtime shuts down.
+        template <typename T>
+        class communicator_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef std::shared_ptr<communicator<T> > communicator_ptr;
+            typedef std::pair<std::string, std::size_t> key_type;
+            typedef std::map<
+                    key_type, hpx::shared_future<communicator_ptr>
+                > communicators_type;
+
+        public:
+            static communicator_ptr get(std::string const& name,
+                std::size_t this_site)
+            {
+                communicator_registry& r = instance();
+                key_type key(name, this_site);
+
+                lcos::local::promise<communicator_ptr> p;
+                bool register_cleanup = false;
+                {
+                    std::unique_lock<mutex_type> l(r.mtx_);
+                    auto it = r.communicators_.find(key);
+                    if (it != r.communicators_.end())
+                    {
+                        hpx::shared_future<communicator_ptr> f = it->second;
+                        l.unlock();
+                        return f.get();
+                    }
+
+                    // other operations on this site wait for the
+                    // communicator to be created
+                    r.communicators_.emplace(key, p.get_future().share());
+
+                    register_cleanup = !r.cleanup_registered_;
+                    r.cleanup_registered_ = true;
+                }
+
+                if (register_cleanup)
+                {
+                    hpx::register_pre_shutdown_function(
+                        &communicator_registry::clear);
+                }
+
+                try {
+                    communicator_ptr c =
+                        std::make_shared<communicator<T> >(name, this_site);
+                    p.set_value(c);
+                    return c;
+                }
+                catch (...) {
+                    {
+                        std::lock_guard<mutex_type> l(r.mtx_);
+                        r.communicators_.erase(key);
+                    }
+                    p.set_exception(std::current_exception());
+                    throw;
+                }
+            }
+
+        private:
+            communicator_registry()
+              : cleanup_registered_(false)
+            {}
+
+            static communicator_registry& instance()
+            {
+                static communicator_registry registry;
+                return registry;
+            }
+
+            static void clear()
+            {
+                communicator_registry& r = instance();
+
+                communicators_type communicators;
+                {
+                    std::lock_guard<mutex_type> l(r.mtx_);
+                    std::swap(communicators, r.communicators_);
+                    r.cleanup_registered_ = false;
+                }
+                // the communicators are released outside of the lock
+            }
+
+            mutex_type mtx_;
+            communicators_type communicators_;
+            bool cleanup_registered_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The local end point of one site participating in one collective
+        // operation. All ranks used by the algorithms are relative to the
+        // root site, the node translates them back to site numbers.
+        template <typename T>
+        class collective_node
+        {
+        public:
+            collective_node(std::string const& name, std::size_t generation,
+                    std::size_t num_sites, std::size_t this_site,
+                    std::size_t root_site = 0)
+              : communicator_(communicator_registry<T>::get(name, this_site)),
+                generation_(generation), num_sites_(num_sites),
+                root_site_(root_site),
+                rank_((this_site + num_sites - root_site) % num_sites)
+            {}
+
+            ~collective_node()
+            {
+                // make sure all outgoing messages have left before the
+                // values they refer to go out of scope
+                if (!sends_.empty())
+                    hpx::wait_all(sends_);
+            }
+
+            std::size_t rank() const { return rank_; }
+            std::size_t size() const { return num_sites_; }
+
+            void send(std::size_t rank, std::size_t step, std::vector<T> && data)
+            {
+                std::size_t site = (rank + root_site_) % num_sites_;
+                sends_.push_back(communicator_->send(site, generation_, step,
+                    std::move(data)));
+            }
+
+            std::vector<T> receive(std::size_t step)
+            {
+                return communicator_->receive(generation_, step).get();
+            }
+
+            // wait for all outgoing messages, rethrows any errors
+            void finish()
+            {
+                hpx::wait_all(sends_);
+                for (hpx::future<void>& f : sends_)
+                    f.get();
+                sends_.clear();
+            }
+
+        private:
+            std::shared_ptr<communicator<T> > communicator_;
+            std::size_t generation_;
+            std::size_t num_sites_;
+            std::size_t root_site_;
+            std::size_t rank_;
+            std::vector<hpx::future<void> > sends_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Binomial tree gather towards rank zero. The root returns all values
+        // in rank order, all other ranks return an empty vector.
+        template <typename T>
+        std::vector<T> tree_gather(collective_node<T>& node,
+            std::vector<T> block, std::size_t phase)
+        {
+            std::size_t const rank = node.rank();
+            std::size_t const size = node.size();
+
+            for (std::size_t mask = 1, k = 0; mask < size; mask <<= 1, ++k)
+            {
+                if (rank & mask)
+                {
+                    node.send(rank - mask, phase + k, std::move(block));
+                    return std::vector<T>();
+                }
+                if (rank + mask < size)
+                {
+                    // the child's block covers the ranks following ours
+                    std::vector<T> child = node.receive(phase + k);
+                    block.insert(block.end(),
+                        std::make_move_iterator(child.begin()),
+                        std::make_move_iterator(child.end()));
+                }
+            }
+            return block;
+        }
+
+        // Binomial tree scatter from rank zero. The root passes the values
+        // for all ranks in rank order, every rank ends up with its own value
+        // as the first element of the returned block. If 'split' is false,
+        // the whole block is forwarded to every rank (broadcast).
+        template <typename T>
+        std::vector<T> tree_scatter(collective_node<T>& node,
+            std::vector<T> block, std::size_t phase, bool split)
+        {
+            std::size_t const rank = node.rank();
+            std::size_t const size = node.size();
+
+            // the block of a non-root rank is sent by the parent which is
+            // found by clearing the lowest set bit of the rank
+            std::size_t mask = 1;
+            if (rank == 0)
+            {
+                while (mask < size)
+                    mask <<= 1;
+            }
+            else
+            {
+                mask = rank & (~rank + 1);
+                block = node.receive(phase + floor_log2(mask));
+            }
+
+            for (mask >>= 1; mask != 0; mask >>= 1)
+            {
+                if (rank + mask >= size)
+                    continue;
+
+                std::size_t step = phase + floor_log2(mask);
+                if (split)
+                {
+                    HPX_ASSERT(block.size() > mask);
+                    std::vector<T> upper(
+                        std::make_move_iterator(block.begin() + mask),
+                        std::make_move_iterator(block.end()));
+                    block.resize(mask);
+                    node.send(rank + mask, step, std::move(upper));
+                }
+                else
+                {
+                    node.send(rank + mask, step, std::vector<T>(block));
+                }
+            }
+            return block;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        std::vector<T> gather_impl(std::string const& name,
+            std::size_t generation, T value, std::size_t num_sites,
+            std::size_t this_site, std::size_t root_site)
+        {
+            collective_node<T> node(name, generation, num_sites, this_site,
+                root_site);
+
+            std::vector<T> block(1, std::move(value));
+            block = tree_gather(node, std::move(block), gather_phase);
+            node.finish();
+
+            if (node.rank() != 0)
+                return block;
+
+            // rotate from ranks (relative to the root) to site numbers
+            std::vector<T> result;
+            result.reserve(num_sites);
+            for (std::size_t site = 0; site != num_sites; ++site)
+            {
+                result.push_back(std::move(
+                    block[(site + num_sites - root_site) % num_sites]));
+            }
+            return result;
+        }
+
+        template <typename T>
+        std::vector<T> all_gather_impl(std::string const& name,
+            std::size_t generation, T value, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            collective_node<T> node(name, generation, num_sites, this_site);
+
+            std::vector<T> block(1, std::move(value));
+            block = tree_gather(node, std::move(block), gather_phase);
+            block = tree_scatter(node, std::move(block), broadcast_phase, false);
+            node.finish();
+
+            return block;
+        }
+
+        template <typename T>
+        T scatter_impl(std::string const& name, std::size_t generation,
+            std::vector<T> values, std::size_t num_sites,
+            std::size_t this_site, std::size_t root_site)
+        {
+            collective_node<T> node(name, generation, num_sites, this_site,
+                root_site);
+
+            std::vector<T> block;
+            if (node.rank() == 0)
+            {
+                if (values.size() != num_sites)
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::collectives::scatter",
+                        "the root site has to supply one value per site");
+                }
+
+                // rotate from site numbers to ranks relative to the root
+                block.reserve(num_sites);
+                for (std::size_t rank = 0; rank != num_sites; ++rank)
+                {
+                    block.push_back(std::move(
+                        values[(rank + root_site) % num_sites]));
+                }
+            }
+
+            block = tree_scatter(node, std::move(block), scatter_phase, true);
+            node.finish();
+
+            HPX_ASSERT(!block.empty());
+            return std::move(block.front());
+        }
+
+        template <typename T, typename F>
+        T reduce_impl(std::string const& name, std::size_t generation,
+            T value, F op, std::size_t num_sites, std::size_t this_site,
+            std::size_t root_site)
+        {
+            collective_node<T> node(name, generation, num_sites, this_site,
+                root_site);
+
+            std::size_t const rank = node.rank();
+            for (std::size_t mask = 1, k = 0; mask < num_sites; mask <<= 1, ++k)
+            {
+                if (rank & mask)
+                {
+                    node.send(rank - mask, reduce_phase + k,
+                        std::vector<T>(1, value));
+                    break;
+                }
+                if (rank + mask < num_sites)
+                {
+                    std::vector<T> child = node.receive(reduce_phase + k);
+                    value = op(std::move(value), std::move(child.front()));
+                }
+            }
+            node.finish();
+
+            return value;
+        }
+
+        template <typename T, typename F>
+        T all_reduce_impl(std::string const& name, std::size_t generation,
+            T value, F op, std::size_t num_sites, std::size_t this_site)
+        {
+            collective_node<T> node(name, generation, num_sites, this_site);
+
+            std::size_t const rank = node.rank();
+
+            // fold the sites exceeding the largest power of two into their
+            // neighbors: even ranks below 2*rem hand their value to the next
+            // odd rank and sit out the recursive doubling
+            std::size_t pof2 = std::size_t(1) << floor_log2(num_sites);
+            std::size_t rem = num_sites - pof2;
+
+            std::size_t new_rank = std::size_t(-1);
+            if (rank < 2 * rem)
+            {
+                if (rank % 2 == 0)
+                {
+                    node.send(rank + 1, fold_phase, std::vector<T>(1, value));
+                }
+                else
+                {
+                    std::vector<T> lower = node.receive(fold_phase);
+                    value = op(std::move(lower.front()), std::move(value));
+                    new_rank = rank / 2;
+                }
+            }
+            else
+            {
+                new_rank = rank - rem;
+            }
+
+            if (new_rank != std::size_t(-1))
+            {
+                for (std::size_t mask = 1, k = 0; mask < pof2; mask <<= 1, ++k)
+                {
+                    std::size_t new_peer = new_rank ^ mask;
+                    std::size_t peer = new_peer < rem ?
+                        new_peer * 2 + 1 : new_peer + rem;
+
+                    node.send(peer, doubling_phase + k, std::vector<T>(1, value));
+                    std::vector<T> other = node.receive(doubling_phase + k);
+
+                    // keep the order of the operands stable on all sites
+                    if (new_peer < new_rank)
+                        value = op(std::move(other.front()), std::move(value));
+                    else
+                        value = op(std::move(value), std::move(other.front()));
+                }
+            }
+
+            // hand the result back to the folded sites
+            if (rank < 2 * rem)
+            {
+                if (rank % 2 == 0)
+                {
+                    value = std::move(node.receive(unfold_phase).front());
+                }
+                else
+                {
+                    node.send(rank - 1, unfold_phase, std::vector<T>(1, value));
+                }
+            }
+            node.finish();
+
+            return value;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline void normalize_sites(std::size_t& num_sites,
+            std::size_t& this_site)
+        {
+            if (num_sites == std::size_t(-1))
+                num_sites = hpx::get_num_localities(hpx::launch::sync);
+            if (this_site == std::size_t(-1))
+                this_site = static_cast<std::size_t>(hpx::get_locality_id());
+        }
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Gather a set of values from all call sites at the root site
+    ///
+    /// \param  basename    The base name identifying the operation
+    /// \param  local       The value to contribute from this call site.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name. This needs to be supplied only if the
+    ///                     operation on the given base name has to be
+    ///                     performed more than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    /// \param root_site    The sequence number of the site receiving the
+    ///                     gathered values (default: 0).
+    ///
+    /// \note       Each data type used with the collective operations has to
+    ///             be registered using \a HPX_REGISTER_COLLECTIVES.
+    ///
+    /// \returns    A future holding the values of all sites ordered by site
+    ///             number on the root site and an empty vector on all other
+    ///             sites.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    gather(char const* basename, T && local,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1), std::size_t root_site = 0)
+    {
+        typedef typename util::decay<T>::type result_type;
+
+        detail::normalize_sites(num_sites, this_site);
+        detail::check_sites("hpx::lcos::collectives::gather",
+            num_sites, this_site, root_site);
+
+        return hpx::async(&detail::gather_impl<result_type>,
+            std::string(basename), generation,
+            result_type(std::forward<T>(local)), num_sites, this_site,
+            root_site);
+    }
+
+    /// Gather a set of values from all call sites on every call site
+    ///
+    /// The parameters have the same meaning as for \a gather.
+    ///
+    /// \returns    A future holding the values of all sites ordered by site
+    ///             number.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    all_gather(char const* basename, T && local,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type result_type;
+
+        detail::normalize_sites(num_sites, this_site);
+        detail::check_sites("hpx::lcos::collectives::all_gather",
+            num_sites, this_site, 0);
+
+        return hpx::async(&detail::all_gather_impl<result_type>,
+            std::string(basename), generation,
+            result_type(std::forward<T>(local)), num_sites, this_site);
+    }
+
+    /// Distribute a set of values from the root site to all call sites
+    ///
+    /// \param  values      The values to distribute, one per site ordered by
+    ///                     site number. Only the root site has to supply
+    ///                     them, all other sites pass an empty vector.
+    ///
+    /// The remaining parameters have the same meaning as for \a gather.
+    ///
+    /// \returns    A future holding the value destined for this site.
+    ///
+    template <typename T>
+    hpx::future<T>
+    scatter(char const* basename, std::vector<T> values,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1), std::size_t root_site = 0)
+    {
+        detail::normalize_sites(num_sites, this_site);
+        detail::check_sites("hpx::lcos::collectives::scatter",
+            num_sites, this_site, root_site);
+
+        return hpx::async(&detail::scatter_impl<T>,
+            std::string(basename), generation, std::move(values),
+            num_sites, this_site, root_site);
+    }
+
+    /// Combine the values of all call sites at the root site
+    ///
+    /// \param  op          The binary operation used to combine two values.
+    ///                     It has to be associative and, unless the root
+    ///                     site is zero, commutative.
+    ///
+    /// The remaining parameters have the same meaning as for \a gather.
+    ///
+    /// \returns    A future holding the combined value on the root site. The
+    ///             value returned on any other site is unspecified.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    reduce(char const* basename, T && local, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1), std::size_t root_site = 0)
+    {
+        typedef typename util::decay<T>::type result_type;
+        typedef typename util::decay<F>::type function_type;
+
+        detail::normalize_sites(num_sites, this_site);
+        detail::check_sites("hpx::lcos::collectives::reduce",
+            num_sites, this_site, root_site);
+
+        return hpx::async(
+            &detail::reduce_impl<result_type, function_type>,
+            std::string(basename), generation,
+            result_type(std::forward<T>(local)), std::forward<F>(op),
+            num_sites, this_site, root_site);
+    }
+
+    /// Combine the values of all call sites on every call site
+    ///
+    /// \param  op          The binary operation used to combine two values.
+    ///                     It has to be associative. Values are always
+    ///                     combined in the order of their site numbers, so
+    ///                     all sites receive the same result.
+    ///
+    /// The remaining parameters have the same meaning as for \a gather.
+    ///
+    /// \returns    A future holding the combined value.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    all_reduce(char const* basename, T && local, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type result_type;
+        typedef typename util::decay<F>::type function_type;
+
+        detail::normalize_sites(num_sites, this_site);
+        detail::check_sites("hpx::lcos::collectives::all_reduce",
+            num_sites, this_site, 0);
+
+        return hpx::async(
+            &detail::all_reduce_impl<result_type, function_type>,
+            std::string(basename), generation,
+            result_type(std::forward<T>(local)), std::forward<F>(op),
+            num_sites, this_site);
+    }
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_COLLECTIVES_DECLARATION(...)                             \
+    HPX_REGISTER_COLLECTIVES_DECLARATION_(__VA_ARGS__)                        \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_(...)                            \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_COLLECTIVES_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)      \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_1(type)                          \
+    HPX_REGISTER_COLLECTIVES_DECLARATION_2(type,                              \
+        HPX_PP_CAT(type, _collectives))                                       \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_2(type, name)                    \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::collectives::detail::collective_server<type>::             \
+            set_data_action,                                                  \
+        HPX_PP_CAT(collective_set_data_action_, name))                        \
+    /**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_COLLECTIVES(...)                                         \
+    HPX_REGISTER_COLLECTIVES_(__VA_ARGS__)                                    \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_(...)                                        \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_COLLECTIVES_, HPX_PP_NARGS(__VA_ARGS__)                  \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_1(type)                                      \
+    HPX_REGISTER_COLLECTIVES_2(type, HPX_PP_CAT(type, _collectives))          \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_2(type, name)                                \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::collectives::detail::collective_server<type>::             \
+            set_data_action,                                                  \
+        HPX_PP_CAT(collective_set_data_action_, name));                       \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::collectives::detail::collective_server<type>               \
+    > HPX_PP_CAT(collectives_, name);                                         \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(collectives_, name))                    \
+    /**/
+
+#endif
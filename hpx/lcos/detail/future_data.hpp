@@ -8,7 +8,6 @@
 
 #include <hpx/config.hpp>
 #include <hpx/error_code.hpp>
-#include <hpx/lcos/local/detail/condition_variable.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -24,14 +23,17 @@
 #include <hpx/util/bind.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/deferred_call.hpp>
+#include <hpx/util/detail/yield_k.hpp>
 #include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/unused.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/intrusive_ptr.hpp>
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -194,67 +196,47 @@ namespace detail
     };
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename F1, typename F2>
-    struct compose_cb_impl
+    // Entry of the list of continuations and waiting threads a shared state
+    // keeps until it becomes ready. Continuations leave the id empty, waiting
+    // threads leave the callback empty. The alignment leaves the lower three
+    // bits of pointers to entries for tagging the state word.
+    struct alignas(8) future_data_callback
     {
-        template <typename A1, typename A2>
-        compose_cb_impl(A1 && f1, A2 && f2)
-          : f1_(std::forward<A1>(f1))
-          , f2_(std::forward<A2>(f2))
-        {}
+        typedef util::unique_function_nonser<void()> completed_callback_type;
+
+        enum wait_state
+        {
+            not_waiting = 0,
+            waiting = 1,            // the thread is suspended
+            notified = 2,           // the thread has been resumed
+            abandoned = 3           // the thread timed out or was aborted
+        };
 
-        compose_cb_impl(compose_cb_impl&& other)
-          : f1_(std::move(other.f1_))
-          , f2_(std::move(other.f2_))
+        future_data_callback()
+          : next_(nullptr)
+          , id_(threads::invalid_thread_id_repr)
+          , state_(not_waiting)
         {}
 
-        void operator()()
-        {
-            bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
-#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            recurse_asynchronously =
-                !this_thread::has_sufficient_stack_space();
-#else
-            handle_continuation_recursion_count cnt;
-            recurse_asynchronously = recurse_asynchronously ||
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
-#endif
-            if (recurse_asynchronously)
-            {
-                error_code ec;
-                threads::thread_id_type id = threads::register_thread_nullary(
-                    compose_cb_impl(std::move(f1_), std::move(f2_)),
-                    "compose_cb",
-                    threads::pending, true, threads::thread_priority_boost,
-                    std::size_t(-1), threads::thread_stacksize_current, ec);
-                return;
-            }
+        explicit future_data_callback(completed_callback_type && f)
+          : next_(nullptr)
+          , on_completed_(std::move(f))
+          , id_(threads::invalid_thread_id_repr)
+          , state_(not_waiting)
+        {}
 
-            f1_();
-            f2_();
-        }
+        explicit future_data_callback(threads::thread_id_repr_type id)
+          : next_(nullptr)
+          , id_(id)
+          , state_(waiting)
+        {}
 
-    private:
-        F1 f1_;
-        F2 f2_;
+        future_data_callback* next_;
+        completed_callback_type on_completed_;
+        threads::thread_id_repr_type id_;
+        boost::atomic<int> state_;
     };
 
-    template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
-    compose_cb(F1 && f1, F2 && f2)
-    {
-        if (!f1)
-            return std::forward<F2>(f2);
-        else if (!f2)
-            return std::forward<F1>(f1);
-
-        // otherwise create a combined callback
-        typedef compose_cb_impl<
-            typename util::decay<F1>::type, typename util::decay<F2>::type
-        > result_type;
-        return result_type(std::forward<F1>(f1), std::forward<F2>(f2));
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT bool run_on_completed_on_new_thread(
         util::unique_function_nonser<bool()> && f, error_code& ec);
@@ -267,18 +249,23 @@ namespace detail
     struct future_data<traits::detail::future_data_void> : future_data_refcnt_base
     {
         future_data()
-          : state_(empty)
+          : state_(empty), inline_used_(false), num_abandoned_(0)
         {}
 
         future_data(init_no_addref no_addref)
-          : future_data_refcnt_base(no_addref), state_(empty)
+          : future_data_refcnt_base(no_addref)
+          , state_(empty), inline_used_(false), num_abandoned_(0)
         {}
 
         typedef lcos::local::spinlock mutex_type;
         typedef util::unused_type result_type;
         typedef future_data_refcnt_base::init_no_addref init_no_addref;
 
-        virtual ~future_data() noexcept {}
+        virtual ~future_data() noexcept
+        {
+            release_callbacks();
+        }
+
         virtual void execute_deferred(error_code& = throws) = 0;
         virtual bool cancelable() const = 0;
         virtual void cancel() = 0;
@@ -288,11 +275,17 @@ namespace detail
             error_code& = throws) = 0;
         virtual std::exception_ptr get_exception_ptr() const = 0;
 
+        // The state word holds either one of the ready states or the list of
+        // callbacks registered while the shared state was not ready yet, the
+        // latter possibly tagged with 'setting' and 'purging'. Callbacks are
+        // aligned to 8 bytes, thus a pointer never has the 'ready' bit set.
         enum state
         {
             empty = 0,
-            ready = 1,
-            value = 2 | ready,
+            setting = 1,            // the data is being stored
+            ready = 2,
+            purging = 4,            // abandoned entries are being removed
+            value = ready,
             exception = 4 | ready
         };
 
@@ -300,32 +293,174 @@ namespace detail
         /// \a future.
         bool is_ready() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return is_ready_locked(l);
+            return is_ready_state(state_.load(boost::memory_order_acquire));
         }
 
         template <typename Lock>
         bool is_ready_locked(Lock& l) const
         {
             HPX_ASSERT_OWNS_LOCK(l);
-            return (state_ & ready) != 0;
+            return is_ready();
         }
 
         bool has_value() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == value;
+            return state_.load(boost::memory_order_acquire) == value;
         }
 
         bool has_exception() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == exception;
+            return state_.load(boost::memory_order_acquire) == exception;
         }
 
     protected:
-         mutable mutex_type mtx_;
-         state state_;                               // current state
+        typedef future_data_callback::completed_callback_type
+            completed_callback_type;
+
+        static bool is_ready_state(std::uintptr_t s)
+        {
+            return (s & ready) != 0;
+        }
+
+        // Return the list of callbacks held by a state word which is not
+        // ready.
+        static future_data_callback* get_callbacks(std::uintptr_t s)
+        {
+            return reinterpret_cast<future_data_callback*>(
+                s & ~std::uintptr_t(setting | purging));
+        }
+
+        // Claim the right to store the data, fails if the data has already
+        // been (or is being) set.
+        bool start_setting()
+        {
+            std::uintptr_t s = state_.load(boost::memory_order_relaxed);
+            do {
+                if (s & (setting | ready))
+                    return false;
+            } while (!state_.compare_exchange_weak(s, s | setting,
+                boost::memory_order_acquire, boost::memory_order_relaxed));
+            return true;
+        }
+
+        // Storing the data failed, allow for it to be set again.
+        void cancel_setting()
+        {
+            state_.fetch_and(~std::uintptr_t(setting),
+                boost::memory_order_release);
+        }
+
+        // Publish the stored data and return the registered callbacks in the
+        // order they were registered.
+        future_data_callback* finish_setting(state s)
+        {
+            // wait for a concurrent removal of abandoned entries to finish
+            std::uintptr_t old = state_.load(boost::memory_order_relaxed);
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                if (!(old & purging) && state_.compare_exchange_weak(old, s,
+                        boost::memory_order_acq_rel,
+                        boost::memory_order_relaxed))
+                {
+                    break;
+                }
+
+                if (old & purging)
+                {
+                    util::detail::yield_k(k % 16,
+                        "hpx::lcos::detail::future_data::finish_setting");
+                    old = state_.load(boost::memory_order_relaxed);
+                }
+            }
+            HPX_ASSERT((old & setting) != 0);
+
+            future_data_callback* callbacks = get_callbacks(old);
+
+            future_data_callback* result = nullptr;
+            while (callbacks != nullptr)
+            {
+                future_data_callback* next = callbacks->next_;
+                callbacks->next_ = result;
+                result = callbacks;
+                callbacks = next;
+            }
+            return result;
+        }
+
+        // Register the given callback, fails if the shared state has become
+        // ready in the meantime.
+        bool push_callback(future_data_callback* cb)
+        {
+            std::uintptr_t s = state_.load(boost::memory_order_acquire);
+            do {
+                if (is_ready_state(s))
+                    return false;
+
+                cb->next_ = get_callbacks(s);
+
+            } while (!state_.compare_exchange_weak(s,
+                reinterpret_cast<std::uintptr_t>(cb) | (s & (setting | purging)),
+                boost::memory_order_release, boost::memory_order_acquire));
+            return true;
+        }
+
+        // Most shared states have a single continuation attached, which is
+        // stored in place.
+        future_data_callback* make_callback(completed_callback_type && f)
+        {
+            bool expected = false;
+            if (!inline_used_.load(boost::memory_order_relaxed) &&
+                inline_used_.compare_exchange_strong(expected, true,
+                    boost::memory_order_acquire))
+            {
+                inline_callback_.on_completed_ = std::move(f);
+                return &inline_callback_;
+            }
+            return new future_data_callback(std::move(f));
+        }
+
+        void release_callback(future_data_callback* cb)
+        {
+            if (cb == &inline_callback_)
+            {
+                inline_callback_.on_completed_.reset();
+                inline_callback_.next_ = nullptr;
+                inline_used_.store(false, boost::memory_order_release);
+            }
+            else
+            {
+                delete cb;
+            }
+        }
+
+        // Resume all threads waiting for the shared state to become ready,
+        // returns the remaining continuations.
+        HPX_EXPORT future_data_callback* notify_waiting(
+            future_data_callback* callbacks, error_code& ec);
+
+        // Suspend the calling thread until the shared state becomes ready or
+        // the given point in time has been reached.
+        HPX_EXPORT threads::thread_state_ex_enum wait_ready(
+            util::steady_clock::time_point const* abs_time,
+            char const* description, error_code& ec);
+
+        // Release all callbacks of a shared state which never became ready.
+        HPX_EXPORT void release_callbacks();
+
+        // Unlink and release the entries of threads which gave up waiting.
+        HPX_EXPORT void remove_abandoned();
+
+    protected:
+        // protects additional data of derived shared states
+        mutable mutex_type mtx_;
+
+        boost::atomic<std::uintptr_t> state_;       // current state
+
+        future_data_callback inline_callback_;
+        boost::atomic<bool> inline_used_;
+
+        // number of entries of threads which gave up waiting
+        boost::atomic<std::size_t> num_abandoned_;
     };
 
     template <typename Result>
@@ -355,7 +490,7 @@ namespace detail
                 reinterpret_cast<result_type*>(&storage_);
             ::new ((void*)value_ptr) result_type(
                 future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
+            state_.store(value, boost::memory_order_relaxed);
         }
 
         future_data(std::exception_ptr const& e, init_no_addref no_addref)
@@ -364,7 +499,7 @@ namespace detail
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(e);
-            state_ = exception;
+            state_.store(exception, boost::memory_order_relaxed);
         }
         future_data(std::exception_ptr && e, init_no_addref no_addref)
           : future_data<traits::detail::future_data_void>(no_addref)
@@ -372,7 +507,7 @@ namespace detail
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(std::move(e));
-            state_ = exception;
+            state_.store(exception, boost::memory_order_relaxed);
         }
 
         virtual ~future_data() noexcept
@@ -423,7 +558,8 @@ namespace detail
             // - there are multiple readers only (shared_future, lock hurts
             //   concurrency)
 
-            if (state_ == empty) {
+            std::uintptr_t s = state_.load(boost::memory_order_acquire);
+            if (s == empty) {
                 // the value has already been moved out of this future
                 HPX_THROWS_IF(ec, no_state,
                     "future_data::get_result",
@@ -434,7 +570,7 @@ namespace detail
             // the thread has been re-activated by one of the actions
             // supported by this promise (see promise::set_event
             // and promise::set_exception).
-            if (state_ == exception)
+            if (s == exception)
             {
                 std::exception_ptr* exception_ptr =
                     reinterpret_cast<std::exception_ptr*>(&storage_);
@@ -465,7 +601,8 @@ namespace detail
             // - there are multiple readers only (shared_future, lock hurts
             //   concurrency)
 
-            if (state_ == empty) {
+            std::uintptr_t s = state_.load(boost::memory_order_acquire);
+            if (s == empty) {
                 // the value has already been moved out of this future
                 HPX_THROWS_IF(ec, no_state,
                     "future_data::get_result",
@@ -476,7 +613,7 @@ namespace detail
             // the thread has been re-activated by one of the actions
             // supported by this promise (see promise::set_event
             // and promise::set_exception).
-            if (state_ == exception)
+            if (s == exception)
             {
                 std::exception_ptr* exception_ptr =
                     reinterpret_cast<std::exception_ptr*>(&storage_);
@@ -562,95 +699,102 @@ namespace detail
             }
         }
 
+        // resume the waiting threads and invoke the continuations registered
+        // before the data was set
+        void handle_callbacks(future_data_callback* callbacks, error_code& ec)
+        {
+            if (callbacks == nullptr)
+                return;
+
+            // Note: threads waiting for the future to become ready are
+            //       resumed before any of the continuations is invoked
+            error_code notify_ec(lightweight);
+            callbacks = this->notify_waiting(callbacks, notify_ec);
+
+            // invoke the callback (continuation) functions in the order they
+            // were attached
+            try {
+                while (callbacks != nullptr)
+                {
+                    future_data_callback* next = callbacks->next_;
+                    completed_callback_type on_completed =
+                        std::move(callbacks->on_completed_);
+                    this->release_callback(callbacks);
+                    callbacks = next;
+
+                    handle_on_completed(std::move(on_completed));
+                }
+            }
+            catch (...) {
+                while (callbacks != nullptr)
+                {
+                    future_data_callback* next = callbacks->next_;
+                    this->release_callback(callbacks);
+                    callbacks = next;
+                }
+                throw;
+            }
+
+            if (notify_ec)
+            {
+                if (&ec == &throws)
+                {
+                    std::rethrow_exception(
+                        hpx::detail::access_exception(notify_ec));
+                }
+                ec = std::move(notify_ec);
+            }
+        }
+
         /// Set the result of the requested action.
         template <typename Target>
         void set_value(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked(l)) {
-                l.unlock();
+            if (!this->start_setting()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed = std::move(this->on_completed_);
-
             // set the data
-            result_type* value_ptr =
-                reinterpret_cast<result_type*>(&storage_);
-            ::new ((void*)value_ptr) result_type(
-                future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
-
-            // handle all threads waiting for the future to become ready
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost, ec))
-            {
-                l = std::unique_lock<mutex_type>(this->mtx_);
+            try {
+                result_type* value_ptr =
+                    reinterpret_cast<result_type*>(&storage_);
+                ::new ((void*)value_ptr) result_type(
+                    future_data_result<Result>::set(std::forward<Target>(data)));
+            }
+            catch (...) {
+                this->cancel_setting();
+                throw;
             }
 
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // make the data visible, handle all threads waiting for the
+            // future to become ready, and invoke the continuations
+            handle_callbacks(this->finish_setting(value), ec);
         }
 
         template <typename Target>
         void set_exception(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked(l)) {
-                l.unlock();
+            if (!this->start_setting()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed = std::move(this->on_completed_);
-
             // set the data
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(
                 std::forward<Target>(data));
-            state_ = exception;
-
-            // handle all threads waiting for the future to become ready
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost, ec))
-            {
-                l = std::unique_lock<mutex_type>(this->mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // make the data visible, handle all threads waiting for the
+            // future to become ready, and invoke the continuations
+            handle_callbacks(this->finish_setting(exception), ec);
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -696,7 +840,7 @@ namespace detail
             // and no reader
 
             // release any stored data and callback functions
-            switch (state_) {
+            switch (state_.load(boost::memory_order_relaxed)) {
             case value:
             {
                 result_type* value_ptr =
@@ -711,11 +855,12 @@ namespace detail
                 exception_ptr->~exception_ptr();
                 break;
             }
-            default: break;
+            default:
+                this->release_callbacks();
+                break;
             }
 
-            state_ = empty;
-            on_completed_ = completed_callback_type();
+            state_.store(empty, boost::memory_order_relaxed);
         }
 
         // continuation support
@@ -727,33 +872,29 @@ namespace detail
         {
             if (!data_sink) return;
 
-            std::unique_lock<mutex_type> l(this->mtx_);
-
-            if (is_ready_locked(l)) {
-
-                HPX_ASSERT(!on_completed_);
-
-                // invoke the callback (continuation) function right away
-                l.unlock();
-
-                handle_on_completed(std::move(data_sink));
-            }
-            else {
-                // store a combined callback wrapping the old and the new one
-                // make sure continuations are evaluated in the order they are
-                // attached
-                this->on_completed_ = compose_cb(
-                    std::move(on_completed_), std::move(data_sink));
+            if (!this->is_ready())
+            {
+                // store the callback, make sure continuations are evaluated
+                // in the order they are attached
+                future_data_callback* cb =
+                    this->make_callback(std::move(data_sink));
+                if (this->push_callback(cb))
+                    return;
+
+                // the future has become ready in the meantime
+                data_sink = std::move(cb->on_completed_);
+                this->release_callback(cb);
             }
+
+            // invoke the callback (continuation) function right away
+            handle_on_completed(std::move(data_sink));
         }
 
         virtual void wait(error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
-                cond_.wait(l, "future_data::wait", ec);
+            if (!this->is_ready()) {
+                this->wait_ready(nullptr, "future_data::wait", ec);
                 if (ec) return;
             }
 
@@ -765,13 +906,10 @@ namespace detail
         wait_until(util::steady_clock::time_point const& abs_time,
             error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
+            if (!this->is_ready()) {
                 threads::thread_state_ex_enum const reason =
-                    cond_.wait_until(l, abs_time,
-                        "future_data::wait_until", ec);
+                    this->wait_ready(&abs_time, "future_data::wait_until", ec);
                 if (ec) return future_status::uninitialized;
 
                 if (reason == threads::wait_timeout)
@@ -788,15 +926,11 @@ namespace detail
 
         std::exception_ptr get_exception_ptr() const
         {
-            HPX_ASSERT(state_ == exception);
+            HPX_ASSERT(state_.load(boost::memory_order_acquire) == exception);
             return *reinterpret_cast<std::exception_ptr const*>(&storage_);
         }
 
-    protected:
-        completed_callback_type on_completed_;
-
     private:
-        local::detail::condition_variable cond_;    // threads waiting in read
         typename future_data_storage<Result>::type storage_;
     };
 
@@ -957,39 +1091,25 @@ namespace detail
     private:
         bool started_test() const
         {
-            std::lock_guard<mutex_type> l(this->mtx_);
-            return started_;
+            return started_.load(boost::memory_order_acquire);
         }
 
         bool started_test_and_set()
         {
-            std::lock_guard<mutex_type> l(this->mtx_);
-            return started_test_and_set_locked(l);
-        }
-
-        template <typename Lock>
-        bool started_test_and_set_locked(Lock& l)
-        {
-            HPX_ASSERT_OWNS_LOCK(l);
-            if (started_)
+            if (started_.load(boost::memory_order_relaxed))
                 return true;
-
-            started_ = true;
-            return false;
+            return started_.exchange(true, boost::memory_order_acq_rel);
         }
 
     protected:
         void check_started()
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-            if (started_) {
-                l.unlock();
+            if (started_.exchange(true, boost::memory_order_acq_rel)) {
                 HPX_THROW_EXCEPTION(task_already_started,
                     "task_base::check_started",
                     "this task has already been started");
                 return;
             }
-            started_ = true;
         }
 
     public:
@@ -1035,7 +1155,7 @@ namespace detail
         }
 
     protected:
-        bool started_;
+        boost::atomic<bool> started_;
         threads::executor* sched_;
     };
 
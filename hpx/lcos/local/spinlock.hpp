@@ -74,7 +74,7 @@ namespace hpx { namespace lcos { namespace local
 #endif
             else if(k < 32 || k & 1) //-V112
             {
-                if (hpx::threads::get_self_ptr())
+                if (hpx::this_thread::can_suspend())
                 {
                     hpx::this_thread::suspend(hpx::threads::pending_boost,
                         "hpx::lcos::local::spinlock::yield");
@@ -101,7 +101,7 @@ namespace hpx { namespace lcos { namespace local
                 }
 #endif
 
-                if (hpx::threads::get_self_ptr())
+                if (hpx::this_thread::can_suspend())
                 {
                     hpx::this_thread::suspend(hpx::threads::pending,
                         "hpx::lcos::local::spinlock::yield");
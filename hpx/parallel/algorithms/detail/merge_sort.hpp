@@ -0,0 +1,273 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_MERGE_SORT_OCT_17_2017_1040AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_MERGE_SORT_OCT_17_2017_1040AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/sort_tasks.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parallel stable merge sort
+    //
+    // The sequence is split into chunks which are sorted concurrently using
+    // std::stable_sort. The sorted runs are merged pairwise until a single
+    // run is left, alternating between the sequence and a temporary buffer.
+    // Each round of merges is split into pieces of equal size (independently
+    // of the length of the merged runs) to keep all cores busy during the
+    // last rounds as well.
+
+    // Return the number of elements of the first run which go into the first
+    // n elements of the merged sequence. Elements of the first run precede
+    // equal elements of the second run.
+    template <typename Iter1, typename Iter2, typename Compare>
+    std::size_t merge_sort_split(Iter1 first1, std::size_t count1,
+        Iter2 first2, std::size_t count2, std::size_t n, Compare& comp)
+    {
+        std::size_t lo = n > count2 ? n - count2 : 0;
+        std::size_t hi = (std::min)(n, count1);
+        while (lo != hi)
+        {
+            std::size_t i = lo + (hi - lo) / 2;
+            std::size_t j = n - i;
+
+            // the i-th element of the first run is part of the first n
+            // elements if it is not greater than the (j-1)-th element of the
+            // second run
+            if (j != 0 && !comp(*(first2 + (j - 1)), *(first1 + i)))
+                lo = i + 1;
+            else
+                hi = i;
+        }
+        return lo;
+    }
+
+    // Return the number of elements of the first run of the pair of runs
+    // containing the element at position pos which go into the merged
+    // sequence before that element.
+    template <typename Iter, typename Compare>
+    std::size_t merge_sort_split_at(Iter src,
+        std::vector<std::size_t> const& runs, std::size_t pos, Compare& comp)
+    {
+        std::size_t const num_runs = runs.size() - 1;
+        for (std::size_t r = 0; r + 1 < num_runs; r += 2)
+        {
+            std::size_t first = runs[r];
+            std::size_t middle = runs[r + 1];
+            std::size_t last = runs[r + 2];
+
+            if (pos > first && pos < last)
+            {
+                return merge_sort_split(src + first, middle - first,
+                    src + middle, last - middle, pos - first, comp);
+            }
+        }
+        return 0;
+    }
+
+    // Merge the pieces of all pairs of runs of one round which are assigned
+    // to the given task. The split points of the piece have to be computed
+    // beforehand as the elements are moved out of the source while other
+    // pieces are merged.
+    template <typename Iter1, typename Iter2>
+    struct merge_sort_piece
+    {
+        Iter1 src;
+        Iter2 dest;
+        std::size_t begin;
+        std::size_t end;
+        std::size_t split_begin;
+        std::size_t split_end;
+    };
+
+    template <typename Iter1, typename Iter2, typename Compare>
+    void merge_sort_round(merge_sort_piece<Iter1, Iter2> const& piece,
+        std::vector<std::size_t> const& runs, Compare& comp)
+    {
+        Iter1 src = piece.src;
+        Iter2 dest = piece.dest;
+
+        std::size_t const num_runs = runs.size() - 1;
+        for (std::size_t r = 0; r < num_runs; r += 2)
+        {
+            std::size_t first = runs[r];
+            std::size_t middle = runs[r + 1];
+            std::size_t last = r + 2 <= num_runs ? runs[r + 2] : middle;
+
+            std::size_t b = (std::max)(piece.begin, first);
+            std::size_t e = (std::min)(piece.end, last);
+            if (b >= e)
+                continue;
+
+            if (middle == last)
+            {
+                // an odd run is left over
+                std::move(src + b, src + e, dest + b);
+                continue;
+            }
+
+            std::size_t i1 = b == piece.begin ? piece.split_begin : 0;
+            std::size_t i2 = e == piece.end && e != last ?
+                piece.split_end : middle - first;
+
+            std::merge(
+                std::make_move_iterator(src + (first + i1)),
+                std::make_move_iterator(src + (first + i2)),
+                std::make_move_iterator(src + (middle + (b - first - i1))),
+                std::make_move_iterator(src + (middle + (e - first - i2))),
+                dest + b, comp);
+        }
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Iter2,
+        typename Compare>
+    void merge_sort_round(ExPolicy& policy, Iter1 src, Iter2 dest,
+        std::size_t count, std::size_t num_pieces,
+        std::vector<std::size_t> const& runs, Compare& comp)
+    {
+        // find the split points of all pieces before moving any element
+        std::vector<std::size_t> splits(num_pieces + 1, 0);
+        run_sort_tasks(policy, num_pieces,
+            [&](std::size_t piece)
+            {
+                splits[piece] = merge_sort_split_at(src, runs,
+                    get_sort_part_begin(count, num_pieces, piece), comp);
+            });
+
+        run_sort_tasks(policy, num_pieces,
+            [&](std::size_t piece)
+            {
+                merge_sort_piece<Iter1, Iter2> p = {
+                    src, dest,
+                    get_sort_part_begin(count, num_pieces, piece),
+                    get_sort_part_begin(count, num_pieces, piece + 1),
+                    splits[piece], splits[piece + 1]
+                };
+                merge_sort_round(p, runs, comp);
+            });
+    }
+
+    template <typename ExPolicy, typename RandomIt, typename Compare>
+    void merge_sort(ExPolicy& policy, RandomIt first, RandomIt last,
+        Compare comp)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type
+            value_type;
+
+        std::size_t const count = static_cast<std::size_t>(last - first);
+        std::size_t const num_chunks =
+            get_sort_num_tasks(policy, count, sort_limit_per_task / 4);
+
+        // sort all chunks and move them to the temporary buffer
+        sort_buffer<value_type> buffer(count, num_chunks);
+
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                RandomIt begin = first + buffer.part_begin(chunk);
+                RandomIt end = first + buffer.part_begin(chunk + 1);
+
+                std::stable_sort(begin, end, comp);
+                buffer.construct(chunk, begin);
+            });
+
+        std::vector<std::size_t> runs(num_chunks + 1);
+        for (std::size_t i = 0; i <= num_chunks; ++i)
+            runs[i] = buffer.part_begin(i);
+
+        // merge pairs of runs until only one is left
+        bool in_buffer = true;
+        while (runs.size() > 2)
+        {
+            if (in_buffer)
+            {
+                merge_sort_round(policy, buffer.data(), first, count,
+                    num_chunks, runs, comp);
+            }
+            else
+            {
+                merge_sort_round(policy, first, buffer.data(), count,
+                    num_chunks, runs, comp);
+            }
+            in_buffer = !in_buffer;
+
+            std::vector<std::size_t> merged;
+            merged.reserve(runs.size() / 2 + 1);
+            for (std::size_t r = 0; r < runs.size() - 1; r += 2)
+                merged.push_back(runs[r]);
+            merged.push_back(count);
+            runs = std::move(merged);
+        }
+
+        // move the result back into the sequence and release the buffer
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                if (in_buffer)
+                {
+                    std::size_t begin = buffer.part_begin(chunk);
+                    std::size_t end = buffer.part_begin(chunk + 1);
+                    std::move(buffer.data() + begin, buffer.data() + end,
+                        first + begin);
+                }
+                buffer.destroy(chunk);
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename RandomIt, typename Compare>
+    hpx::future<RandomIt>
+    parallel_stable_sort_async(ExPolicy && policy, RandomIt first,
+        RandomIt last, Compare comp)
+    {
+        hpx::future<RandomIt> result;
+        try {
+            std::ptrdiff_t N = last - first;
+            HPX_ASSERT(N >= 0);
+
+            if (std::size_t(N) < sort_limit_per_task)
+            {
+                std::stable_sort(first, last, comp);
+                return hpx::make_ready_future(last);
+            }
+
+            // check if already sorted
+            if (detail::is_sorted_sequential(first, last, comp))
+                return hpx::make_ready_future(last);
+
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            result = async_sort(std::forward<ExPolicy>(policy), first, last,
+                std::move(comp), &merge_sort<policy_type, RandomIt, Compare>);
+        }
+        catch (...) {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::current_exception());
+        }
+
+        if (result.has_exception())
+        {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::move(result));
+        }
+
+        return result;
+    }
+    /// \endcond
+}}}}
+
+#endif
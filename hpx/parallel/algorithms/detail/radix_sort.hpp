@@ -0,0 +1,318 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_OCT_17_2017_1125AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_OCT_17_2017_1125AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/sort_tasks.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Map arithmetic values onto unsigned integers of the same size such that
+    // the order of the integers corresponds to the order of the values as
+    // defined by operator<().
+    template <typename T, typename Enable = void>
+    struct radix_sort_key
+    {
+        typedef void type;
+    };
+
+    template <typename T>
+    struct radix_sort_key<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && !std::is_same<T, bool>::value
+        >::type>
+    {
+        typedef typename std::make_unsigned<T>::type type;
+
+        static type call(T value)
+        {
+            // flip the sign bit of signed values
+            return static_cast<type>(value) ^ (std::is_signed<T>::value ?
+                type(type(1) << (8 * sizeof(T) - 1)) : type(0));
+        }
+    };
+
+    template <typename T>
+    struct radix_sort_key<T,
+        typename std::enable_if<
+            std::is_floating_point<T>::value &&
+            (sizeof(T) == sizeof(std::uint32_t) ||
+                sizeof(T) == sizeof(std::uint64_t))
+        >::type>
+    {
+        typedef typename std::conditional<
+                sizeof(T) == sizeof(std::uint32_t),
+                std::uint32_t, std::uint64_t
+            >::type type;
+
+        static type call(T value)
+        {
+            type const sign_bit = type(1) << (8 * sizeof(T) - 1);
+
+            // -0.0 and 0.0 compare equal, use the same key for both
+            if (value == T(0))
+                return sign_bit;
+
+            type bits;
+            std::memcpy(&bits, &value, sizeof(T));
+
+            // negative values: flip all bits, positive values: set sign bit
+            return (bits & sign_bit) ? type(~bits) : type(bits | sign_bit);
+        }
+    };
+
+    // The radix sort can be used if the sequence is sorted by the natural
+    // order of an arithmetic value type.
+    template <typename T, typename Compare>
+    struct is_radix_sort_compare
+      : std::false_type
+    {};
+
+    template <typename T>
+    struct is_radix_sort_compare<T, detail::less>
+      : std::true_type
+    {};
+
+    template <typename T>
+    struct is_radix_sort_compare<T, std::less<T> >
+      : std::true_type
+    {};
+
+    template <typename T>
+    struct is_radix_sort_compare<T, std::less<void> >
+      : std::true_type
+    {};
+
+    template <typename RandomIt, typename Compare, typename Proj>
+    struct is_radix_sortable
+      : std::integral_constant<bool,
+            !std::is_void<typename radix_sort_key<
+                typename std::iterator_traits<RandomIt>::value_type
+            >::type>::value &&
+            is_radix_sort_compare<
+                typename std::iterator_traits<RandomIt>::value_type,
+                typename hpx::util::decay<Compare>::type
+            >::value &&
+            std::is_same<
+                typename hpx::util::decay<Proj>::type,
+                util::projection_identity
+            >::value>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parallel LSD radix sort
+    //
+    // The keys are sorted one byte at a time, starting with the least
+    // significant byte. Each pass counts the number of keys per chunk and
+    // digit, and moves the keys to their position in the other of the
+    // sequence and a temporary buffer. Digits which are equal for all keys
+    // are skipped. The radix sort is stable.
+    static const std::size_t radix_sort_digit_bits = 8;
+    static const std::size_t radix_sort_num_digits =
+        std::size_t(1) << radix_sort_digit_bits;
+
+    template <typename ExPolicy, typename Iter1, typename Iter2>
+    void radix_sort_pass(ExPolicy& policy, Iter1 src, Iter2 dest,
+        std::size_t count, std::size_t num_chunks, std::size_t shift,
+        std::vector<std::size_t>& offsets)
+    {
+        typedef typename std::iterator_traits<Iter1>::value_type value_type;
+        typedef radix_sort_key<value_type> key;
+
+        std::fill(offsets.begin(), offsets.end(), std::size_t(0));
+
+        // count the keys per chunk and digit
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                std::size_t begin = get_sort_part_begin(count, num_chunks, chunk);
+                std::size_t end = get_sort_part_begin(count, num_chunks, chunk + 1);
+
+                std::size_t* counts = &offsets[chunk * radix_sort_num_digits];
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    ++counts[(key::call(*(src + i)) >> shift) &
+                        (radix_sort_num_digits - 1)];
+                }
+            });
+
+        // compute the position of each chunk's part of each digit
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d != radix_sort_num_digits; ++d)
+        {
+            for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+            {
+                std::size_t& o = offsets[chunk * radix_sort_num_digits + d];
+                std::size_t n = o;
+                o = offset;
+                offset += n;
+            }
+        }
+        HPX_ASSERT(offset == count);
+
+        // move the keys to their new position
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                std::size_t begin = get_sort_part_begin(count, num_chunks, chunk);
+                std::size_t end = get_sort_part_begin(count, num_chunks, chunk + 1);
+
+                std::size_t* positions = &offsets[chunk * radix_sort_num_digits];
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    value_type value = *(src + i);
+                    std::size_t digit = (key::call(value) >> shift) &
+                        (radix_sort_num_digits - 1);
+                    *(dest + positions[digit]++) = value;
+                }
+            });
+    }
+
+    template <typename ExPolicy, typename RandomIt>
+    void radix_sort(ExPolicy& policy, RandomIt first, RandomIt last)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type
+            value_type;
+        typedef radix_sort_key<value_type> key;
+        typedef typename key::type key_type;
+
+        std::size_t const count = static_cast<std::size_t>(last - first);
+        std::size_t const num_chunks =
+            get_sort_num_tasks(policy, count, sort_limit_per_task / 4);
+
+        // find the bits which differ between the keys, digits which are
+        // equal for all keys don't need to be sorted
+        std::vector<key_type> and_bits(num_chunks, key_type(~key_type(0)));
+        std::vector<key_type> or_bits(num_chunks, key_type(0));
+
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                std::size_t begin = get_sort_part_begin(count, num_chunks, chunk);
+                std::size_t end = get_sort_part_begin(count, num_chunks, chunk + 1);
+
+                key_type a = key_type(~key_type(0)), o = key_type(0);
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    key_type k = key::call(*(first + i));
+                    a &= k;
+                    o |= k;
+                }
+                and_bits[chunk] = a;
+                or_bits[chunk] = o;
+            });
+
+        key_type differing_bits = key_type(0);
+        for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+            differing_bits |= key_type(and_bits[chunk] ^ or_bits[chunk]);
+
+        if (differing_bits == key_type(0))
+            return;             // all keys are equal
+
+        std::unique_ptr<value_type[]> buffer(new value_type[count]);
+        std::vector<std::size_t> offsets(num_chunks * radix_sort_num_digits);
+
+        bool in_buffer = false;
+        for (std::size_t shift = 0; shift < 8 * sizeof(key_type);
+             shift += radix_sort_digit_bits)
+        {
+            if (((differing_bits >> shift) & (radix_sort_num_digits - 1)) == 0)
+                continue;
+
+            if (in_buffer)
+            {
+                radix_sort_pass(policy, buffer.get(), first, count,
+                    num_chunks, shift, offsets);
+            }
+            else
+            {
+                radix_sort_pass(policy, first, buffer.get(), count,
+                    num_chunks, shift, offsets);
+            }
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            value_type const* data = buffer.get();
+            run_sort_tasks(policy, num_chunks,
+                [&](std::size_t chunk)
+                {
+                    std::size_t begin =
+                        get_sort_part_begin(count, num_chunks, chunk);
+                    std::size_t end =
+                        get_sort_part_begin(count, num_chunks, chunk + 1);
+                    std::copy(data + begin, data + end, first + begin);
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename RandomIt>
+    hpx::future<RandomIt>
+    parallel_radix_sort_async(ExPolicy && policy, RandomIt first,
+        RandomIt last)
+    {
+        hpx::future<RandomIt> result;
+        try {
+            std::ptrdiff_t N = last - first;
+            HPX_ASSERT(N >= 0);
+
+            if (std::size_t(N) < sort_limit_per_task)
+            {
+                std::stable_sort(first, last, detail::less());
+                return hpx::make_ready_future(last);
+            }
+
+            // check if already sorted
+            if (detail::is_sorted_sequential(first, last, detail::less()))
+                return hpx::make_ready_future(last);
+
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            result = async_sort(std::forward<ExPolicy>(policy), first, last,
+                detail::less(),
+                [](policy_type& p, RandomIt first, RandomIt last, detail::less)
+                {
+                    radix_sort(p, first, last);
+                });
+        }
+        catch (...) {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::current_exception());
+        }
+
+        if (result.has_exception())
+        {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::move(result));
+        }
+
+        return result;
+    }
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,269 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_SAMPLE_SORT_OCT_17_2017_0950AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_SAMPLE_SORT_OCT_17_2017_0950AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/sort_tasks.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parallel sample sort
+    //
+    // The sequence is split into buckets based on a set of splitters which
+    // are selected from a sorted sample of the input. Each element is
+    // assigned to the bucket between the two splitters enclosing its value,
+    // elements equal to a splitter are assigned to a separate (equality)
+    // bucket which does not need to be sorted. This keeps the buckets
+    // balanced even for inputs with many duplicate values. The elements are
+    // redistributed into their buckets and all buckets are sorted
+    // concurrently.
+    //
+    // The number of buckets is chosen such that each bucket roughly fits
+    // into the cache, but there are at least four buckets per core.
+    static const std::size_t sample_sort_bucket_bytes = 1024 * 1024;
+    static const std::size_t sample_sort_max_splitters = 127;
+    static const std::size_t sample_sort_oversampling = 32;
+
+    template <typename RandomIt, typename Compare>
+    struct sample_sort_classifier
+    {
+        sample_sort_classifier(RandomIt first,
+                std::vector<std::size_t> const& splitters, Compare& comp)
+          : first_(first), splitters_(splitters), comp_(comp)
+        {}
+
+        // Return the bucket for the given value: values between splitters
+        // i-1 and i go to bucket 2*i, values equal to splitter i-1 go to
+        // bucket 2*i-1.
+        template <typename T>
+        std::uint8_t operator()(T const& value) const
+        {
+            std::size_t lo = 0, hi = splitters_.size();
+            while (lo != hi)
+            {
+                std::size_t mid = lo + (hi - lo) / 2;
+                if (comp_(value, *(first_ + splitters_[mid])))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+
+            if (lo != 0 && !comp_(*(first_ + splitters_[lo - 1]), value))
+                return static_cast<std::uint8_t>(2 * lo - 1);
+            return static_cast<std::uint8_t>(2 * lo);
+        }
+
+        RandomIt first_;
+        std::vector<std::size_t> const& splitters_;
+        Compare& comp_;
+    };
+
+    // Select the splitters from an evenly spaced sample of the input, the
+    // splitters are returned as offsets of the corresponding elements.
+    template <typename RandomIt, typename Compare>
+    std::vector<std::size_t> select_sample_sort_splitters(RandomIt first,
+        std::size_t count, std::size_t num_buckets, Compare& comp)
+    {
+        std::size_t num_samples =
+            (std::min)(count, num_buckets * sample_sort_oversampling);
+
+        // pick one (pseudo random) element from each part of the input to
+        // avoid sampling artifacts for periodic data
+        std::vector<std::size_t> samples(num_samples);
+        std::uint64_t state = 0x9e3779b97f4a7c15ULL ^ count;
+        for (std::size_t i = 0; i != num_samples; ++i)
+        {
+            std::size_t begin = get_sort_part_begin(count, num_samples, i);
+            std::size_t end = get_sort_part_begin(count, num_samples, i + 1);
+
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            samples[i] = begin + static_cast<std::size_t>(
+                (state >> 33) % (end - begin));
+        }
+
+        std::sort(samples.begin(), samples.end(),
+            [first, &comp](std::size_t lhs, std::size_t rhs)
+            {
+                return comp(*(first + lhs), *(first + rhs));
+            });
+
+        std::vector<std::size_t> splitters;
+        splitters.reserve(num_buckets - 1);
+        for (std::size_t i = 1; i != num_buckets; ++i)
+        {
+            std::size_t s = samples[(i * num_samples) / num_buckets];
+
+            // duplicate splitters would result in empty buckets
+            if (splitters.empty() ||
+                comp(*(first + splitters.back()), *(first + s)))
+            {
+                splitters.push_back(s);
+            }
+        }
+        return splitters;
+    }
+
+    template <typename ExPolicy, typename RandomIt, typename Compare>
+    void sample_sort(ExPolicy& policy, RandomIt first, RandomIt last,
+        Compare comp)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type
+            value_type;
+
+        std::size_t const count = static_cast<std::size_t>(last - first);
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t bucket_size = (std::max)(std::size_t(1024),
+            sample_sort_bucket_bytes / sizeof(value_type));
+        std::size_t num_buckets = (std::min)(sample_sort_max_splitters + 1,
+            (std::max)(4 * cores, count / bucket_size));
+
+        std::vector<std::size_t> splitters =
+            select_sample_sort_splitters(first, count, num_buckets, comp);
+        if (splitters.empty())
+        {
+            // all samples are equal, fall back to sequential sort
+            std::sort(first, last, comp);
+            return;
+        }
+
+        std::size_t const num_classes = 2 * splitters.size() + 1;
+        std::size_t const num_chunks =
+            get_sort_num_tasks(policy, count, sort_limit_per_task / 4);
+
+        // classify all elements and count the elements per chunk and bucket
+        std::vector<std::uint8_t> classes(count);
+        std::vector<std::size_t> offsets(num_chunks * num_classes, 0);
+
+        sample_sort_classifier<RandomIt, Compare> classify(
+            first, splitters, comp);
+
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                std::size_t begin = get_sort_part_begin(count, num_chunks, chunk);
+                std::size_t end = get_sort_part_begin(count, num_chunks, chunk + 1);
+
+                std::size_t* counts = &offsets[chunk * num_classes];
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    std::uint8_t c = classify(*(first + i));
+                    classes[i] = c;
+                    ++counts[c];
+                }
+            });
+
+        // compute the position of each chunk's part of each bucket
+        std::vector<std::size_t> buckets(num_classes + 1, 0);
+        std::size_t offset = 0;
+        for (std::size_t c = 0; c != num_classes; ++c)
+        {
+            buckets[c] = offset;
+            for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+            {
+                std::size_t& o = offsets[chunk * num_classes + c];
+                std::size_t n = o;
+                o = offset;
+                offset += n;
+            }
+        }
+        buckets[num_classes] = offset;
+        HPX_ASSERT(offset == count);
+
+        // move all elements to the temporary buffer, and from there into
+        // their buckets
+        sort_buffer<value_type> buffer(count, num_chunks);
+
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                buffer.construct(chunk, first + buffer.part_begin(chunk));
+            });
+
+        run_sort_tasks(policy, num_chunks,
+            [&](std::size_t chunk)
+            {
+                std::size_t begin = buffer.part_begin(chunk);
+                std::size_t end = buffer.part_begin(chunk + 1);
+
+                std::size_t* positions = &offsets[chunk * num_classes];
+                value_type* data = buffer.data();
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    *(first + positions[classes[i]]++) = std::move(data[i]);
+                }
+
+                buffer.destroy(chunk);
+            });
+
+        // sort all buckets, equality buckets are already sorted
+        run_sort_tasks(policy, splitters.size() + 1,
+            [&](std::size_t bucket)
+            {
+                std::sort(first + buckets[2 * bucket],
+                    first + buckets[2 * bucket + 1], comp);
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename RandomIt, typename Compare>
+    hpx::future<RandomIt>
+    parallel_sort_async(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare comp)
+    {
+        hpx::future<RandomIt> result;
+        try {
+            std::ptrdiff_t N = last - first;
+            HPX_ASSERT(N >= 0);
+
+            if (std::size_t(N) < sort_limit_per_task)
+            {
+                std::sort(first, last, comp);
+                return hpx::make_ready_future(last);
+            }
+
+            // check if already sorted
+            if (detail::is_sorted_sequential(first, last, comp))
+                return hpx::make_ready_future(last);
+
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            result = async_sort(std::forward<ExPolicy>(policy), first, last,
+                std::move(comp), &sample_sort<policy_type, RandomIt, Compare>);
+        }
+        catch (...) {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::current_exception());
+        }
+
+        if (result.has_exception())
+        {
+            return detail::handle_exception<ExPolicy, RandomIt>::call(
+                std::move(result));
+        }
+
+        return result;
+    }
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,233 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_TASKS_OCT_17_2017_0912AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_TASKS_OCT_17_2017_0912AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/exception_list.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/executor_parameter_traits.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    // Sequences shorter than this are sorted sequentially
+    static const std::size_t sort_limit_per_task = 65536ul;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // std::is_sorted is not available on all supported platforms yet
+    template <typename Iter, typename Compare>
+    inline bool is_sorted_sequential(Iter first, Iter last, Compare comp)
+    {
+        bool sorted = true;
+        if (first != last)
+        {
+            for (Iter it1 = first, it2 = first + 1;
+                 it2 != last && (sorted = !comp(*it2, *it1));
+                 it1 = it2++)
+            {
+                /**/
+            }
+        }
+        return sorted;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the number of tasks to use for processing count elements. This
+    // respects the chunking parameters of the given execution policy, but
+    // does not create chunks smaller than min_chunk_size elements.
+    template <typename ExPolicy>
+    std::size_t get_sort_num_tasks(ExPolicy& policy, std::size_t count,
+        std::size_t min_chunk_size)
+    {
+        typedef typename ExPolicy::executor_parameters_type parameters_type;
+        typedef executor_parameter_traits<parameters_type> traits;
+
+        if (count == 0)
+            return 1;
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t max_chunks = traits::maximal_number_of_chunks(
+            policy.parameters(), policy.executor(), cores, count);
+        HPX_ASSERT(0 != max_chunks);
+
+        std::size_t chunk_size = traits::get_chunk_size(policy.parameters(),
+            policy.executor(), [](){ return 0; }, cores, count);
+
+        chunk_size = (std::max)(chunk_size, (count + max_chunks - 1) / max_chunks);
+        chunk_size = (std::max)(chunk_size, min_chunk_size);
+
+        return (count + chunk_size - 1) / chunk_size;
+    }
+
+    // Return the first element of the given part if count elements are
+    // split into num_parts parts of (almost) equal size.
+    inline std::size_t get_sort_part_begin(std::size_t count,
+        std::size_t num_parts, std::size_t part)
+    {
+        return static_cast<std::size_t>(
+            (static_cast<unsigned long long>(count) * part) / num_parts);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(i) for all i in [0, num_tasks) on the executor of the given
+    // execution policy and wait for all of the invocations to finish.
+    // Exceptions are reported as an exception_list (except for bad_alloc).
+    template <typename ExPolicy, typename F>
+    void run_sort_tasks(ExPolicy& policy, std::size_t num_tasks, F && f)
+    {
+        std::vector<std::size_t> shape(num_tasks);
+        for (std::size_t i = 0; i != num_tasks; ++i)
+            shape[i] = i;
+
+        std::vector<hpx::future<void> > workitems;
+        std::list<std::exception_ptr> errors;
+
+        try {
+            workitems = execution::bulk_async_execute(
+                policy.executor(), std::forward<F>(f), shape);
+        }
+        catch (...) {
+            util::detail::handle_local_exceptions<ExPolicy>::call(
+                std::current_exception(), errors);
+        }
+
+        // wait for all tasks to finish
+        hpx::wait_all(workitems);
+
+        // always rethrow if 'errors' is not empty or workitems has
+        // exceptional future
+        util::detail::handle_local_exceptions<ExPolicy>::call(workitems, errors);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the given sort engine asynchronously on the executor of the given
+    // execution policy. The engine is invoked as f(policy, first, last, comp)
+    // on a copy of the execution policy.
+    template <typename ExPolicy, typename RandomIt, typename Compare,
+        typename F>
+    hpx::future<RandomIt> async_sort(ExPolicy && policy, RandomIt first,
+        RandomIt last, Compare comp, F && f)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+        policy_type p(policy);
+        return execution::async_execute(policy.executor(),
+            [p, first, last, comp, f]() mutable -> RandomIt
+            {
+                try {
+                    f(p, first, last, comp);
+                }
+                catch (std::bad_alloc const&) {
+                    throw;
+                }
+                catch (hpx::exception_list const&) {
+                    throw;
+                }
+                catch (...) {
+                    std::list<std::exception_ptr> errors;
+                    util::detail::handle_local_exceptions<policy_type>::call(
+                        std::current_exception(), errors);
+                    throw hpx::exception_list(std::move(errors));
+                }
+                return last;
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Uninitialized temporary storage used by the sort engines. The buffer
+    // is split into parts, each of which is either fully constructed or not
+    // constructed at all. Constructed parts are destroyed with the buffer.
+    template <typename T>
+    class sort_buffer
+    {
+    public:
+        HPX_NON_COPYABLE(sort_buffer);
+
+        sort_buffer(std::size_t size, std::size_t num_parts)
+          : data_(std::allocator<T>().allocate(size)),
+            size_(size), constructed_(num_parts, 0)
+        {}
+
+        ~sort_buffer()
+        {
+            if (!std::is_trivially_destructible<T>::value)
+            {
+                std::size_t const num_parts = constructed_.size();
+                for (std::size_t i = 0; i != num_parts; ++i)
+                {
+                    if (constructed_[i])
+                        destroy(i);
+                }
+            }
+            std::allocator<T>().deallocate(data_, size_);
+        }
+
+        T* data() const { return data_; }
+
+        // Move-construct the elements of the given part from [first, ...)
+        template <typename RandomIt>
+        void construct(std::size_t part, RandomIt first)
+        {
+            HPX_ASSERT(!constructed_[part]);
+
+            std::size_t const begin = part_begin(part);
+            std::size_t const end = part_begin(part + 1);
+
+            std::uninitialized_copy(std::make_move_iterator(first),
+                std::make_move_iterator(first + (end - begin)), data_ + begin);
+            constructed_[part] = 1;
+        }
+
+        // Destroy the elements of the given part
+        void destroy(std::size_t part)
+        {
+            HPX_ASSERT(constructed_[part]);
+
+            std::size_t const begin = part_begin(part);
+            std::size_t const end = part_begin(part + 1);
+
+            for (T* p = data_ + begin; p != data_ + end; ++p)
+                p->~T();
+            constructed_[part] = 0;
+        }
+
+        std::size_t part_begin(std::size_t part) const
+        {
+            return get_sort_part_begin(size_, constructed_.size(), part);
+        }
+
+    private:
+        T* data_;
+        std::size_t size_;
+        std::vector<char> constructed_;
+    };
+    /// \endcond
+}}}}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/range.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -144,6 +145,35 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::equal_binary().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, last2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -236,12 +266,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -249,13 +273,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::equal_binary().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, last2, std::forward<Pred>(op));
+        // both ranges have to be segmented to use the segmented version
+        typedef std::integral_constant<bool,
+                hpx::traits::is_segmented_iterator<FwdIter1>::value &&
+                hpx::traits::is_segmented_iterator<FwdIter2>::value
+            > is_segmented;
+
+        return detail::equal_binary_(
+            std::forward<ExPolicy>(policy), first1, last1, first2, last2, std::forward<Pred>(op),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -332,6 +360,35 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::equal().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -420,12 +477,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -433,13 +484,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::equal().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, std::forward<Pred>(op));
+        // both ranges have to be segmented to use the segmented version
+        typedef std::integral_constant<bool,
+                hpx::traits::is_segmented_iterator<FwdIter1>::value &&
+                hpx::traits::is_segmented_iterator<FwdIter2>::value
+            > is_segmented;
+
+        return detail::equal_(
+            std::forward<ExPolicy>(policy), first1, last1, first2, std::forward<Pred>(op),
+            is_segmented());
     }
 }}}
 
@@ -11,6 +11,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -48,16 +49,15 @@ namespace hpx { namespace parallel { inline namespace v1
                 return std::find(first, last, val);
             }
 
-            template <typename ExPolicy, typename T>
+            template <typename ExPolicy, typename Iter, typename T>
             static typename util::detail::algorithm_result<
-                ExPolicy, FwdIter
+                ExPolicy, Iter
             >::type
-            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
-                T const& val)
+            parallel(ExPolicy && policy, Iter first, Iter last, T const& val)
             {
-                typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
-                typedef typename std::iterator_traits<FwdIter>::value_type type;
-                typedef typename std::iterator_traits<FwdIter>::difference_type
+                typedef util::detail::algorithm_result<ExPolicy, Iter> result;
+                typedef typename std::iterator_traits<Iter>::value_type type;
+                typedef typename std::iterator_traits<Iter>::difference_type
                     difference_type;
 
                 difference_type count = std::distance(first, last);
@@ -66,10 +66,10 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 util::cancellation_token<std::size_t> tok(count);
 
-                return util::partitioner<ExPolicy, FwdIter, void>::
+                return util::partitioner<ExPolicy, Iter, void>::
                     call_with_index(
                         std::forward<ExPolicy>(policy), first, count, 1,
-                        [val, tok](FwdIter it, std::size_t part_size,
+                        [val, tok](Iter it, std::size_t part_size,
                             std::size_t base_idx) mutable -> void
                         {
                             util::loop_idx_n(
@@ -80,7 +80,7 @@ namespace hpx { namespace parallel { inline namespace v1
                                         tok.cancel(i);
                                 });
                         },
-                        [=](std::vector<hpx::future<void> > &&) mutable -> FwdIter
+                        [=](std::vector<hpx::future<void> > &&) mutable -> Iter
                         {
                             difference_type find_res =
                                 static_cast<difference_type>(tok.get_data());
@@ -94,6 +94,32 @@ namespace hpx { namespace parallel { inline namespace v1
                         });
             }
         };
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename T>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_(ExPolicy && policy, FwdIter first, FwdIter last, T const& val,
+            std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::find<FwdIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, val);
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename T>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_(ExPolicy && policy, FwdIter first, FwdIter last, T const& val,
+            std::true_type);
         /// \endcond
     }
 
@@ -152,22 +178,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::find<FwdIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, val);
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::find_(
+            std::forward<ExPolicy>(policy), first, last, val,
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -234,6 +255,32 @@ namespace hpx { namespace parallel { inline namespace v1
                         });
             }
         };
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_if_(ExPolicy && policy, FwdIter first, FwdIter last, F && f,
+            std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::find_if<FwdIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_if_(ExPolicy && policy, FwdIter first, FwdIter last, F && f,
+            std::true_type);
         /// \endcond
     }
 
@@ -306,22 +353,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::find_if<FwdIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::forward<F>(f));
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::find_if_(
+            std::forward<ExPolicy>(policy), first, last, std::forward<F>(f),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -394,6 +436,32 @@ namespace hpx { namespace parallel { inline namespace v1
                         });
             }
         };
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_if_not_(ExPolicy && policy, FwdIter first, FwdIter last, F && f,
+            std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::find_if_not<FwdIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        find_if_not_(ExPolicy && policy, FwdIter first, FwdIter last, F && f,
+            std::true_type);
         /// \endcond
     }
 
@@ -466,22 +534,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::find_if_not<FwdIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::forward<F>(f));
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::find_if_not_(
+            std::forward<ExPolicy>(policy), first, last, std::forward<F>(f),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
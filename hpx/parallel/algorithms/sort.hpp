@@ -9,30 +9,23 @@
 #define HPX_PARALLEL_ALGORITHM_SORT_OCT_2015
 
 #include <hpx/config.hpp>
-#include <hpx/dataflow.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
-#include <hpx/util/assert.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/decay.hpp>
-#include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
-#include <hpx/parallel/exception_list.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/algorithms/detail/sample_sort.hpp>
 #include <hpx/parallel/execution_policy.hpp>
-#include <hpx/parallel/executors/execution.hpp>
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/util/compare_projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
-#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
 #include <algorithm>
-#include <cstddef>
-#include <exception>
-#include <functional>
 #include <iterator>
-#include <list>
 #include <type_traits>
 #include <utility>
 
@@ -43,178 +36,6 @@ namespace hpx { namespace parallel { inline namespace v1
     namespace detail
     {
         /// \cond NOINTERNAL
-        static const std::size_t sort_limit_per_task = 65536ul;
-
-        ///////////////////////////////////////////////////////////////////////
-        // std::is_sorted is not available on all supported platforms yet
-        template <typename Iter, typename Compare>
-        inline bool is_sorted_sequential(Iter first, Iter last, Compare comp)
-        {
-            bool sorted = true;
-            if (first != last)
-            {
-                for (Iter it1 = first, it2 = first + 1;
-                     it2 != last && (sorted = !comp(*it2, *it1));
-                     it1 = it2++)
-                {
-                    /**/
-                }
-            }
-            return sorted;
-        }
-
-        //------------------------------------------------------------------------
-        //  function : sort_thread
-        /// \brief this function is the work assigned to each thread in the
-        ///        parallel process
-        /// \exception
-        /// \return
-        /// \remarks
-        //------------------------------------------------------------------------
-        template <typename ExPolicy, typename RandomIt, typename Compare>
-        hpx::future<RandomIt> sort_thread(ExPolicy& policy,
-            RandomIt first, RandomIt last, Compare comp)
-        {
-            //------------------------- begin ----------------------
-            std::ptrdiff_t N = last - first;
-            if (std::size_t(N) <= sort_limit_per_task)
-            {
-                return execution::async_execute(
-                    policy.executor(),
-                    [first, last, comp]() -> RandomIt
-                    {
-                        std::sort(first, last, comp);
-                        return last;
-                    });
-            }
-
-            //----------------------------------------------------------------
-            //                     split
-            //----------------------------------------------------------------
-
-            //------------------- check if sorted ----------------------------
-            if (detail::is_sorted_sequential(first, last, comp))
-                return hpx::make_ready_future(last);
-
-            //---------------------- pivot select ----------------------------
-            std::size_t nx = std::size_t(N) >> 1;
-
-            RandomIt it_a = first + 1;
-            RandomIt it_b = first + nx;
-            RandomIt it_c = last - 1;
-
-            if (comp(*it_b, *it_a))
-                std::iter_swap(it_a, it_b);
-
-            if (comp(*it_c, *it_b))
-            {
-                std::iter_swap(it_c, it_b);
-                if (comp(*it_b, *it_a))
-                    std::iter_swap(it_a, it_b);
-            }
-
-            std::iter_swap(first, it_b);
-
-            typedef
-                typename std::iterator_traits<RandomIt>::reference
-                reference;
-
-            reference val = *first;
-            RandomIt c_first = first + 2, c_last = last - 2;
-
-            while (c_first != last && comp(*c_first, val))
-                ++c_first;
-            while (comp(val, *c_last))
-                --c_last;
-            while (!(c_first > c_last))
-            {
-                std::iter_swap(c_first++, c_last--);
-                while (comp(*c_first, val))
-                    ++c_first;
-                while (comp(val, *c_last))
-                    --c_last;
-            } // End while
-
-            std::iter_swap(first, c_last);
-
-            // spawn tasks for each sub section
-            hpx::future<RandomIt> left =
-                execution::async_execute(
-                    policy.executor(),
-                        &sort_thread<ExPolicy, RandomIt, Compare>,
-                        std::ref(policy), first, c_last, comp);
-
-            hpx::future<RandomIt> right =
-                execution::async_execute(
-                    policy.executor(),
-                        &sort_thread<ExPolicy, RandomIt, Compare>,
-                        std::ref(policy), c_first, last, comp);
-
-            return hpx::dataflow(
-                [last](hpx::future<RandomIt> && left,
-                    hpx::future<RandomIt> && right) -> RandomIt
-                {
-                    if (left.has_exception() || right.has_exception())
-                    {
-                        std::list<std::exception_ptr> errors;
-                        if (left.has_exception())
-                            errors.push_back(left.get_exception_ptr());
-                        if (right.has_exception())
-                            errors.push_back(right.get_exception_ptr());
-
-                        throw exception_list(std::move(errors));
-                    }
-                    return last;
-                },
-                std::move(left), std::move(right));
-        }
-
-        //------------------------------------------------------------------------
-        //  function : parallel_sort_async
-        //------------------------------------------------------------------------
-        /// @param [in] first : iterator to the first element to sort
-        /// @param [in] last : iterator to the next element after the last
-        /// @param [in] comp : object for to compare
-        /// @exception
-        /// @return
-        /// @remarks
-        template <typename ExPolicy, typename RandomIt, typename Compare>
-        hpx::future<RandomIt>
-        parallel_sort_async(ExPolicy && policy, RandomIt first, RandomIt last,
-            Compare comp)
-        {
-            hpx::future<RandomIt> result;
-            try {
-                std::ptrdiff_t N = last - first;
-                HPX_ASSERT(N >= 0);
-
-                if (std::size_t(N) < sort_limit_per_task)
-                {
-                    std::sort(first, last, comp);
-                    return hpx::make_ready_future(last);
-                }
-
-                // check if already sorted
-                if (detail::is_sorted_sequential(first, last, comp))
-                    return hpx::make_ready_future(last);
-
-                result = execution::async_execute(policy.executor(),
-                        &sort_thread<ExPolicy, RandomIt, Compare>,
-                        std::ref(policy), first, last, comp);
-            }
-            catch (...) {
-                return detail::handle_exception<ExPolicy, RandomIt>::call(
-                    std::current_exception());
-            }
-
-            if (result.has_exception())
-            {
-                return detail::handle_exception<ExPolicy, RandomIt>::call(
-                    std::move(result));
-            }
-
-            return result;
-        }
 
         ///////////////////////////////////////////////////////////////////////
         // sort
@@ -225,9 +46,10 @@ namespace hpx { namespace parallel { inline namespace v1
               : sort::algorithm("sort")
             {}
 
-            template <typename ExPolicy, typename Compare, typename Proj>
-            static RandomIt
-            sequential(ExPolicy, RandomIt first, RandomIt last,
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
                 std::sort(first, last,
@@ -238,24 +60,72 @@ namespace hpx { namespace parallel { inline namespace v1
                 return last;
             }
 
-            template <typename ExPolicy, typename Compare, typename Proj>
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
             static typename util::detail::algorithm_result<
-                ExPolicy, RandomIt
+                ExPolicy, Iter
             >::type
-            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+            parallel(ExPolicy && policy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
                 // call the sort routine and return the right type,
                 // depending on execution policy
-                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
-                    parallel_sort_async(std::forward<ExPolicy>(policy),
-                        first, last,
-                        util::compare_projected<Compare, Proj>(
-                            std::forward<Compare>(comp),
-                            std::forward<Proj>(proj)
-                        )));
+                return util::detail::algorithm_result<ExPolicy, Iter>::get(
+                    parallel_async(std::forward<ExPolicy>(policy),
+                        first, last, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj),
+                        is_radix_sortable<Iter, Compare, Proj>()));
+            }
+
+        private:
+            // arithmetic values sorted by their natural order use the radix
+            // sort, everything else uses the sample sort
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static hpx::future<Iter>
+            parallel_async(ExPolicy && policy, Iter first, Iter last,
+                Compare &&, Proj &&, std::true_type)
+            {
+                return parallel_radix_sort_async(
+                    std::forward<ExPolicy>(policy), first, last);
+            }
+
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static hpx::future<Iter>
+            parallel_async(ExPolicy && policy, Iter first, Iter last,
+                Compare && comp, Proj && proj, std::false_type)
+            {
+                return parallel_sort_async(std::forward<ExPolicy>(policy),
+                    first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)
+                    ));
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(
+                std::forward<ExPolicy>(policy), is_seq(), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -266,7 +136,8 @@ namespace hpx { namespace parallel { inline namespace v1
     /// operator<()).
     ///
     /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
-    ///                     comparisons.
+    ///                     comparisons. Arithmetic values sorted using the
+    ///                     default comparison operator are sorted in O(N).
     ///
     /// A sequence is sorted with respect to a comparator \a comp and a
     /// projection \a proj if for every iterator i pointing to the sequence and
@@ -346,11 +217,11 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(
-            std::forward<ExPolicy>(policy), is_seq(), first, last,
-            std::forward<Compare>(comp), std::forward<Proj>(proj));
+        return detail::sort_(std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}
 
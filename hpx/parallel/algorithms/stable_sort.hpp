@@ -0,0 +1,201 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_OCT_17_2017_0130PM)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_OCT_17_2017_0130PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/merge_sort.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        ///////////////////////////////////////////////////////////////////////
+        // stable_sort
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                // call the stable_sort routine and return the right type,
+                // depending on execution policy
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    parallel_async(std::forward<ExPolicy>(policy),
+                        first, last, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj),
+                        is_radix_sortable<RandomIt, Compare, Proj>()));
+            }
+
+        private:
+            // arithmetic values sorted by their natural order use the radix
+            // sort, everything else uses the merge sort
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_async(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare &&, Proj &&, std::true_type)
+            {
+                return parallel_radix_sort_async(
+                    std::forward<ExPolicy>(policy), first, last);
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_async(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj, std::false_type)
+            {
+                return parallel_stable_sort_async(
+                    std::forward<ExPolicy>(policy),
+                    first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)
+                    ));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// order of equal elements is guaranteed to be preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons. Arithmetic values sorted using the
+    ///                     default comparison operator are sorted in O(N).
+    ///
+    /// A sequence is sorted with respect to a comparator \a comp and a
+    /// projection \a proj if for every iterator i pointing to the sequence and
+    /// every non-negative integer n such that i + n is a valid iterator
+    /// pointing to an element of the sequence, and
+    /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam Iter        The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
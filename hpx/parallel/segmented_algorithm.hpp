@@ -9,10 +9,14 @@
 #include <hpx/config.hpp>
 #include <hpx/parallel/algorithm.hpp>
 
+#include <hpx/parallel/segmented_algorithms/all_any_none.hpp>
 #include <hpx/parallel/segmented_algorithms/count.hpp>
+#include <hpx/parallel/segmented_algorithms/equal.hpp>
+#include <hpx/parallel/segmented_algorithms/find.hpp>
 #include <hpx/parallel/segmented_algorithms/for_each.hpp>
 #include <hpx/parallel/segmented_algorithms/generate.hpp>
 #include <hpx/parallel/segmented_algorithms/minmax.hpp>
+#include <hpx/parallel/segmented_algorithms/sort.hpp>
 #include <hpx/parallel/segmented_algorithms/transform_reduce.hpp>
 
 #endif
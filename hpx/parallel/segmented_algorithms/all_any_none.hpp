@@ -0,0 +1,261 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_ALL_ANY_NONE_OCT_17_2017_0305PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_ALL_ANY_NONE_OCT_17_2017_0305PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/all_any_none.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented all_of, any_of, none_of
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The overall result is 'decisive' as soon as a single segment
+        // returns 'decisive', and !decisive otherwise (all_of and none_of
+        // are decided by the first segment returning false, any_of by the
+        // first one returning true).
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_all_any_none(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, F && f, bool decisive, std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    if (dispatch(traits::get_id(sit), algo, policy,
+                            std::true_type(), beg, end, f) == decisive)
+                    {
+                        return result::get(std::move(decisive));
+                    }
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    if (dispatch(traits::get_id(sit), algo, policy,
+                            std::true_type(), beg, end, f) == decisive)
+                    {
+                        return result::get(std::move(decisive));
+                    }
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        if (dispatch(traits::get_id(sit), algo, policy,
+                                std::true_type(), beg, end, f) == decisive)
+                        {
+                            return result::get(std::move(decisive));
+                        }
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    if (dispatch(traits::get_id(sit), algo, policy,
+                            std::true_type(), beg, end, f) == decisive)
+                    {
+                        return result::get(std::move(decisive));
+                    }
+                }
+            }
+
+            return result::get(!decisive);
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_all_any_none(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, F && f, bool decisive, std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<future<bool> > segments;
+            segments.reserve(std::distance(sit, send));
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, f));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, f));
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        segments.push_back(dispatch_async(traits::get_id(sit),
+                            algo, policy, forced_seq(), beg, end, f));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, f));
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<hpx::future<bool> > && r) -> bool
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        for (hpx::future<bool>& sf: r)
+                        {
+                            if (sf.get() == decisive)
+                                return decisive;
+                        }
+                        return !decisive;
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementations
+        template <typename ExPolicy, typename SegIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        none_of_(ExPolicy && policy, SegIter first, SegIter last, F && f,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+                return util::detail::algorithm_result<ExPolicy, bool>::get(true);
+
+            return segmented_all_any_none(none_of(),
+                std::forward<ExPolicy>(policy), first, last,
+                typename hpx::util::decay<F>::type(std::forward<F>(f)),
+                false, is_seq());
+        }
+
+        template <typename ExPolicy, typename SegIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        any_of_(ExPolicy && policy, SegIter first, SegIter last, F && f,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+                return util::detail::algorithm_result<ExPolicy, bool>::get(false);
+
+            return segmented_all_any_none(any_of(),
+                std::forward<ExPolicy>(policy), first, last,
+                typename hpx::util::decay<F>::type(std::forward<F>(f)),
+                true, is_seq());
+        }
+
+        template <typename ExPolicy, typename SegIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        all_of_(ExPolicy && policy, SegIter first, SegIter last, F && f,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+                return util::detail::algorithm_result<ExPolicy, bool>::get(true);
+
+            return segmented_all_any_none(all_of(),
+                std::forward<ExPolicy>(policy), first, last,
+                typename hpx::util::decay<F>::type(std::forward<F>(f)),
+                false, is_seq());
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
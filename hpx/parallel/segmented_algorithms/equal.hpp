@@ -0,0 +1,217 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL_OCT_17_2017_0340PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL_OCT_17_2017_0340PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/equal.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_equal
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // A part of the first range together with the corresponding part of
+        // the second range, both located on the same locality.
+        template <typename SegIter1, typename SegIter2>
+        struct equal_segment
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+
+            id_type id_;
+            typename traits1::local_iterator beg1_;
+            typename traits1::local_iterator end1_;
+            typename traits2::local_iterator beg2_;
+        };
+
+        // Split the given ranges into parts which can be compared on a single
+        // locality. Returns false if the segments of the second range are
+        // not aligned with the segments of the first one.
+        template <typename SegIter1, typename SegIter2>
+        bool get_equal_segments(SegIter1 first1, SegIter1 last1,
+            SegIter2 first2,
+            std::vector<equal_segment<SegIter1, SegIter2> >& segments)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+
+            segment_iterator1 sit = traits1::segment(first1);
+            segment_iterator1 send = traits1::segment(last1);
+
+            for (/**/; /**/; ++sit)
+            {
+                local_iterator_type1 beg = (sit == traits1::segment(first1)) ?
+                    traits1::local(first1) : traits1::begin(sit);
+                local_iterator_type1 end = (sit == send) ?
+                    traits1::local(last1) : traits1::end(sit);
+
+                std::ptrdiff_t count = std::distance(beg, end);
+                if (count != 0)
+                {
+                    // the corresponding part of the second range has to be
+                    // located in one segment on the same locality
+                    SegIter2 back2 = first2;
+                    detail::advance(back2, count - 1);
+
+                    id_type id = traits1::get_id(sit);
+                    if (traits2::segment(first2) != traits2::segment(back2) ||
+                        naming::get_locality_id_from_id(id) !=
+                            naming::get_locality_id_from_id(
+                                traits2::get_id(traits2::segment(first2))))
+                    {
+                        return false;
+                    }
+
+                    equal_segment<SegIter1, SegIter2> s = {
+                        id, beg, end, traits2::local(first2)
+                    };
+                    segments.push_back(std::move(s));
+
+                    first2 = ++back2;
+                }
+
+                if (sit == send)
+                    break;
+            }
+            return true;
+        }
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            std::vector<equal_segment<SegIter1, SegIter2> > const& segments,
+            Pred && op, std::true_type)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            for (equal_segment<SegIter1, SegIter2> const& s: segments)
+            {
+                if (!dispatch(s.id_, algo, policy, std::true_type(),
+                        s.beg1_, s.end1_, s.beg2_, op))
+                {
+                    return result::get(false);
+                }
+            }
+            return result::get(true);
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            std::vector<equal_segment<SegIter1, SegIter2> > const& segments,
+            Pred && op, std::false_type)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter1>::value ||
+                    !hpx::traits::is_forward_iterator<SegIter2>::value
+                > forced_seq;
+
+            std::vector<future<bool> > results;
+            results.reserve(segments.size());
+
+            for (equal_segment<SegIter1, SegIter2> const& s: segments)
+            {
+                results.push_back(dispatch_async(s.id_, algo, policy,
+                    forced_seq(), s.beg1_, s.end1_, s.beg2_, op));
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<hpx::future<bool> > && r) -> bool
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        return std::all_of(r.begin(), r.end(),
+                            [](hpx::future<bool>& f) { return f.get(); });
+                    },
+                    std::move(results)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter1, typename SegIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, SegIter1 first1, SegIter1 last1,
+            SegIter2 first2, Pred && op, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first1 == last1)
+                return util::detail::algorithm_result<ExPolicy, bool>::get(true);
+
+            // fall back to the element-wise comparison if the segments of the
+            // two ranges don't match
+            std::vector<equal_segment<SegIter1, SegIter2> > segments;
+            if (!get_equal_segments(first1, last1, first2, segments))
+            {
+                return equal_(std::forward<ExPolicy>(policy), first1, last1,
+                    first2, std::forward<Pred>(op), std::false_type());
+            }
+
+            return segmented_equal(equal(), std::forward<ExPolicy>(policy),
+                segments,
+                typename hpx::util::decay<Pred>::type(std::forward<Pred>(op)),
+                is_seq());
+        }
+
+        template <typename ExPolicy, typename SegIter1, typename SegIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, SegIter1 first1, SegIter1 last1,
+            SegIter2 first2, SegIter2 last2, Pred && op, std::true_type)
+        {
+            if (std::distance(first1, last1) != std::distance(first2, last2))
+                return util::detail::algorithm_result<ExPolicy, bool>::get(false);
+
+            return equal_(std::forward<ExPolicy>(policy), first1, last1,
+                first2, std::forward<Pred>(op), std::true_type());
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,588 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_17_2017_0420PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_17_2017_0420PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // A contiguous part of the sorted range stored in one segment.
+        template <typename LocalIter>
+        struct sort_segment
+        {
+            id_type id_;
+            LocalIter beg_;
+            LocalIter end_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned int)
+            {
+                ar & id_ & beg_ & end_;
+            }
+        };
+
+        // A pivot value together with the window [lo_, hi_) of a sorted
+        // segment the corresponding split position is known to lie in.
+        template <typename T>
+        struct sort_pivot
+        {
+            T value_;
+            std::size_t lo_;
+            std::size_t hi_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned int)
+            {
+                ar & value_ & lo_ & hi_;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Returns the element at the given position of a segment.
+        template <typename T>
+        struct sort_fetch : public detail::algorithm<sort_fetch<T>, T>
+        {
+            sort_fetch()
+              : sort_fetch::algorithm("sort_fetch")
+            {}
+
+            template <typename ExPolicy, typename Iter>
+            static T sequential(ExPolicy, Iter first, std::size_t pos)
+            {
+                std::advance(first, pos);
+                return *first;
+            }
+
+            template <typename ExPolicy, typename Iter>
+            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            parallel(ExPolicy && policy, Iter first, std::size_t pos)
+            {
+                return util::detail::algorithm_result<ExPolicy, T>::get(
+                    sequential(std::forward<ExPolicy>(policy), first, pos));
+            }
+        };
+
+        // Locates all given pivots in a sorted segment, returns the lower and
+        // upper bound of each of the pivots relative to the segment start.
+        template <typename T>
+        struct sort_rank
+          : public detail::algorithm<
+                sort_rank<T>, std::vector<std::pair<std::size_t, std::size_t> >
+            >
+        {
+            typedef std::vector<
+                    std::pair<std::size_t, std::size_t>
+                > bounds_type;
+
+            sort_rank()
+              : sort_rank::algorithm("sort_rank")
+            {}
+
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static bounds_type
+            sequential(ExPolicy, Iter first,
+                std::vector<sort_pivot<T> > const& pivots,
+                Compare const& comp, Proj const& proj)
+            {
+                util::compare_projected<Compare, Proj> pred(comp, proj);
+
+                bounds_type bounds;
+                bounds.reserve(pivots.size());
+
+                for (sort_pivot<T> const& p: pivots)
+                {
+                    Iter lo = std::next(first, p.lo_);
+                    Iter hi = std::next(first, p.hi_);
+
+                    // the split position is known to lie in [lo, hi)
+                    Iter lb = std::lower_bound(lo, hi, p.value_, pred);
+                    Iter ub = std::upper_bound(lb, hi, p.value_, pred);
+
+                    bounds.push_back(std::make_pair(
+                        std::size_t(std::distance(first, lb)),
+                        std::size_t(std::distance(first, ub))));
+                }
+                return bounds;
+            }
+
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, bounds_type
+            >::type
+            parallel(ExPolicy && policy, Iter first,
+                std::vector<sort_pivot<T> > const& pivots,
+                Compare const& comp, Proj const& proj)
+            {
+                return util::detail::algorithm_result<ExPolicy, bounds_type>::
+                    get(sequential(std::forward<ExPolicy>(policy), first,
+                        pivots, comp, proj));
+            }
+        };
+
+        // Returns a copy of the elements of a part of a segment.
+        template <typename T>
+        struct sort_extract
+          : public detail::algorithm<sort_extract<T>, std::vector<T> >
+        {
+            sort_extract()
+              : sort_extract::algorithm("sort_extract")
+            {}
+
+            template <typename ExPolicy, typename Iter>
+            static std::vector<T> sequential(ExPolicy, Iter first, Iter last)
+            {
+                return std::vector<T>(first, last);
+            }
+
+            template <typename ExPolicy, typename Iter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(sequential(std::forward<ExPolicy>(policy),
+                        first, last));
+            }
+        };
+
+        // Runs on the locality of a destination segment: collects the sorted
+        // pieces which end up in this segment, merges them and writes the
+        // result back once all destinations have read their input.
+        template <typename T>
+        struct sort_exchange : public detail::algorithm<sort_exchange<T> >
+        {
+            sort_exchange()
+              : sort_exchange::algorithm("sort_exchange")
+            {}
+
+            template <typename ExPolicy, typename Iter, typename LocalIter,
+                typename Compare, typename Proj>
+            static hpx::util::unused_type
+            sequential(ExPolicy, Iter first, Iter last,
+                std::vector<sort_segment<LocalIter> > const& pieces,
+                std::string const& barrier_name, std::size_t num_segments,
+                std::size_t rank, Compare const& comp, Proj const& proj)
+            {
+                std::vector<hpx::future<std::vector<T> > > parts;
+                parts.reserve(pieces.size());
+
+                for (sort_segment<LocalIter> const& piece: pieces)
+                {
+                    parts.push_back(dispatch_async(piece.id_,
+                        sort_extract<T>(), execution::seq, std::true_type(),
+                        piece.beg_, piece.end_));
+                }
+                hpx::wait_all(parts);
+
+                // none of the segments may be overwritten before all of the
+                // destinations have collected their input
+                hpx::lcos::barrier b(barrier_name, num_segments, rank);
+                b.wait();
+
+                // handle any remote exceptions, will throw on error
+                std::list<std::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                        ExPolicy
+                    >::call(parts, errors);
+
+                util::compare_projected<Compare, Proj> pred(comp, proj);
+
+                std::vector<T> buffer;
+                buffer.reserve(std::distance(first, last));
+
+                for (hpx::future<std::vector<T> >& f: parts)
+                {
+                    std::vector<T> part = f.get();
+                    std::size_t mid = buffer.size();
+
+                    buffer.insert(buffer.end(),
+                        std::make_move_iterator(part.begin()),
+                        std::make_move_iterator(part.end()));
+                    std::inplace_merge(buffer.begin(), buffer.begin() + mid,
+                        buffer.end(), pred);
+                }
+
+                HPX_ASSERT(std::ptrdiff_t(buffer.size()) ==
+                    std::distance(first, last));
+
+                std::move(buffer.begin(), buffer.end(), first);
+                return hpx::util::unused;
+            }
+
+            template <typename ExPolicy, typename Iter, typename LocalIter,
+                typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy>::type
+            parallel(ExPolicy && policy, Iter first, Iter last,
+                std::vector<sort_segment<LocalIter> > const& pieces,
+                std::string const& barrier_name, std::size_t num_segments,
+                std::size_t rank, Compare const& comp, Proj const& proj)
+            {
+                sequential(std::forward<ExPolicy>(policy), first, last, pieces,
+                    barrier_name, num_segments, rank, comp, proj);
+                return util::detail::algorithm_result<ExPolicy>::get();
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename T>
+        void sort_wait_all(std::vector<hpx::future<T> >& results)
+        {
+            hpx::wait_all(results);
+
+            // handle any remote exceptions, will throw on error
+            std::list<std::exception_ptr> errors;
+            parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(results, errors);
+        }
+
+        inline std::string sort_barrier_name()
+        {
+            static std::atomic<std::size_t> sequence(0);
+            return "/hpx/parallel/segmented_sort/" +
+                std::to_string(hpx::get_locality_id()) + "/" +
+                std::to_string(++sequence);
+        }
+
+        // The segments are sorted locally first. Afterwards, the exact
+        // position at which each destination segment starts in the sorted
+        // sequence is determined in every (sorted) source segment using a
+        // distributed selection. Finally, every destination segment merges
+        // the pieces it has been assigned. The sizes of all segments are
+        // preserved.
+        template <typename ExPolicy, typename IsSeq, typename SegIter,
+            typename Compare, typename Proj>
+        SegIter sort_segments(SegIter first, SegIter last,
+            Compare const& comp, Proj const& proj)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+            typedef sort_segment<local_iterator_type> segment_type;
+
+            typedef typename std::conditional<IsSeq::value,
+                    execution::sequenced_policy, execution::parallel_policy
+                >::type local_policy;
+
+            // collect the non-empty parts of the input sequence
+            std::vector<segment_type> segments;
+            std::vector<std::size_t> sizes;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            for (/**/; /**/; ++sit)
+            {
+                local_iterator_type beg = (sit == traits::segment(first)) ?
+                    traits::local(first) : traits::begin(sit);
+                local_iterator_type end = (sit == send) ?
+                    traits::local(last) : traits::end(sit);
+
+                std::size_t count = std::distance(beg, end);
+                if (count != 0)
+                {
+                    segment_type s = { traits::get_id(sit), beg, end };
+                    segments.push_back(std::move(s));
+                    sizes.push_back(count);
+                }
+
+                if (sit == send)
+                    break;
+            }
+
+            std::size_t const num_segments = segments.size();
+            if (num_segments == 0)
+                return last;
+
+            // sort all segments locally
+            {
+                std::vector<hpx::future<local_iterator_type> > results;
+                results.reserve(num_segments);
+
+                for (segment_type const& s: segments)
+                {
+                    results.push_back(dispatch_async(s.id_,
+                        sort<local_iterator_type>(), local_policy(), IsSeq(),
+                        s.beg_, s.end_, comp, proj));
+                }
+                sort_wait_all<ExPolicy>(results);
+            }
+
+            if (num_segments == 1)
+                return last;
+
+            // splits[d][i] is the number of elements of source segment i
+            // which end up in front of destination segment d
+            std::vector<std::vector<std::size_t> > splits(num_segments + 1,
+                std::vector<std::size_t>(num_segments, 0));
+            splits[num_segments] = sizes;
+
+            // every boundary between two destination segments is located
+            // inside the windows [lo, hi) of the source segments
+            std::vector<std::size_t> ranks(num_segments, 0);
+            std::vector<std::vector<std::size_t> > lo(num_segments,
+                std::vector<std::size_t>(num_segments, 0));
+            std::vector<std::vector<std::size_t> > hi(num_segments, sizes);
+
+            std::vector<std::size_t> active;
+            for (std::size_t d = 1; d != num_segments; ++d)
+            {
+                ranks[d] = ranks[d - 1] + sizes[d - 1];
+                active.push_back(d);
+            }
+
+            while (!active.empty())
+            {
+                // use the middle element of the largest window as the next
+                // pivot for each of the outstanding boundaries
+                std::vector<hpx::future<value_type> > pivots;
+                pivots.reserve(active.size());
+
+                for (std::size_t d: active)
+                {
+                    std::size_t j = 0;
+                    for (std::size_t i = 1; i != num_segments; ++i)
+                    {
+                        if (hi[d][i] - lo[d][i] > hi[d][j] - lo[d][j])
+                            j = i;
+                    }
+
+                    HPX_ASSERT(hi[d][j] != lo[d][j]);
+                    pivots.push_back(dispatch_async(segments[j].id_,
+                        sort_fetch<value_type>(), execution::seq,
+                        std::true_type(), segments[j].beg_,
+                        lo[d][j] + (hi[d][j] - lo[d][j]) / 2));
+                }
+                sort_wait_all<ExPolicy>(pivots);
+
+                std::vector<value_type> values;
+                values.reserve(active.size());
+                for (hpx::future<value_type>& f: pivots)
+                    values.push_back(f.get());
+
+                // locate all pivots in all segments
+                typedef typename sort_rank<value_type>::bounds_type
+                    bounds_type;
+
+                std::vector<hpx::future<bounds_type> > bounds;
+                bounds.reserve(num_segments);
+
+                for (std::size_t i = 0; i != num_segments; ++i)
+                {
+                    std::vector<sort_pivot<value_type> > queries;
+                    queries.reserve(active.size());
+
+                    for (std::size_t k = 0; k != active.size(); ++k)
+                    {
+                        std::size_t d = active[k];
+                        sort_pivot<value_type> q = {
+                            values[k], lo[d][i], hi[d][i]
+                        };
+                        queries.push_back(std::move(q));
+                    }
+
+                    bounds.push_back(dispatch_async(segments[i].id_,
+                        sort_rank<value_type>(), execution::seq,
+                        std::true_type(), segments[i].beg_,
+                        std::move(queries), comp, proj));
+                }
+                sort_wait_all<ExPolicy>(bounds);
+
+                std::vector<bounds_type> b;
+                b.reserve(num_segments);
+                for (hpx::future<bounds_type>& f: bounds)
+                    b.push_back(f.get());
+
+                // narrow down the windows, retire all boundaries which have
+                // been found
+                std::vector<std::size_t> next_active;
+                for (std::size_t k = 0; k != active.size(); ++k)
+                {
+                    std::size_t d = active[k];
+
+                    std::size_t lower = 0, upper = 0;
+                    for (std::size_t i = 0; i != num_segments; ++i)
+                    {
+                        lower += b[i][k].first;
+                        upper += b[i][k].second;
+                    }
+
+                    if (ranks[d] < lower)
+                    {
+                        for (std::size_t i = 0; i != num_segments; ++i)
+                            hi[d][i] = b[i][k].first;
+                        next_active.push_back(d);
+                    }
+                    else if (ranks[d] > upper)
+                    {
+                        for (std::size_t i = 0; i != num_segments; ++i)
+                            lo[d][i] = b[i][k].second;
+                        next_active.push_back(d);
+                    }
+                    else
+                    {
+                        // the boundary falls into a run of elements equal to
+                        // the pivot, distribute those in segment order
+                        std::size_t remaining = ranks[d] - lower;
+                        for (std::size_t i = 0; i != num_segments; ++i)
+                        {
+                            std::size_t equal = (std::min)(remaining,
+                                b[i][k].second - b[i][k].first);
+                            splits[d][i] = b[i][k].first + equal;
+                            remaining -= equal;
+                        }
+                        HPX_ASSERT(remaining == 0);
+                    }
+                }
+                active = std::move(next_active);
+            }
+
+            // let every destination segment merge its pieces
+            std::string barrier_name = sort_barrier_name();
+
+            std::vector<hpx::future<void> > results;
+            results.reserve(num_segments);
+
+            for (std::size_t d = 0; d != num_segments; ++d)
+            {
+                std::vector<segment_type> pieces;
+                for (std::size_t i = 0; i != num_segments; ++i)
+                {
+                    if (splits[d][i] != splits[d + 1][i])
+                    {
+                        segment_type piece = {
+                            segments[i].id_,
+                            std::next(segments[i].beg_, splits[d][i]),
+                            std::next(segments[i].beg_, splits[d + 1][i])
+                        };
+                        pieces.push_back(std::move(piece));
+                    }
+                }
+
+                // all destinations have to run concurrently as they
+                // synchronize on a barrier
+                results.push_back(dispatch_async(segments[d].id_,
+                    sort_exchange<value_type>(), local_policy(), IsSeq(),
+                    segments[d].beg_, segments[d].end_, std::move(pieces),
+                    barrier_name, num_segments, d, comp, proj));
+            }
+            sort_wait_all<ExPolicy>(results);
+
+            return last;
+        }
+
+        // sequential and parallel execution
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort(ExPolicy const&, SegIter first, SegIter last,
+            Compare const& comp, Proj const& proj, std::false_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                sort_segments<ExPolicy, is_seq>(first, last, comp, proj));
+        }
+
+        // asynchronous execution
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort(ExPolicy const&, SegIter first, SegIter last,
+            Compare const& comp, Proj const& proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                hpx::async(
+                    [=]() -> SegIter
+                    {
+                        return sort_segments<ExPolicy, is_seq>(
+                            first, last, comp, proj);
+                    }));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        sort_(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef parallel::execution::is_async_execution_policy<
+                    policy_type
+                > is_async;
+
+            if (first == last)
+            {
+                typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+                return result::get(std::move(last));
+            }
+
+            return segmented_sort(std::forward<ExPolicy>(policy), first, last,
+                typename hpx::util::decay<Compare>::type(
+                    std::forward<Compare>(comp)),
+                typename hpx::util::decay<Proj>::type(
+                    std::forward<Proj>(proj)),
+                is_async());
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
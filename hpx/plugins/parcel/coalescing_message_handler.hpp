@@ -19,6 +19,9 @@
 
 #include <hpx/plugins/parcel/message_buffer.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -31,6 +34,18 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace plugins { namespace parcel
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // The coalescing message handler collects parcels sent to the same
+    // destination for the same action and sends them as a single message.
+    //
+    // - Parcels are appended to one of several buffers, chosen based on the
+    //   OS thread calling put_parcel. This avoids contention between worker
+    //   threads sending parcels concurrently. All buffers are merged into a
+    //   single message whenever the handler is flushed.
+    // - The number of parcels to coalesce and the flush interval are adapted
+    //   to the observed rate of parcels. The configured values
+    //   (hpx.plugins.coalescing_message_handler.num_messages and .interval)
+    //   serve as upper limits.
     struct HPX_LIBRARY_EXPORT coalescing_message_handler
       : parcelset::policies::message_handler
     {
@@ -66,6 +81,13 @@ namespace hpx { namespace plugins { namespace parcel
             std::int64_t min_boundary, std::int64_t max_boundary,
             std::int64_t num_buckets,
             util::function_nonser<std::vector<std::int64_t>(bool)>& result);
+        std::vector<std::int64_t> get_parcels_per_message_histogram(
+            std::int64_t min_boundary, std::int64_t max_boundary,
+            std::int64_t num_buckets, bool reset);
+        void get_parcels_per_message_histogram_creator(
+            std::int64_t min_boundary, std::int64_t max_boundary,
+            std::int64_t num_buckets,
+            util::function_nonser<std::vector<std::int64_t>(bool)>& result);
 
         // register the given action
         static void register_action(char const* action, error_code& ec);
@@ -79,33 +101,57 @@ namespace hpx { namespace plugins { namespace parcel
         void update_num_messages();
         void update_interval();
 
+        std::size_t get_adaptive_num_messages(
+            std::int64_t time_between_parcels) const;
+        std::int64_t get_adaptive_interval(std::int64_t time_between_parcels,
+            std::size_t num_messages) const;
+
     private:
-        mutable mutex_type mtx_;
+        enum { num_stripes = 16 };
+
+        struct buffer_stripe
+        {
+            mutex_type mtx_;
+            detail::message_buffer buffer_;
+
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        mutable mutex_type mtx_;        // serializes flushing and counters
         parcelset::parcelport* pp_;
-        std::size_t num_coalesced_parcels_;
-        std::size_t interval_;
-        detail::message_buffer buffer_;
+        boost::atomic<std::size_t> num_coalesced_parcels_;
+        boost::atomic<std::size_t> interval_;
+        std::unique_ptr<buffer_stripe[]> stripes_;
+        boost::atomic<std::size_t> num_buffered_parcels_;
         util::pool_timer timer_;
-        bool stopped_;
+        boost::atomic<bool> stopped_;
         bool allow_background_flush_;
         std::string action_name_;
 
+        // moving average of the time between parcels [ns], drives the
+        // adaptation of the number of coalesced parcels and of the interval
+        boost::atomic<std::int64_t> estimated_time_between_parcels_;
+
         // performance counter data
-        std::int64_t num_parcels_;
+        boost::atomic<std::int64_t> num_parcels_;
         std::int64_t reset_num_parcels_;
         std::int64_t reset_num_parcels_per_message_parcels_;
-        std::int64_t num_messages_;
+        boost::atomic<std::int64_t> num_messages_;
         std::int64_t reset_num_messages_;
         std::int64_t reset_num_parcels_per_message_messages_;
         std::int64_t started_at_;
         std::int64_t reset_time_num_parcels_;
-        std::int64_t last_parcel_time_;
+        boost::atomic<std::int64_t> last_parcel_time_;
+
+        // number of generated messages for each number of parcels per message
+        std::vector<std::int64_t> parcels_per_message_;
 
         typedef boost::accumulators::accumulator_set<
                 double,     // collects percentiles
                 boost::accumulators::features<hpx::util::tag::histogram>
             > histogram_collector_type;
 
+        boost::atomic<bool> collect_time_between_parcels_;
         std::unique_ptr<histogram_collector_type> time_between_parcels_;
         std::int64_t histogram_min_boundary_;
         std::int64_t histogram_max_boundary_;
@@ -112,6 +112,35 @@ namespace hpx { namespace plugins { namespace parcel { namespace detail
             return message_buffer_append_state(result);
         }
 
+        // Move all parcels held by the given buffer to the end of this one
+        void merge(message_buffer& rhs)
+        {
+            if (rhs.empty())
+                return;
+
+            if (messages_.empty())
+            {
+                dest_ = std::move(rhs.dest_);
+                messages_ = std::move(rhs.messages_);
+                handlers_ = std::move(rhs.handlers_);
+            }
+            else
+            {
+                HPX_ASSERT(dest_ == rhs.dest_);
+
+                messages_.reserve(messages_.size() + rhs.messages_.size());
+                handlers_.reserve(handlers_.size() + rhs.handlers_.size());
+
+                for (std::size_t i = 0; i != rhs.messages_.size(); ++i)
+                {
+                    messages_.push_back(std::move(rhs.messages_[i]));
+                    handlers_.push_back(std::move(rhs.handlers_[i]));
+                }
+            }
+
+            rhs.clear();
+        }
+
         bool empty() const
         {
             HPX_ASSERT(messages_.size() == handlers_.size());
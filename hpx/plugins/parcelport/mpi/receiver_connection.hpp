@@ -62,6 +62,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             data.time_ = timer_.elapsed_nanoseconds();
             data.bytes_ = static_cast<std::size_t>(header_.numbytes());
 
+            buffer_.data_ = pp_.get_buffer_pool().get_buffer(
+                static_cast<std::size_t>(header_.size()));
             buffer_.data_.resize(static_cast<std::size_t>(header_.size()));
             buffer_.num_chunks_ = header_.num_chunks();
         }
@@ -163,6 +165,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                 std::size_t chunk_size = buffer_.transmission_chunks_[idx].second;
 
                 data_type & c = buffer_.chunks_[idx];
+                c = pp_.get_buffer_pool().get_buffer(chunk_size);
                 c.resize(chunk_size);
                 {
                     util::mpi_environment::scoped_lock l;
@@ -205,7 +208,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                 request_ptr_ = &request_;
             }
 
-            decode_parcels(pp_, std::move(buffer_), num_thread);
+            decode_parcels(pp_, buffer_, num_thread);
+
+            // hand the received buffers back to the pool
+            pp_.get_buffer_pool().reclaim_buffer(std::move(buffer_.data_));
+            for (data_type& c : buffer_.chunks_)
+                pp_.get_buffer_pool().reclaim_buffer(std::move(c));
+            buffer_.clear();
 
             state_ = sent_release_tag;
 
@@ -20,6 +20,7 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
@@ -51,11 +52,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
         receiver(boost::asio::io_service& io_service, std::uint64_t max_inbound_size,
-            connection_handler& parcelport)
+            connection_handler& parcelport,
+            parcelset::parcelport::buffer_pool_type& buffer_pool)
           : socket_(io_service)
           , max_inbound_size_(max_inbound_size)
           , ack_(0)
           , parcelport_(parcelport)
+          , buffer_pool_(buffer_pool)
           , timer_()
           , mtx_()
           , operation_in_flight_(0)
@@ -196,6 +199,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                             sizeof(transmission_chunk_type)));
 
                     // add main buffer holding data which was serialized normally
+                    buffer_.data_ = buffer_pool_.get_buffer(
+                        static_cast<std::size_t>(inbound_size));
                     buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
                     buffers.push_back(boost::asio::buffer(buffer_.data_));
 
@@ -204,6 +209,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 }
                 else {
                     // add main buffer holding data which was serialized normally
+                    buffer_.data_ = buffer_pool_.get_buffer(
+                        static_cast<std::size_t>(inbound_size));
                     buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
                     buffers.push_back(boost::asio::buffer(buffer_.data_));
 
@@ -260,6 +267,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 {
                     std::size_t chunk_size = static_cast<std::size_t>(
                         buffer_.transmission_chunks_[i].second);
+                    buffer_.chunks_[i] = buffer_pool_.get_buffer(chunk_size);
                     buffer_.chunks_[i].resize(chunk_size);
                     buffers.push_back(
                         boost::asio::buffer(buffer_.chunks_[i].data(), chunk_size));
@@ -315,9 +323,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                         Handler)
                     = &receiver::handle_write_ack<Handler>;
 
-                // decode the received parcels.
-                decode_parcels(parcelport_, std::move(buffer_), -1);
-                buffer_ = parcel_buffer_type();
+                // decode the received parcels and recycle the buffers
+                decode_parcels(parcelport_, buffer_, -1);
+                reclaim_buffers();
 
                 ack_ = true;
                 {
@@ -339,6 +347,16 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
         }
 
+        // hand the received buffers back to the pool
+        void reclaim_buffers()
+        {
+            buffer_pool_.reclaim_buffer(std::move(buffer_.data_));
+            for (std::vector<char>& c : buffer_.chunks_)
+                buffer_pool_.reclaim_buffer(std::move(c));
+
+            buffer_ = parcel_buffer_type();
+        }
+
         template <typename Handler>
         void handle_write_ack(boost::system::error_code const& e,
             Handler handler)
@@ -366,6 +384,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         /// The handler used to process the incoming request.
         connection_handler& parcelport_;
 
+        /// The pool the receive buffers are taken from.
+        parcelset::parcelport::buffer_pool_type& buffer_pool_;
+
         /// Counters and timers for parcels received.
         util::high_resolution_timer timer_;
 
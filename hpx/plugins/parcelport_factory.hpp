@@ -101,6 +101,9 @@ namespace hpx { namespace plugins
                 "zero_copy_optimization = ${HPX_PARCEL_" + name_uc +
                     "_ZERO_COPY_OPTIMIZATION:"
                     "$[hpx.parcel.zero_copy_optimization]}",
+                "integer_compression = ${HPX_PARCEL_" + name_uc +
+                    "_INTEGER_COMPRESSION:"
+                    "$[hpx.parcel.integer_compression]}",
                 "enable_security = ${HPX_PARCEL_" + name_uc +
                     "_ENABLE_SECURITY:"
                     "$[hpx.parcel.enable_security]}",
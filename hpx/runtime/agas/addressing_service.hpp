@@ -18,6 +18,7 @@
 #include <hpx/runtime/agas_fwd.hpp>
 #include <hpx/runtime/agas/gva.hpp>
 #include <hpx/runtime/agas/component_namespace.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/runtime/agas/locality_namespace.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
 #include <hpx/runtime/agas/primary_namespace.hpp>
@@ -26,8 +27,6 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/state.hpp>
-#include <hpx/util/cache/lru_cache.hpp>
-#include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
 
@@ -73,19 +72,12 @@ public:
     // }}}
 
     // {{{ gva cache
-    struct gva_cache_key;
-
-    typedef hpx::util::cache::lru_cache<
-        gva_cache_key
-      , gva
-      , hpx::util::cache::statistics::local_full_statistics
-    > gva_cache_type;
+    typedef detail::gva_cache gva_cache_type;
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, std::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
     mutable mutex_type migrated_objects_mtx_;
@@ -96,10 +88,26 @@ public:
 
     std::size_t const max_refcnt_requests_;
 
+    // Each OS-thread accumulates its decref requests in its own table (modulo
+    // the number of tables), those are merged into refcnt_requests_ whenever
+    // the requests are sent. The pending decref requests double as a local
+    // reservoir of credits which is used to satisfy increfs issued on the
+    // same OS-thread without talking to AGAS.
+    struct refcnt_accumulator
+    {
+        mutex_type mtx_;
+        refcnt_requests_type requests_;
+    };
+
+    static std::size_t const num_refcnt_accumulators = 16;
+
+    refcnt_accumulator& get_refcnt_accumulator();
+
     mutex_type refcnt_requests_mtx_;
-    std::size_t refcnt_requests_count_;
-    bool enable_refcnt_caching_;
+    boost::atomic<std::size_t> refcnt_requests_count_;
+    boost::atomic<bool> enable_refcnt_caching_;
 
+    std::unique_ptr<refcnt_accumulator[]> refcnt_accumulators_;
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
     service_mode const service_type;
@@ -203,7 +211,9 @@ public:
     std::int64_t synchronize_with_async_incref(
         hpx::future<std::int64_t> fut
       , naming::id_type const& id
+      , naming::gid_type const& gid
       , std::int64_t compensated_credit
+      , std::int64_t pooled_credit
         );
 
     naming::address::address_type get_primary_ns_lva() const
@@ -241,7 +251,15 @@ protected:
         );
 
 private:
-    /// Assumes that \a refcnt_requests_mtx_ is locked.
+    /// Move the decref requests accumulated by all OS-threads into
+    /// \a refcnt_requests_. Assumes that \a refcnt_requests_mtx_ is locked.
+    void merge_refcnt_requests(
+        std::unique_lock<mutex_type>& l
+        );
+
+    /// Send the pending requests if caching is disabled or if enough
+    /// requests have been accumulated. Assumes that \a l refers to
+    /// \a refcnt_requests_mtx_ without owning it.
     void send_refcnt_requests(
         std::unique_lock<mutex_type>& l
       , error_code& ec = throws
@@ -0,0 +1,200 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_GVA_CACHE_SEP_22_2017_1020AM)
+#define HPX_AGAS_DETAIL_GVA_CACHE_SEP_22_2017_1020AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The gva_cache holds the resolved addresses of remote objects. It is
+    // optimized for concurrent lookups which never acquire any lock:
+    //
+    // - Entries describing a single object (count == 1) are stored in a set
+    //   associative table (each key hashes to a set of a small number of
+    //   slots). Each slot is protected by a sequence lock, readers simply
+    //   retry if they observe a concurrent modification. Writers serialize
+    //   on one of a fixed number of spinlocks, chosen based on the set.
+    // - Sets are replaced using the CLOCK algorithm: lookups mark a slot as
+    //   referenced, inserting into a full set evicts the first slot which was
+    //   not referenced since the last sweep.
+    // - Entries describing a range of objects (count > 1, see
+    //   hpx.agas.use_range_caching) are kept in a separate ordered map which
+    //   is protected by a spinlock. This map is consulted only if any range
+    //   entries exist.
+    //
+    // Note: In contrast to the lru_cache previously used, inserting a range
+    //       entry does not detect collisions with existing single entries
+    //       covered by that range.
+    class HPX_EXPORT gva_cache
+    {
+    public:
+        HPX_NON_COPYABLE(gva_cache);
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Cache statistics, the counts are collected separately for each OS
+        // thread to avoid contention.
+        class HPX_EXPORT statistics
+        {
+        public:
+            enum method
+            {
+                method_get_entry = 0,
+                method_insert_entry = 1,
+                method_update_entry = 2,
+                method_erase_entry = 3,
+                num_methods = 4
+            };
+
+            statistics();
+            ~statistics();
+
+            std::size_t hits(bool reset);
+            std::size_t misses(bool reset);
+            std::size_t insertions(bool reset);
+            std::size_t evictions(bool reset);
+
+            std::int64_t get_get_entry_count(bool reset);
+            std::int64_t get_insert_entry_count(bool reset);
+            std::int64_t get_update_entry_count(bool reset);
+            std::int64_t get_erase_entry_count(bool reset);
+
+            std::int64_t get_get_entry_time(bool reset);
+            std::int64_t get_insert_entry_time(bool reset);
+            std::int64_t get_update_entry_time(bool reset);
+            std::int64_t get_erase_entry_time(bool reset);
+
+            void got_hit();
+            void got_miss();
+            void got_insertion();
+            void got_eviction(std::size_t count = 1);
+
+            struct update_on_exit;
+
+        private:
+            struct data;
+
+            data& get_data();
+
+            std::int64_t accumulate(
+                boost::atomic<std::int64_t> data::* value, bool reset);
+            std::int64_t accumulate(method m, bool count, bool reset);
+
+            std::unique_ptr<data[]> data_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        explicit gva_cache(std::size_t max_size = 0);
+        ~gva_cache();
+
+        // Return the number of entries currently held by the cache
+        std::size_t size() const;
+
+        // Return the maximum number of entries the cache may hold
+        std::size_t capacity() const;
+
+        // Change the maximum number of entries, this drops all entries which
+        // don't fit into the new table.
+        void reserve(std::size_t max_size);
+
+        // Find the entry holding the address of the given (stripped) gid.
+        // On success, return the base gid of the entry and its gva.
+        bool get_entry(naming::gid_type const& gid, naming::gid_type& idbase,
+            gva& g);
+
+        // Insert or update the entry for the objects [gid, gid + count). This
+        // returns false if an entry with a different base gid or count
+        // exists which covers the given gid, in which case the base gid and
+        // count of that entry are returned in idbase and old_count.
+        bool update_if(naming::gid_type const& gid, std::uint64_t count,
+            gva const& g, naming::gid_type& idbase, std::uint64_t& old_count);
+
+        // Remove all entries with the given base gid, returns the number of
+        // removed entries.
+        std::size_t erase(naming::gid_type const& gid);
+
+        // Remove all entries
+        std::size_t clear();
+
+        // Return the number of replaced tables which could not be freed yet
+        // as concurrent readers might still access them.
+        std::size_t num_retired_tables() const;
+
+        statistics& get_statistics()
+        {
+            return statistics_;
+        }
+
+    private:
+        struct slot;
+        struct table;
+        struct shard;
+        struct reader_count;
+        struct reader_guard;
+
+        struct range_entry
+        {
+            std::uint64_t count_;
+            gva gva_;
+            bool referenced_;
+        };
+        typedef std::map<naming::gid_type, range_entry> range_map_type;
+
+        shard& get_shard(std::size_t set);
+
+        bool get_single_entry(table const& t, naming::gid_type const& gid,
+            gva& g);
+        range_map_type::iterator find_range_entry(naming::gid_type const& gid);
+
+        bool update_single_entry(naming::gid_type const& gid, gva const& g);
+        bool update_range_entry(naming::gid_type const& gid,
+            std::uint64_t count, gva const& g, naming::gid_type& idbase,
+            std::uint64_t& old_count);
+
+        void evict_range_entry();
+
+        void reclaim_retired_tables();
+
+        boost::atomic<std::size_t> max_size_;
+
+        // The table is replaced by reserve() only. Retired tables are freed
+        // as soon as no reader is found accessing the cache (see
+        // reclaim_retired_tables), readers announce themselves in the reader
+        // count assigned to their OS thread.
+        boost::atomic<table*> table_;
+        std::vector<std::unique_ptr<table> > retired_tables_;
+        std::unique_ptr<reader_count[]> readers_;
+        std::unique_ptr<shard[]> shards_;
+        boost::atomic<std::size_t> size_;
+
+        mutable mutex_type ranges_mtx_;
+        range_map_type ranges_;
+        naming::gid_type ranges_hand_;
+        boost::atomic<std::size_t> num_ranges_;
+
+        statistics statistics_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -32,6 +32,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -124,30 +125,61 @@ struct HPX_EXPORT primary_namespace
 
     typedef std::int32_t component_type;
 
-    typedef std::pair<gva, naming::gid_type> gva_table_data_type;
+    // Each bound range [base, base + count) is stored in all partitions it
+    // has gids in, keyed by the first of its gids belonging to the partition.
+    struct gva_table_data_type
+    {
+        naming::gid_type base_;         // first gid of the bound range
+        gva gva_;
+        naming::gid_type locality_;
+    };
     typedef std::map<naming::gid_type, gva_table_data_type> gva_table_type;
-    typedef std::map<naming::gid_type, std::int64_t> refcnt_table_type;
+    typedef std::unordered_map<naming::gid_type, std::int64_t>
+        refcnt_table_type;
 
     typedef hpx::util::tuple<naming::gid_type, gva, naming::gid_type>
         resolved_type;
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
-
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::condition_variable_any>
         > migration_table_type;
 
+    // The tables are split into partitions guarded by separate mutexes,
+    // a gid belongs to the partition selected by the low bits of its LSB.
+    // Operations touching more than one partition acquire the locks in
+    // ascending order.
+    static std::size_t const num_partitions =
+        HPX_AGAS_PRIMARY_NAMESPACE_PARTITIONS;
+
+    static_assert(num_partitions != 0 &&
+        (num_partitions & (num_partitions - 1)) == 0,
+        "HPX_AGAS_PRIMARY_NAMESPACE_PARTITIONS must be a power of two");
+
+    struct partition
+    {
+        mutex_type mutex_;
+        gva_table_type gvas_;
+        refcnt_table_type refcnts_;
+        migration_table_type migrating_objects_;
+    };
+    partition partitions_[num_partitions];
+
+    static std::size_t get_partition_index(naming::gid_type const& id)
+    {
+        return static_cast<std::size_t>(id.get_lsb() & (num_partitions - 1));
+    }
+
+    partition& get_partition(naming::gid_type const& id)
+    {
+        return partitions_[get_partition_index(id)];
+    }
+
     std::string instance_name_;
     naming::gid_type next_id_;      // next available gid
     naming::gid_type locality_;     // our locality id
-    migration_table_type migrating_objects_;
 
     struct update_time_on_exit;
 
@@ -223,11 +255,10 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all gids in [lower, upper) stored in the
+    /// given partition. Expects that \p l is locked.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
+        partition& p
       , naming::gid_type const& lower
       , naming::gid_type const& upper
       , std::unique_lock<mutex_type>& l
@@ -235,7 +266,16 @@ struct HPX_EXPORT primary_namespace
         );
 #endif
 
-    // helper function
+    // helper functions
+    static std::uint64_t get_partition_count(
+        naming::gid_type const& lower
+      , naming::gid_type const& upper);
+
+    void lock_partitions(
+        naming::gid_type const& id
+      , std::uint64_t count
+      , std::vector<std::unique_lock<mutex_type> >& locks);
+
     void wait_for_migration_locked(
         std::unique_lock<mutex_type>& l
       , naming::gid_type id
@@ -244,7 +284,6 @@ struct HPX_EXPORT primary_namespace
   public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
-      , mutex_()
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
@@ -342,7 +381,8 @@ struct HPX_EXPORT primary_namespace
 
     void resolve_free_list(
         std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+      , partition& p
+      , std::list<naming::gid_type> const& free_list
       , std::list<free_entry>& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
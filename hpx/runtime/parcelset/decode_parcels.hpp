@@ -15,17 +15,26 @@
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_route_handler.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime_fwd.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/buffer_pool.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/thread_trace.hpp>
 
 #include <boost/exception/exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -100,19 +109,239 @@ namespace hpx { namespace parcelset
         return chunks;
     }
 
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Allows for the de-serialized objects to take over the memory of the
+        // zero-copy chunks received into separate buffers. Chunks allocated
+        // from the parcelport's buffer pool are handed back to it once the
+        // last object referring to them has released them (unless the pool
+        // has been destroyed in the meantime).
+        template <typename Buffer>
+        struct adoptable_buffer_chunks : serialization::adoptable_chunks
+        {
+            typedef util::buffer_pool<char> buffer_pool_type;
+            typedef buffer_pool_type::buffer_type pool_buffer_type;
+
+            adoptable_buffer_chunks(Buffer& buffer,
+                    std::weak_ptr<buffer_pool_type> pool =
+                        std::weak_ptr<buffer_pool_type>())
+              : buffer_(buffer), pool_(std::move(pool))
+            {}
+
+            std::shared_ptr<void> adopt(std::size_t chunk)
+            {
+                return adopt_chunk(chunk, buffer_.chunks_);
+            }
+
+        private:
+            struct reclaim_chunk
+            {
+                void operator()(pool_buffer_type* chunk) const
+                {
+                    std::shared_ptr<buffer_pool_type> pool = pool_.lock();
+                    if (pool)
+                        pool->reclaim_buffer(std::move(*chunk));
+                    delete chunk;
+                }
+
+                std::weak_ptr<buffer_pool_type> pool_;
+            };
+
+            std::shared_ptr<void> make_owner(pool_buffer_type&& chunk)
+            {
+                return std::shared_ptr<pool_buffer_type>(
+                    new pool_buffer_type(std::move(chunk)),
+                    reclaim_chunk{pool_});
+            }
+
+            template <typename Allocator>
+            std::shared_ptr<void> make_owner(
+                std::vector<char, Allocator>&& chunk)
+            {
+                return std::make_shared<std::vector<char, Allocator> >(
+                    std::move(chunk));
+            }
+
+            template <typename Allocator>
+            std::shared_ptr<void> adopt_chunk(std::size_t chunk,
+                std::vector<std::vector<char, Allocator> >& chunks)
+            {
+                std::size_t num_zero_copy_chunks =
+                    static_cast<std::size_t>(
+                        static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+                // chunk refers to the position in the list of all chunks
+                for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+                {
+                    if (buffer_.transmission_chunks_[i].first == chunk)
+                        return make_owner(std::move(chunks[i]));
+                }
+                return std::shared_ptr<void>();
+            }
+
+            // other chunk types can't be adopted
+            template <typename Chunks>
+            std::shared_ptr<void> adopt_chunk(std::size_t, Chunks&)
+            {
+                return std::shared_ptr<void>();
+            }
+
+            Buffer& buffer_;
+            std::weak_ptr<buffer_pool_type> pool_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Schedule the action of the given parcel on a new HPX-thread.
+        inline void schedule_parcel_thread(parcel&& p, std::size_t num_thread)
+        {
+            hpx::applier::register_thread_nullary(
+                util::bind(
+                    util::one_shot(
+                        [num_thread](parcel&& p)
+                        {
+                            p.schedule_action(num_thread);
+                        }
+                    ), std::move(p)),
+                "schedule_parcel",
+                threads::pending, true,
+                threads::thread_priority_boost, num_thread,
+                threads::thread_stacksize_default);
+        }
+
+        // Detects whether the calling HPX-thread was suspended during the
+        // lifetime of this object by hooking into its yield function. Unlike
+        // the thread phase this is available in all configurations.
+        class suspension_detector
+        {
+            typedef threads::thread_self::yield_decorator_type
+                yield_decorator_type;
+
+        public:
+            explicit suspension_detector(threads::thread_self& self)
+              : self_(self), suspended_(false),
+                previous_(self.decorate_yield(util::bind(
+                    &suspension_detector::yield, this,
+                    util::placeholders::_1)))
+            {}
+
+            ~suspension_detector()
+            {
+                self_.decorate_yield(std::move(previous_));
+            }
+
+            bool suspended() const
+            {
+                return suspended_;
+            }
+
+        private:
+            HPX_NON_COPYABLE(suspension_detector);
+
+            threads::thread_arg_type yield(threads::thread_result_type state)
+            {
+                suspended_ = true;
+                return previous_.empty() ?
+                    self_.yield_impl(std::move(state)) :
+                    previous_(std::move(state));
+            }
+
+            threads::thread_self& self_;
+            bool suspended_;
+            yield_decorator_type previous_;
+        };
+
+        // Execute the direct actions of the parcels [begin, end) one after
+        // the other on the calling HPX-thread. An action which suspended the
+        // calling HPX-thread is likely to be followed by more of the same
+        // kind, thus all remaining parcels are moved to separate HPX-threads
+        // instead of delaying them further. There is no separate trait
+        // marking actions as non-blocking, every direct action is batched.
+        // An exception escaping one of the actions is reported and doesn't
+        // prevent the remaining parcels from being handled.
+        template <typename Parcelport>
+        void schedule_parcels_inline(Parcelport& pp,
+            std::vector<parcel>& parcels, std::size_t begin, std::size_t end,
+            std::size_t num_thread)
+        {
+            threads::thread_self* self = threads::get_self_ptr();
+            HPX_ASSERT(self != nullptr);
+
+            std::size_t i = begin;
+            {
+                suspension_detector detector(*self);
+                while (i != end)
+                {
+                    try {
+                        parcels[i++].schedule_action(num_thread);
+                    }
+                    catch (...) {
+                        LPT_(error)
+                            << "schedule_parcels_inline: caught exception "
+                               "while executing a direct action";
+                        hpx::report_error(std::current_exception());
+                    }
+
+                    if (detector.suspended())
+                        break;
+                }
+            }
+            pp.add_inlined_actions(i - begin);
+
+            if (i != end)
+            {
+                pp.add_spawned_actions(end - i);
+                for (/**/; i != end; ++i)
+                    schedule_parcel_thread(std::move(parcels[i]), num_thread);
+            }
+        }
+
+        // Execute the direct actions of all given parcels on one new
+        // HPX-thread. Parcelports are destroyed only at runtime shutdown,
+        // after all received parcels have been handled, thus the new thread
+        // can safely refer to the parcelport.
+        template <typename Parcelport>
+        void schedule_parcels_batch(Parcelport& pp,
+            std::vector<parcel>&& parcels, std::size_t num_thread)
+        {
+            Parcelport* ppp = &pp;
+            hpx::applier::register_thread_nullary(
+                util::bind(
+                    util::one_shot(
+                        [ppp, num_thread](std::vector<parcel>&& parcels)
+                        {
+                            schedule_parcels_inline(*ppp, parcels, 0,
+                                parcels.size(), num_thread);
+                        }
+                    ), std::move(parcels)),
+                "schedule_parcels",
+                threads::pending, true,
+                threads::thread_priority_boost, num_thread,
+                threads::thread_stacksize_default);
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
+    // The buffer is not consumed, all parcels are de-serialized (copied
+    // out of the buffer or adopted from it) before this returns.
     template <typename Parcelport, typename Buffer>
     void decode_message_with_chunks(
         Parcelport & pp
-      , Buffer buffer
+      , Buffer && buffer
       , std::size_t parcel_count
       , std::vector<serialization::serialization_chunk> &chunks
       , std::size_t num_thread = -1
+      , serialization::adoptable_chunks* adoptable = nullptr
     )
     {
         std::size_t inbound_data_size = static_cast<std::size_t>(
             static_cast<std::uint64_t>(buffer.data_size_));
 
+#if defined(HPX_HAVE_THREAD_TRACE)
+        util::thread_trace::record(util::thread_trace::parcel_receive,
+            nullptr, nullptr, inbound_data_size);
+#endif
+
         // protect from un-handled exceptions bubbling up
         try {
             try {
@@ -126,7 +355,7 @@ namespace hpx { namespace parcelset
                     std::vector<parcel> deferred_parcels;
                     // De-serialize the parcel data
                     serialization::input_archive archive(buffer.data_,
-                        inbound_data_size, &chunks);
+                        inbound_data_size, &chunks, adoptable);
 
                     if(parcel_count == 0)
                     {
@@ -194,6 +423,12 @@ namespace hpx { namespace parcelset
                         // If we got a direct action,
                         else if (deferred_schedule)
                             deferred_parcels.push_back(std::move(p));
+                        // a single direct action was executed right away
+                        else if (p.get_action()->get_action_type() ==
+                            actions::base_action::direct_action)
+                            pp.add_inlined_actions(1);
+                        else
+                            pp.add_spawned_actions(1);
 
                         // be sure not to measure add_parcel as serialization time
                         overall_add_parcel_time += timer.elapsed_nanoseconds() -
@@ -206,24 +441,41 @@ namespace hpx { namespace parcelset
 
                     if (!deferred_parcels.empty())
                     {
-                        for (std::size_t i = 1; i != deferred_parcels.size(); ++i)
+                        std::size_t const batch_size =
+                            HPX_PARCEL_MAX_INLINE_BATCH_SIZE;
+                        std::size_t const size = deferred_parcels.size();
+
+                        // The first batch of parcels is executed right here
+                        // if this is an HPX-thread, otherwise (e.g. when
+                        // called on an io_service thread) all batches are
+                        // handed to new HPX-threads.
+                        std::size_t const first_batch =
+                            threads::get_self_ptr() != nullptr ?
+                                (std::min)(batch_size, size) : 0;
+
+                        // schedule all but the first batch of parcels,
+                        // using one new thread per batch
+                        for (std::size_t i = first_batch; i < size;
+                             i += batch_size)
+                        {
+                            auto first = deferred_parcels.begin() + i;
+                            auto last = deferred_parcels.begin() +
+                                (std::min)(i + batch_size, size);
+
+                            detail::schedule_parcels_batch(pp,
+                                std::vector<parcel>(
+                                    std::make_move_iterator(first),
+                                    std::make_move_iterator(last)),
+                                num_thread);
+                        }
+
+                        // ...we don't need to spin a new thread for the
+                        // first batch
+                        if (first_batch != 0)
                         {
-                            // schedule all but the first parcel on a new thread.
-                            hpx::applier::register_thread_nullary(
-                                util::bind(
-                                    util::one_shot(
-                                        [num_thread](parcel&& p)
-                                        {
-                                            p.schedule_action(num_thread);
-                                        }
-                                    ), std::move(deferred_parcels[i])),
-                                "schedule_parcel",
-                                threads::pending, true, threads::thread_priority_boost,
-                                num_thread, threads::thread_stacksize_default);
+                            detail::schedule_parcels_inline(pp,
+                                deferred_parcels, 0, first_batch, num_thread);
                         }
-                        // If we are the first deferred parcel, we don't need to spin
-                        // a new thread...
-                        deferred_parcels[0].schedule_action(num_thread);
                     }
                 }
 
@@ -269,19 +521,24 @@ namespace hpx { namespace parcelset
     template <typename Parcelport, typename Buffer>
     void decode_message(
         Parcelport & pp
-      , Buffer buffer
+      , Buffer & buffer
       , std::size_t parcel_count
       , std::size_t num_thread = -1
     )
     {
         std::vector<serialization::serialization_chunk>
             chunks(decode_chunks(buffer));
-        decode_message_with_chunks(pp, std::move(buffer),
-            parcel_count, chunks, num_thread);
+        detail::adoptable_buffer_chunks<Buffer> adoptable(buffer,
+            pp.get_shared_buffer_pool());
+        decode_message_with_chunks(pp, buffer,
+            parcel_count, chunks, num_thread, &adoptable);
     }
 
+    // The functions below leave the given buffer intact (except for zero-copy
+    // chunks adopted by the de-serialized objects), this allows for the
+    // caller to reuse its memory once the parcels have been decoded.
     template <typename Parcelport, typename Buffer>
-    void decode_parcel(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
+    void decode_parcel(Parcelport & parcelport, Buffer & buffer, std::size_t num_thread)
     {
 //         if(hpx::is_running() && parcelport.async_serialization())
 //         {
@@ -295,12 +552,12 @@ namespace hpx { namespace parcelset
 //         }
 //         else
         {
-            decode_message(parcelport, std::move(buffer), 1, num_thread);
+            decode_message(parcelport, buffer, 1, num_thread);
         }
     }
 
     template <typename Parcelport, typename Buffer>
-    void decode_parcels(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
+    void decode_parcels(Parcelport & parcelport, Buffer & buffer, std::size_t num_thread)
     {
 //         if(hpx::is_running() && parcelport.async_serialization())
 //         {
@@ -314,7 +571,7 @@ namespace hpx { namespace parcelset
 //         }
 //         else
         {
-            decode_message(parcelport, std::move(buffer), 0, num_thread);
+            decode_message(parcelport, buffer, 0, num_thread);
         }
     }
 
@@ -23,6 +23,7 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/integer/endian.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/thread_trace.hpp>
 
 #include <boost/exception/exception.hpp>
 
@@ -260,6 +261,11 @@ namespace hpx
             buffer.data_point_.num_parcels_ = parcels_sent;
             detail::encode_finalize(buffer, arg_size);
 
+#if defined(HPX_HAVE_THREAD_TRACE)
+            util::thread_trace::record(util::thread_trace::parcel_send,
+                nullptr, nullptr, arg_size);
+#endif
+
             return parcels_sent;
         }
     }
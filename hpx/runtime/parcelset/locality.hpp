@@ -16,8 +16,11 @@
 #include <hpx/runtime/serialization/map.hpp>
 #include <hpx/traits/is_iterator.hpp>
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -27,6 +30,25 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace parcelset
 {
+    namespace detail
+    {
+        // Use the hash_value() function of the parcelport specific locality
+        // type if available, otherwise hash its textual representation.
+        template <typename Impl>
+        auto hash_locality(Impl const& i, int) -> decltype(hash_value(i))
+        {
+            return hash_value(i);
+        }
+
+        template <typename Impl>
+        std::size_t hash_locality(Impl const& i, long)
+        {
+            std::ostringstream strm;
+            strm << i;
+            return std::hash<std::string>()(strm.str());
+        }
+    }
+
     class HPX_EXPORT locality
     {
         template <typename Impl>
@@ -39,6 +61,7 @@ namespace hpx { namespace parcelset
 
             virtual bool equal(impl_base const & rhs) const = 0;
             virtual bool less_than(impl_base const & rhs) const = 0;
+            virtual std::size_t hash() const = 0;
             virtual bool valid() const = 0;
             virtual const char *type() const = 0;
             virtual std::ostream & print(std::ostream & os) const = 0;
@@ -129,6 +152,13 @@ namespace hpx { namespace parcelset
             return impl_ ? impl_->type() : "";
         }
 
+        /// Return a hash value for this locality, equal localities have equal
+        /// hash values.
+        std::size_t hash() const
+        {
+            return impl_ ? impl_->hash() : 0;
+        }
+
         template <typename Impl>
         Impl & get()
         {
@@ -170,6 +200,11 @@ namespace hpx { namespace parcelset
             return !(lhs < rhs) && !(lhs == rhs);
         }
 
+        friend std::size_t hash_value(locality const& l)
+        {
+            return l.hash();
+        }
+
         friend std::ostream& operator<< (std::ostream& os, locality const& l)
         {
             if(!l.impl_) return os;
@@ -206,6 +241,11 @@ namespace hpx { namespace parcelset
                     (type() == rhs.type() && impl_ < rhs.get<Impl>());
             }
 
+            std::size_t hash() const
+            {
+                return detail::hash_locality(impl_, 0);
+            }
+
             bool valid() const
             {
                 return !!impl_;
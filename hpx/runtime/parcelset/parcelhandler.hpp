@@ -327,6 +327,14 @@ namespace hpx { namespace parcelset
         std::int64_t get_message_receive_count(
             std::string const& pp_type, bool reset) const;
 
+        // number of received actions executed without a separate HPX-thread
+        std::int64_t get_inlined_action_count(
+            std::string const& pp_type, bool reset) const;
+
+        // number of received actions executed on a new HPX-thread
+        std::int64_t get_spawned_action_count(
+            std::string const& pp_type, bool reset) const;
+
         // the total time it took for all sends, from async_write to the
         // completion handler (nanoseconds)
         std::int64_t get_sending_time(
@@ -406,6 +414,9 @@ namespace hpx { namespace parcelset
         std::int64_t get_connection_cache_statistics(std::string const& pp_type,
             parcelport::connection_cache_statistics_type stat_type, bool) const;
 
+        std::int64_t get_buffer_pool_statistics(std::string const& pp_type,
+            parcelport::buffer_pool_statistics_type stat_type, bool) const;
+
         void list_parcelports(std::ostringstream& strm) const;
         void list_parcelport(std::ostringstream& strm,
             std::string const& ppname, int priority, bool bootstrap) const;
@@ -443,6 +454,7 @@ namespace hpx { namespace parcelset
 
         void register_counter_types(std::string const& pp_type);
         void register_connection_cache_counter_types(std::string const& pp_type);
+        void register_buffer_pool_counter_types(std::string const& pp_type);
 
     private:
         int get_priority(std::string const& name) const
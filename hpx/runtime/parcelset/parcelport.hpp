@@ -18,6 +18,7 @@
 #include <hpx/runtime/parcelset/detail/per_action_data_counter.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/util/buffer_pool.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/tuple.hpp>
 #include <hpx/util_fwd.hpp>
@@ -179,6 +180,34 @@ namespace hpx { namespace parcelset
         virtual std::int64_t get_connection_cache_statistics(
             connection_cache_statistics_type, bool reset) = 0;
 
+        /// Return the pool of buffers used to receive messages
+        typedef util::buffer_pool<char> buffer_pool_type;
+
+        buffer_pool_type& get_buffer_pool()
+        {
+            return *buffer_pool_;
+        }
+
+        // Received buffers which are handed over to de-serialized objects
+        // return to the pool (if it still exists) once they are released
+        std::weak_ptr<buffer_pool_type> get_shared_buffer_pool() const
+        {
+            return buffer_pool_;
+        }
+
+        enum buffer_pool_statistics_type
+        {
+            buffer_pool_allocations = 0,
+            buffer_pool_reuses = 1,
+            buffer_pool_reclaims = 2,
+            buffer_pool_releases = 3,
+            buffer_pool_cached_bytes = 4
+        };
+
+        /// Return buffer pool statistics
+        std::int64_t get_buffer_pool_statistics(
+            buffer_pool_statistics_type, bool reset);
+
         /// Return the name of this locality
         virtual std::string get_locality_name() const = 0;
 
@@ -236,6 +265,13 @@ namespace hpx { namespace parcelset
         /// total data received (bytes)
         std::int64_t get_data_received(bool reset);
 
+        /// number of received actions executed without creating a separate
+        /// HPX-thread for each of them
+        std::int64_t get_inlined_action_count(bool reset);
+
+        /// number of received actions executed on a new HPX-thread
+        std::int64_t get_spawned_action_count(bool reset);
+
         /// total data (uncompressed) received (bytes)
         std::int64_t get_raw_data_received(bool reset);
 
@@ -286,6 +322,16 @@ namespace hpx { namespace parcelset
         void add_sent_data(
             performance_counters::parcels::data_point const& data);
 
+        void add_inlined_actions(std::size_t count)
+        {
+            actions_inlined_.fetch_add(count, boost::memory_order_relaxed);
+        }
+
+        void add_spawned_actions(std::size_t count)
+        {
+            actions_spawned_.fetch_add(count, boost::memory_order_relaxed);
+        }
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
         void add_received_data(char const* action,
             performance_counters::parcels::data_point const& data);
@@ -317,6 +363,13 @@ namespace hpx { namespace parcelset
             return allow_zero_copy_optimizations_;
         }
 
+        /// Return whether integers should be stored using a variable length
+        /// encoding
+        bool allow_integer_compression() const
+        {
+            return allow_integer_compression_;
+        }
+
         bool enable_security() const
         {
             return enable_security_;
@@ -343,12 +396,41 @@ namespace hpx { namespace parcelset
           , std::vector<write_handler_type>
         > map_second_type;
         typedef std::map<locality, map_second_type> pending_parcels_map;
-        pending_parcels_map pending_parcels_;
-
         typedef std::set<locality> pending_parcels_destinations;
-        pending_parcels_destinations parcel_destinations_;
+
+        /// The pending parcels are split into independently locked shards,
+        /// each destination is assigned to one of those based on its hash
+        /// value. The destinations set of a shard holds all destinations which
+        /// have parcels waiting to be sent.
+        struct pending_parcels_shard
+        {
+            lcos::local::spinlock mtx_;
+            pending_parcels_map pending_parcels_;
+            pending_parcels_destinations parcel_destinations_;
+
+            // the destination a parcel was dequeued for most recently
+            locality last_destination_;
+        };
+
+        static std::size_t const num_pending_parcels_shards =
+            HPX_PARCELPORT_PENDING_PARCELS_SHARDS;
+
+        pending_parcels_shard& get_pending_parcels_shard(
+            locality const& locality_id)
+        {
+            return pending_parcels_shards_[
+                locality_id.hash() % num_pending_parcels_shards];
+        }
+
+        pending_parcels_shard
+            pending_parcels_shards_[num_pending_parcels_shards];
+
+        /// The overall number of destinations with pending parcels
         boost::atomic<std::uint32_t> num_parcel_destinations_;
 
+        /// The shard dequeue_parcel starts looking for parcels at
+        boost::atomic<std::size_t> next_pending_parcels_shard_;
+
         /// The local locality
         locality here_;
 
@@ -360,6 +442,10 @@ namespace hpx { namespace parcelset
         performance_counters::parcels::gatherer parcels_sent_;
         performance_counters::parcels::gatherer parcels_received_;
 
+        /// Statistics about how received actions were executed
+        boost::atomic<std::int64_t> actions_inlined_;
+        boost::atomic<std::int64_t> actions_spawned_;
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
         // Per-action based parcel statistics
         detail::per_action_data_counter action_parcels_sent_;
@@ -369,6 +455,7 @@ namespace hpx { namespace parcelset
         /// serialization is allowed to use array optimization
         bool allow_array_optimizations_;
         bool allow_zero_copy_optimizations_;
+        bool allow_integer_compression_;
 
         /// enable security
         bool enable_security_;
@@ -379,6 +466,9 @@ namespace hpx { namespace parcelset
         /// priority of the parcelport
         int priority_;
         std::string type_;
+
+        /// cached buffers for received messages
+        std::shared_ptr<buffer_pool_type> buffer_pool_;
     };
 }}
 
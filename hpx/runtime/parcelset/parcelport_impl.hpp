@@ -141,6 +141,9 @@ namespace hpx { namespace parcelset
                 if (!this->allow_zero_copy_optimizations())
                     archive_flags_ |= serialization::disable_data_chunking;
             }
+
+            if (this->allow_integer_compression())
+                archive_flags_ |= serialization::enable_integer_compression;
         }
 
         ~parcelport_impl()
@@ -614,7 +617,10 @@ namespace hpx { namespace parcelset
         {
             typedef pending_parcels_map::mapped_type mapped_type;
 
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
+            pending_parcels_shard& shard =
+                get_pending_parcels_shard(locality_id);
+
+            std::unique_lock<lcos::local::spinlock> l(shard.mtx_);
             // We ignore the lock here. It might happen that while enqueuing,
             // we need to acquire a lock. This should not cause any problems
             // (famous last words)
@@ -622,12 +628,12 @@ namespace hpx { namespace parcelset
                 std::unique_lock<lcos::local::spinlock>
             > il(&l);
 
-            mapped_type& e = pending_parcels_[locality_id];
+            mapped_type& e = shard.pending_parcels_[locality_id];
             util::get<0>(e).push_back(std::move(p));
             util::get<1>(e).push_back(std::move(f));
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            if (shard.parcel_destinations_.insert(locality_id).second)
+                ++num_parcel_destinations_;
         }
 
         void enqueue_parcels(locality const& locality_id,
@@ -636,7 +642,10 @@ namespace hpx { namespace parcelset
         {
             typedef pending_parcels_map::mapped_type mapped_type;
 
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
+            pending_parcels_shard& shard =
+                get_pending_parcels_shard(locality_id);
+
+            std::unique_lock<lcos::local::spinlock> l(shard.mtx_);
             // We ignore the lock here. It might happen that while enqueuing,
             // we need to acquire a lock. This should not cause any problems
             // (famous last words)
@@ -646,7 +655,7 @@ namespace hpx { namespace parcelset
 
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
+            mapped_type& e = shard.pending_parcels_[locality_id];
             if (util::get<0>(e).empty())
             {
                 HPX_ASSERT(util::get<1>(e).empty());
@@ -666,8 +675,8 @@ namespace hpx { namespace parcelset
                     std::back_inserter(util::get<1>(e)));
             }
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            if (shard.parcel_destinations_.insert(locality_id).second)
+                ++num_parcel_destinations_;
         }
 
         bool dequeue_parcels(locality const& locality_id,
@@ -676,16 +685,21 @@ namespace hpx { namespace parcelset
         {
             typedef pending_parcels_map::iterator iterator;
 
+            pending_parcels_shard& shard =
+                get_pending_parcels_shard(locality_id);
+
             {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+                std::unique_lock<lcos::local::spinlock> l(
+                    shard.mtx_, std::try_to_lock);
 
                 if (!l) return false;
 
-                iterator it = pending_parcels_.find(locality_id);
+                iterator it = shard.pending_parcels_.find(locality_id);
 
                 // do nothing if parcels have already been picked up by
                 // another thread
-                if (it != pending_parcels_.end() && !util::get<0>(it->second).empty())
+                if (it != shard.pending_parcels_.end() &&
+                    !util::get<0>(it->second).empty())
                 {
                     HPX_ASSERT(it->first == locality_id);
                     HPX_ASSERT(handlers.size() == 0);
@@ -699,14 +713,16 @@ namespace hpx { namespace parcelset
                 }
                 else
                 {
-                    HPX_ASSERT(util::get<1>(it->second).empty());
+                    HPX_ASSERT(it == shard.pending_parcels_.end() ||
+                        util::get<1>(it->second).empty());
                     return false;
                 }
 
-                parcel_destinations_.erase(locality_id);
-
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
+                if (shard.parcel_destinations_.erase(locality_id) != 0)
+                {
+                    HPX_ASSERT(0 != num_parcel_destinations_.load());
+                    --num_parcel_destinations_;
+                }
 
                 return true;
             }
@@ -715,30 +731,60 @@ namespace hpx { namespace parcelset
     protected:
         bool dequeue_parcel(locality& dest, parcel& p, write_handler_type& handler)
         {
+            if (0 == num_parcel_destinations_.load(boost::memory_order_relaxed))
+                return false;
+
+            // the destinations set of each shard refers to the pending
+            // parcels, no need to look at the (possibly empty) entries of
+            // all known destinations
+            //
+            // Each call starts with the next shard and, inside a shard, with
+            // the destination following the one served last, which keeps
+            // destinations with many parcels from starving the others.
+            std::size_t const first = next_pending_parcels_shard_.fetch_add(
+                1, boost::memory_order_relaxed);
+            for (std::size_t i = 0; i != num_pending_parcels_shards; ++i)
             {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+                pending_parcels_shard& shard = pending_parcels_shards_[
+                    (first + i) % num_pending_parcels_shards];
 
-                if (!l) return false;
+                std::unique_lock<lcos::local::spinlock> l(
+                    shard.mtx_, std::try_to_lock);
+
+                if (!l || shard.parcel_destinations_.empty())
+                    continue;
+
+                pending_parcels_destinations::iterator dit =
+                    shard.parcel_destinations_.upper_bound(
+                        shard.last_destination_);
+                if (dit == shard.parcel_destinations_.end())
+                    dit = shard.parcel_destinations_.begin();
+
+                dest = *dit;
+                shard.last_destination_ = dest;
 
-                for (auto &pending: pending_parcels_)
+                pending_parcels_map::iterator it =
+                    shard.pending_parcels_.find(dest);
+                HPX_ASSERT(it != shard.pending_parcels_.end());
+
+                auto& parcels = util::get<0>(it->second);
+                auto& handlers = util::get<1>(it->second);
+                HPX_ASSERT(!parcels.empty());
+
+                p = std::move(parcels.back());
+                parcels.pop_back();
+                handler = std::move(handlers.back());
+                handlers.pop_back();
+
+                if (parcels.empty())
                 {
-                    auto &parcels = util::get<0>(pending.second);
-                    if (!parcels.empty())
-                    {
-                        auto& handlers = util::get<1>(pending.second);
-                        dest = pending.first;
-                        p = std::move(parcels.back());
-                        parcels.pop_back();
-                        handler = std::move(handlers.back());
-                        handlers.pop_back();
-
-                        if (parcels.empty())
-                        {
-                            pending_parcels_.erase(dest);
-                        }
-                        return true;
-                    }
+                    shard.pending_parcels_.erase(it);
+                    shard.parcel_destinations_.erase(dit);
+
+                    HPX_ASSERT(0 != num_parcel_destinations_.load());
+                    --num_parcel_destinations_;
                 }
+                return true;
             }
             return false;
         }
@@ -750,18 +796,17 @@ namespace hpx { namespace parcelset
 
             std::vector<locality> destinations;
 
+            // shards which are currently locked are being worked on by
+            // another thread, skip those
+            for (pending_parcels_shard& shard : pending_parcels_shards_)
             {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-                if(l.owns_lock())
+                std::unique_lock<lcos::local::spinlock> l(
+                    shard.mtx_, std::try_to_lock);
+                if (l.owns_lock())
                 {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
-                    {
-                        destinations.push_back(loc);
-                    }
+                    destinations.insert(destinations.end(),
+                        shard.parcel_destinations_.begin(),
+                        shard.parcel_destinations_.end());
                 }
             }
 
@@ -856,12 +901,18 @@ namespace hpx { namespace parcelset
                 connection_cache_.clear(locality_id, sender_connection);
             }
             {
-                std::lock_guard<lcos::local::spinlock> l(mtx_);
+                pending_parcels_shard& shard =
+                    get_pending_parcels_shard(locality_id);
+                std::lock_guard<lcos::local::spinlock> l(shard.mtx_);
 
 //                HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it = pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() || util::get<0>(it->second).empty())
+                pending_parcels_map::iterator it =
+                    shard.pending_parcels_.find(locality_id);
+                if (it == shard.pending_parcels_.end() ||
+                    util::get<0>(it->second).empty())
+                {
                     return;
+                }
             }
 
             // Create a new HPX thread which sends parcels that are still
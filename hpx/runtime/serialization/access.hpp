@@ -12,6 +12,7 @@
 #include <hpx/traits/polymorphic_traits.hpp>
 #include <hpx/util/decay.hpp>
 
+#include <cstdint>
 #include <string>
 #include <type_traits>
 
@@ -134,6 +135,12 @@ namespace hpx { namespace serialization
         {
             return t->hpx_serialization_get_name();
         }
+
+        template <typename T> HPX_FORCEINLINE
+        static std::uint64_t get_type_hash(const T* t)
+        {
+            return t->hpx_serialization_get_type_hash();
+        }
     };
 
 }}
@@ -24,6 +24,24 @@ namespace hpx { namespace serialization
         {
             virtual ~ptr_helper() {}
         };
+
+        // a 64 bit integer occupies at most 10 bytes if stored using 7 bit
+        // groups (variable length integer encoding)
+        static const std::size_t max_varint_size = 10;
+
+        // map signed integers to unsigned ones such that values with a small
+        // magnitude have a short variable length encoding
+        inline std::uint64_t zigzag_encode(std::int64_t val)
+        {
+            return (static_cast<std::uint64_t>(val) << 1) ^
+                static_cast<std::uint64_t>(val >> 63);
+        }
+
+        inline std::int64_t zigzag_decode(std::uint64_t val)
+        {
+            return static_cast<std::int64_t>(val >> 1) ^
+                -static_cast<std::int64_t>(val & 1);
+        }
     }
 
     enum archive_flags
@@ -34,7 +52,8 @@ namespace hpx { namespace serialization
         endian_little               = 0x00008000,
         disable_array_optimization  = 0x00010000,
         disable_data_chunking       = 0x00020000,
-        all_archive_flags           = 0x0003e000    // all of the above
+        enable_integer_compression  = 0x00040000,
+        all_archive_flags           = 0x0007e000    // all of the above
     };
 
     void HPX_FORCEINLINE
@@ -94,6 +113,12 @@ namespace hpx { namespace serialization
                 true : false;
         }
 
+        bool enable_integer_compression() const
+        {
+            return (flags_ & hpx::serialization::enable_integer_compression) ?
+                true : false;
+        }
+
         std::uint32_t flags() const
         {
             return flags_;
@@ -12,6 +12,7 @@
 #include <hpx/runtime/serialization/detail/polymorphic_id_factory.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_intrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_type_hash.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/runtime/serialization/string.hpp>
 #include <hpx/traits/polymorphic_traits.hpp>
@@ -67,11 +68,10 @@ namespace hpx { namespace serialization
             {
                 static Pointer call(input_archive& ar)
                 {
-                    std::string name;
-                    ar >> name;
+                    std::uint64_t hash = load_polymorphic_type_hash(ar);
 
                     Pointer t(polymorphic_intrusive_factory::instance().
-                        create<referred_type>(name));
+                        create<referred_type>(hash));
                     ar >> *t;
                     return t;
                 }
@@ -145,8 +145,8 @@ namespace hpx { namespace serialization
             {
                 static void call(output_archive& ar, const Pointer& ptr)
                 {
-                    const std::string name = access::get_name(ptr.get());
-                    ar << name;
+                    save_polymorphic_type_hash(ar,
+                        access::get_type_hash(ptr.get()));
                     ar << *ptr;
                 }
             };
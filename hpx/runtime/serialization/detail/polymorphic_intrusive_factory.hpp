@@ -9,13 +9,13 @@
 #define HPX_SERIALIZATION_POLYMORPHIC_INTRUSIVE_FACTORY_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_type_hash.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/util/demangle_helper.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
-#include <hpx/util/jenkins_hash.hpp>
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 
 namespace hpx { namespace serialization { namespace detail
 {
@@ -26,8 +26,7 @@ namespace hpx { namespace serialization { namespace detail
 
     private:
         typedef void* (*ctor_type) ();
-        typedef std::unordered_map<std::string,
-            ctor_type, hpx::util::jenkins_hash> ctor_map_type;
+        typedef polymorphic_type_map<ctor_type> ctor_map_type;
 
     public:
         polymorphic_intrusive_factory() {}
@@ -36,7 +35,18 @@ namespace hpx { namespace serialization { namespace detail
 
         HPX_EXPORT void register_class(std::string const& name, ctor_type fun);
 
-        HPX_EXPORT void* create(std::string const& name) const;
+        HPX_EXPORT void* create(std::uint64_t hash) const;
+
+        void* create(std::string const& name) const
+        {
+            return create(polymorphic_type_hash(name));
+        }
+
+        template <typename T>
+        T* create(std::uint64_t hash) const
+        {
+            return static_cast<T*>(create(hash));
+        }
 
         template <typename T>
         T* create(std::string const& name) const
@@ -92,6 +102,13 @@ namespace hpx { namespace serialization { namespace detail
   {                                                                           \
       return Class::hpx_serialization_get_name_impl();                        \
   }                                                                           \
+  virtual std::uint64_t hpx_serialization_get_type_hash() const               \
+  {                                                                           \
+      static std::uint64_t const hash =                                       \
+          hpx::serialization::detail::polymorphic_type_hash(                  \
+              Class::hpx_serialization_get_name_impl());                      \
+      return hash;                                                            \
+  }                                                                           \
 /**/
 
 #define HPX_SERIALIZATION_POLYMORPHIC_WITH_NAME(Class, Name)                  \
@@ -122,6 +139,7 @@ namespace hpx { namespace serialization { namespace detail
 
 #define HPX_SERIALIZATION_POLYMORPHIC_ABSTRACT(Class)                         \
   virtual std::string hpx_serialization_get_name() const = 0;                 \
+  virtual std::uint64_t hpx_serialization_get_type_hash() const = 0;          \
   virtual void load(hpx::serialization::input_archive& ar, unsigned n)        \
   {                                                                           \
       serialize<hpx::serialization::input_archive>(ar, n);                    \
@@ -136,6 +154,7 @@ namespace hpx { namespace serialization { namespace detail
 
 #define HPX_SERIALIZATION_POLYMORPHIC_ABSTRACT_SPLITTED(Class)                \
   virtual std::string hpx_serialization_get_name() const = 0;                 \
+  virtual std::uint64_t hpx_serialization_get_type_hash() const = 0;          \
   virtual void load(hpx::serialization::input_archive& ar, unsigned n)        \
   {                                                                           \
       load<hpx::serialization::input_archive>(ar, n);                         \
@@ -10,6 +10,7 @@
 #define HPX_SERIALIZATION_POLYMORPHIC_NONINTRUSIVE_FACTORY_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_type_hash.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/needs_automatic_registration.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/util/jenkins_hash.hpp>
 #include <hpx/util/static.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -95,10 +97,9 @@ namespace hpx { namespace serialization { namespace detail
         HPX_NON_COPYABLE(polymorphic_nonintrusive_factory);
 
     public:
+        typedef polymorphic_type_map<function_bunch_type> serializer_map_type;
         typedef std::unordered_map<std::string,
-                  function_bunch_type, hpx::util::jenkins_hash> serializer_map_type;
-        typedef std::unordered_map<std::string,
-                  std::string, hpx::util::jenkins_hash> serializer_typeinfo_map_type;
+                  std::uint64_t, hpx::util::jenkins_hash> serializer_typeinfo_map_type;
 
         HPX_EXPORT static polymorphic_nonintrusive_factory& instance();
 
@@ -118,13 +119,10 @@ namespace hpx { namespace serialization { namespace detail
                   , "polymorphic_nonintrusive_factory::register_class"
                   , "Cannot register a factory with an empty name");
             }
-            auto it = map_.find(class_name);
-            auto jt = typeinfo_map_.find(typeinfo.name());
+            std::uint64_t hash = polymorphic_type_hash(class_name);
 
-            if(it == map_.end())
-                map_[class_name] = bunch;
-            if(jt == typeinfo_map_.end())
-                typeinfo_map_[typeinfo.name()] = class_name;
+            map_.insert(hash, class_name, bunch);
+            typeinfo_map_.emplace(typeinfo.name(), hash);
         }
 
         // the following templates are defined in *.ipp file
@@ -144,6 +142,9 @@ namespace hpx { namespace serialization { namespace detail
         {
         }
 
+        HPX_EXPORT function_bunch_type const& get_bunch(
+            std::uint64_t hash) const;
+
         friend struct hpx::util::static_<polymorphic_nonintrusive_factory>;
 
         serializer_map_type map_;
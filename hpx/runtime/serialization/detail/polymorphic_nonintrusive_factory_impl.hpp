@@ -14,6 +14,7 @@
 #include <hpx/runtime/serialization/output_archive.hpp>
 #include <hpx/runtime/serialization/string.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace hpx { namespace serialization { namespace detail
@@ -22,30 +23,28 @@ namespace hpx { namespace serialization { namespace detail
    void polymorphic_nonintrusive_factory::save(output_archive& ar, const T& t)
    {
        // It's safe to call typeid here. The typeid(t) return value is
-       // only used for local lookup to the portable string that goes over the
+       // only used for local lookup to the portable hash that goes over the
        // wire
-       const std::string class_name = typeinfo_map_.at(typeid(t).name());
-       ar << class_name;
+       std::uint64_t hash = typeinfo_map_.at(typeid(t).name());
+       save_polymorphic_type_hash(ar, hash);
 
-       map_.at(class_name).save_function(ar, &t);
+       get_bunch(hash).save_function(ar, &t);
    }
 
    template <class T>
    void polymorphic_nonintrusive_factory::load(input_archive& ar, T& t)
    {
-       std::string class_name;
-       ar >> class_name;
+       std::uint64_t hash = load_polymorphic_type_hash(ar);
 
-       map_.at(class_name).load_function(ar, &t);
+       get_bunch(hash).load_function(ar, &t);
    }
 
    template <class T>
    T* polymorphic_nonintrusive_factory::load(input_archive& ar)
    {
-       std::string class_name;
-       ar >> class_name;
+       std::uint64_t hash = load_polymorphic_type_hash(ar);
 
-       const function_bunch_type& bunch = map_.at(class_name);
+       const function_bunch_type& bunch = get_bunch(hash);
        T* t = static_cast<T*>(bunch.create_function(ar));
 
        return t;
@@ -0,0 +1,183 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_POLYMORPHIC_TYPE_HASH_HPP
+#define HPX_SERIALIZATION_POLYMORPHIC_TYPE_HASH_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace serialization { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Polymorphic objects are identified on the wire by the 64 bit FNV-1a
+    // hash of their registered name instead of the name itself. The hash can
+    // be computed at compile time if the name is a literal. Zero is reserved
+    // to mark unused entries in the lookup tables.
+    HPX_CONSTEXPR inline std::uint64_t polymorphic_type_hash_impl(
+        char const* name, std::uint64_t hash)
+    {
+        return *name == '\0' ? (hash == 0 ? 1 : hash) :
+            polymorphic_type_hash_impl(name + 1,
+                (hash ^ static_cast<unsigned char>(*name)) *
+                    1099511628211ull);
+    }
+
+    HPX_CONSTEXPR inline std::uint64_t polymorphic_type_hash(char const* name)
+    {
+        return polymorphic_type_hash_impl(name, 14695981039346656037ull);
+    }
+
+    inline std::uint64_t polymorphic_type_hash(std::string const& name)
+    {
+        return polymorphic_type_hash(name.c_str());
+    }
+
+    // The hash is stored using a fixed number of bytes independently of
+    // the archive flags (compressing a hash makes it longer).
+    template <typename Archive>
+    void save_polymorphic_type_hash(Archive& ar, std::uint64_t hash)
+    {
+        unsigned char bytes[sizeof(std::uint64_t)];
+        for (std::size_t i = 0; i != sizeof(std::uint64_t); ++i)
+            bytes[i] = static_cast<unsigned char>(hash >> (8 * i));
+        save_binary(ar, bytes, sizeof(bytes));
+    }
+
+    template <typename Archive>
+    std::uint64_t load_polymorphic_type_hash(Archive& ar)
+    {
+        unsigned char bytes[sizeof(std::uint64_t)];
+        load_binary(ar, bytes, sizeof(bytes));
+
+        std::uint64_t hash = 0;
+        for (std::size_t i = 0; i != sizeof(std::uint64_t); ++i)
+            hash |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        return hash;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Open addressing hash table mapping type hashes to the registered
+    // factory data. Entries are added during static initialization only,
+    // lookups do not need any synchronization.
+    template <typename T>
+    class polymorphic_type_map
+    {
+        struct entry
+        {
+            entry() : hash_(0), value_() {}
+
+            std::uint64_t hash_;
+            T value_;
+        };
+
+    public:
+        polymorphic_type_map()
+          : size_(0)
+        {}
+
+        // Add a new entry, returns false if the name was registered before.
+        // Throws if a different name maps onto the same hash.
+        bool insert(std::uint64_t hash, std::string const& name, T const& value)
+        {
+            HPX_ASSERT(hash != 0);
+
+            std::size_t pos = 0;
+            if (find_pos(hash, pos))
+            {
+                if (names_[pos] != name)
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "polymorphic_type_map::insert",
+                        "type hash collision between '" + names_[pos] +
+                        "' and '" + name + "'");
+                }
+                return false;
+            }
+
+            if (2 * (size_ + 1) > entries_.size())
+            {
+                grow();
+                find_pos(hash, pos);
+            }
+
+            entries_[pos].hash_ = hash;
+            entries_[pos].value_ = value;
+            names_[pos] = name;
+            ++size_;
+            return true;
+        }
+
+        T const* find(std::uint64_t hash) const
+        {
+            std::size_t pos = 0;
+            if (!find_pos(hash, pos))
+                return nullptr;
+            return &entries_[pos].value_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        // returns whether the hash was found, pos refers to the matching or
+        // the first free entry
+        bool find_pos(std::uint64_t hash, std::size_t& pos) const
+        {
+            if (entries_.empty())
+                return false;
+
+            std::size_t const mask = entries_.size() - 1;
+            for (pos = static_cast<std::size_t>(hash) & mask; /**/;
+                 pos = (pos + 1) & mask)
+            {
+                if (entries_[pos].hash_ == hash)
+                    return true;
+                if (entries_[pos].hash_ == 0)
+                    return false;
+            }
+        }
+
+        void grow()
+        {
+            std::vector<entry> entries(
+                entries_.empty() ? 64 : 2 * entries_.size());
+            std::vector<std::string> names(entries.size());
+
+            std::size_t const mask = entries.size() - 1;
+            for (std::size_t i = 0; i != entries_.size(); ++i)
+            {
+                if (entries_[i].hash_ == 0)
+                    continue;
+
+                std::size_t pos = static_cast<std::size_t>(entries_[i].hash_);
+                for (pos &= mask; entries[pos].hash_ != 0; pos = (pos + 1) & mask)
+                    /**/;
+
+                entries[pos] = std::move(entries_[i]);
+                names[pos] = std::move(names_[i]);
+            }
+
+            entries_ = std::move(entries);
+            names_ = std::move(names);
+        }
+
+        std::vector<entry> entries_;
+        std::vector<std::string> names_;    // used for collision detection only
+        std::size_t size_;
+    };
+}}}
+
+#endif
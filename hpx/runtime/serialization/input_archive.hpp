@@ -14,6 +14,7 @@
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/raw_ptr.hpp>
 #include <hpx/runtime/serialization/input_container.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/traits/is_bitwise_serializable.hpp>
 
 #include <boost/cstdint.hpp>
@@ -42,24 +43,25 @@ namespace hpx { namespace serialization
         template <typename Container>
         input_archive(Container & buffer,
                 std::size_t inbound_data_size = 0,
-                const std::vector<serialization_chunk>* chunks = nullptr)
+                const std::vector<serialization_chunk>* chunks = nullptr,
+                adoptable_chunks* adoptable = nullptr)
           : base_type(0U)
-          , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
+          , buffer_(new input_container<Container>(
+                buffer, chunks, inbound_data_size, adoptable))
         {
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
-
-            // FIXME: make bool once integer compression is implemented
-            std::uint64_t endianess = 0ul;
+            bool endianess = false;
             load(endianess);
             if (endianess)
                 this->base_type::flags_ = hpx::serialization::endian_big;
 
             // load flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            std::uint32_t flags = 0;
-            load(flags);
-            this->base_type::flags_ = flags;
+            // the same assumptions about the archive format, the flags are
+            // never compressed as they tell whether integers are compressed
+            std::uint64_t flags = 0;
+            load_integral_impl(flags);
+            this->base_type::flags_ = static_cast<std::uint32_t>(flags);
 
             bool has_filter = false;
             load(has_filter);
@@ -130,6 +132,31 @@ namespace hpx { namespace serialization
             return basic_archive<input_archive>::current_pos();
         }
 
+        // Try to take over the memory of the next zero-copy chunk (holding
+        // count bytes) instead of loading it using load_binary_chunk. On
+        // success, this returns the address of the chunk data and an object
+        // keeping that memory alive.
+        std::shared_ptr<void> adopt_binary_chunk(void*& address,
+            std::size_t count)
+        {
+#ifdef BOOST_BIG_ENDIAN
+            bool archive_endianess_differs = endian_little();
+#else
+            bool archive_endianess_differs = endian_big();
+#endif
+            if (0 == count || disable_data_chunking() ||
+                disable_array_optimization() || archive_endianess_differs)
+            {
+                return std::shared_ptr<void>();
+            }
+
+            std::shared_ptr<void> owner =
+                buffer_->adopt_binary_chunk(address, count);
+            if (owner)
+                size_ += count;
+            return owner;
+        }
+
     private:
         friend struct basic_archive<input_archive>;
         template <class T>
@@ -173,7 +200,10 @@ namespace hpx { namespace serialization
         void load_integral(T & val, std::false_type)
         {
             std::int64_t l;
-            load_integral_impl(l);
+            if (enable_integer_compression())
+                l = detail::zigzag_decode(load_varint());
+            else
+                load_integral_impl(l);
             val = static_cast<T>(l);
         }
 
@@ -181,7 +211,10 @@ namespace hpx { namespace serialization
         void load_integral(T & val, std::true_type)
         {
             std::uint64_t ul;
-            load_integral_impl(ul);
+            if (enable_integer_compression())
+                ul = load_varint();
+            else
+                load_integral_impl(ul);
             val = static_cast<T>(ul);
         }
 
@@ -236,6 +269,27 @@ namespace hpx { namespace serialization
 #endif
         }
 
+        // Load a value stored as a sequence of 7 bit groups (LEB128), see
+        // output_archive::save_varint.
+        std::uint64_t load_varint()
+        {
+            std::uint64_t val = 0;
+            for (std::size_t i = 0; i != detail::max_varint_size; ++i)
+            {
+                std::uint8_t byte = 0;
+                load_binary(&byte, 1);
+
+                val |= static_cast<std::uint64_t>(byte & 0x7f) << (7 * i);
+                if ((byte & 0x80) == 0)
+                    return val;
+            }
+
+            HPX_THROW_EXCEPTION(serialization_error,
+                "input_archive::load_varint",
+                "malformed variable length integer in archive");
+            return val;
+        }
+
         void load_binary(void * address, std::size_t count)
         {
             if (0 == count) return;
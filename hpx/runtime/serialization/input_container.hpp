@@ -54,16 +54,17 @@ namespace hpx { namespace serialization
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
             chunks_(nullptr), current_chunk_(std::size_t(-1)),
-            current_chunk_size_(0)
+            current_chunk_size_(0), adoptable_(nullptr)
         {}
 
         input_container(Container const& cont,
                 std::vector<serialization_chunk> const* chunks,
-                std::size_t inbound_data_size)
+                std::size_t inbound_data_size,
+                adoptable_chunks* adoptable = nullptr)
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
             chunks_(nullptr), current_chunk_(std::size_t(-1)),
-            current_chunk_size_(0)
+            current_chunk_size_(0), adoptable_(adoptable)
         {
             if (chunks && chunks->size() != 0)
             {
@@ -155,14 +156,42 @@ namespace hpx { namespace serialization
                     return;
                 }
 
-                // unfortunately we can't implement a zero copy policy on
-                // the receiving end
-                // as the memory was already allocated by the serialization code
+                // the memory was already allocated by the serialization code,
+                // see adopt_binary_chunk for avoiding this copy
                 std::memcpy(address, get_chunk_data(current_chunk_).pos_, count);
                 ++current_chunk_;
             }
         }
 
+        // Try to take over the memory of the next chunk instead of copying
+        // it, this is possible only if the chunk was received separately and
+        // the parcelport allows for its memory to be adopted.
+        std::shared_ptr<void> adopt_binary_chunk(void*& address,
+            std::size_t count) // override
+        {
+            if (adoptable_ == nullptr || chunks_ == nullptr ||
+                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD ||
+                filter_)
+            {
+                return std::shared_ptr<void>();
+            }
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            if (get_chunk_type(current_chunk_) != chunk_type_pointer ||
+                get_chunk_size(current_chunk_) != count)
+            {
+                return std::shared_ptr<void>();
+            }
+
+            std::shared_ptr<void> owner = adoptable_->adopt(current_chunk_);
+            if (owner)
+            {
+                address = get_chunk_data(current_chunk_).pos_;
+                ++current_chunk_;
+            }
+            return owner;
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
@@ -171,6 +200,8 @@ namespace hpx { namespace serialization
         std::vector<serialization_chunk> const* chunks_;
         std::size_t current_chunk_;
         std::size_t current_chunk_size_;
+
+        adoptable_chunks* adoptable_;
     };
 }}
 
@@ -125,14 +125,13 @@ namespace hpx { namespace serialization
         {
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
-
-            // FIXME: make bool once integer compression is implemented
-            std::uint64_t endianess = this->base_type::endian_big() ? ~0ul : 0ul;
+            bool endianess = this->base_type::endian_big();
             save(endianess);
 
             // send flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            save(this->flags_);
+            // the same assumptions about the archive format, the flags are
+            // never compressed as they tell whether integers are compressed
+            save_integral_impl(static_cast<std::uint64_t>(this->flags_));
 
             bool has_filter = filter != nullptr;
             save(has_filter);
@@ -288,13 +287,19 @@ namespace hpx { namespace serialization
         template <typename T>
         void save_integral(T val, std::false_type)
         {
-            save_integral_impl(static_cast<std::int64_t>(val));
+            if (enable_integer_compression())
+                save_varint(detail::zigzag_encode(static_cast<std::int64_t>(val)));
+            else
+                save_integral_impl(static_cast<std::int64_t>(val));
         }
 
         template <typename T>
         void save_integral(T val, std::true_type)
         {
-            save_integral_impl(static_cast<std::uint64_t>(val));
+            if (enable_integer_compression())
+                save_varint(static_cast<std::uint64_t>(val));
+            else
+                save_integral_impl(static_cast<std::uint64_t>(val));
         }
 
 #if defined(BOOST_HAS_INT128) && !defined(__NVCC__) && \
@@ -349,6 +354,22 @@ namespace hpx { namespace serialization
             save_binary(cptr, size);
         }
 
+        // Store the value as a sequence of 7 bit groups (LEB128), least
+        // significant group first, the high bit marks all but the last byte.
+        void save_varint(std::uint64_t val)
+        {
+            std::uint8_t bytes[detail::max_varint_size];
+            std::size_t size = 0;
+            while (val >= 0x80)
+            {
+                bytes[size++] = static_cast<std::uint8_t>(val | 0x80);
+                val >>= 7;
+            }
+            bytes[size++] = static_cast<std::uint8_t>(val);
+
+            save_binary(bytes, size);
+        }
+
         void save_binary(void const * address, std::size_t count)
         {
             if(count == 0) return;
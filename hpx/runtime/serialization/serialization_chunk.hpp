@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 
 #if CHAR_BIT != 8
 #  error This code assumes an eight-bit byte.
@@ -63,6 +64,19 @@ namespace hpx { namespace serialization
         return retval;
     }
 
+    ///////////////////////////////////////////////////////////////////////
+    // A receiving parcelport may allow for the de-serialized objects to take
+    // over the memory of received (pointer) chunks instead of copying it.
+    struct adoptable_chunks
+    {
+        virtual ~adoptable_chunks() {}
+
+        // Transfer the ownership of the memory referenced by the given chunk,
+        // the returned object keeps that memory alive. Returns an empty
+        // pointer if the chunk can't be adopted.
+        virtual std::shared_ptr<void> adopt(std::size_t chunk) = 0;
+    };
+
 }}
 
 #endif
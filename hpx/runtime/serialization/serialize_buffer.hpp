@@ -11,6 +11,7 @@
 #include <hpx/runtime/serialization/array.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/traits/supports_streaming_with_any.hpp>
 #include <hpx/util/bind.hpp>
 
@@ -18,7 +19,11 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hpx { namespace serialization
 {
@@ -37,6 +42,9 @@ namespace hpx { namespace serialization
             dealloc.deallocate(p, size);
         }
 
+        // the memory of adopted chunks is kept alive by the bound owner
+        static void owner_deleter(T*, std::shared_ptr<void> const&) {}
+
     public:
         enum init_mode
         {
@@ -259,6 +267,16 @@ namespace hpx { namespace serialization
             using util::placeholders::_1;
             ar >> size_ >> alloc_; //-V128
 
+            // Buffers using the default allocator can take over the memory
+            // of received chunks, which avoids copying their data.
+            typedef std::integral_constant<bool,
+                    std::is_same<Allocator, std::allocator<T> >::value &&
+                    hpx::traits::is_bitwise_serializable<T>::value
+                > may_adopt;
+
+            if (size_ != 0 && load_adopted(ar, may_adopt()))
+                return;
+
             data_.reset(alloc_.allocate(size_),
                 util::bind(&serialize_buffer::deleter<allocator_type>, _1,
                     alloc_, size_));
@@ -269,6 +287,39 @@ namespace hpx { namespace serialization
             }
         }
 
+        template <typename Archive>
+        bool load_adopted(Archive& ar, std::false_type)
+        {
+            return false;
+        }
+
+        template <typename Archive>
+        bool load_adopted(Archive& ar, std::true_type)
+        {
+            using util::placeholders::_1;
+
+            void* address = nullptr;
+            std::shared_ptr<void> owner =
+                ar.adopt_binary_chunk(address, size_ * sizeof(T));
+            if (!owner)
+                return false;
+
+            if (reinterpret_cast<std::uintptr_t>(address) % alignof(T) != 0)
+            {
+                // the received data is not suitably aligned, copy it
+                data_.reset(alloc_.allocate(size_),
+                    util::bind(&serialize_buffer::deleter<allocator_type>, _1,
+                        alloc_, size_));
+                std::memcpy(data_.get(), address, size_ * sizeof(T));
+                return true;
+            }
+
+            data_.reset(static_cast<T*>(address),
+                util::bind(&serialize_buffer::owner_deleter, _1,
+                    std::move(owner)));
+            return true;
+        }
+
         HPX_SERIALIZATION_SPLIT_MEMBER()
 
         // this is needed for util::any
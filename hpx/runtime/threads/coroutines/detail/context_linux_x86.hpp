@@ -17,6 +17,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/threads/coroutines/detail/get_stack_pointer.hpp>
 #include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/runtime/threads/coroutines/detail/swap_context.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
@@ -207,7 +208,12 @@ namespace hpx { namespace threads { namespace coroutines
                             m_stack_size));
                 }
 
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+                m_stack = posix::alloc_pooled_stack(
+                    static_cast<std::size_t>(m_stack_size));
+#else
                 m_stack = posix::alloc_stack(static_cast<std::size_t>(m_stack_size));
+#endif
                 HPX_ASSERT(m_stack);
                 posix::watermark_stack(m_stack, static_cast<std::size_t>(m_stack_size));
 
@@ -275,7 +281,12 @@ namespace hpx { namespace threads { namespace coroutines
                     VALGRIND_STACK_DEREGISTER(
                         reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
 #endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+                    posix::free_pooled_stack(
+                        m_stack, static_cast<std::size_t>(m_stack_size));
+#else
                     posix::free_stack(m_stack, static_cast<std::size_t>(m_stack_size));
+#endif
                 }
             }
 
@@ -43,30 +43,17 @@
 
 namespace hpx { namespace threads { namespace coroutines { namespace detail
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // The coroutine_self is the interface exposed to the code running inside
+    // of a HPX thread (see threads::get_self()). It is implemented for
+    // threads running on their own stack (coroutine_stackful_self below) and
+    // for stackless threads running directly on the stack of the scheduling
+    // worker thread (see coroutine_stackless_self).
     class coroutine_self
     {
     public:
         HPX_NON_COPYABLE(coroutine_self);
 
-    private:
-        // store the current this and write it to the TSS on exit
-        struct reset_self_on_exit
-        {
-            reset_self_on_exit(coroutine_self* self)
-              : self_(self)
-            {
-                set_self(self->next_self_);
-            }
-
-            ~reset_self_on_exit()
-            {
-                set_self(self_);
-            }
-
-            coroutine_self* self_;
-        };
-
-    public:
         friend struct detail::coroutine_accessor;
 
         typedef coroutine_impl impl_type;
@@ -86,19 +73,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
                 yield_impl(std::move(arg));
         }
 
-        arg_type yield_impl(result_type arg)
-        {
-            HPX_ASSERT(m_pimpl);
-
-            this->m_pimpl->bind_result(&arg);
-
-            {
-                reset_self_on_exit on_exit(this);
-                this->m_pimpl->yield();
-            }
-
-            return *m_pimpl->args();
-        }
+        virtual arg_type yield_impl(result_type arg) = 0;
 
         template <typename F>
         yield_decorator_type decorate_yield(F && f)
@@ -128,25 +103,122 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             return tmp;
         }
 
-        HPX_ATTRIBUTE_NORETURN void exit()
+        HPX_ATTRIBUTE_NORETURN virtual void exit() = 0;
+
+        virtual bool pending() const = 0;
+
+        // stackless threads can't give up their worker thread, code which
+        // needs to back off has to block the OS thread instead
+        virtual bool is_stackless() const = 0;
+
+        virtual thread_id_repr_type get_thread_id() const = 0;
+
+        virtual std::size_t get_thread_phase() const = 0;
+
+        virtual std::ptrdiff_t get_available_stack_space() = 0;
+
+        virtual std::size_t get_thread_data() const = 0;
+        virtual std::size_t set_thread_data(std::size_t data) = 0;
+
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        virtual tss_storage* get_thread_tss_data() = 0;
+        virtual tss_storage* get_or_create_thread_tss_data() = 0;
+#endif
+
+        virtual std::size_t& get_continuation_recursion_count() = 0;
+
+#if defined(HPX_HAVE_APEX)
+        virtual void** get_apex_data() const = 0;
+#endif
+
+    public:
+        static HPX_EXPORT void set_self(coroutine_self* self);
+        static HPX_EXPORT coroutine_self* get_self();
+        static HPX_EXPORT void init_self();
+        static HPX_EXPORT void reset_self();
+
+    protected:
+        explicit coroutine_self(coroutine_self* next_self)
+          : next_self_(next_self)
+        {}
+
+        virtual ~coroutine_self() {}
+
+        // returns nullptr for threads not running on their own stack
+        virtual impl_ptr get_impl()
+        {
+            return nullptr;
+        }
+
+        yield_decorator_type yield_decorator_;
+        coroutine_self* next_self_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    class coroutine_stackful_self : public coroutine_self
+    {
+    private:
+        // store the current this and write it to the TSS on exit
+        struct reset_self_on_exit
+        {
+            reset_self_on_exit(coroutine_stackful_self* self)
+              : self_(self)
+            {
+                set_self(self->next_self_);
+            }
+
+            ~reset_self_on_exit()
+            {
+                set_self(self_);
+            }
+
+            coroutine_stackful_self* self_;
+        };
+
+    public:
+        explicit coroutine_stackful_self(impl_type * pimpl,
+                coroutine_self* next_self = nullptr)
+          : coroutine_self(next_self), m_pimpl(pimpl)
+        {}
+
+        arg_type yield_impl(result_type arg) override
+        {
+            HPX_ASSERT(m_pimpl);
+
+            this->m_pimpl->bind_result(&arg);
+
+            {
+                reset_self_on_exit on_exit(this);
+                this->m_pimpl->yield();
+            }
+
+            return *m_pimpl->args();
+        }
+
+        HPX_ATTRIBUTE_NORETURN void exit() override
         {
             m_pimpl->exit_self();
             std::terminate(); // FIXME: replace with hpx::terminate();
         }
 
-        bool pending() const
+        bool pending() const override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->pending() != 0;
         }
 
-        thread_id_repr_type get_thread_id() const
+        bool is_stackless() const override
+        {
+            return false;
+        }
+
+        thread_id_repr_type get_thread_id() const override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_id();
         }
 
-        std::size_t get_thread_phase() const
+        std::size_t get_thread_phase() const override
         {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
             HPX_ASSERT(m_pimpl);
@@ -156,7 +228,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
         }
 
-        std::ptrdiff_t get_available_stack_space()
+        std::ptrdiff_t get_available_stack_space() override
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
             return m_pimpl->get_available_stack_space();
@@ -165,50 +237,39 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
         }
 
-        explicit coroutine_self(impl_type * pimpl,
-                coroutine_self* next_self = nullptr)
-          : m_pimpl(pimpl), next_self_(next_self)
-        {}
-
-        std::size_t get_thread_data() const
+        std::size_t get_thread_data() const override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_data();
         }
-        std::size_t set_thread_data(std::size_t data)
+        std::size_t set_thread_data(std::size_t data) override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->set_thread_data(data);
         }
 
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-        tss_storage* get_thread_tss_data()
+        tss_storage* get_thread_tss_data() override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_tss_data(false);
         }
 
-        tss_storage* get_or_create_thread_tss_data()
+        tss_storage* get_or_create_thread_tss_data() override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_tss_data(true);
         }
 #endif
 
-        std::size_t& get_continuation_recursion_count()
+        std::size_t& get_continuation_recursion_count() override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_continuation_recursion_count();
         }
 
-    public:
-        static HPX_EXPORT void set_self(coroutine_self* self);
-        static HPX_EXPORT coroutine_self* get_self();
-        static HPX_EXPORT void init_self();
-        static HPX_EXPORT void reset_self();
-
 #if defined(HPX_HAVE_APEX)
-        void** get_apex_data() const
+        void** get_apex_data() const override
         {
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_apex_data();
@@ -216,14 +277,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
 
     private:
-        yield_decorator_type yield_decorator_;
-
-        impl_ptr get_impl()
+        impl_ptr get_impl() override
         {
             return m_pimpl;
         }
+
         impl_ptr m_pimpl;
-        coroutine_self* next_self_;
     };
 }}}}
 
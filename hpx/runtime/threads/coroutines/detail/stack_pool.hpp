@@ -0,0 +1,88 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_SEP_20_2017_0915AM)
+#define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_SEP_20_2017_0915AM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+// The stack pool hands out coroutine stacks carved from large pre-mapped
+// slabs. Each stack is preceded by its own guard page (if enabled), the
+// memory is committed lazily by the kernel on first touch. Released stacks
+// are kept in per NUMA-domain free lists (one for each of the configured
+// stack size classes). Stacks exceeding the configured number of idle stacks
+// are handed back to the operating system using madvise(MADV_DONTNEED) while
+// keeping their address range reserved.
+//
+// Stacks of a size which does not correspond to any of the configured size
+// classes are allocated and freed using posix::alloc_stack/free_stack.
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    enum stack_size_class
+    {
+        stack_size_class_small = 0,
+        stack_size_class_medium = 1,
+        stack_size_class_large = 2,
+        stack_size_class_huge = 3,
+        num_stack_size_classes = 4
+    };
+
+    struct stack_pool_parameters
+    {
+        stack_pool_parameters()
+          : enabled_(true), use_huge_pages_(false),
+            slab_size_(0x1000000), max_idle_stacks_(256)
+        {
+            for (std::size_t i = 0; i != num_stack_size_classes; ++i)
+                stack_sizes_[i] = 0;
+        }
+
+        bool enabled_;                  // use the pool at all
+        bool use_huge_pages_;           // advise the kernel to back slabs
+                                        // with transparent huge pages
+        std::size_t slab_size_;         // size of address range mapped at once
+        std::size_t max_idle_stacks_;   // committed idle stacks per size class
+                                        // and NUMA domain
+        std::size_t stack_sizes_[num_stack_size_classes];
+    };
+
+    // Set the parameters of the stack pool, this has to be called before
+    // the first HPX thread is created.
+    HPX_EXPORT void configure_stack_pool(stack_pool_parameters const& params);
+
+    HPX_EXPORT void* alloc_pooled_stack(std::size_t size);
+    HPX_EXPORT void free_pooled_stack(void* stack, std::size_t size);
+
+    // Performance counter support: number of stacks currently handed out by
+    // and currently available from the pool (the reset flag is ignored)
+    HPX_EXPORT std::int64_t get_stack_pool_in_use_count(
+        std::size_t size_class, bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_in_use_count_all(bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_free_count(
+        std::size_t size_class, bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_free_count_all(bool reset);
+
+    // Performance counter support: maximal number of stacks handed out by
+    // and minimal number of stacks available from the pool at the same time
+    // since the last reset
+    HPX_EXPORT std::int64_t get_stack_pool_max_in_use_count(
+        std::size_t size_class, bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_max_in_use_count_all(bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_min_free_count(
+        std::size_t size_class, bool reset);
+    HPX_EXPORT std::int64_t get_stack_pool_min_free_count_all(bool reset);
+}
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,368 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP
+#define HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/coroutine_fwd.hpp>
+#include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
+#include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
+#include <hpx/runtime/threads/coroutines/detail/tss.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#if defined(HPX_WINDOWS)
+#include <windows.h>
+#elif defined(BOOST_HAS_PTHREADS)
+#include <sched.h>
+#endif
+
+namespace hpx { namespace threads { namespace coroutines
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A stackless_coroutine executes its function directly on the stack of
+    // the invoking (scheduling) thread, thus it does not own any stack memory
+    // and invoking it does not require a context switch. The function is
+    // required to run to completion: yielding backs off by yielding the
+    // worker's OS thread, any attempt to suspend it (including timed
+    // suspension) is reported as an error.
+    class stackless_coroutine
+    {
+    private:
+        enum context_state
+        {
+            ctx_running,  // context running
+            ctx_ready     // context at yield point (or not started yet)
+        };
+
+        // make sure the thread's self is reset whenever we leave
+        struct reset_self_on_exit
+        {
+            reset_self_on_exit(detail::coroutine_self* val,
+                    detail::coroutine_self* old_val)
+              : old_self(old_val)
+            {
+                detail::coroutine_self::set_self(val);
+            }
+
+            ~reset_self_on_exit()
+            {
+                detail::coroutine_self::set_self(old_self);
+            }
+
+            detail::coroutine_self* old_self;
+        };
+
+    public:
+        HPX_NON_COPYABLE(stackless_coroutine);
+
+        typedef detail::coroutine_impl::thread_id_repr_type thread_id_repr_type;
+        typedef detail::coroutine_impl::result_type result_type;
+        typedef detail::coroutine_impl::arg_type arg_type;
+
+        typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
+
+        stackless_coroutine(functor_type&& f = functor_type(),
+                thread_id_repr_type id = nullptr)
+          : f_(std::move(f)),
+            state_(ctx_ready),
+            id_(id),
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+            phase_(0),
+#endif
+#if defined(HPX_HAVE_APEX)
+            apex_data_(nullptr),
+#endif
+            thread_data_(0),
+            continuation_recursion_count_(0)
+        {}
+
+        ~stackless_coroutine()
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            detail::delete_tss_storage(thread_data_);
+#else
+            thread_data_ = 0;
+#endif
+        }
+
+        thread_id_repr_type get_thread_id() const
+        {
+            return id_;
+        }
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        std::size_t get_thread_phase() const
+        {
+            return phase_;
+        }
+#endif
+
+        std::size_t get_thread_data() const
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            if (!thread_data_)
+                return 0;
+            return detail::get_tss_thread_data(thread_data_);
+#else
+            return thread_data_;
+#endif
+        }
+
+        std::size_t set_thread_data(std::size_t data)
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            return detail::set_tss_thread_data(thread_data_, data);
+#else
+            std::size_t olddata = thread_data_;
+            thread_data_ = data;
+            return olddata;
+#endif
+        }
+
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        detail::tss_storage* get_thread_tss_data(bool create_if_needed) const
+        {
+            if (!thread_data_ && create_if_needed)
+                thread_data_ = detail::create_tss_storage();
+            return thread_data_;
+        }
+#endif
+
+        std::size_t& get_continuation_recursion_count()
+        {
+            return continuation_recursion_count_;
+        }
+
+#if defined(HPX_HAVE_APEX)
+        void** get_apex_data() const
+        {
+            return const_cast<void**>(&apex_data_);
+        }
+#endif
+
+        void rebind(functor_type && f, thread_id_repr_type id)
+        {
+            HPX_ASSERT(is_ready());
+
+            f_ = std::move(f);
+            id_ = id;
+        }
+
+        void reset()
+        {
+            f_.reset();
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+            phase_ = 0;
+#endif
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            detail::delete_tss_storage(thread_data_);
+#else
+            thread_data_ = 0;
+#endif
+#if defined(HPX_HAVE_APEX)
+            apex_data_ = nullptr;
+#endif
+            continuation_recursion_count_ = 0;
+        }
+
+        inline result_type operator()(arg_type arg = arg_type());
+
+        bool is_ready() const
+        {
+            return state_ == ctx_ready;
+        }
+
+        bool running() const
+        {
+            return state_ == ctx_running;
+        }
+
+    private:
+        functor_type f_;
+        context_state state_;
+        thread_id_repr_type id_;
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        std::size_t phase_;
+#endif
+#if defined(HPX_HAVE_APEX)
+        void* apex_data_;
+#endif
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        mutable detail::tss_storage* thread_data_;
+#else
+        mutable std::size_t thread_data_;
+#endif
+        std::size_t continuation_recursion_count_;
+    };
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        class coroutine_stackless_self : public coroutine_self
+        {
+        public:
+            explicit coroutine_stackless_self(stackless_coroutine* pimpl,
+                    coroutine_self* next_self = nullptr)
+              : coroutine_self(next_self), m_pimpl(pimpl)
+            {}
+
+            // A stackless thread can't give up its worker thread. Yielding
+            // (as done by this_thread::yield) backs off by yielding the OS
+            // thread instead, which gives other OS threads (e.g. the holder
+            // of a contended lock) a chance to make progress. Any suspension
+            // which relies on being woken up by somebody else is an error.
+            arg_type yield_impl(result_type arg) override
+            {
+                if (arg.first == threads::pending ||
+                    arg.first == threads::pending_boost)
+                {
+#if defined(HPX_WINDOWS)
+                    Sleep(0);
+#elif defined(BOOST_HAS_PTHREADS)
+                    sched_yield();
+#endif
+                    return wait_signaled;
+                }
+
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "coroutine_stackless_self::yield_impl",
+                    "attempting to suspend a stackless HPX thread, threads "
+                    "which may suspend have to be created with a stack (see "
+                    "threads::thread_stacksize)");
+                return wait_unknown;
+            }
+
+            HPX_ATTRIBUTE_NORETURN void exit() override
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "coroutine_stackless_self::exit",
+                    "stackless HPX threads can't be exited, they always run "
+                    "to completion");
+            }
+
+            bool pending() const override
+            {
+                return false;
+            }
+
+            bool is_stackless() const override
+            {
+                return true;
+            }
+
+            thread_id_repr_type get_thread_id() const override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_thread_id();
+            }
+
+            std::size_t get_thread_phase() const override
+            {
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_thread_phase();
+#else
+                return 0;
+#endif
+            }
+
+            // stackless threads run on the (large) stack of the OS thread
+            std::ptrdiff_t get_available_stack_space() override
+            {
+                return (std::numeric_limits<std::ptrdiff_t>::max)();
+            }
+
+            std::size_t get_thread_data() const override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_thread_data();
+            }
+            std::size_t set_thread_data(std::size_t data) override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->set_thread_data(data);
+            }
+
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            tss_storage* get_thread_tss_data() override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_thread_tss_data(false);
+            }
+
+            tss_storage* get_or_create_thread_tss_data() override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_thread_tss_data(true);
+            }
+#endif
+
+            std::size_t& get_continuation_recursion_count() override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_continuation_recursion_count();
+            }
+
+#if defined(HPX_HAVE_APEX)
+            void** get_apex_data() const override
+            {
+                HPX_ASSERT(m_pimpl);
+                return m_pimpl->get_apex_data();
+            }
+#endif
+
+        private:
+            stackless_coroutine* m_pimpl;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    stackless_coroutine::result_type stackless_coroutine::operator()(
+        arg_type arg)
+    {
+        HPX_ASSERT(is_ready());
+
+        result_type result(thread_state_enum::unknown, nullptr);
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        ++phase_;
+#endif
+
+        {
+            detail::coroutine_self* old_self = detail::coroutine_self::get_self();
+            detail::coroutine_stackless_self self(this, old_self);
+            reset_self_on_exit on_exit(&self, old_self);
+
+            state_ = ctx_running;
+            try {
+                result = f_(arg);
+            }
+            catch (...) {
+                state_ = ctx_ready;
+                reset();
+                throw;
+            }
+            state_ = ctx_ready;
+        }
+
+        // if this thread returned 'terminated' we need to reset the functor
+        // and the bound arguments
+        if (result.first == terminated)
+            reset();
+
+        return result;
+    }
+}}}
+
+#endif /*HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP*/
@@ -18,6 +18,7 @@
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/itt_notify.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/thread_trace.hpp>
 
 #include <boost/atomic.hpp>
 
@@ -511,6 +512,17 @@ namespace hpx { namespace threads { namespace detail
                                 // and add to aggregate execution time.
                                 exec_time_wrapper exec_time_collector(idle_rate);
 
+#if defined(HPX_HAVE_THREAD_TRACE)
+                                // retrieving the description acquires the
+                                // thread's lock, avoid this if not tracing
+                                if (util::thread_trace::is_enabled())
+                                {
+                                    util::thread_trace::record(
+                                        util::thread_trace::thread_run, thrd,
+                                        thrd->get_description(),
+                                        thrd->get_thread_phase());
+                                }
+#endif
 #if defined(HPX_HAVE_APEX)
                                 // get the APEX data pointer, in case we are resuming the
                                 // thread and have to restore any leaf timers from
@@ -534,6 +546,13 @@ namespace hpx { namespace threads { namespace detail
                                 }
 #else
                                 thrd_stat = (*thrd)();
+#endif
+#if defined(HPX_HAVE_THREAD_TRACE)
+                                util::thread_trace::record(
+                                    thrd_stat.get_previous() == terminated ?
+                                        util::thread_trace::thread_terminate :
+                                        util::thread_trace::thread_suspend,
+                                    thrd);
 #endif
                             }
 
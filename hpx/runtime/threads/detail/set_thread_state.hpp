@@ -142,7 +142,9 @@ namespace hpx { namespace threads { namespace detail
                         util::bind(&set_active_state,
                             thrd, new_state, new_state_ex,
                             priority, previous_state),
-                        "set state for active thread", 0, priority);
+                        "set state for active thread", 0, priority,
+                        std::size_t(-1),
+                        get_stack_size(thread_stacksize_nostack));
 
                     create_work(thrd->get_scheduler_base(), data, pending, ec);
 
@@ -300,7 +302,8 @@ namespace hpx { namespace threads { namespace detail
             util::bind(&wake_timer_thread,
                 thrd, newstate, newstate_ex, priority,
                 self_id, triggered),
-            "wake_timer", 0, priority);
+            "wake_timer", 0, priority, std::size_t(-1),
+            get_stack_size(thread_stacksize_nostack));
 
         thread_id_type wake_id = invalid_thread_id;
         create_thread(&scheduler, data, wake_id, suspended);
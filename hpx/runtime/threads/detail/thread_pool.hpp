@@ -130,6 +130,13 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t get_num_stolen_to_staged(std::size_t num, bool reset);
 #endif
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::int64_t get_num_idle_parks(std::size_t num, bool reset);
+        std::int64_t get_num_idle_wakeups(std::size_t num, bool reset);
+        std::int64_t get_num_idle_spurious_wakeups(std::size_t num,
+            bool reset);
+#endif
+
         std::int64_t get_thread_count(thread_state_enum state,
             thread_priority priority, std::size_t num_thread, bool reset) const;
 
@@ -18,6 +18,7 @@
 #include <hpx/runtime/threads_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/thread_trace.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/atomic.hpp>
@@ -125,7 +126,7 @@ namespace hpx { namespace threads { namespace policies
             max_queue_thread_count_(init.max_queue_thread_count_),
             queues_(init.num_queues_),
             high_priority_queues_(init.num_high_priority_queues_),
-            low_priority_queue_(init.max_queue_thread_count_),
+            low_priority_queue_(std::size_t(-1), init.max_queue_thread_count_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_)
         {
@@ -140,13 +141,14 @@ namespace hpx { namespace threads { namespace policies
 #endif
                 BOOST_ASSERT(init.num_queues_ != 0);
                 for (std::size_t i = 0; i < init.num_queues_; ++i)
-                    queues_[i] = new thread_queue_type(init.max_queue_thread_count_);
+                    queues_[i] =
+                        new thread_queue_type(i, init.max_queue_thread_count_);
 
                 BOOST_ASSERT(init.num_high_priority_queues_ != 0);
                 BOOST_ASSERT(init.num_high_priority_queues_ <= init.num_queues_);
                 for (std::size_t i = 0; i < init.num_high_priority_queues_; ++i) {
                     high_priority_queues_[i] =
-                        new thread_queue_type(init.max_queue_thread_count_);
+                        new thread_queue_type(i, init.max_queue_thread_count_);
                 }
 #if defined(HPX_MSVC)
 #pragma warning(pop)
@@ -552,6 +554,11 @@ namespace hpx { namespace threads { namespace policies
                         q->increment_num_stolen_from_pending();
                         this_high_priority_queue->
                             increment_num_stolen_to_pending();
+#if defined(HPX_HAVE_THREAD_TRACE)
+                        util::thread_trace::record(
+                            util::thread_trace::thread_steal, thrd,
+                            nullptr, idx);
+#endif
                         return true;
                     }
                 }
@@ -560,6 +567,10 @@ namespace hpx { namespace threads { namespace policies
                 {
                     queues_[idx]->increment_num_stolen_from_pending();
                     this_queue->increment_num_stolen_to_pending();
+#if defined(HPX_HAVE_THREAD_TRACE)
+                    util::thread_trace::record(
+                        util::thread_trace::thread_steal, thrd, nullptr, idx);
+#endif
                     return true;
                 }
             }
@@ -999,12 +1010,12 @@ namespace hpx { namespace threads { namespace policies
 #pragma warning(disable: 4316) // object allocated on the heap may not be aligned 16
 #endif
                 queues_[num_thread] =
-                    new thread_queue_type(max_queue_thread_count_);
+                    new thread_queue_type(num_thread, max_queue_thread_count_);
 
                 if (num_thread < high_priority_queues_.size())
                 {
-                    high_priority_queues_[num_thread] =
-                        new thread_queue_type(max_queue_thread_count_);
+                    high_priority_queues_[num_thread] = new thread_queue_type(
+                        num_thread, max_queue_thread_count_);
                 }
 #if defined(HPX_MSVC)
 #pragma warning(pop)
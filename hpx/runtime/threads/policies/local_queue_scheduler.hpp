@@ -20,6 +20,7 @@
 #include <hpx/runtime/threads_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/thread_trace.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/atomic.hpp>
@@ -372,6 +373,11 @@ namespace hpx { namespace threads { namespace policies
                         {
                             q->increment_num_stolen_from_pending();
                             queues_[num_thread]->increment_num_stolen_to_pending();
+#if defined(HPX_HAVE_THREAD_TRACE)
+                            util::thread_trace::record(
+                                util::thread_trace::thread_steal, thrd,
+                                nullptr, idx);
+#endif
                             return true;
                         }
                     }
@@ -401,6 +407,11 @@ namespace hpx { namespace threads { namespace policies
                         {
                             q->increment_num_stolen_from_pending();
                             queues_[num_thread]->increment_num_stolen_to_pending();
+#if defined(HPX_HAVE_THREAD_TRACE)
+                            util::thread_trace::record(
+                                util::thread_trace::thread_steal, thrd,
+                                nullptr, idx);
+#endif
                             return true;
                         }
                     }
@@ -422,6 +433,11 @@ namespace hpx { namespace threads { namespace policies
                     {
                         q->increment_num_stolen_from_pending();
                         queues_[num_thread]->increment_num_stolen_to_pending();
+#if defined(HPX_HAVE_THREAD_TRACE)
+                        util::thread_trace::record(
+                            util::thread_trace::thread_steal, thrd,
+                            nullptr, idx);
+#endif
                         return true;
                     }
                 }
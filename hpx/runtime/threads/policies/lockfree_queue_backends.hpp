@@ -10,18 +10,22 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 #include <hpx/util/lockfree/deque.hpp>
+#include <boost/atomic.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/stack.hpp>
 
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 
 namespace hpx { namespace threads { namespace policies
 {
 
 struct lockfree_fifo;
 struct lockfree_lifo;
+struct lockfree_chase_lev;
 
 ///////////////////////////////////////////////////////////////////////////////
 template <typename T, typename Queuing>
@@ -55,6 +59,8 @@ struct basic_lockfree_queue_backend
         return queue_.empty();
     }
 
+    void on_start_thread(std::size_t /*num_thread*/) {}
+
   private:
     container_type queue_;
 };
@@ -81,6 +87,89 @@ struct lockfree_lifo
     };
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Owner-local LIFO + FIFO stealing from the opposite end, based on the
+// Chase-Lev work-stealing deque.
+//
+// Only the OS thread owning the queue may operate on the bottom end of the
+// deque. The owner is bound in on_start_thread(), which is invoked by the
+// scheduler on the worker thread corresponding to 'num_thread' (queues not
+// associated with a particular worker thread are created with
+// num_thread == -1 and never have an owner). Items pushed by any other thread
+// are routed through a separate (multi-producer) inbox queue.
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : queue_(std::size_t(initial_size))
+      , inbox_(std::size_t(initial_size))
+      , num_thread_(num_thread)
+      , owner_(std::thread::id())
+    {}
+
+    bool push(const_reference val, bool /*other_end*/ = false)
+    {
+        if (is_owner())
+            return queue_.push(val);
+        return inbox_.push(val);
+    }
+
+    bool pop(reference val, bool /*steal*/ = true)
+    {
+        if (is_owner())
+        {
+            if (queue_.pop(val))
+                return true;
+        }
+        else if (queue_.steal(val))
+        {
+            return true;
+        }
+        return inbox_.pop(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && inbox_.empty();
+    }
+
+    void on_start_thread(std::size_t num_thread)
+    {
+        if (num_thread_ == num_thread)
+            owner_.store(std::this_thread::get_id(), boost::memory_order_release);
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(boost::memory_order_relaxed) ==
+            std::this_thread::get_id();
+    }
+
+    container_type queue_;
+    boost::lockfree::queue<T> inbox_;
+    size_type num_thread_;
+    boost::atomic<std::thread::id> owner_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type;
+    };
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // FIFO + stealing at opposite end.
 #if defined(HPX_HAVE_ABP_SCHEDULER)
@@ -120,6 +209,8 @@ struct lockfree_abp_fifo_backend
         return queue_.empty();
     }
 
+    void on_start_thread(std::size_t /*num_thread*/) {}
+
   private:
     container_type queue_;
 };
@@ -172,6 +263,8 @@ struct lockfree_abp_lifo_backend
         return queue_.empty();
     }
 
+    void on_start_thread(std::size_t /*num_thread*/) {}
+
   private:
     container_type queue_;
 };
@@ -0,0 +1,167 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_PARKING_LOT_OCT_17_2017_0405PM)
+#define HPX_RUNTIME_THREADS_POLICIES_PARKING_LOT_OCT_17_2017_0405PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#if !defined(__linux) && !defined(linux) && !defined(__linux__)
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#endif
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The parking_lot allows idle worker threads to block until new work is
+    /// available. Every worker parks on its own slot, which makes it possible
+    /// to wake up exactly one worker, preferably the one closest to the queue
+    /// which has received new work, instead of waking all idle workers.
+    ///
+    /// On Linux the workers block on a futex directly, on other platforms
+    /// every slot has its own mutex and condition variable.
+    class HPX_EXPORT parking_lot
+    {
+    public:
+        HPX_NON_COPYABLE(parking_lot);
+
+    public:
+        explicit parking_lot(std::size_t num_threads);
+        ~parking_lot();
+
+        std::size_t size() const
+        {
+            return num_threads_;
+        }
+
+        // Associate a worker with the core and NUMA domain it runs on, this
+        // is used to select the parked worker closest to a given one.
+        void set_location(std::size_t num_thread, std::size_t core,
+            std::size_t domain);
+
+        // Block the given worker until it is unparked or its timeout has
+        // expired. The predicate is polled for a while before the worker
+        // blocks and once more after it has been published as parked, which
+        // ensures that no wakeup gets lost. Returns whether the worker was
+        // woken up explicitly.
+        template <typename F>
+        bool park(std::size_t num_thread, F && has_work)
+        {
+            HPX_ASSERT(num_thread < num_threads_);
+
+            for (std::size_t k = 0; k != spin_count_; ++k)
+            {
+                if (has_work())
+                {
+                    reset_backoff(num_thread);
+                    return false;
+                }
+                pause();
+            }
+
+            prepare_park(num_thread);
+            if (has_work())
+            {
+                cancel_park(num_thread);
+                return false;
+            }
+            return wait(num_thread);
+        }
+
+        // Wake up the given worker if it is parked.
+        bool unpark(std::size_t num_thread);
+
+        // Wake up the given worker if it is parked, otherwise the parked
+        // worker closest to it (same core, then same NUMA domain, then any
+        // other). If num_thread is not a valid worker number the calling
+        // worker is used as the reference, if any.
+        bool unpark_near(std::size_t num_thread);
+
+        // Wake up all parked workers.
+        void unpark_all();
+
+        std::size_t num_parked() const
+        {
+            return num_parked_.load(boost::memory_order_relaxed);
+        }
+
+        // performance counter data
+        std::int64_t get_num_parks(std::size_t num_thread, bool reset);
+        std::int64_t get_num_wakeups(std::size_t num_thread, bool reset);
+        std::int64_t get_num_spurious_wakeups(std::size_t num_thread,
+            bool reset);
+
+    protected:
+        static void pause();
+
+        void reset_backoff(std::size_t num_thread);
+        void prepare_park(std::size_t num_thread);
+        void cancel_park(std::size_t num_thread);
+        bool wait(std::size_t num_thread);
+
+    private:
+        enum slot_state
+        {
+            active = 0,
+            parked = 1,
+            notified = 2
+        };
+
+        struct slot
+        {
+            slot();
+
+            // this is the word the worker waits on
+            boost::atomic<std::uint32_t> state_;
+
+            boost::atomic<std::size_t> core_;
+            boost::atomic<std::size_t> domain_;
+
+            // number of consecutive timeouts, accessed by the owner only
+            std::size_t backoff_;
+
+            boost::atomic<std::int64_t> parks_;
+            boost::atomic<std::int64_t> wakeups_;
+            boost::atomic<std::int64_t> spurious_wakeups_;
+
+#if !defined(__linux) && !defined(linux) && !defined(__linux__)
+            compat::mutex mtx_;
+            compat::condition_variable cond_;
+#endif
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        bool unpark(slot& s);
+        static void wake(slot& s);
+
+        std::int64_t accumulate(boost::atomic<std::int64_t> slot::* counter,
+            std::size_t num_thread, bool reset);
+
+        std::size_t const num_threads_;
+        std::unique_ptr<slot[]> slots_;
+
+        boost::atomic<std::size_t> num_parked_;
+        boost::atomic<std::size_t> next_;
+
+        std::size_t const spin_count_;
+        std::size_t const min_timeout_;     // in microseconds
+        std::size_t const max_timeout_;     // in microseconds
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -7,11 +7,13 @@
 #define HPX_THREADMANAGER_SCHEDULING_SCHEDULER_BASE_JUL_14_2013_1132AM
 
 #include <hpx/config.hpp>
-#include <hpx/compat/condition_variable.hpp>
-#include <hpx/compat/mutex.hpp>
+#include <hpx/error_code.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/threads/policies/affinity_data.hpp>
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+#include <hpx/runtime/threads/policies/parking_lot.hpp>
+#endif
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
@@ -25,12 +27,10 @@
 #include <boost/atomic.hpp>
 
 #include <algorithm>
-#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
-#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -39,27 +39,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
-#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-    namespace detail
-    {
-        struct reset_on_exit
-        {
-            reset_on_exit(boost::atomic<std::int32_t>& counter)
-              : counter_(counter)
-            {
-                ++counter_;
-                HPX_ASSERT(counter_ > 0);
-            }
-            ~reset_on_exit()
-            {
-                HPX_ASSERT(counter_ > 0);
-                --counter_;
-            }
-            boost::atomic<std::int32_t>& counter_;
-        };
-    }
-#endif
-
     ///////////////////////////////////////////////////////////////////////////
     /// The scheduler_base defines the interface to be implemented by all
     /// scheduler policies
@@ -76,7 +55,7 @@ namespace hpx { namespace threads { namespace policies
           , affinity_data_(num_threads)
           , mode_(mode)
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-          , wait_count_(0)
+          , parking_lot_(num_threads)
 #endif
           , states_(num_threads)
           , description_(description)
@@ -106,23 +85,37 @@ namespace hpx { namespace threads { namespace policies
         void add_punit(std::size_t virt_core, std::size_t thread_num)
         {
             affinity_data_.add_punit(virt_core, thread_num, topology_);
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            init_parking_location(virt_core);
+#endif
         }
 
         std::size_t init(init_affinity_data const& data,
             topology const& topology)
         {
-            return affinity_data_.init(data, topology);
+            std::size_t result = affinity_data_.init(data, topology);
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            for (std::size_t i = 0; i != parking_lot_.size(); ++i)
+                init_parking_location(i);
+#endif
+            return result;
         }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        void idle_callback(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            std::chrono::milliseconds period(++wait_count_);
-
-            std::unique_lock<compat::mutex> l(mtx_);
-            cond_.wait_for(l, period);
+            // Park this thread until new work is scheduled close to it or
+            // its backoff time has expired.
+            if (num_thread >= parking_lot_.size())
+                return;
+
+            parking_lot_.park(num_thread,
+                [this, num_thread]() -> bool
+                {
+                    return this->get_queue_length(num_thread) != 0 ||
+                        states_[num_thread].load(boost::memory_order_relaxed)
+                            > state_running;
+                });
 #endif
         }
 
@@ -143,15 +136,36 @@ namespace hpx { namespace threads { namespace policies
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            wait_count_.store(0, boost::memory_order_release);
+            // wake up the given thread, or the parked thread closest to it
+            parking_lot_.unpark_near(num_thread);
+#endif
+        }
 
-            if (num_thread == std::size_t(-1))
-                cond_.notify_all();
-            else
-                cond_.notify_one();
+        /// This function gets called by the thread-manager whenever all
+        /// OS threads have to be reactivated (for instance during shutdown)
+        void wake_all_idle()
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            parking_lot_.unpark_all();
 #endif
         }
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::int64_t get_num_idle_parks(std::size_t num_thread, bool reset)
+        {
+            return parking_lot_.get_num_parks(num_thread, reset);
+        }
+        std::int64_t get_num_idle_wakeups(std::size_t num_thread, bool reset)
+        {
+            return parking_lot_.get_num_wakeups(num_thread, reset);
+        }
+        std::int64_t get_num_idle_spurious_wakeups(std::size_t num_thread,
+            bool reset)
+        {
+            return parking_lot_.get_num_spurious_wakeups(num_thread, reset);
+        }
+#endif
+
         // allow to access/manipulate states
         boost::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
@@ -307,10 +321,27 @@ namespace hpx { namespace threads { namespace policies
         boost::atomic<scheduler_mode> mode_;
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        void init_parking_location(std::size_t num_thread)
+        {
+            if (num_thread >= parking_lot_.size())
+                return;
+
+            error_code ec(lightweight);
+            std::size_t pu_num = affinity_data_.get_pu_num(num_thread);
+            std::size_t core = topology_.get_core_number(pu_num, ec);
+            if (ec)
+                core = std::size_t(-1);
+
+            ec = make_success_code();
+            std::size_t domain = topology_.get_numa_node_number(pu_num, ec);
+            if (ec)
+                domain = std::size_t(-1);
+
+            parking_lot_.set_location(num_thread, core, domain);
+        }
+
         // support for suspension on idle queues
-        compat::mutex mtx_;
-        compat::condition_variable cond_;
-        boost::atomic<std::uint32_t> wait_count_;
+        parking_lot parking_lot_;
 #endif
 
         std::vector<boost::atomic<hpx::state> > states_;
@@ -13,6 +13,7 @@
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
+#include <hpx/runtime/threads/policies/thread_registry.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/thread_trace.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
@@ -28,17 +30,16 @@
 
 #include <boost/atomic.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/lockfree/stack.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -151,6 +152,10 @@ namespace hpx { namespace threads { namespace policies
     //     bool pop(reference val, bool steal = true);
     //
     //     bool empty();
+    //
+    //     // invoked on the worker thread 'num_thread' before it starts
+    //     // executing work
+    //     void on_start_thread(std::size_t num_thread);
     // };
     //
     // struct queue_policy
@@ -187,8 +192,13 @@ namespace hpx { namespace threads { namespace policies
         // number of terminated threads to collect before cleaning them up
         int const max_terminated_threads;
 
-        // this is the type of a map holding all threads (except depleted ones)
-        typedef std::unordered_set<thread_id_type> thread_map_type;
+        // this is the type of the registry holding all threads (except
+        // depleted ones)
+        typedef detail::thread_registry thread_map_type;
+
+        // this is the type of the lists of recycled thread objects, each
+        // element holds one reference to the thread object
+        typedef boost::lockfree::stack<thread_data*> thread_heap_type;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -214,78 +224,112 @@ namespace hpx { namespace threads { namespace policies
             apply<thread_data*>::type terminated_items_type;
 
     protected:
-        template <typename Lock>
-        void create_thread_object(threads::thread_id_type& thrd,
-            threads::thread_init_data& data, thread_state_enum state, Lock& lk)
+        thread_heap_type* get_thread_heap(std::ptrdiff_t stacksize)
         {
-            HPX_ASSERT(lk.owns_lock());
-            HPX_ASSERT(data.stacksize != 0);
+            if (stacksize == get_stack_size(thread_stacksize_small))
+                return &thread_heap_small_;
 
-            std::ptrdiff_t stacksize = data.stacksize;
+            if (stacksize == get_stack_size(thread_stacksize_medium))
+                return &thread_heap_medium_;
 
-            std::list<thread_id_type>* heap = nullptr;
+            if (stacksize == get_stack_size(thread_stacksize_large))
+                return &thread_heap_large_;
 
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                heap = &thread_heap_small_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                heap = &thread_heap_medium_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                heap = &thread_heap_large_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                heap = &thread_heap_huge_;
-            }
-            else {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    heap = &thread_heap_small_;
-                    break;
+            if (stacksize == get_stack_size(thread_stacksize_huge))
+                return &thread_heap_huge_;
 
-                case thread_stacksize_medium:
-                    heap = &thread_heap_medium_;
-                    break;
+            if (stacksize == get_stack_size(thread_stacksize_nostack))
+                return &thread_heap_nostack_;
 
-                case thread_stacksize_large:
-                    heap = &thread_heap_large_;
-                    break;
+            switch(stacksize) {
+            case thread_stacksize_small:
+                return &thread_heap_small_;
 
-                case thread_stacksize_huge:
-                    heap = &thread_heap_huge_;
-                    break;
+            case thread_stacksize_medium:
+                return &thread_heap_medium_;
 
-                default:
-                    break;
-                }
+            case thread_stacksize_large:
+                return &thread_heap_large_;
+
+            case thread_stacksize_huge:
+                return &thread_heap_huge_;
+
+            case thread_stacksize_nostack:
+                return &thread_heap_nostack_;
+
+            default:
+                break;
             }
+            return nullptr;
+        }
+
+        // Take ownership of an unused thread object and rebind it, if
+        // possible.
+        bool reuse_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state)
+        {
+            HPX_ASSERT(data.stacksize != 0);
+
+            thread_heap_type* heap = get_thread_heap(data.stacksize);
             HPX_ASSERT(heap);
 
+            thread_data* p = nullptr;
+            if (!heap->pop(p))
+                return false;
+
+            thrd = thread_id_type(p, false);    // adopt reference
+            thrd->rebind(data, state);
+            return true;
+        }
+
+        void create_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state)
+        {
             if (state == pending_do_not_schedule || state == pending_boost)
             {
                 state = pending;
             }
 
-            // Check for an unused thread object.
-            if (!heap->empty())
+            // Check for an unused thread object, otherwise allocate a new one.
+            if (!reuse_thread_object(thrd, data, state))
+                thrd = threads::thread_data::create(data, memory_pool_, state);
+
+            record_thread_create(thrd);
+        }
+
+        template <typename Lock>
+        void create_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state, Lock& lk)
+        {
+            HPX_ASSERT(lk.owns_lock());
+
+            if (state == pending_do_not_schedule || state == pending_boost)
             {
-                // Take ownership of the thread object and rebind it.
-                thrd = heap->front();
-                heap->pop_front();
-                thrd->rebind(data, state);
+                state = pending;
             }
 
-            else
+            if (!reuse_thread_object(thrd, data, state))
             {
                 hpx::util::unlock_guard<Lock> ull(lk);
 
                 // Allocate a new thread object.
                 thrd = threads::thread_data::create(data, memory_pool_, state);
             }
+
+            record_thread_create(thrd);
+        }
+
+        // Staged threads get their thread object only once they are
+        // converted, which is the point their creation is recorded at.
+        static void record_thread_create(threads::thread_id_type const& thrd)
+        {
+#if defined(HPX_HAVE_THREAD_TRACE)
+            if (util::thread_trace::is_enabled())
+            {
+                util::thread_trace::record(util::thread_trace::thread_create,
+                    thrd.get(), thrd->get_description());
+            }
+#endif
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -324,17 +368,13 @@ namespace hpx { namespace threads { namespace policies
                 delete task;
 
                 // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
-
-                if (HPX_UNLIKELY(!p.second)) {
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
                     lk.unlock();
                     HPX_THROW_EXCEPTION(hpx::out_of_memory,
                         "threadmanager::add_new",
                         "Couldn't add new thread to the thread map");
                     return 0;
                 }
-                ++thread_map_count_;
 
                 // only insert the thread into the work-items queue if it is in
                 // pending state
@@ -346,7 +386,7 @@ namespace hpx { namespace threads { namespace policies
                 }
 
                 // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
                 HPX_ASSERT(thrd->get_pool() == &memory_pool_);
             }
 
@@ -372,7 +412,7 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count = static_cast<std::size_t>(thread_map_.size());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>(
@@ -400,48 +440,19 @@ namespace hpx { namespace threads { namespace policies
 
         void recycle_thread(thread_id_type thrd)
         {
-            std::ptrdiff_t stacksize = thrd->get_stack_size();
-
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                thread_heap_small_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                thread_heap_medium_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                thread_heap_large_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                thread_heap_huge_.push_front(thrd);
-            }
-            else
-            {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    thread_heap_small_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_medium:
-                    thread_heap_medium_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_large:
-                    thread_heap_large_.push_front(thrd);
-                    break;
+            thread_heap_type* heap = get_thread_heap(thrd->get_stack_size());
+            HPX_ASSERT(heap);
 
-                case thread_stacksize_huge:
-                    thread_heap_huge_.push_front(thrd);
-                    break;
+            // the heap takes over the reference held by thrd
+            if (heap && heap->push(thrd.get()))
+                thrd.detach();
+        }
 
-                default:
-                    HPX_ASSERT(false);
-                    break;
-                }
-            }
+        static void clear_thread_heap(thread_heap_type& heap)
+        {
+            thread_data* p = nullptr;
+            while (heap.pop(p))
+                intrusive_ptr_release(p);
         }
 
     public:
@@ -467,14 +478,12 @@ namespace hpx { namespace threads { namespace policies
                     --terminated_items_count_;
 
                     // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
+                    HPX_ASSERT(thread_map_.contains(todelete));
 
-                    bool deleted = thread_map_.erase(todelete) != 0;
+                    // dropping the reference deletes the thread object
+                    bool deleted = thread_map_.erase(todelete) != nullptr;
                     HPX_ASSERT(deleted);
-                    if (deleted) {
-                        --thread_map_count_;
-                        HPX_ASSERT(thread_map_count_ >= 0);
-                    }
+                    HPX_UNUSED(deleted);
                 }
             }
             else {
@@ -489,16 +498,13 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    thread_map_type::iterator it = thread_map_.find(todelete);
+                    thread_id_type thrd = thread_map_.erase(todelete);
 
                     // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
-
-                    recycle_thread(*it);
+                    HPX_ASSERT(thrd);
 
-                    thread_map_.erase(it);
-                    --thread_map_count_;
-                    HPX_ASSERT(thread_map_count_ >= 0);
+                    if (thrd)
+                        recycle_thread(std::move(thrd));
 
                     --delete_count;
                 }
@@ -513,30 +519,22 @@ namespace hpx { namespace threads { namespace policies
         }
 
     public:
+        // None of the data structures touched while cleaning up terminated
+        // threads require the queue's mutex to be held.
         bool cleanup_terminated(bool delete_all = false)
         {
             if (terminated_items_count_ == 0)
-                return thread_map_count_ == 0;
+                return thread_map_.empty();
 
             if (delete_all) {
-                // do not lock mutex while deleting all threads, do it piece-wise
-                bool thread_map_is_empty = false;
-                while (true)
-                {
-                    std::lock_guard<mutex_type> lk(mtx_);
-                    if (cleanup_terminated_locked_helper(false))
-                    {
-                        thread_map_is_empty =
-                            (thread_map_count_ == 0) && (new_tasks_count_ == 0);
-                        break;
-                    }
-                }
-                return thread_map_is_empty;
+                // do it piece-wise
+                while (!cleanup_terminated_locked_helper(false))
+                    ;
+                return thread_map_.empty() && (new_tasks_count_ == 0);
             }
 
-            std::lock_guard<mutex_type> lk(mtx_);
             return cleanup_terminated_locked_helper(false) &&
-                (thread_map_count_ == 0) && (new_tasks_count_ == 0);
+                thread_map_.empty() && (new_tasks_count_ == 0);
         }
 
         // The maximum number of active threads this thread manager should
@@ -554,7 +552,6 @@ namespace hpx { namespace threads { namespace policies
             max_add_new_count(detail::get_max_add_new_count()),
             max_delete_count(detail::get_max_delete_count()),
             max_terminated_threads(detail::get_max_terminated_threads()),
-            thread_map_count_(0),
             work_items_(128, queue_num),
             work_items_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -566,17 +563,18 @@ namespace hpx { namespace threads { namespace policies
             max_count_((0 == max_count)
                       ? static_cast<std::size_t>(max_thread_count)
                       : max_count),
-            new_tasks_(128),
+            new_tasks_(128, queue_num),
             new_tasks_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
             new_tasks_wait_(0),
             new_tasks_wait_count_(0),
 #endif
             memory_pool_(64),
-            thread_heap_small_(),
-            thread_heap_medium_(),
-            thread_heap_large_(),
-            thread_heap_huge_(),
+            thread_heap_small_(128),
+            thread_heap_medium_(128),
+            thread_heap_large_(128),
+            thread_heap_huge_(128),
+            thread_heap_nostack_(128),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -592,6 +590,18 @@ namespace hpx { namespace threads { namespace policies
             add_new_logger_("thread_queue::add_new")
         {}
 
+        ~thread_queue()
+        {
+            // release all threads before the memory pool goes away
+            thread_map_.clear();
+
+            clear_thread_heap(thread_heap_small_);
+            clear_thread_heap(thread_heap_medium_);
+            clear_thread_heap(thread_heap_large_);
+            clear_thread_heap(thread_heap_huge_);
+            clear_thread_heap(thread_heap_nostack_);
+        }
+
         void set_max_count(std::size_t max_count = max_thread_count)
         {
             max_count_ = (0 == max_count) ? max_thread_count : max_count; //-V105
@@ -729,41 +739,32 @@ namespace hpx { namespace threads { namespace policies
             {
                 threads::thread_id_type thrd;
 
-                // The mutex can not be locked while a new thread is getting
-                // created, as it might have that the current HPX thread gets
-                // suspended.
-                {
-                    std::unique_lock<mutex_type> lk(mtx_);
-
-                    create_thread_object(thrd, data, initial_state, lk);
-
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
+                // No lock is required here, the thread heaps and the map of
+                // all threads can be accessed concurrently.
+                create_thread_object(thrd, data, initial_state);
 
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
-                    ++thread_map_count_;
+                // add a new entry in the map for this thread
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                    HPX_THROWS_IF(ec, hpx::out_of_memory,
+                        "threadmanager::register_thread",
+                        "Couldn't add new thread to the map of threads");
+                    return;
+                }
 
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                // this thread has to be in the map now
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
+                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    // return the thread_id of the newly created thread
-                    if (id) *id = std::move(thrd);
+                // return the thread_id of the newly created thread
+                if (id) *id = std::move(thrd);
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
-                    return;
-                }
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
             }
 
             // do not execute the work, but register a task description for
@@ -916,43 +917,40 @@ namespace hpx { namespace threads { namespace policies
                 return new_tasks_count_;
 
             if (unknown == state)
-                return thread_map_count_ + new_tasks_count_ - terminated_items_count_;
-
-            // acquire lock only if absolutely necessary
-            std::lock_guard<mutex_type> lk(mtx_);
-
-            std::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
-                 it != end; ++it)
             {
-                if ((*it)->get_state().state() == state)
-                    ++num_threads;
+                return thread_map_.size() + new_tasks_count_ -
+                    terminated_items_count_;
             }
+
+            std::int64_t num_threads = 0;
+            thread_map_.for_each(
+                [&num_threads, state](thread_data* thrd)
+                {
+                    if (thrd->get_state().state() == state)
+                        ++num_threads;
+                });
             return num_threads;
         }
 
         ///////////////////////////////////////////////////////////////////////
         void abort_all_suspended_threads()
         {
-            std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
-                 it != end; ++it)
-            {
-                if ((*it)->get_state().state() == suspended)
+            thread_map_.for_each(
+                [this](thread_data* thrd)
                 {
-                    (*it)->set_state(pending, wait_abort);
-                    schedule_thread((*it).get());
-                }
-            }
+                    if (thrd->get_state().state() == suspended)
+                    {
+                        thrd->set_state(pending, wait_abort);
+                        schedule_thread(thrd);
+                    }
+                });
         }
 
         bool enumerate_threads(
             util::function_nonser<bool(thread_id_type)> const& f,
             thread_state_enum state = unknown) const
         {
-            std::uint64_t count = thread_map_count_;
+            std::uint64_t count = static_cast<std::uint64_t>(thread_map_.size());
             if (state == terminated)
             {
                 count = terminated_items_count_;
@@ -970,24 +968,20 @@ namespace hpx { namespace threads { namespace policies
 
             if (state == unknown)
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids](thread_data* thrd)
+                    {
+                        ids.push_back(thrd);
+                    });
             }
             else
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    if ((*it)->get_state().state() == state)
-                        ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids, state](thread_data* thrd)
+                    {
+                        if (thrd->get_state().state() == state)
+                            ids.push_back(thrd);
+                    });
             }
 
             // now invoke callback function for all matching threads
@@ -1074,16 +1068,20 @@ namespace hpx { namespace threads { namespace policies
             return false;
 #else
             if (minimal_deadlock_detection) {
-                std::lock_guard<mutex_type> lk(mtx_);
-                return detail::dump_suspended_threads(num_thread, thread_map_
-                  , idle_loop_count, running);
+                std::vector<thread_id_type> ids = thread_map_.get_ids();
+                return detail::dump_suspended_threads(num_thread, ids,
+                    idle_loop_count, running);
             }
             return false;
 #endif
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            work_items_.on_start_thread(num_thread);
+            new_tasks_.on_start_thread(num_thread);
+        }
         void on_stop_thread(std::size_t num_thread) {}
         void on_error(std::size_t num_thread, std::exception_ptr const& e) {}
 
@@ -1091,9 +1089,7 @@ namespace hpx { namespace threads { namespace policies
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
         thread_map_type thread_map_;
-        ///< mapping of thread id's to HPX-threads
-        boost::atomic<std::int64_t> thread_map_count_;
-        ///< overall count of work items
+        ///< registry of all HPX-threads managed by this queue
 
         work_items_type work_items_;
         ///< list of active work items
@@ -1127,10 +1123,11 @@ namespace hpx { namespace threads { namespace policies
         threads::thread_pool memory_pool_;          ///< OS thread local memory pools for
                                                     ///< HPX-threads
 
-        std::list<thread_id_type> thread_heap_small_;
-        std::list<thread_id_type> thread_heap_medium_;
-        std::list<thread_id_type> thread_heap_large_;
-        std::list<thread_id_type> thread_heap_huge_;
+        thread_heap_type thread_heap_small_;
+        thread_heap_type thread_heap_medium_;
+        thread_heap_type thread_heap_large_;
+        thread_heap_type thread_heap_huge_;
+        thread_heap_type thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         std::uint64_t add_new_time_;
@@ -0,0 +1,211 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_THREAD_REGISTRY_SEP_18_2017_1052AM)
+#define HPX_THREADMANAGER_THREAD_REGISTRY_SEP_18_2017_1052AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace threads { namespace policies { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The thread_registry keeps track of all threads managed by a thread_queue
+    // (it holds one reference to each of them). The threads are linked into
+    // intrusive doubly linked lists (using the registry_hook embedded into
+    // each thread_data) which are sharded based on the address of the thread
+    // object. Every shard is protected by its own spinlock, which is held for
+    // a couple of pointer operations only. Neither inserting nor erasing a
+    // thread allocates any memory.
+    class thread_registry
+    {
+    public:
+        HPX_NON_COPYABLE(thread_registry);
+
+    private:
+        typedef hpx::util::spinlock mutex_type;
+        typedef thread_data::registry_hook hook_type;
+
+        enum { log2_num_shards = 4, num_shards = 1 << log2_num_shards };
+
+        struct shard
+        {
+            shard() : head_(nullptr) {}
+
+            mutable mutex_type mtx_;
+            thread_data* head_;
+
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES -
+                sizeof(mutex_type) - sizeof(thread_data*)];
+        };
+
+        static std::size_t shard_index(thread_data const* thrd)
+        {
+            // Fibonacci hashing of the address spreads objects allocated from
+            // the same memory pool evenly over all shards
+            std::uint64_t addr = reinterpret_cast<std::size_t>(thrd);
+            return static_cast<std::size_t>(
+                (addr * 0x9E3779B97F4A7C15ull) >> (64 - log2_num_shards));
+        }
+
+        shard& get_shard(thread_data const* thrd)
+        {
+            return shards_[shard_index(thrd)];
+        }
+        shard const& get_shard(thread_data const* thrd) const
+        {
+            return shards_[shard_index(thrd)];
+        }
+
+    public:
+        thread_registry()
+          : size_(0)
+        {}
+
+        ~thread_registry()
+        {
+            clear();
+        }
+
+        // Add the given thread to the registry, returns false if the thread
+        // is already registered.
+        bool insert(thread_id_type const& id)
+        {
+            thread_data* thrd = id.get();
+            shard& s = get_shard(thrd);
+            hook_type& hook = thrd->get_registry_hook();
+
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                if (hook.owner_ != nullptr)
+                    return false;
+
+                hook.owner_ = &s;
+                hook.prev_ = nullptr;
+                hook.next_ = s.head_;
+                if (s.head_ != nullptr)
+                    s.head_->get_registry_hook().prev_ = thrd;
+                s.head_ = thrd;
+            }
+
+            intrusive_ptr_add_ref(thrd);
+            ++size_;
+            return true;
+        }
+
+        // Remove the given thread from the registry. This returns the
+        // reference previously held by the registry (or an empty id if the
+        // thread was not registered).
+        thread_id_type erase(thread_data* thrd)
+        {
+            shard& s = get_shard(thrd);
+            hook_type& hook = thrd->get_registry_hook();
+
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                if (hook.owner_ != &s)
+                    return thread_id_type();
+
+                if (hook.prev_ != nullptr)
+                    hook.prev_->get_registry_hook().next_ = hook.next_;
+                else
+                    s.head_ = hook.next_;
+
+                if (hook.next_ != nullptr)
+                    hook.next_->get_registry_hook().prev_ = hook.prev_;
+
+                hook.prev_ = hook.next_ = nullptr;
+                hook.owner_ = nullptr;
+            }
+
+            --size_;
+            return thread_id_type(thrd, false);     // adopt reference
+        }
+
+        bool contains(thread_data const* thrd) const
+        {
+            shard const& s = get_shard(thrd);
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return thrd->get_registry_hook().owner_ == &s;
+        }
+
+        // Invoke the given function for all registered threads. Each shard is
+        // locked while its threads are visited, thus f must not call back
+        // into the registry.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (thread_data* thrd = s.head_; thrd != nullptr;
+                     thrd = thrd->get_registry_hook().next_)
+                {
+                    f(thrd);
+                }
+            }
+        }
+
+        // Return the ids of all registered threads.
+        std::vector<thread_id_type> get_ids() const
+        {
+            std::vector<thread_id_type> ids;
+            ids.reserve(static_cast<std::size_t>(size()));
+            for_each([&ids](thread_data* thrd) { ids.push_back(thrd); });
+            return ids;
+        }
+
+        void clear()
+        {
+            for (shard& s : shards_)
+            {
+                thread_data* thrd = nullptr;
+                {
+                    std::lock_guard<mutex_type> l(s.mtx_);
+                    thrd = s.head_;
+                    s.head_ = nullptr;
+                }
+
+                while (thrd != nullptr)
+                {
+                    hook_type& hook = thrd->get_registry_hook();
+                    thread_data* next = hook.next_;
+                    hook.prev_ = hook.next_ = nullptr;
+                    hook.owner_ = nullptr;
+
+                    --size_;
+                    intrusive_ptr_release(thrd);
+                    thrd = next;
+                }
+            }
+        }
+
+        std::int64_t size() const
+        {
+            return size_.load(boost::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+    private:
+        shard shards_[num_shards];
+        boost::atomic<std::int64_t> size_;
+    };
+}}}}
+
+#endif
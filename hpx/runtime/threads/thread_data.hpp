@@ -12,6 +12,7 @@
 #include <hpx/runtime/get_locality_id.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
+#include <hpx/runtime/threads/coroutines/stackless_coroutine.hpp>
 #include <hpx/runtime/threads/detail/combined_tagged_state.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -31,6 +32,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <new>
 #include <stack>
 #include <string>
 #include <utility>
@@ -120,6 +122,11 @@ namespace hpx { namespace threads
             LTM_(debug) << "~thread(" << this << "), description(" //-V128
                         << get_description() << "), phase("
                         << get_thread_phase() << ")";
+
+            if (is_stackless_)
+                delete stackless_coroutine_;
+            else
+                coroutine_.~coroutine_type();
         }
 
         /// The get_state function queries the state of this thread instance.
@@ -503,11 +510,40 @@ namespace hpx { namespace threads
             return stacksize_;
         }
 
+        /// Stackless threads run to completion on the stack of the worker
+        /// thread executing them (see thread_stacksize_nostack).
+        bool is_stackless() const
+        {
+            return is_stackless_;
+        }
+
         pool_type* get_pool()
         {
             return pool_;
         }
 
+        /// Intrusive hook used by the schedulers to keep track of all
+        /// threads they manage (see policies::detail::thread_registry).
+        struct registry_hook
+        {
+            registry_hook()
+              : prev_(nullptr), next_(nullptr), owner_(nullptr)
+            {}
+
+            thread_data* prev_;
+            thread_data* next_;
+            void const* owner_;
+        };
+
+        registry_hook& get_registry_hook()
+        {
+            return registry_hook_;
+        }
+        registry_hook const& get_registry_hook() const
+        {
+            return registry_hook_;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -516,16 +552,22 @@ namespace hpx { namespace threads
         ///                 thread's scheduling status.
         coroutine_type::result_type operator()()
         {
+            if (is_stackless_)
+            {
+                HPX_ASSERT(this == stackless_coroutine_->get_thread_id());
+                return (*stackless_coroutine_)(set_state_ex(wait_signaled));
+            }
+
             HPX_ASSERT(this == coroutine_.get_thread_id());
             return coroutine_(set_state_ex(wait_signaled));
         }
 
         thread_id_type get_thread_id() const
         {
-            HPX_ASSERT(this == coroutine_.get_thread_id());
-            return thread_id_type(
-                    reinterpret_cast<thread_data*>(coroutine_.get_thread_id())
-                );
+            HPX_ASSERT(this == (is_stackless_ ?
+                stackless_coroutine_->get_thread_id() :
+                coroutine_.get_thread_id()));
+            return thread_id_type(const_cast<thread_data*>(this));
         }
 
         std::size_t get_thread_phase() const
@@ -533,24 +575,29 @@ namespace hpx { namespace threads
 #ifndef HPX_HAVE_THREAD_PHASE_INFORMATION
             return 0;
 #else
-            return coroutine_.get_thread_phase();
+            return is_stackless_ ? stackless_coroutine_->get_thread_phase() :
+                coroutine_.get_thread_phase();
 #endif
         }
 
         std::size_t get_thread_data() const
         {
-            return coroutine_.get_thread_data();
+            return is_stackless_ ? stackless_coroutine_->get_thread_data() :
+                coroutine_.get_thread_data();
         }
 
         std::size_t set_thread_data(std::size_t data)
         {
-            return coroutine_.set_thread_data(data);
+            return is_stackless_ ?
+                stackless_coroutine_->set_thread_data(data) :
+                coroutine_.set_thread_data(data);
         }
 
 #if defined(HPX_HAVE_APEX)
         void** get_apex_data() const
         {
-            return coroutine_.get_apex_data();
+            return is_stackless_ ? stackless_coroutine_->get_apex_data() :
+                coroutine_.get_apex_data();
         }
 #endif
 
@@ -563,10 +610,16 @@ namespace hpx { namespace threads
 
             rebind_base(init_data, newstate);
 
-            coroutine_.rebind(std::move(init_data.func), this_());
+            if (is_stackless_)
+            {
+                stackless_coroutine_->rebind(
+                    std::move(init_data.func), this_());
+            }
+            else
+                coroutine_.rebind(std::move(init_data.func), this_());
 
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+            HPX_ASSERT(is_ready());
         }
 
         /// This function will be called when the thread is about to be deleted
@@ -604,10 +657,21 @@ namespace hpx { namespace threads
             scheduler_base_(init_data.scheduler_base),
             count_(0),
             stacksize_(init_data.stacksize),
-            coroutine_(std::move(init_data.func),
-                this_(), init_data.stacksize),
+            is_stackless_(init_data.stacksize ==
+                threads::get_stack_size(thread_stacksize_nostack)),
             pool_(pool)
         {
+            if (is_stackless_)
+            {
+                stackless_coroutine_ = new coroutines::stackless_coroutine(
+                    std::move(init_data.func), this_());
+            }
+            else
+            {
+                new (&coroutine_) coroutine_type(
+                    std::move(init_data.func), this_(), init_data.stacksize);
+            }
+
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
 
@@ -626,10 +690,16 @@ namespace hpx { namespace threads
                 parent_locality_id_ = get_locality_id();
 #endif
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+            HPX_ASSERT(is_ready());
         }
 
     private:
+        bool is_ready() const
+        {
+            return is_stackless_ ? stackless_coroutine_->is_ready() :
+                coroutine_.is_ready();
+        }
+
         void rebind_base(thread_init_data& init_data, thread_state_enum newstate)
         {
             free_thread_exit_callbacks();
@@ -731,9 +801,18 @@ namespace hpx { namespace threads
         util::atomic_count count_;
 
         std::ptrdiff_t stacksize_;
+        bool is_stackless_;
 
-        coroutine_type coroutine_;
+        // a thread either owns a stackful coroutine or (if stackless) a
+        // separately allocated stackless one, never both
+        union
+        {
+            coroutine_type coroutine_;
+            coroutines::stackless_coroutine* stackless_coroutine_;
+        };
         pool_type* pool_;
+
+        registry_hook registry_hook_;
     };
 
     typedef thread_data::pool_type thread_pool;
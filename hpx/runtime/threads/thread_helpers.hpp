@@ -649,6 +649,11 @@ namespace hpx { namespace this_thread
     // requested
     HPX_EXPORT bool has_sufficient_stack_space(
         std::size_t space_needed = 8 * HPX_THREADS_STACK_OVERHEAD);
+
+    // returns whether the calling thread is a HPX thread which may be
+    // suspended, stackless HPX threads have to back off by yielding their
+    // OS thread instead
+    HPX_EXPORT bool can_suspend();
     /// \endcond
 }}
 
@@ -1,4 +1,5 @@
 //  Copyright (c)      2013 Thomas Heller
+//  Copyright (c)      2017 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -6,86 +7,354 @@
 #if !defined(HPX_UTIL_BUFFER_POOL_HPP)
 #define HPX_UTIL_BUFFER_POOL_HPP
 
-#include <list>
-#include <map>
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
-namespace hpx { namespace util {
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        // Each OS thread is assigned its own stripe of the buffer pools
+        // (modulo the number of available stripes) on first use.
+        inline std::size_t get_buffer_pool_stripe()
+        {
+            static boost::atomic<std::size_t> next_stripe(0);
+            static HPX_NATIVE_TLS std::size_t stripe = std::size_t(-1);
+
+            if (stripe == std::size_t(-1))
+                stripe = next_stripe++;
+            return stripe;
+        }
+    }
 
-    // This class holds shared_ptr of vector<T, Allocator> with a power of two
+    ///////////////////////////////////////////////////////////////////////////
+    // This class caches vector<T, Allocator> instances for later reuse. It is
+    // safe to use from any number of threads concurrently:
+    //
+    // - Buffers are sorted into size classes, each power of two is split into
+    //   four classes. A request is served from the class it rounds up to, a
+    //   returned buffer is put into the class its capacity rounds down to.
+    // - The free lists are striped, each OS thread uses its own stripe first
+    //   and falls back to the stripes of other threads only if those are not
+    //   locked at that point.
+    // - The overall number of cached bytes is bounded by a high watermark.
+    //   Whenever it is exceeded, the largest buffers are released until the
+    //   pool holds no more than half of the high watermark.
     template <typename T, typename Allocator = std::allocator<T> >
-    struct buffer_pool
+    class buffer_pool
     {
+    public:
+        HPX_NON_COPYABLE(buffer_pool);
+
         typedef std::vector<T, Allocator> buffer_type;
-        typedef std::shared_ptr<buffer_type> shared_buffer_type;
         typedef typename buffer_type::size_type size_type;
-        typedef std::map<size_type, std::list<shared_buffer_type> > buffer_map_type;
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+    private:
+        enum
+        {
+            num_stripes = 16,
+            min_size_log2 = 6,              // buffers smaller than 64 elements
+                                            // are not cached
+            num_sub_classes = 4,            // classes per power of two
+            num_classes = (64 - min_size_log2) * num_sub_classes + 1
+        };
+
+        struct stripe
+        {
+            stripe()
+              : allocations_(0), reuses_(0), reclaims_(0), releases_(0)
+            {}
+
+            mutex_type mtx_;
+            std::vector<buffer_type> buffers_[num_classes];
+
+            boost::atomic<std::int64_t> allocations_;
+            boost::atomic<std::int64_t> reuses_;
+            boost::atomic<std::int64_t> reclaims_;
+            boost::atomic<std::int64_t> releases_;
 
-        shared_buffer_type get_buffer(size_type size)
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+    public:
+        // The default high watermark is 16MB
+        explicit buffer_pool(std::size_t high_watermark = 16 * 1024 * 1024)
+          : stripes_(new stripe[num_stripes])
+          , high_watermark_(high_watermark)
+          , cached_bytes_(0)
+        {}
+
+        ~buffer_pool()
         {
-            size_type capacity = next_power_of_two(size);
-            typename buffer_map_type::iterator it = buffers_.find(capacity);
-            shared_buffer_type res;
-            if(it == buffers_.end() || it->second.empty())
+            clear();
+        }
+
+        // Return an empty buffer which can hold at least the given number of
+        // elements without reallocation.
+        buffer_type get_buffer(size_type size)
+        {
+            size_type capacity = 0;
+            std::size_t size_class = get_size_class(size, capacity);
+
+            std::size_t const current =
+                detail::get_buffer_pool_stripe() % num_stripes;
+
+            buffer_type result;
+            if (capacity * sizeof(T) >
+                high_watermark_.load(boost::memory_order_relaxed))
             {
-                res.reset(new buffer_type());
-                res->reserve(capacity);
+                // the buffer will never be cached, don't round up its size
+                stripes_[current].allocations_.fetch_add(1,
+                    boost::memory_order_relaxed);
+
+                result.reserve(size);
+                return result;
             }
-            else
+
+            if (cached_bytes_.load(boost::memory_order_relaxed) != 0)
             {
-                res = it->second.front();
-                it->second.pop_front();
+                // look at our own stripe first
+                if (try_get(stripes_[current], size_class, result, true))
+                    return result;
+
+                for (std::size_t i = 1; i != num_stripes; ++i)
+                {
+                    if (try_get(stripes_[(current + i) % num_stripes],
+                            size_class, result, false))
+                    {
+                        return result;
+                    }
+                }
             }
-            return res;
+
+            stripes_[current].allocations_.fetch_add(1,
+                boost::memory_order_relaxed);
+
+            result.reserve(capacity);
+            return result;
         }
 
-        void reclaim_buffer(shared_buffer_type buffer)
+        // Hand a buffer back to the pool, the buffer will be cleared.
+        void reclaim_buffer(buffer_type && buffer)
         {
-            size_type capacity = next_power_of_two(buffer->capacity());
-            buffer->clear();
-            if(capacity != buffer->capacity())
+            size_type capacity = buffer.capacity();
+            if (capacity < (size_type(1) << min_size_log2))
+                return;
+
+            std::size_t const current =
+                detail::get_buffer_pool_stripe() % num_stripes;
+            stripe& s = stripes_[current];
+
+            std::size_t bytes = capacity * sizeof(T);
+            std::size_t high_watermark =
+                high_watermark_.load(boost::memory_order_relaxed);
+            if (bytes > high_watermark)
             {
-                buffer->reserve(capacity);
+                s.releases_.fetch_add(1, boost::memory_order_relaxed);
+                return;
             }
 
-            typename buffer_map_type::iterator it = buffers_.find(capacity);
-            if(it == buffers_.end())
+            // account for the buffer before it becomes visible to others
+            std::size_t cached = cached_bytes_.fetch_add(bytes) + bytes;
+
+            buffer.clear();
             {
-                it = buffers_.insert(it, std::make_pair(capacity,
-                    std::list<shared_buffer_type>()));
+                std::lock_guard<mutex_type> l(s.mtx_);
+                s.buffers_[get_capacity_class(capacity)].push_back(
+                    std::move(buffer));
+                s.reclaims_.fetch_add(1, boost::memory_order_relaxed);
             }
-            it->second.push_back(buffer);
+
+            if (cached > high_watermark)
+                trim(high_watermark / 2);
+        }
+
+        // Release cached buffers (largest first) until the pool holds no
+        // more than the given number of bytes. Returns the number of
+        // released buffers.
+        std::size_t trim(std::size_t max_cached_bytes)
+        {
+            std::vector<buffer_type> released;
+
+            std::size_t const current =
+                detail::get_buffer_pool_stripe() % num_stripes;
+
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                if (cached_bytes_.load() <= max_cached_bytes)
+                    break;
+
+                stripe& s = stripes_[(current + i) % num_stripes];
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (std::size_t c = num_classes; c-- != 0; /**/)
+                {
+                    std::vector<buffer_type>& buffers = s.buffers_[c];
+                    while (!buffers.empty() &&
+                        cached_bytes_.load() > max_cached_bytes)
+                    {
+                        cached_bytes_.fetch_sub(
+                            buffers.back().capacity() * sizeof(T));
+                        released.push_back(std::move(buffers.back()));
+                        buffers.pop_back();
+
+                        s.releases_.fetch_add(1, boost::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // the buffers are deallocated outside of the locks
+            return released.size();
+        }
+
+        // Release all cached buffers
+        std::size_t clear()
+        {
+            return trim(0);
+        }
+
+        // Return the number of bytes currently held by the pool
+        std::size_t cached_bytes() const
+        {
+            return cached_bytes_.load(boost::memory_order_relaxed);
+        }
+
+        std::size_t high_watermark() const
+        {
+            return high_watermark_.load(boost::memory_order_relaxed);
+        }
+
+        void set_high_watermark(std::size_t high_watermark)
+        {
+            high_watermark_.store(high_watermark);
+            if (cached_bytes_.load() > high_watermark)
+                trim(high_watermark / 2);
+        }
+
+        // Performance counter data
+
+        // number of requests which required a new buffer to be allocated
+        std::int64_t get_allocations(bool reset)
+        {
+            return accumulate(&stripe::allocations_, reset);
+        }
+
+        // number of requests which were served from the cached buffers
+        std::int64_t get_reuses(bool reset)
+        {
+            return accumulate(&stripe::reuses_, reset);
         }
 
-        void clear()
+        // number of buffers which were handed back to the pool
+        std::int64_t get_reclaims(bool reset)
         {
-            buffers_.clear();
+            return accumulate(&stripe::reclaims_, reset);
+        }
+
+        // number of buffers which were released because of the high watermark
+        std::int64_t get_releases(bool reset)
+        {
+            return accumulate(&stripe::releases_, reset);
         }
 
     private:
-        buffer_map_type buffers_;
-
-        static size_type next_power_of_two(size_type size)
-        {
-            // Check if we already have a power of two
-            // http://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
-            if(size && !(size & (size - 1)))
-                return size;
-            size--;
-            size |= size >> 1;
-            size |= size >> 2;
-            size |= size >> 4;
-            size |= size >> 8;
-            size |= size >> 16;
-            if(sizeof(size_type) == 8)
+        bool try_get(stripe& s, std::size_t size_class, buffer_type& result,
+            bool block)
+        {
+            std::unique_lock<mutex_type> l(s.mtx_, std::defer_lock);
+            if (block)
+                l.lock();
+            else if (!l.try_lock())
+                return false;
+
+            std::vector<buffer_type>& buffers = s.buffers_[size_class];
+            if (buffers.empty())
+                return false;
+
+            result = std::move(buffers.back());
+            buffers.pop_back();
+
+            s.reuses_.fetch_add(1, boost::memory_order_relaxed);
+            l.unlock();
+
+            cached_bytes_.fetch_sub(result.capacity() * sizeof(T));
+            return true;
+        }
+
+        std::int64_t accumulate(boost::atomic<std::int64_t> stripe::* value,
+            bool reset)
+        {
+            std::int64_t result = 0;
+            for (std::size_t i = 0; i != num_stripes; ++i)
             {
-                size |= size >> 32; //-V112
+                boost::atomic<std::int64_t>& v = stripes_[i].*value;
+                result += reset ? v.exchange(0) :
+                    v.load(boost::memory_order_relaxed);
             }
-            size++;
-            return size;
+            return result;
         }
+
+        static std::size_t floor_log2(std::uint64_t v)
+        {
+            std::size_t result = 0;
+            if (v >= (std::uint64_t(1) << 32)) { v >>= 32; result += 32; }
+            if (v >= (std::uint64_t(1) << 16)) { v >>= 16; result += 16; }
+            if (v >= (std::uint64_t(1) << 8)) { v >>= 8; result += 8; }
+            if (v >= (std::uint64_t(1) << 4)) { v >>= 4; result += 4; }
+            if (v >= (std::uint64_t(1) << 2)) { v >>= 2; result += 2; }
+            if (v >= (std::uint64_t(1) << 1)) { result += 1; }
+            return result;
+        }
+
+        // Return the class of buffers which can hold the given number of
+        // elements, the capacity of the buffers in that class is returned as
+        // well.
+        static std::size_t get_size_class(size_type size, size_type& capacity)
+        {
+            if (size <= (size_type(1) << min_size_log2))
+            {
+                capacity = size_type(1) << min_size_log2;
+                return 0;
+            }
+
+            std::size_t log2 = floor_log2(size - 1);
+            size_type base = size_type(1) << log2;
+            size_type step = base / num_sub_classes;
+            size_type sub = (size - 1 - base) / step + 1;
+
+            capacity = base + sub * step;
+            return (log2 - min_size_log2) * num_sub_classes +
+                static_cast<std::size_t>(sub);
+        }
+
+        // Return the class a buffer of the given capacity belongs to, all
+        // buffers in that class have at least the capacity corresponding to
+        // the class.
+        static std::size_t get_capacity_class(size_type capacity)
+        {
+            std::size_t log2 = floor_log2(capacity);
+            size_type base = size_type(1) << log2;
+            size_type step = base / num_sub_classes;
+
+            return (log2 - min_size_log2) * num_sub_classes +
+                static_cast<std::size_t>((capacity - base) / step);
+        }
+
+        std::unique_ptr<stripe[]> stripes_;
+        boost::atomic<std::size_t> high_watermark_;
+        boost::atomic<std::size_t> cached_bytes_;
     };
 }}
 
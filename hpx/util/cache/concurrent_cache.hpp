@@ -0,0 +1,766 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_CACHE_CONCURRENT_CACHE_OCT_17_2017_0215PM)
+#define HPX_UTIL_CACHE_CONCURRENT_CACHE_OCT_17_2017_0215PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/cache/policies/always.hpp>
+#include <hpx/util/cache/statistics/no_statistics.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace util { namespace cache
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// \class concurrent_cache concurrent_cache.hpp hpx/util/cache/concurrent_cache.hpp
+    ///
+    /// \brief The \a concurrent_cache implements the same functionality as
+    ///        the \a local_cache, but may be accessed concurrently from any
+    ///        number of threads without additional locking.
+    ///
+    /// The entries are distributed over a number of shards based on the hash
+    /// of their keys. Each shard is a hash table protected by its own lock,
+    /// and holds an equal part of the overall capacity of the cache. Looking
+    /// up an entry only updates the entry itself (see \a entry#touch), the
+    /// order of the entries as defined by the \a UpdatePolicy is established
+    /// only if a shard runs out of space. In this case a batch of entries
+    /// (roughly an eighth of the capacity of the shard) is evicted at once to
+    /// amortize the cost of ordering the entries.
+    ///
+    /// \note The capacity is split evenly between the shards, a shard may
+    ///       start evicting entries before the cache as a whole is full.
+    ///       Small caches use fewer shards to avoid this.
+    ///
+    /// \tparam Key           The type of the keys to use to identify the
+    ///                       entries stored in the cache
+    /// \tparam Entry         The type of the items to be held in the cache,
+    ///                       must model the CacheEntry concept
+    /// \tparam UpdatePolicy  A (optional) type specifying a (binary) function
+    ///                       object used to sort the cache entries based on
+    ///                       their 'age'. The 'oldest' entries (according to
+    ///                       this sorting criteria) will be discarded first if
+    ///                       the maximum capacity of the cache is reached.
+    ///                       The default is std::less<Entry>.
+    /// \tparam InsertPolicy  A (optional) type specifying a (unary) function
+    ///                       object used to allow global decisions whether a
+    ///                       particular entry should be added to the cache or
+    ///                       not. The default is \a policies#always. The
+    ///                       function object may be invoked concurrently.
+    /// \tparam Hash          A (optional) type specifying the hash function
+    ///                       used for the keys. The default is std::hash<Key>.
+    /// \tparam Statistics    A (optional) type allowing to collect some basic
+    ///                       statistics about the operation of the cache
+    ///                       instance. The type must conform to the
+    ///                       CacheStatistics concept and must allow to be
+    ///                       updated concurrently, see
+    ///                       \a statistics#concurrent_statistics. The default
+    ///                       is \a statistics#no_statistics.
+    /// \tparam Mutex         A (optional) type of the lock protecting each of
+    ///                       the shards. The default is
+    ///                       \a hpx#lcos#local#spinlock.
+    template <
+        typename Key, typename Entry,
+        typename UpdatePolicy = std::less<Entry>,
+        typename InsertPolicy = policies::always<Entry>,
+        typename Hash = std::hash<Key>,
+        typename Statistics = statistics::no_statistics,
+        typename Mutex = hpx::lcos::local::spinlock
+    >
+    class concurrent_cache
+    {
+    public:
+        HPX_NON_COPYABLE(concurrent_cache);
+
+        typedef Key key_type;
+        typedef Entry entry_type;
+        typedef UpdatePolicy update_policy_type;
+        typedef InsertPolicy insert_policy_type;
+        typedef Hash hash_type;
+        typedef Statistics statistics_type;
+        typedef Mutex mutex_type;
+
+        typedef std::unordered_map<Key, Entry, Hash> storage_type;
+
+        typedef typename entry_type::value_type value_type;
+        typedef typename storage_type::size_type size_type;
+        typedef typename storage_type::value_type storage_value_type;
+
+        // The default number of shards, the actual number is a power of two
+        // not larger than this
+        static const std::size_t default_num_shards = 16;
+
+        // Caches are not split into shards holding less than this
+        static const size_type min_shard_size = 64;
+
+    private:
+        typedef typename storage_type::iterator iterator;
+
+        typedef typename statistics_type::update_on_exit update_on_exit;
+
+        ///////////////////////////////////////////////////////////////////////
+        // The UpdatePolicy Concept expects to get passed references to
+        // instances of the Entry type, adapt it to the iterators used while
+        // evicting entries.
+        struct adapt
+        {
+            adapt(UpdatePolicy const& f)
+              : f_(f)
+            {}
+
+            bool operator()(iterator const& lhs, iterator const& rhs) const
+            {
+                return f_((*lhs).second, (*rhs).second);
+            }
+
+            UpdatePolicy const& f_;
+        };
+
+        struct shard
+        {
+            shard()
+              : max_size_(0), current_size_(0)
+            {}
+
+            mutable mutex_type mtx_;
+            storage_type store_;
+            size_type max_size_;
+            boost::atomic<size_type> current_size_;
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        typedef std::lock_guard<mutex_type> lock_type;
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Construct an instance of a concurrent_cache.
+        ///
+        /// \param max_size   [in] The maximal size this cache is allowed to
+        ///                   reach any time. The default is zero (no size
+        ///                   limitation). The unit of this value is usually
+        ///                   determined by the unit of the values returned by
+        ///                   the entry's \a get_size function.
+        /// \param up         [in] An instance of the \a UpdatePolicy to use
+        ///                   for this cache.
+        /// \param ip         [in] An instance of the \a InsertPolicy to use for
+        ///                   this cache.
+        ///
+        concurrent_cache(size_type max_size = 0,
+                update_policy_type const& up = update_policy_type(),
+                insert_policy_type const& ip = insert_policy_type())
+          : num_shards_(get_num_shards(max_size, default_num_shards)),
+            shards_(new shard[num_shards_]),
+            max_size_(max_size), update_policy_(up), insert_policy_(ip)
+        {
+            init_shards(max_size);
+        }
+
+        /// \brief Construct an instance of a concurrent_cache.
+        ///
+        /// \param max_size   [in] The maximal size this cache is allowed to
+        ///                   reach any time (zero: no size limitation).
+        /// \param num_shards [in] The maximal number of shards to split the
+        ///                   cache into.
+        /// \param up         [in] An instance of the \a UpdatePolicy to use
+        ///                   for this cache.
+        /// \param ip         [in] An instance of the \a InsertPolicy to use for
+        ///                   this cache.
+        ///
+        concurrent_cache(size_type max_size, std::size_t num_shards,
+                update_policy_type const& up = update_policy_type(),
+                insert_policy_type const& ip = insert_policy_type())
+          : num_shards_(get_num_shards(max_size, num_shards)),
+            shards_(new shard[num_shards_]),
+            max_size_(max_size), update_policy_(up), insert_policy_(ip)
+        {
+            init_shards(max_size);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Return current size of the cache.
+        ///
+        /// \returns The current size of this cache instance. The value may be
+        ///          outdated if the cache is modified concurrently.
+        size_type size() const
+        {
+            size_type result = 0;
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                result += shards_[i].current_size_.load(
+                    boost::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Access the maximum size the cache is allowed to grow to.
+        ///
+        /// \returns    The maximum size this cache instance is currently
+        ///             allowed to reach. If this number is zero the cache has
+        ///             no limitation with regard to a maximum size.
+        size_type capacity() const
+        {
+            return max_size_.load(boost::memory_order_relaxed);
+        }
+
+        /// \brief Return the number of shards this cache is split into.
+        std::size_t num_shards() const
+        {
+            return num_shards_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Change the maximum size this cache can grow to
+        ///
+        /// \param max_size    [in] The new maximum size this cache will be
+        ///             allowed to grow to.
+        ///
+        /// \returns    This function returns \a true if successful. It returns
+        ///             \a false if the new \a max_size is smaller than the
+        ///             current limit and the cache could not be shrinked to
+        ///             the new maximum size.
+        bool reserve(size_type max_size)
+        {
+            bool retval = true;
+
+            max_size_.store(max_size, boost::memory_order_relaxed);
+            size_type shard_max_size = get_shard_max_size(max_size);
+
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+
+                lock_type l(s.mtx_);
+                s.max_size_ = shard_max_size;
+                if (shard_max_size != 0 && !free_space(s, 0))
+                    retval = false;     // not able to shrink cache
+            }
+            return retval;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Check whether the cache currently holds an entry identified
+        ///        by the given key
+        ///
+        /// \param k      [in] The key for the entry which should be looked up
+        ///               in the cache.
+        ///
+        /// \note         This function does not call the entry's function
+        ///               \a entry#touch.
+        ///
+        /// \returns      This function returns \a true if the cache holds the
+        ///               referenced entry, otherwise it returns \a false.
+        bool holds_key(key_type const& k) const
+        {
+            shard const& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            return s.store_.find(k) != s.store_.end();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Get a specific entry identified by the given key.
+        ///
+        /// \param k      [in] The key for the entry which should be retrieved
+        ///               from the cache.
+        /// \param realkey [out] The key of the entry as stored in the cache.
+        /// \param val    [out] If the entry indexed by the key is found in the
+        ///               cache this value on successful return will be a copy
+        ///               of the corresponding entry.
+        ///
+        /// \note         The function will call the entry's \a entry#touch
+        ///               function if the value corresponding to the provided
+        ///               key is found in the cache.
+        ///
+        /// \returns      This function returns \a true if the cache holds the
+        ///               referenced entry, otherwise it returns \a false.
+        bool get_entry(key_type const& k, key_type& realkey, entry_type& val)
+        {
+            update_on_exit update(statistics_, statistics::method_get_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            iterator it = find_and_touch(s, k);
+            if (it == s.store_.end())
+                return false;
+
+            realkey = (*it).first;
+            val = (*it).second;
+            return true;
+        }
+
+        /// \brief Get a specific entry identified by the given key.
+        ///
+        /// \param k      [in] The key for the entry which should be retrieved
+        ///               from the cache.
+        /// \param val    [out] If the entry indexed by the key is found in the
+        ///               cache this value on successful return will be a copy
+        ///               of the corresponding entry.
+        ///
+        /// \note         The function will call the entry's \a entry#touch
+        ///               function if the value corresponding to the provided
+        ///               key is found in the cache.
+        ///
+        /// \returns      This function returns \a true if the cache holds the
+        ///               referenced entry, otherwise it returns \a false.
+        bool get_entry(key_type const& k, entry_type& val)
+        {
+            update_on_exit update(statistics_, statistics::method_get_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            iterator it = find_and_touch(s, k);
+            if (it == s.store_.end())
+                return false;
+
+            val = (*it).second;
+            return true;
+        }
+
+        /// \brief Get a specific entry identified by the given key.
+        ///
+        /// \param k      [in] The key for the entry which should be retrieved
+        ///               from the cache
+        /// \param val    [out] If the entry indexed by the key is found in the
+        ///               cache this value on successful return will be a copy
+        ///               of the corresponding value.
+        ///
+        /// \note         The function will call the entry's \a entry#touch
+        ///               function if the value corresponding to the provided
+        ///               is found in the cache.
+        ///
+        /// \returns      This function returns \a true if the cache holds the
+        ///               referenced entry, otherwise it returns \a false.
+        bool get_entry(key_type const& k, value_type& val)
+        {
+            update_on_exit update(statistics_, statistics::method_get_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            iterator it = find_and_touch(s, k);
+            if (it == s.store_.end())
+                return false;
+
+            val = (*it).second.get();
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Insert a new element into this cache
+        ///
+        /// \param k      [in] The key for the entry which should be added to
+        ///               the cache.
+        /// \param value  [in] The value which should be added to the cache.
+        ///
+        /// \note         See \a local_cache#insert.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully added to the cache, otherwise it returns
+        ///               \a false.
+        bool insert(key_type const& k, value_type const& val)
+        {
+            entry_type e(val);
+            return insert(k, e);
+        }
+
+        /// \brief Insert a new entry into this cache
+        ///
+        /// \param k      [in] The key for the entry which should be added to
+        ///               the cache.
+        /// \param value  [in] The entry which should be added to the cache.
+        ///
+        /// \note         See \a local_cache#insert.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully added to the cache, otherwise it returns
+        ///               \a false.
+        bool insert(key_type const& k, entry_type& e)
+        {
+            update_on_exit update(statistics_, statistics::method_insert_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            return insert_locked(s, k, e);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Update an existing element in this cache
+        ///
+        /// \param k      [in] The key for the value which should be updated in
+        ///               the cache.
+        /// \param value  [in] The value which should be used as a replacement
+        ///               for the existing value in the cache. Any existing
+        ///               cache entry is not changed except for its value.
+        ///
+        /// \note         See \a local_cache#update.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully updated, otherwise it returns \a false.
+        ///               If the entry currently is not held by the cache it is
+        ///               added and the return value reflects the outcome of
+        ///               the corresponding insert operation.
+        bool update(key_type const& k, value_type const& val)
+        {
+            return update_if(k, val,
+                [](key_type const&, key_type const&) { return true; });
+        }
+
+        /// \brief Update an existing element in this cache
+        ///
+        /// \param k      [in] The key for the value which should be updated in
+        ///               the cache.
+        /// \param value  [in] The value which should be used as a replacement
+        ///               for the existing value in the cache. Any existing
+        ///               cache entry is not changed except for its value.
+        /// \param f      [in] A callable taking two arguments, \a k and the
+        ///               key found in the cache (in that order). If \a f
+        ///               returns true, then the update will continue. If \a f
+        ///               returns false, then the update will not succeed.
+        ///               The callable is invoked while the shard holding the
+        ///               entry is locked.
+        ///
+        /// \note         See \a local_cache#update_if.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully updated, otherwise it returns \a false.
+        ///               If the entry currently is not held by the cache it is
+        ///               added and the return value reflects the outcome of
+        ///               the corresponding insert operation.
+        template <typename F>
+        bool update_if(key_type const& k, value_type const& val, F f)
+        {
+            update_on_exit update(statistics_, statistics::method_update_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end()) {
+                // doesn't exist in this cache
+                statistics_.got_miss();     // update statistics
+
+                entry_type e(val);
+                return insert_locked(s, k, e);
+            }
+
+            if (!f(k, (*it).first))
+                return false;
+
+            // update cache entry
+            (*it).second.get() = val;
+            (*it).second.touch();
+
+            // update statistics
+            statistics_.got_hit();
+
+            return true;
+        }
+
+        /// \brief Update an existing entry in this cache
+        ///
+        /// \param k      [in] The key for the entry which should be updated in
+        ///               the cache.
+        /// \param value  [in] The entry which should be used as a replacement
+        ///               for the existing entry in the cache. Any existing
+        ///               entry is first removed and then this entry is added.
+        ///
+        /// \note         See \a local_cache#update.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully updated, otherwise it returns \a false.
+        ///               If the entry currently is not held by the cache it is
+        ///               added and the return value reflects the outcome of
+        ///               the corresponding insert operation.
+        bool update(key_type const& k, entry_type& e)
+        {
+            update_on_exit update(statistics_, statistics::method_update_entry);
+
+            shard& s = get_shard(k);
+
+            lock_type l(s.mtx_);
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end()) {
+                // doesn't exist in this cache
+                statistics_.got_miss();     // update statistics
+                return insert_locked(s, k, e);
+            }
+
+            // make sure the old entry agrees to be removed
+            if (!(*it).second.remove())
+                return false;           // entry doesn't want to be removed
+
+            // make sure the new entry agrees to be inserted
+            if (!insert_policy_(e) || !e.insert())
+                return false;           // entry doesn't want to be inserted
+
+            // update cache entry, accounting for a changed entry size
+            s.current_size_.fetch_sub((*it).second.get_size(),
+                boost::memory_order_relaxed);
+            (*it).second = e;
+            (*it).second.touch();
+            s.current_size_.fetch_add((*it).second.get_size(),
+                boost::memory_order_relaxed);
+
+            // update statistics
+            statistics_.got_hit();
+
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Remove stored entries from the cache for which the supplied
+        ///        function object returns true.
+        ///
+        /// \param ep     [in] This parameter has to be a (unary) function
+        ///               object. It is invoked for each of the entries
+        ///               currently held in the cache while the shard holding
+        ///               the entry is locked. See \a local_cache#erase.
+        ///
+        /// \returns      This function returns the overall size of the removed
+        ///               entries (which is the sum of the values returned by
+        ///               the \a entry#get_size functions of the removed
+        ///               entries).
+        template <typename Func>
+        size_type erase(Func const& ep = policies::always<storage_value_type>())
+        {
+            update_on_exit update(statistics_, statistics::method_erase_entry);
+
+            size_type erased = 0;
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+
+                lock_type l(s.mtx_);
+                for (iterator it = s.store_.begin(); it != s.store_.end(); /**/)
+                {
+                    // do not remove this entry from the cache if either the
+                    // function object or the entries' remove function return
+                    // false
+                    storage_value_type& val = *it;
+                    if (ep(val) && val.second.remove())
+                    {
+                        size_type entry_size = val.second.get_size();
+                        s.current_size_.fetch_sub(entry_size,
+                            boost::memory_order_relaxed);
+                        erased += entry_size;
+
+                        it = s.store_.erase(it);
+
+                        // update statistics
+                        statistics_.got_eviction();
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            return erased;
+        }
+
+        /// \brief Remove all stored entries from the cache
+        ///
+        /// \note         See \a local_cache#erase.
+        ///
+        /// \returns      This function returns the overall size of the removed
+        ///               entries (which is the sum of the values returned by
+        ///               the \a entry#get_size functions of the removed
+        ///               entries).
+        size_type erase()
+        {
+            return erase(policies::always<storage_value_type>());
+        }
+
+        /// \brief Clear the cache
+        ///
+        /// Unconditionally removes all stored entries from the cache.
+        void clear()
+        {
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+
+                lock_type l(s.mtx_);
+                s.store_.clear();
+                s.current_size_.store(0, boost::memory_order_relaxed);
+            }
+            statistics_.clear();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Allow to access the embedded statistics instance
+        ///
+        /// \returns      This function returns a reference to the statistics
+        ///               instance embedded inside this cache
+        statistics_type const& get_statistics() const
+        {
+            return statistics_;
+        }
+
+        statistics_type& get_statistics()
+        {
+            return statistics_;
+        }
+
+    protected:
+        ///////////////////////////////////////////////////////////////////////
+        static std::size_t get_num_shards(size_type max_size,
+            std::size_t num_shards)
+        {
+            // use a power of two, but don't create shards which are too small
+            std::size_t result = 1;
+            while (2 * result <= num_shards &&
+                (max_size == 0 || max_size / (2 * result) >= min_shard_size))
+            {
+                result *= 2;
+            }
+            return result;
+        }
+
+        size_type get_shard_max_size(size_type max_size) const
+        {
+            return (max_size + num_shards_ - 1) / num_shards_;
+        }
+
+        void init_shards(size_type max_size)
+        {
+            size_type shard_max_size = get_shard_max_size(max_size);
+            for (std::size_t i = 0; i != num_shards_; ++i)
+                shards_[i].max_size_ = shard_max_size;
+        }
+
+        shard& get_shard(key_type const& k) const
+        {
+            // the shard is selected using the upper bits of the (mixed) hash
+            // as the lower bits select the bucket inside the shard
+            std::uint64_t h = static_cast<std::uint64_t>(hash_(k));
+            h *= 0x9e3779b97f4a7c15ULL;
+            return shards_[static_cast<std::size_t>(h >> 32) &
+                (num_shards_ - 1)];
+        }
+
+        iterator find_and_touch(shard& s, key_type const& k)
+        {
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end()) {
+                statistics_.got_miss();     // update statistics
+                return it;                  // doesn't exist in this cache
+            }
+
+            // touch the found entry, the entries are reordered only when
+            // space has to be freed
+            (*it).second.touch();
+
+            // update statistics
+            statistics_.got_hit();
+
+            return it;
+        }
+
+        bool insert_locked(shard& s, key_type const& k, entry_type& e)
+        {
+            // ask entry if it really wants to be inserted
+            if (!insert_policy_(e) || !e.insert())
+                return false;
+
+            if (s.store_.find(k) != s.store_.end())
+                return false;
+
+            // make sure cache doesn't get too large
+            size_type entry_size = e.get_size();
+            if (0 != s.max_size_ &&
+                s.current_size_.load(boost::memory_order_relaxed) +
+                    entry_size > s.max_size_ &&
+                !free_space(s, entry_size))
+            {
+                return false;
+            }
+
+            // insert new entry to cache
+            s.store_.insert(storage_value_type(k, e));
+            s.current_size_.fetch_add(entry_size, boost::memory_order_relaxed);
+
+            // update statistics
+            statistics_.got_insertion();
+
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Free some space in the given shard such that an entry of the given
+        // size fits. This orders the entries of the shard based on the
+        // UpdatePolicy and evicts the 'oldest' entries until an additional
+        // eighth of the capacity of the shard is available.
+        bool free_space(shard& s, size_type required)
+        {
+            size_type current_size =
+                s.current_size_.load(boost::memory_order_relaxed);
+            if (current_size + required <= s.max_size_)
+                return true;
+            if (required > s.max_size_)
+                return false;
+
+            size_type target = s.max_size_ - s.max_size_ / 8;
+
+            std::vector<iterator> heap;
+            heap.reserve(s.store_.size());
+            for (iterator it = s.store_.begin(); it != s.store_.end(); ++it)
+                heap.push_back(it);
+
+            adapt update_policy(update_policy_);
+            std::make_heap(heap.begin(), heap.end(), update_policy);
+
+            while (!heap.empty() && current_size + required > target)
+            {
+                std::pop_heap(heap.begin(), heap.end(), update_policy);
+                iterator it = heap.back();
+                heap.pop_back();
+
+                // do not remove this entry from the cache
+                if (!(*it).second.remove())
+                    continue;
+
+                current_size -= (*it).second.get_size();
+                s.store_.erase(it);
+
+                // update statistics
+                statistics_.got_eviction();
+            }
+
+            s.current_size_.store(current_size, boost::memory_order_relaxed);
+            return current_size + required <= s.max_size_;
+        }
+
+    private:
+        std::size_t const num_shards_;
+        std::unique_ptr<shard[]> shards_;
+        boost::atomic<size_type> max_size_;     // cache capacity
+
+        hash_type hash_;
+        update_policy_type update_policy_;
+        insert_policy_type insert_policy_;
+
+        statistics_type statistics_;        // embedded statistics instance
+    };
+}}}
+
+#endif
@@ -0,0 +1,107 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_CACHE_CONCURRENT_STATISTICS_OCT_17_2017_0210PM)
+#define HPX_UTIL_CACHE_CONCURRENT_STATISTICS_OCT_17_2017_0210PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/cache/statistics/no_statistics.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace util { namespace cache { namespace statistics
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The \a concurrent_statistics collects the same numbers as the
+    /// \a local_statistics, but may be updated concurrently from several
+    /// threads. It is meant to be used with the \a concurrent_cache.
+    class concurrent_statistics : public no_statistics
+    {
+    public:
+        concurrent_statistics()
+          : hits_(0), misses_(0), insertions_(0), evictions_(0)
+        {}
+
+        std::size_t get_and_reset(boost::atomic<std::size_t>& value,
+            bool reset)
+        {
+            if (reset)
+                return value.exchange(0, boost::memory_order_relaxed);
+            return value.load(boost::memory_order_relaxed);
+        }
+
+        std::size_t hits() const
+        {
+            return hits_.load(boost::memory_order_relaxed);
+        }
+        std::size_t misses() const
+        {
+            return misses_.load(boost::memory_order_relaxed);
+        }
+        std::size_t insertions() const
+        {
+            return insertions_.load(boost::memory_order_relaxed);
+        }
+        std::size_t evictions() const
+        {
+            return evictions_.load(boost::memory_order_relaxed);
+        }
+
+        std::size_t hits(bool reset)
+        {
+            return get_and_reset(hits_, reset);
+        }
+        std::size_t misses(bool reset)
+        {
+            return get_and_reset(misses_, reset);
+        }
+        std::size_t insertions(bool reset)
+        {
+            return get_and_reset(insertions_, reset);
+        }
+        std::size_t evictions(bool reset)
+        {
+            return get_and_reset(evictions_, reset);
+        }
+
+        void got_hit()
+        {
+            hits_.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void got_miss()
+        {
+            misses_.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void got_insertion()
+        {
+            insertions_.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void got_eviction()
+        {
+            evictions_.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void clear()
+        {
+            hits_.store(0, boost::memory_order_relaxed);
+            misses_.store(0, boost::memory_order_relaxed);
+            evictions_.store(0, boost::memory_order_relaxed);
+            insertions_.store(0, boost::memory_order_relaxed);
+        }
+
+    private:
+        boost::atomic<std::size_t> hits_;
+        boost::atomic<std::size_t> misses_;
+        boost::atomic<std::size_t> insertions_;
+        boost::atomic<std::size_t> evictions_;
+    };
+}}}}
+
+#endif
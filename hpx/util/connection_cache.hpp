@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2014 Hartmut Kaiser
+//  Copyright (c) 2007-2017 Hartmut Kaiser
 //  Copyright (c)      2012 Thomas Heller
 //  Copyright (c)      2012 Bryce Adelstein-Lelbach
 //
@@ -23,6 +23,10 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util/tuple.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
 #include <cstddef>
 #include <cstdint>
 #include <deque>
@@ -33,6 +37,8 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
+
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util
@@ -40,11 +46,24 @@ namespace hpx { namespace util
     ///////////////////////////////////////////////////////////////////////////
     /// This class implements an LRU cache to hold connections. It includes
     /// entries checked out from the cache in its cache size.
+    ///
+    /// The cache is split into independently locked stripes, each key is
+    /// assigned to one of those based on its hash value. Getting and
+    /// reclaiming connections for a key locks the corresponding stripe only.
+    /// The overall number of connections is tracked separately, space for a
+    /// new connection is reserved by atomically incrementing it only while it
+    /// is below the overall maximum. If the maximum is reached, the least
+    /// recently used connections of the stripe at hand are evicted first,
+    /// followed by those of all other stripes which are not locked at that
+    /// point. The LRU order is maintained per stripe.
     // TODO: investigate usage of boost.cache.
-    template <typename Connection, typename Key>
+    template <typename Connection, typename Key,
+        typename Hash = boost::hash<Key> >
     class connection_cache
     {
     public:
+        HPX_NON_COPYABLE(connection_cache);
+
         typedef hpx::lcos::local::spinlock mutex_type;
 
         typedef std::shared_ptr<Connection> connection_type;
@@ -60,6 +79,19 @@ namespace hpx { namespace util
         typedef std::map<key_type, cache_value_type> cache_type;
         typedef typename cache_type::size_type size_type;
 
+    private:
+        enum { num_stripes = 16 };
+
+        struct stripe
+        {
+            mutable mutex_type mtx_;
+            key_tracker_type key_tracker_;
+            cache_type cache_;
+
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+    public:
         connection_cache(
             size_type max_connections
           , size_type max_connections_per_locality
@@ -134,13 +166,22 @@ namespace hpx { namespace util
             return util::get<3>(entry);
         }
 
+        stripe& get_stripe(key_type const& l)
+        {
+            return stripes_[Hash()(l) % num_stripes];
+        }
+        stripe const& get_stripe(key_type const& l) const
+        {
+            return stripes_[Hash()(l) % num_stripes];
+        }
+
         ///////////////////////////////////////////////////////////////////////
-        // Increase the per-locality and overall connection counts.
+        // Increase the per-locality connection count, the caller has
+        // reserved space in the overall connection count already.
         void increment_connection_count(cache_value_type& e)
         {
             std::size_t& num_connections = num_existing_connections(e);
             ++num_connections;
-            ++connections_;
 
             // If appropriate, update the maximum number of allowed cached
             // connections.
@@ -179,20 +220,21 @@ namespace hpx { namespace util
         ///          \a reclaim().
         connection_type get(key_type const& l)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
 
                 // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                  , key_tracker_
+                s.key_tracker_.splice(
+                    s.key_tracker_.end()
+                  , s.key_tracker_
                   , lru_reference(it->second)
                 );
 
@@ -205,14 +247,14 @@ namespace hpx { namespace util
                     connections.pop_front();
 
                     ++hits_;
-                    check_invariants();
+                    check_invariants(s);
                     return result;
                 }
             }
 
             // If we get here then the item is not in the cache.
             ++misses_;
-            check_invariants();
+            check_invariants(s);
             return connection_type();
         }
 
@@ -236,19 +278,20 @@ namespace hpx { namespace util
         bool get_or_reserve(key_type const& l, connection_type& conn,
             bool force_insert = false)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
 
                 // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                  , key_tracker_
+                s.key_tracker_.splice(
+                    s.key_tracker_.end()
+                  , s.key_tracker_
                   , lru_reference(it->second)
                 );
 
@@ -264,7 +307,7 @@ namespace hpx { namespace util
                     conn->set_state(Connection::state_reinitialized);
 #endif
                     ++hits_;
-                    check_invariants();
+                    check_invariants(s);
                     return true;
                 }
 
@@ -283,26 +326,29 @@ namespace hpx { namespace util
                     // reduced in size next time some connection is handed back
                     // to the cache).
 
-                    if (!free_space() &&
-                        num_existing_connections(it->second) != 0 &&
-                        !force_insert)
+                    if (!reserve_connection(s, &l))
                     {
-                        // If we can't find or make space, give up.
-                        ++misses_;
-                        check_invariants();
-                        return false;
+                        if (num_existing_connections(it->second) != 0 &&
+                            !force_insert)
+                        {
+                            // If we can't find or make space, give up.
+                            ++misses_;
+                            check_invariants(s);
+                            return false;
+                        }
+                        ++connections_;
                     }
 
                     // Make sure the input connection shared_ptr doesn't hold
                     // anything.
                     conn.reset();
 
-                    // Increase the per-locality and overall connection counts.
+                    // Increase the per-locality connection count.
                     increment_connection_count(it->second);
 
                     // Statistics
                     ++insertions_;
-                    check_invariants();
+                    check_invariants(s);
                     return true;
                 }
 
@@ -310,7 +356,7 @@ namespace hpx { namespace util
                 // locality, and none of them are checked into the cache, so
                 // we have to give up.
                 ++misses_;
-                check_invariants();
+                check_invariants(s);
                 return false;
             }
 
@@ -318,19 +364,19 @@ namespace hpx { namespace util
 
             // See if we have enough space or can make space available.
 
-            // Note that we ignore the outcome of free_space() here as we have
-            // to guarantee to have space for the new connection as there are
-            // no connections outstanding for this locality. If free_space
-            // fails we grow the cache size beyond its limit (hoping that it
-            // will be reduced in size next time some connection is handed back
-            // to the cache).
-            free_space();
+            // Note that we have to guarantee to have space for the new
+            // connection as there are no connections outstanding for this
+            // locality. If no space can be reserved we grow the cache size
+            // beyond its limit (hoping that it will be reduced in size next
+            // time some connection is handed back to the cache).
+            if (!reserve_connection(s, nullptr))
+                ++connections_;
 
             // Update LRU meta data.
             typename key_tracker_type::iterator kt =
-                key_tracker_.insert(key_tracker_.end(), l);
+                s.key_tracker_.insert(s.key_tracker_.end(), l);
 
-            cache_.insert(std::make_pair(
+            s.cache_.insert(std::make_pair(
                 l, util::make_tuple(
                     value_type(), 1, max_connections_per_locality_, kt
                 ))
@@ -339,11 +385,8 @@ namespace hpx { namespace util
             // Make sure the input connection shared_ptr doesn't hold anything.
             conn.reset();
 
-            // Increase the overall connection counts.
-            ++connections_;
-
             ++insertions_;
-            check_invariants();
+            check_invariants(s);
             return true;
         }
 
@@ -353,16 +396,17 @@ namespace hpx { namespace util
         ///       a prior call to \a get() or \a get_or_reserve().
         void reclaim(key_type const& l, connection_type const& conn)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Search for an entry for this key.
-            typename cache_type::iterator const ct = cache_.find(l);
+            typename cache_type::iterator const ct = s.cache_.find(l);
 
-            if (ct != cache_.end()) {
+            if (ct != s.cache_.end()) {
                 // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                  , key_tracker_
+                s.key_tracker_.splice(
+                    s.key_tracker_.end()
+                  , s.key_tracker_
                   , lru_reference(ct->second)
                 );
 
@@ -396,7 +440,7 @@ namespace hpx { namespace util
 
                 // FIXME: Again, this should probably throw instead of asserting,
                 // as invariants could be invalidated here due to caller error.
-                check_invariants();
+                check_invariants(s);
             }
 //             else {
 //                 // Key should already exist in the cache. FIXME: This should
@@ -409,24 +453,23 @@ namespace hpx { namespace util
         /// than the maximum number of overall connections, and false otherwise.
         bool full() const
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return (connections_ >= max_connections_);
+            return (connections_.load() >= max_connections_);
         }
 
         /// Returns true if the connection count for \a l is equal to or larger
         /// than the maximum connection count per locality, and false otherwise.
         bool full(key_type const& l) const
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe const& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
-            if (!cache_.count(l))
-                return false || (connections_ >= max_connections_);
+            typename cache_type::const_iterator ct = s.cache_.find(l);
+            if (ct == s.cache_.end())
+                return (connections_.load() >= max_connections_);
 
-            typename cache_type::const_iterator ct = cache_.find(l);
-            HPX_ASSERT(ct != cache_.end());
             return (num_existing_connections(ct->second) >=
                     max_num_connections(ct->second))
-                || (connections_ >= max_connections_);
+                || (connections_.load() >= max_connections_);
         }
 
         /// Destroys all connections in the cache, and resets all counts.
@@ -436,9 +479,18 @@ namespace hpx { namespace util
         ///       invariants.
         void clear()
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            key_tracker_.clear();
-            cache_.clear();
+            // acquire the locks in ascending order, all other operations lock
+            // at most one stripe unconditionally
+            std::vector<std::unique_lock<mutex_type> > locks;
+            locks.reserve(num_stripes);
+            for (stripe& s : stripes_)
+                locks.emplace_back(s.mtx_);
+
+            for (stripe& s : stripes_)
+            {
+                s.key_tracker_.clear();
+                s.cache_.clear();
+            }
             connections_ = 0;
 
             insertions_ = 0;
@@ -449,7 +501,8 @@ namespace hpx { namespace util
 
             // FIXME: This should probably throw instead of asserting, as it
             // can be triggered by caller error.
-            check_invariants();
+            for (stripe& s : stripes_)
+                check_invariants(s);
         }
 
         /// Destroys all connections for the given locality in the cache, reset
@@ -460,14 +513,15 @@ namespace hpx { namespace util
         ///       invariants.
         void clear(key_type const& l)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
                 // Remove from LRU meta data.
-                key_tracker_.erase(lru_reference(it->second));
+                s.key_tracker_.erase(lru_reference(it->second));
 
                 // correct counter to avoid assertions later on
                 std::size_t num_existing = num_existing_connections(it->second);
@@ -475,23 +529,24 @@ namespace hpx { namespace util
                 evictions_ += num_existing;
 
                 // Erase entry if key exists in the cache.
-                cache_.erase(it);
+                s.cache_.erase(it);
             }
 
             // FIXME: This should probably throw instead of asserting, as it
             // can be triggered by caller error.
-            check_invariants();
+            check_invariants(s);
         }
 
         /// Destroys all connections for the given locality in the cache, reset
         /// all associated counts.
         void clear(key_type const& l, connection_type const& conn)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            stripe& s = get_stripe(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator const it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
                 // Adjust the number of existing connections for this key.
                 decrement_connection_count(it->second);
@@ -505,50 +560,45 @@ namespace hpx { namespace util
 #endif
             }
 
-            check_invariants();
+            check_invariants(s);
         }
 
         // access statistics
         std::int64_t get_cache_insertions(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
             return util::get_and_reset_value(insertions_, reset);
         }
 
         std::int64_t get_cache_evictions(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
             return util::get_and_reset_value(evictions_, reset);
         }
 
         std::int64_t get_cache_hits(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
             return util::get_and_reset_value(hits_, reset);
         }
 
         std::int64_t get_cache_misses(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
             return util::get_and_reset_value(misses_, reset);
         }
 
         std::int64_t get_cache_reclaims(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
             return util::get_and_reset_value(reclaims_, reset);
         }
 
     private:
-        /// Verify class invariants
-        void check_invariants() const
+        /// Verify class invariants of the given (locked) stripe
+        void check_invariants(stripe const& s) const
         {
 #if defined(HPX_DEBUG)
             typedef typename cache_type::const_iterator const_iterator;
 
             size_type in_cache_count = 0, total_count = 0;
-            const_iterator end = cache_.end();
-            for (const_iterator ct = cache_.begin(); ct != end; ++ct)
+            const_iterator end = s.cache_.end();
+            for (const_iterator ct = s.cache_.begin(); ct != end; ++ct)
             {
                 cache_value_type const& val = ct->second;
 
@@ -566,60 +616,108 @@ namespace hpx { namespace util
             }
 
             // Overall connection count should be larger than or equal to the
-            // number of entries in the cache.
-            HPX_ASSERT(in_cache_count <= connections_);
-
-            // Overall connection count should be equal to the sum of connection
-            // counts for all localities.
-            HPX_ASSERT(total_count == connections_);
+            // number of connections in this stripe. The other stripes are
+            // not locked, thus the overall counts can't be compared exactly.
+            HPX_ASSERT(in_cache_count <= total_count);
+            HPX_ASSERT(total_count <= connections_.load());
 
             // The list of key trackers should have the same size as the cache.
-            HPX_ASSERT(key_tracker_.size() == cache_.size());
+            HPX_ASSERT(s.key_tracker_.size() == s.cache_.size());
 #endif
         }
 
-        /// Evict the least recently used removable entry from the cache if the
-        /// cache is full.
+        /// Reserve space for a new connection in the overall connection
+        /// count. The count is incremented only if it is below the maximum,
+        /// otherwise cached connections are evicted (see free_space()) and
+        /// the reservation is retried.
+        ///
+        /// \returns Returns true if space was reserved, and false if nothing
+        ///          could be evicted.
+        bool reserve_connection(stripe& s, key_type const* keep)
+        {
+            size_type count = connections_.load();
+            while (true)
+            {
+                if (count < max_connections_)
+                {
+                    if (connections_.compare_exchange_weak(count, count + 1))
+                        return true;
+                    continue;
+                }
+
+                if (!free_space(s, keep))
+                    return false;
+
+                count = connections_.load();
+            }
+        }
+
+        /// Evict the least recently used removable entries from the cache if
+        /// the cache is full. The given stripe is locked by the caller and is
+        /// looked at first, all other stripes are skipped if they are locked
+        /// by somebody else.
         ///
         /// \returns Returns true if an entry was evicted or if the cache is not
         ///          full, and false if nothing could be evicted.
-        bool free_space()
+        bool free_space(stripe& current, key_type const* keep = nullptr)
         {
             // If the cache isn't full, just return true.
-            if (connections_ < max_connections_)
+            if (connections_.load() < max_connections_)
+                return true;
+
+            if (free_space_locked(current, keep))
                 return true;
 
+            for (stripe& s : stripes_)
+            {
+                if (&s == &current)
+                    continue;
+
+                std::unique_lock<mutex_type> l(s.mtx_, std::try_to_lock);
+                if (l.owns_lock() && free_space_locked(s, nullptr))
+                    return true;
+            }
+
+            // Everything which could be evicted must be currently checked
+            // out.
+            return false;
+        }
+
+        // The entry for the key 'keep' (if given) is not removed as it is
+        // referred to by the caller.
+        bool free_space_locked(stripe& s, key_type const* keep)
+        {
             // Find the least recently used key.
-            typename key_tracker_type::iterator kt = key_tracker_.begin();
+            typename key_tracker_type::iterator kt = s.key_tracker_.begin();
 
-            while (connections_ >= max_connections_)
+            while (connections_.load() >= max_connections_)
             {
+                // If we've gone through key_tracker_ and haven't found
+                // anything evict-able, then all the entries must be
+                // currently checked out.
+                if (s.key_tracker_.end() == kt)
+                    return false;
+
                 // Find the least recently used keys data.
-                typename cache_type::iterator ct = cache_.find(*kt);
-                HPX_ASSERT(ct != cache_.end());
+                typename cache_type::iterator ct = s.cache_.find(*kt);
+                HPX_ASSERT(ct != s.cache_.end());
 
                 // If the entry is empty, ignore it and try the next least
                 // recently used entry.
                 if (cached_connections(ct->second).empty())
                 {
                     // Remove the key if its connection count is zero.
-                    if (0 == num_existing_connections(ct->second)) {
-                        cache_.erase(ct);
-                        key_tracker_.erase(kt);
-                        kt = key_tracker_.begin();
+                    if (0 == num_existing_connections(ct->second) &&
+                        (keep == nullptr || !(*keep == *kt)))
+                    {
+                        s.cache_.erase(ct);
+                        kt = s.key_tracker_.erase(kt);
                     }
                     else {
                         // REVIEW: Should we reorder key_tracker_ to speed up
                         // the eviction?
                         ++kt;
                     }
-
-                    // If we've gone through key_tracker_ and haven't found
-                    // anything evict-able, then all the entries must be
-                    // currently checked out.
-                    if (key_tracker_.end() == kt)
-                        return false;
-
                     continue;
                 }
 
@@ -636,20 +734,18 @@ namespace hpx { namespace util
             return true;
         }
 
-        mutable mutex_type mtx_;
         size_type const max_connections_;
         size_type const max_connections_per_locality_;
-        key_tracker_type key_tracker_;
-        cache_type cache_;
-        size_type connections_;
+        stripe stripes_[num_stripes];
+        boost::atomic<size_type> connections_;
         bool shutting_down_;
 
         // statistics support
-        std::int64_t insertions_;
-        std::int64_t evictions_;
-        std::int64_t hits_;
-        std::int64_t misses_;
-        std::int64_t reclaims_;
+        boost::atomic<std::int64_t> insertions_;
+        boost::atomic<std::int64_t> evictions_;
+        boost::atomic<std::int64_t> hits_;
+        boost::atomic<std::int64_t> misses_;
+        boost::atomic<std::int64_t> reclaims_;
     };
 }}
 
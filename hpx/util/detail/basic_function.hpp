@@ -19,6 +19,7 @@
 #include <hpx/util/detail/vtable/vtable.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <type_traits>
@@ -265,10 +266,10 @@ namespace hpx { namespace util { namespace detail
             ar >> is_empty;
             if (!is_empty)
             {
-                std::string name;
-                ar >> name;
+                std::uint64_t hash =
+                    serialization::detail::load_polymorphic_type_hash(ar);
 
-                this->vptr = detail::get_vtable<vtable>(name);
+                this->vptr = detail::get_vtable<vtable>(hash);
                 this->vptr->load_object(this->object, ar, version);
             }
         }
@@ -279,8 +280,8 @@ namespace hpx { namespace util { namespace detail
             ar << is_empty;
             if (!is_empty)
             {
-                std::string function_name = this->vptr->name;
-                ar << function_name;
+                serialization::detail::save_polymorphic_type_hash(
+                    ar, this->vptr->hash);
 
                 this->vptr->save_object(this->object, ar, version);
             }
@@ -10,10 +10,12 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_intrusive_factory.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_type_hash.hpp>
 #include <hpx/util/detail/function_registration.hpp>
 #include <hpx/util/detail/vtable/serializable_vtable.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
 
+#include <cstdint>
 #include <string>
 #include <type_traits>
 
@@ -25,12 +27,14 @@ namespace hpx { namespace util { namespace detail
       : VTable, serializable_vtable
     {
         char const* name;
+        std::uint64_t hash;
 
         template <typename T>
         serializable_function_vtable(construct_vtable<T>) noexcept
           : VTable(construct_vtable<T>())
           , serializable_vtable(construct_vtable<T>())
           , name(this->empty ? "empty" : get_function_name<VTable, T>())
+          , hash(hpx::serialization::detail::polymorphic_type_hash(name))
         {
             hpx::serialization::detail::polymorphic_intrusive_factory::instance().
                 register_class(name, &serializable_function_vtable::get_vtable<T>);
@@ -45,11 +49,11 @@ namespace hpx { namespace util { namespace detail
     };
 
     template <typename VTable>
-    VTable const* get_vtable(std::string const& name)
+    VTable const* get_vtable(std::uint64_t hash)
     {
         return
             hpx::serialization::detail::polymorphic_intrusive_factory::instance().
-                create<VTable const>(name);
+                create<VTable const>(hash);
     }
 }}}
 
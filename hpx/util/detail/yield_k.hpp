@@ -35,7 +35,7 @@ namespace hpx { namespace util { namespace detail
 #endif
         else if(k < 32 || k & 1) //-V112
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::this_thread::can_suspend())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(0);
@@ -51,7 +51,7 @@ namespace hpx { namespace util { namespace detail
         }
         else
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::this_thread::can_suspend())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(1);
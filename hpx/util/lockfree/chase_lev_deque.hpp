@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: http://dl.acm.org/citation.cfm?id=1073974
+//
+//  Memory orderings follow "Correct and Efficient Work-Stealing for Weak
+//  Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//  Link: http://dl.acm.org/citation.cfm?id=2442524
+//
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  The deque has exactly one owner which is the only thread allowed to call
+//  push() and pop(). Any thread may call steal(). push() is wait-free, pop()
+//  needs an atomic read-modify-write operation only if it competes with a
+//  thief for the last element, steal() is lock-free.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_SEP_14_2017_0412PM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_SEP_14_2017_0412PM
+
+#include <hpx/config.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost { namespace lockfree
+{
+
+template <typename T>
+struct chase_lev_array
+{
+    typedef std::int64_t index_type;
+
+    explicit chase_lev_array(std::size_t log_size)
+      : log_size_(log_size),
+        mask_((index_type(1) << log_size) - 1),
+        buffer_(new boost::atomic<T>[std::size_t(1) << log_size]),
+        next_(nullptr)
+    {}
+
+    ~chase_lev_array()
+    {
+        delete [] buffer_;
+    }
+
+    index_type size() const
+    {
+        return mask_ + 1;
+    }
+
+    T get(index_type i) const
+    {
+        return buffer_[i & mask_].load(boost::memory_order_relaxed);
+    }
+
+    void put(index_type i, T const& val)
+    {
+        buffer_[i & mask_].store(val, boost::memory_order_relaxed);
+    }
+
+    // Create a new array of twice the size holding all elements in [top, bottom)
+    chase_lev_array* grow(index_type bottom, index_type top) const
+    {
+        chase_lev_array* a = new chase_lev_array(log_size_ + 1);
+        for (index_type i = top; i != bottom; ++i)
+            a->put(i, get(i));
+        a->next_ = const_cast<chase_lev_array*>(this);
+        return a;
+    }
+
+    std::size_t log_size_;
+    index_type mask_;
+    boost::atomic<T>* buffer_;
+
+    // arrays which were replaced by grow() are kept alive until the deque is
+    // destroyed as concurrent thieves might still read from them
+    chase_lev_array* next_;
+};
+
+template <typename T>
+class chase_lev_deque
+{
+    BOOST_STATIC_ASSERT((boost::has_trivial_destructor<T>::value));
+    BOOST_STATIC_ASSERT((boost::has_trivial_assign<T>::value));
+
+    typedef chase_lev_array<T> array_type;
+    typedef typename array_type::index_type index_type;
+
+    HPX_NON_COPYABLE(chase_lev_deque);
+
+    static std::size_t log2_ceil(std::size_t initial_size)
+    {
+        std::size_t log_size = 4;       // start with at least 16 elements
+        while ((std::size_t(1) << log_size) < initial_size)
+            ++log_size;
+        return log_size;
+    }
+
+  public:
+    typedef T value_type;
+
+    explicit chase_lev_deque(std::size_t initial_size = 0)
+      : top_(0), bottom_(0), array_(new array_type(log2_ceil(initial_size)))
+    {}
+
+    ~chase_lev_deque()
+    {
+        array_type* a = array_.load(boost::memory_order_relaxed);
+        while (a != nullptr)
+        {
+            array_type* next = a->next_;
+            delete a;
+            a = next;
+        }
+    }
+
+    // Owner only: push a new element to the bottom of the deque.
+    bool push(T const& val)
+    {
+        index_type b = bottom_.load(boost::memory_order_relaxed);
+        index_type t = top_.load(boost::memory_order_acquire);
+        array_type* a = array_.load(boost::memory_order_relaxed);
+
+        if (b - t > a->size() - 1)
+        {
+            a = a->grow(b, t);
+            array_.store(a, boost::memory_order_release);
+        }
+
+        a->put(b, val);
+        boost::atomic_thread_fence(boost::memory_order_release);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only: pop the element which was pushed last (LIFO).
+    bool pop(T& val)
+    {
+        index_type b = bottom_.load(boost::memory_order_relaxed) - 1;
+        array_type* a = array_.load(boost::memory_order_relaxed);
+        bottom_.store(b, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        index_type t = top_.load(boost::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // deque was empty
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->get(b);
+        if (t == b)
+        {
+            // single last element, compete with thieves
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return result;
+        }
+        return true;
+    }
+
+    // Any thread: take the oldest element from the top of the deque (FIFO).
+    // This fails if the deque is empty or if another thread won the race for
+    // the same element.
+    bool steal(T& val)
+    {
+        index_type t = top_.load(boost::memory_order_acquire);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        index_type b = bottom_.load(boost::memory_order_acquire);
+
+        if (t >= b)
+            return false;
+
+        array_type* a = array_.load(boost::memory_order_acquire);
+        T tmp = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        val = tmp;
+        return true;
+    }
+
+    bool empty() const
+    {
+        index_type b = bottom_.load(boost::memory_order_relaxed);
+        index_type t = top_.load(boost::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::size_t size() const
+    {
+        index_type b = bottom_.load(boost::memory_order_relaxed);
+        index_type t = top_.load(boost::memory_order_relaxed);
+        return b > t ? std::size_t(b - t) : 0;
+    }
+
+  private:
+    // top_ is written by thieves, bottom_ only by the owner, keep them on
+    // separate cache lines
+    boost::atomic<index_type> top_;
+    char padding1_[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(index_type)];
+    boost::atomic<index_type> bottom_;
+    boost::atomic<array_type*> array_;
+    char padding2_[BOOST_LOCKFREE_CACHELINE_BYTES -
+        sizeof(index_type) - sizeof(array_type*)];
+};
+
+}}
+
+#endif // HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_SEP_14_2017_0412PM
@@ -0,0 +1,107 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This file implements a light-weight event recorder which keeps a timeline
+// of the HPX-thread related events (creation, execution, suspension,
+// termination, stealing) and of the parcels sent and received by this
+// locality. Each OS-thread records into its own fixed size ring buffer, older
+// entries are overwritten once the buffer is full. The recorded events can be
+// written in the Chrome trace event format (JSON), which can be inspected
+// using chrome://tracing or the Perfetto UI.
+
+#if !defined(HPX_UTIL_THREAD_TRACE_OCT_17_2017_1150AM)
+#define HPX_UTIL_THREAD_TRACE_OCT_17_2017_1150AM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_THREAD_TRACE)
+#include <hpx/util/thread_description.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace hpx { namespace util { namespace thread_trace
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum event_type
+    {
+        thread_create = 0,      ///< a new HPX-thread was created
+        thread_run = 1,         ///< an HPX-thread starts/resumes executing
+        thread_suspend = 2,     ///< an HPX-thread returned to the scheduler
+        thread_terminate = 3,   ///< an HPX-thread finished executing
+        thread_steal = 4,       ///< a worker stole work from another queue
+        parcel_send = 5,        ///< parcels were sent to another locality
+        parcel_receive = 6      ///< parcels were received from another locality
+    };
+
+    namespace detail
+    {
+        HPX_API_EXPORT extern std::atomic<bool> enabled;
+
+        HPX_API_EXPORT void record(event_type type, void const* id,
+            char const* desc, std::uint64_t data);
+        HPX_API_EXPORT void record(event_type type, void const* id,
+            util::thread_description const& desc, std::uint64_t data);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Record an event into the ring buffer of the calling OS-thread. This is
+    /// a no-op (besides a relaxed load) if tracing is disabled. The (possibly
+    /// truncated) description is copied into the recorded event. Note that
+    /// the arguments are evaluated regardless, callers which have to do
+    /// expensive work to compute them should check is_enabled() first.
+    inline void record(event_type type, void const* id,
+        char const* desc = nullptr, std::uint64_t data = 0)
+    {
+        if (HPX_UNLIKELY(detail::enabled.load(std::memory_order_relaxed)))
+            detail::record(type, id, desc, data);
+    }
+
+    inline void record(event_type type, void const* id,
+        util::thread_description const& desc, std::uint64_t data = 0)
+    {
+        if (HPX_UNLIKELY(detail::enabled.load(std::memory_order_relaxed)))
+        {
+            detail::record(type, id, desc, data);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Enable or disable the recording of events at runtime.
+    HPX_API_EXPORT void enable(bool enabled = true);
+
+    inline bool is_enabled()
+    {
+        return detail::enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Apply the settings from the [hpx.trace] configuration section. The
+    /// buffer size (number of events per OS-thread) is rounded up to the next
+    /// power of two, the destination names the file the events are written
+    /// to at shutdown (no file is written if it is empty).
+    HPX_API_EXPORT void configure(bool enabled, std::size_t buffer_size,
+        std::string const& destination);
+
+    /// Associate the calling OS-thread with the given name, which is used to
+    /// label the corresponding track in the generated trace.
+    HPX_API_EXPORT void register_thread(char const* name);
+
+    /// Write all recorded events in the Chrome trace event format. Events
+    /// which are recorded concurrently may or may not be included.
+    HPX_API_EXPORT void dump(std::ostream& os);
+    HPX_API_EXPORT bool dump(std::string const& filename);
+
+    /// Write all recorded events to the configured destination, if any.
+    HPX_API_EXPORT void dump_at_shutdown();
+
+    /// Discard all recorded events.
+    HPX_API_EXPORT void clear();
+}}}
+
+#endif
+#endif
@@ -34,7 +34,8 @@ namespace hpx { namespace plugins { namespace parcel
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type num_parcels_per_message,
         get_counter_type average_time_between_parcels,
-        get_counter_values_creator_type time_between_parcels_histogram_creator)
+        get_counter_values_creator_type time_between_parcels_histogram_creator,
+        get_counter_values_creator_type parcels_per_message_histogram_creator)
     {
         if (name.empty())
         {
@@ -53,7 +54,8 @@ namespace hpx { namespace plugins { namespace parcel
                 num_parcels, num_messages,
                 num_parcels_per_message, average_time_between_parcels,
                 time_between_parcels_histogram_creator,
-                0, 0, 1
+                0, 0, 1,
+                parcels_per_message_histogram_creator
             };
 
             map_.emplace(name, std::move(data));
@@ -68,6 +70,8 @@ namespace hpx { namespace plugins { namespace parcel
                 average_time_between_parcels;
             (*it).second.time_between_parcels_histogram_creator =
                 time_between_parcels_histogram_creator;
+            (*it).second.parcels_per_message_histogram_creator =
+                parcels_per_message_histogram_creator;
 
             if ((*it).second.min_boundary != (*it).second.max_boundary)
             {
@@ -205,6 +209,36 @@ namespace hpx { namespace plugins { namespace parcel
         return result;
     }
 
+    coalescing_counter_registry::get_counter_values_type
+        coalescing_counter_registry::get_parcels_per_message_histogram_counter(
+            std::string const& name, std::int64_t min_boundary,
+            std::int64_t max_boundary, std::int64_t num_buckets)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::"
+                    "get_parcels_per_message_histogram_counter",
+                "unknown action type");
+            return &coalescing_counter_registry::empty_histogram;
+        }
+
+        if ((*it).second.parcels_per_message_histogram_creator.empty())
+        {
+            // no parcel of this type has been sent yet
+            return coalescing_counter_registry::get_counter_values_type();
+        }
+
+        coalescing_counter_registry::get_counter_values_type result;
+        (*it).second.parcels_per_message_histogram_creator(
+            min_boundary, max_boundary, num_buckets, result);
+        return result;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool coalescing_counter_registry::counter_discoverer(
         performance_counters::counter_info const& info,
@@ -21,7 +21,9 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
+#include <boost/atomic.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -84,19 +86,29 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        // Each OS thread is assigned its own buffer stripe (modulo the number
+        // of available stripes) on first use.
+        std::size_t get_buffer_stripe()
+        {
+            static boost::atomic<std::size_t> next_stripe(0);
+            static HPX_NATIVE_TLS std::size_t stripe = std::size_t(-1);
+
+            if (stripe == std::size_t(-1))
+                stripe = next_stripe++;
+            return stripe;
+        }
     }
 
     void coalescing_message_handler::update_num_messages()
     {
-        std::lock_guard<mutex_type> l(mtx_);
-        num_coalesced_parcels_ =
-            detail::get_num_messages(num_coalesced_parcels_);
+        num_coalesced_parcels_.store(
+            detail::get_num_messages(num_coalesced_parcels_.load()));
     }
 
     void coalescing_message_handler::update_interval()
     {
-        std::lock_guard<mutex_type> l(mtx_);
-        interval_ = detail::get_interval(interval_);
+        interval_.store(detail::get_interval(interval_.load()));
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -105,7 +117,8 @@ namespace hpx { namespace plugins { namespace parcel
       : pp_(pp),
         num_coalesced_parcels_(detail::get_num_messages(num)),
         interval_(detail::get_interval(interval)),
-        buffer_(num_coalesced_parcels_),
+        stripes_(new buffer_stripe[num_stripes]),
+        num_buffered_parcels_(0),
         timer_(
             util::bind(&coalescing_message_handler::timer_flush, this_()),
             util::bind(&coalescing_message_handler::flush_terminate, this_()),
@@ -113,6 +126,7 @@ namespace hpx { namespace plugins { namespace parcel
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
         action_name_(action_name),
+        estimated_time_between_parcels_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
@@ -120,6 +134,7 @@ namespace hpx { namespace plugins { namespace parcel
         started_at_(util::high_resolution_clock::now()),
         reset_time_num_parcels_(0),
         last_parcel_time_(started_at_),
+        collect_time_between_parcels_(false),
         histogram_min_boundary_(-1),
         histogram_max_boundary_(-1),
         histogram_num_buckets_(-1)
@@ -137,7 +152,9 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::
                 get_average_time_between_parcels, this, _1),
             util::bind(&coalescing_message_handler::
-                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4));
+                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4),
+            util::bind(&coalescing_message_handler::
+                get_parcels_per_message_histogram_creator, this, _1, _2, _3, _4));
 
         // register parameter update callbacks
         set_config_entry_callback(
@@ -148,75 +165,128 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::update_interval, this));
     }
 
+    // The number of parcels to coalesce is the number of parcels expected to
+    // arrive during the configured interval, limited by the configured number
+    // of parcels.
+    std::size_t coalescing_message_handler::get_adaptive_num_messages(
+        std::int64_t time_between_parcels) const
+    {
+        std::size_t num_messages = num_coalesced_parcels_.load(
+            boost::memory_order_relaxed);
+        if (time_between_parcels <= 0)
+            return num_messages;
+
+        std::int64_t interval = std::int64_t(
+            interval_.load(boost::memory_order_relaxed)) * 1000;
+        std::size_t expected =
+            static_cast<std::size_t>(interval / time_between_parcels);
+
+        if (expected == 0)
+            return 1;
+        return (std::min)(expected, num_messages);
+    }
+
+    // Parcels are not held back for longer than twice the time it is expected
+    // to take to collect the adapted number of parcels, limited by the
+    // configured interval.
+    std::int64_t coalescing_message_handler::get_adaptive_interval(
+        std::int64_t time_between_parcels, std::size_t num_messages) const
+    {
+        std::int64_t interval = std::int64_t(
+            interval_.load(boost::memory_order_relaxed)) * 1000;
+        if (time_between_parcels <= 0)
+            return interval;
+
+        std::int64_t expected =
+            2 * time_between_parcels * std::int64_t(num_messages);
+        return (std::max)(std::int64_t(1000), (std::min)(expected, interval));
+    }
+
     void coalescing_message_handler::put_parcel(
         parcelset::locality const& dest, parcelset::parcel p,
         write_handler_type f)
     {
-        std::unique_lock<mutex_type> l(mtx_);
         ++num_parcels_;
 
         // get time since last parcel
         std::int64_t parcel_time = util::high_resolution_clock::now();
-        std::int64_t time_since_last_parcel = parcel_time - last_parcel_time_;
-        last_parcel_time_ = parcel_time;
+        std::int64_t time_since_last_parcel =
+            parcel_time - last_parcel_time_.exchange(parcel_time);
+        if (time_since_last_parcel < 0)
+            time_since_last_parcel = 0;
 
         // collect data for time between parcels histogram
-        if (time_between_parcels_)
-            (*time_between_parcels_)(time_since_last_parcel);
+        if (collect_time_between_parcels_.load(boost::memory_order_relaxed))
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            (*time_between_parcels_)(double(time_since_last_parcel));
+        }
 
-        std::chrono::microseconds interval(interval_);
+        // update the moving average of the time between parcels, long pauses
+        // are capped to allow for quick adaptation once parcels arrive again
+        std::int64_t interval = std::int64_t(
+            interval_.load(boost::memory_order_relaxed)) * 1000;
+        std::int64_t estimate = estimated_time_between_parcels_.load(
+            boost::memory_order_relaxed);
+        estimate += ((std::min)(time_since_last_parcel, 2 * interval) -
+            estimate) / 8;
+        estimated_time_between_parcels_.store(estimate,
+            boost::memory_order_relaxed);
 
         // just send parcel if the coalescing was stopped or the buffer is
         // empty and time since last parcel is larger than coalescing interval.
-        if (stopped_ ||
-            (buffer_.empty() &&
-                std::chrono::nanoseconds(time_since_last_parcel) > interval
-           ))
+        if (stopped_.load(boost::memory_order_relaxed) ||
+            (num_buffered_parcels_.load(boost::memory_order_relaxed) == 0 &&
+                time_since_last_parcel > interval))
         {
             ++num_messages_;
-            l.unlock();
 
             // this instance should not buffer parcels anymore
             pp_->put_parcel(dest, std::move(p), std::move(f));
             return;
         }
 
-        detail::message_buffer::message_buffer_append_state s =
-            buffer_.append(dest, std::move(p), std::move(f));
+        std::size_t num_buffered = 0;
 
-        switch(s) {
-        case detail::message_buffer::first_message:
-            // start deadline timer to flush buffer
-            l.unlock();
-            timer_.start(interval);
-            break;
+        {
+            buffer_stripe& s = stripes_[detail::get_buffer_stripe() % num_stripes];
 
-        case detail::message_buffer::normal:
-            // start deadline timer to flush buffer
-            l.unlock();
-            timer_.start(interval);
-            break;
+            std::unique_lock<mutex_type> l(s.mtx_);
 
-        case detail::message_buffer::buffer_now_full:
+            // flush() sets stopped_ before emptying the stripes
+            if (stopped_.load())
+            {
+                l.unlock();
+
+                ++num_messages_;
+                pp_->put_parcel(dest, std::move(p), std::move(f));
+                return;
+            }
+
+            s.buffer_.append(dest, std::move(p), std::move(f));
+            num_buffered = ++num_buffered_parcels_;
+        }
+
+        std::size_t num_messages = get_adaptive_num_messages(estimate);
+        if (num_buffered >= num_messages)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
             flush_locked(l,
                 parcelset::policies::message_handler::flush_mode_buffer_full,
                 false, true);
-            break;
-
-        default:
-            l.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_message_handler::put_parcel",
-                "unexpected return value from message_buffer::append");
             return;
         }
+
+        // start deadline timer to flush buffer
+        timer_.start(std::chrono::nanoseconds(
+            get_adaptive_interval(estimate, num_messages)));
     }
 
     bool coalescing_message_handler::timer_flush()
     {
         // adjust timer if needed
         std::unique_lock<mutex_type> l(mtx_);
-        if (!buffer_.empty())
+        if (num_buffered_parcels_.load() != 0)
         {
             flush_locked(l,
                 parcelset::policies::message_handler::flush_mode_timer,
@@ -270,13 +340,35 @@ namespace hpx { namespace plugins { namespace parcel
             timer_.stop();              // interrupt timer
         }
 
-        if (buffer_.empty())
+        // parcels which are about to be appended concurrently will be
+        // flushed by the timer, unless coalescing is being stopped
+        if (!stop_buffering && num_buffered_parcels_.load() == 0)
             return false;
 
-        detail::message_buffer buff (num_coalesced_parcels_);
-        std::swap(buff, buffer_);
+        // merge the buffers of all stripes into one message
+        detail::message_buffer buff;
+        for (std::size_t i = 0; i != num_stripes; ++i)
+        {
+            buffer_stripe& s = stripes_[i];
+
+            std::lock_guard<mutex_type> ls(s.mtx_);
+            if (!s.buffer_.empty())
+            {
+                num_buffered_parcels_ -= s.buffer_.size();
+                buff.merge(s.buffer_);
+            }
+        }
+
+        if (buff.empty())
+            return false;
 
         ++num_messages_;
+
+        std::size_t size = buff.size();
+        if (parcels_per_message_.size() <= size)
+            parcels_per_message_.resize(size + 1);
+        ++parcels_per_message_[size];
+
         l.unlock();
 
         HPX_ASSERT(nullptr != pp_);
@@ -291,13 +383,15 @@ namespace hpx { namespace plugins { namespace parcel
     {
         std::lock_guard<mutex_type> l(mtx_);
         std::int64_t now = util::high_resolution_clock::now();
-        if (num_parcels_ == 0)
+        std::int64_t current_num_parcels = num_parcels_.load();
+        if (current_num_parcels == 0)
         {
             if (reset) started_at_ = now;
             return 0;
         }
 
-        std::int64_t num_parcels = num_parcels_ - reset_time_num_parcels_;
+        std::int64_t num_parcels =
+            current_num_parcels - reset_time_num_parcels_;
         if (num_parcels == 0)
         {
             if (reset) started_at_ = now;
@@ -310,7 +404,7 @@ namespace hpx { namespace plugins { namespace parcel
         if (reset)
         {
             started_at_ = now;
-            reset_time_num_parcels_ = num_parcels_;
+            reset_time_num_parcels_ = current_num_parcels;
         }
 
         return value;
@@ -319,9 +413,10 @@ namespace hpx { namespace plugins { namespace parcel
     std::int64_t coalescing_message_handler::get_parcels_count(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
-        std::int64_t num_parcels = num_parcels_ - reset_num_parcels_;
+        std::int64_t current_num_parcels = num_parcels_.load();
+        std::int64_t num_parcels = current_num_parcels - reset_num_parcels_;
         if (reset)
-            reset_num_parcels_ = num_parcels_;
+            reset_num_parcels_ = current_num_parcels;
         return num_parcels;
     }
 
@@ -330,25 +425,28 @@ namespace hpx { namespace plugins { namespace parcel
     {
         std::unique_lock<mutex_type> l(mtx_);
 
-        if (num_messages_ == 0)
+        std::int64_t current_num_parcels = num_parcels_.load();
+        std::int64_t current_num_messages = num_messages_.load();
+
+        if (current_num_messages == 0)
         {
             if (reset)
             {
-                reset_num_parcels_per_message_parcels_ = num_parcels_;
-                reset_num_parcels_per_message_messages_ = num_messages_;
+                reset_num_parcels_per_message_parcels_ = current_num_parcels;
+                reset_num_parcels_per_message_messages_ = current_num_messages;
             }
             return 0;
         }
 
         std::int64_t num_parcels =
-            num_parcels_ - reset_num_parcels_per_message_parcels_;
-        std::int64_t
-            num_messages = num_messages_ - reset_num_parcels_per_message_messages_;
+            current_num_parcels - reset_num_parcels_per_message_parcels_;
+        std::int64_t num_messages =
+            current_num_messages - reset_num_parcels_per_message_messages_;
 
         if (reset)
         {
-            reset_num_parcels_per_message_parcels_ = num_parcels_;
-            reset_num_parcels_per_message_messages_ = num_messages_;
+            reset_num_parcels_per_message_parcels_ = current_num_parcels;
+            reset_num_parcels_per_message_messages_ = current_num_messages;
         }
 
         if (num_messages == 0)
@@ -360,9 +458,10 @@ namespace hpx { namespace plugins { namespace parcel
     std::int64_t coalescing_message_handler::get_messages_count(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
-        std::int64_t num_messages = num_messages_ - reset_num_messages_;
+        std::int64_t current_num_messages = num_messages_.load();
+        std::int64_t num_messages = current_num_messages - reset_num_messages_;
         if (reset)
-            reset_num_messages_ = num_messages_;
+            reset_num_messages_ = current_num_messages;
         return num_messages;
     }
 
@@ -420,11 +519,77 @@ namespace hpx { namespace plugins { namespace parcel
             hpx::util::tag::histogram::min_range = double(min_boundary),
             hpx::util::tag::histogram::max_range = double(max_boundary)));
         last_parcel_time_ = util::high_resolution_clock::now();
+        collect_time_between_parcels_ = true;
 
         result = util::bind(&coalescing_message_handler::
             get_time_between_parcels_histogram, this, util::placeholders::_1);
     }
 
+    // The number of parcels per message is recorded exactly, the histogram
+    // buckets are computed on demand. Values outside of the given boundaries
+    // are accounted for in the first or last bucket.
+    std::vector<std::int64_t>
+    coalescing_message_handler::get_parcels_per_message_histogram(
+        std::int64_t min_boundary, std::int64_t max_boundary,
+        std::int64_t num_buckets, bool reset)
+    {
+        std::vector<std::int64_t> result;
+
+        // first add histogram parameters
+        result.push_back(min_boundary);
+        result.push_back(max_boundary);
+        result.push_back(num_buckets);
+
+        if (num_buckets <= 0 || max_boundary <= min_boundary)
+            return result;
+
+        std::vector<std::int64_t> buckets(std::size_t(num_buckets), 0);
+        std::int64_t num_messages = 0;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            for (std::size_t size = 0; size != parcels_per_message_.size();
+                 ++size)
+            {
+                std::int64_t count = parcels_per_message_[size];
+                if (count == 0)
+                    continue;
+
+                std::int64_t bucket = (std::int64_t(size) - min_boundary) *
+                    num_buckets / (max_boundary - min_boundary);
+                if (bucket < 0)
+                    bucket = 0;
+                else if (bucket >= num_buckets)
+                    bucket = num_buckets - 1;
+
+                buckets[std::size_t(bucket)] += count;
+                num_messages += count;
+            }
+
+            if (reset)
+                parcels_per_message_.clear();
+        }
+
+        for (std::int64_t count : buckets)
+        {
+            result.push_back(
+                num_messages == 0 ? 0 : (count * 1000) / num_messages);
+        }
+
+        return result;
+    }
+
+    void
+    coalescing_message_handler::get_parcels_per_message_histogram_creator(
+        std::int64_t min_boundary, std::int64_t max_boundary,
+        std::int64_t num_buckets,
+        util::function_nonser<std::vector<std::int64_t>(bool)>& result)
+    {
+        result = util::bind(&coalescing_message_handler::
+            get_parcels_per_message_histogram, this, min_boundary,
+            max_boundary, num_buckets, util::placeholders::_1);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // register the given action (called during startup)
     void coalescing_message_handler::register_action(char const* action,
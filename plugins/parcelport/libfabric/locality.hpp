@@ -11,6 +11,7 @@
 //
 #include <utility>
 #include <cstring>
+#include <cstddef>
 #include <cstdint>
 #include <array>
 #include <rdma/fabric.h>
@@ -168,6 +169,14 @@ private:
         return a1 < a2;
     }
 
+    friend std::size_t hash_value(locality const & loc) {
+        std::size_t seed = 0;
+        for (uint32_t i=0; i<array_length; ++i) {
+            seed = seed * 31 + loc.data_[i];
+        }
+        return seed;
+    }
+
     friend std::ostream & operator<<(std::ostream & os, locality const & loc) {
         boost::io::ios_flags_saver ifs(os);
         for (uint32_t i=0; i<array_length; ++i) {
@@ -94,7 +94,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         {
             try {
                 std::shared_ptr<receiver> receiver_conn(
-                    new receiver(io_service, get_max_inbound_message_size(), *this));
+                    new receiver(io_service, get_max_inbound_message_size(),
+                        *this, get_buffer_pool()));
 
                 tcp::endpoint ep = *it;
                 acceptor_->open(ep.protocol());
@@ -283,7 +284,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
             boost::asio::io_service& io_service = io_service_pool_.get_io_service();
             receiver_conn.reset(new receiver(io_service, get_max_inbound_message_size(),
-                *this));
+                *this, get_buffer_pool()));
             acceptor_->async_accept(receiver_conn->socket(),
                 util::bind(&connection_handler::handle_accept,
                     this,
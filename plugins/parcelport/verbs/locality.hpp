@@ -9,6 +9,7 @@
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 //
+#include <cstddef>
 #include <cstdint>
 
 namespace hpx {
@@ -60,6 +61,10 @@ namespace verbs
         return lhs.ip_ < rhs.ip_;
       }
 
+      friend std::size_t hash_value(locality const & loc) {
+        return static_cast<std::size_t>(loc.ip_);
+      }
+
       friend std::ostream & operator<<(std::ostream & os, locality const & loc) {
         boost::io::ios_flags_saver ifs(os);
         os << loc.ip_;
@@ -11,7 +11,14 @@
 #include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/steady_clock.hpp>
 
+#include <boost/atomic.hpp>
+
+#include <cstdint>
 #include <utility>
 
 namespace hpx { namespace lcos { namespace detail
@@ -48,4 +55,231 @@ namespace hpx { namespace lcos { namespace detail
             return true;
         }
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    typedef future_data<traits::detail::future_data_void> future_data_base;
+
+    future_data_callback* future_data_base::notify_waiting(
+        future_data_callback* callbacks, error_code& ec)
+    {
+        future_data_callback* result = nullptr;
+        future_data_callback** last = &result;
+
+        while (callbacks != nullptr)
+        {
+            future_data_callback* next = callbacks->next_;
+
+            int s = callbacks->state_.load(boost::memory_order_acquire);
+            if (s == future_data_callback::not_waiting)
+            {
+                // keep continuations in the order they were attached
+                callbacks->next_ = nullptr;
+                *last = callbacks;
+                last = &callbacks->next_;
+            }
+            else
+            {
+                // the waiting thread owns its entry once it has been notified,
+                // the entry must not be accessed afterwards
+                threads::thread_id_repr_type id = callbacks->id_;
+                if (s == future_data_callback::waiting &&
+                    callbacks->state_.compare_exchange_strong(s,
+                        future_data_callback::notified,
+                        boost::memory_order_acq_rel))
+                {
+                    error_code local_ec(lightweight);
+                    threads::set_thread_state(threads::thread_id_type(
+                            reinterpret_cast<threads::thread_data*>(id)),
+                        threads::pending, threads::wait_signaled,
+                        threads::thread_priority_boost, local_ec);
+
+                    // report the first error only, continue notifying the
+                    // remaining threads
+                    if (local_ec && !ec)
+                        ec = std::move(local_ec);
+                }
+                else
+                {
+                    // the waiting thread has given up already
+                    HPX_ASSERT(s == future_data_callback::abandoned);
+                    delete callbacks;
+                }
+            }
+
+            callbacks = next;
+        }
+
+        return result;
+    }
+
+    threads::thread_state_ex_enum future_data_base::wait_ready(
+        util::steady_clock::time_point const* abs_time,
+        char const* description, error_code& ec)
+    {
+        HPX_ASSERT(threads::get_self_ptr() != nullptr);
+
+        // don't let threads repeatedly giving up waiting (for instance while
+        // polling using wait_for) grow the list of callbacks
+        if (num_abandoned_.load(boost::memory_order_relaxed) != 0)
+            remove_abandoned();
+
+        future_data_callback* cb =
+            new future_data_callback(threads::get_self_id().get());
+
+        if (!push_callback(cb))
+        {
+            // the shared state has become ready in the meantime
+            delete cb;
+            if (&ec != &throws)
+                ec = make_success_code();
+            return threads::wait_signaled;
+        }
+
+        // The thread is suspended at least once even if it was notified
+        // already, this consumes the pending wakeup request.
+        threads::thread_state_ex_enum reason = threads::wait_unknown;
+        do {
+            error_code local_ec(lightweight);
+            if (abs_time != nullptr)
+            {
+                reason = this_thread::suspend(
+                    *abs_time, description, local_ec);
+            }
+            else
+            {
+                reason = this_thread::suspend(
+                    threads::suspended, description, local_ec);
+            }
+
+            if (local_ec || reason == threads::wait_abort ||
+                (abs_time != nullptr && reason == threads::wait_timeout))
+            {
+                // give up waiting, the entry is released by the next thread
+                // starting to wait or by whoever makes the shared state ready
+                // (or destroys it)
+                ++num_abandoned_;
+
+                int s = future_data_callback::waiting;
+                if (cb->state_.compare_exchange_strong(s,
+                        future_data_callback::abandoned,
+                        boost::memory_order_acq_rel))
+                {
+                    if (local_ec)
+                    {
+                        if (&ec == &throws)
+                        {
+                            std::rethrow_exception(
+                                hpx::detail::access_exception(local_ec));
+                        }
+                        ec = std::move(local_ec);
+                        return threads::wait_unknown;
+                    }
+                    if (&ec != &throws)
+                        ec = make_success_code();
+                    return reason == threads::wait_abort ?
+                        reason : threads::wait_timeout;
+                }
+
+                // the shared state has become ready concurrently
+                --num_abandoned_;
+                reason = threads::wait_signaled;
+                break;
+            }
+
+        } while (cb->state_.load(boost::memory_order_acquire) ==
+            future_data_callback::waiting);
+
+        HPX_ASSERT(cb->state_.load(boost::memory_order_relaxed) ==
+            future_data_callback::notified);
+        delete cb;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+        return reason;
+    }
+
+    void future_data_base::release_callbacks()
+    {
+        std::uintptr_t s = state_.exchange(empty, boost::memory_order_acquire);
+        if (is_ready_state(s))
+        {
+            // the shared state was ready, all callbacks have been handled
+            state_.store(s, boost::memory_order_relaxed);
+            return;
+        }
+
+        // the shared state never became ready, no thread can be waiting
+        // anymore as waiting threads keep the shared state alive
+        future_data_callback* callbacks = get_callbacks(s);
+        while (callbacks != nullptr)
+        {
+            future_data_callback* next = callbacks->next_;
+            HPX_ASSERT(callbacks->state_.load(boost::memory_order_relaxed) !=
+                future_data_callback::waiting);
+            release_callback(callbacks);
+            callbacks = next;
+        }
+    }
+
+    // New entries are pushed to the front of the list only, entries are
+    // removed from the list only by whoever makes the shared state ready.
+    // Setting the 'purging' tag excludes the latter while abandoned entries
+    // are unlinked here.
+    void future_data_base::remove_abandoned()
+    {
+        std::uintptr_t s = state_.load(boost::memory_order_relaxed);
+        do {
+            if (s & (ready | purging))
+                return;         // nothing to do, or somebody else is purging
+        } while (!state_.compare_exchange_weak(s, s | purging,
+            boost::memory_order_acquire, boost::memory_order_relaxed));
+        s |= purging;
+
+        std::size_t removed = 0;
+
+        // unlink abandoned entries at the front of the list
+        future_data_callback* head = get_callbacks(s);
+        while (head != nullptr &&
+            head->state_.load(boost::memory_order_acquire) ==
+                future_data_callback::abandoned)
+        {
+            future_data_callback* next = head->next_;
+            std::uintptr_t desired = reinterpret_cast<std::uintptr_t>(next) |
+                (s & (setting | purging));
+            if (state_.compare_exchange_weak(s, desired,
+                    boost::memory_order_acquire, boost::memory_order_relaxed))
+            {
+                delete head;
+                ++removed;
+                s = desired;
+            }
+            head = get_callbacks(s);    // new entries may have been pushed
+        }
+
+        // unlink abandoned entries from the remainder of the list
+        if (head != nullptr)
+        {
+            future_data_callback* prev = head;
+            future_data_callback* cb = head->next_;
+            while (cb != nullptr)
+            {
+                future_data_callback* next = cb->next_;
+                if (cb->state_.load(boost::memory_order_acquire) ==
+                    future_data_callback::abandoned)
+                {
+                    prev->next_ = next;
+                    delete cb;
+                    ++removed;
+                }
+                else
+                {
+                    prev = cb;
+                }
+                cb = next;
+            }
+        }
+
+        num_abandoned_.fetch_sub(removed, boost::memory_order_relaxed);
+        state_.fetch_and(~std::uintptr_t(purging), boost::memory_order_release);
+    }
 }}}
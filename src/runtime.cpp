@@ -1185,10 +1185,18 @@ namespace hpx { namespace threads
     // shortcut for runtime_configuration::get_stack_size
     std::ptrdiff_t get_stack_size(threads::thread_stacksize stacksize)
     {
+        util::runtime_configuration const& cfg = get_runtime().get_config();
         if (stacksize == threads::thread_stacksize_current)
-            return threads::get_self_stacksize();
+        {
+            // threads spawned by stackless threads get a regular stack
+            std::ptrdiff_t size =
+                static_cast<std::ptrdiff_t>(threads::get_self_stacksize());
+            if (size != cfg.get_stack_size(threads::thread_stacksize_nostack))
+                return size;
+            return cfg.get_default_stack_size();
+        }
 
-        return get_runtime().get_config().get_stack_size(stacksize);
+        return cfg.get_stack_size(stacksize);
     }
 
     HPX_API_EXPORT void reset_thread_distribution()
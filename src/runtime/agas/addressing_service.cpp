@@ -34,6 +34,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/unlock_guard.hpp>
@@ -44,9 +45,10 @@
 #include <hpx/lcos/wait_all.hpp>
 #include <hpx/lcos/broadcast.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/format.hpp>
-#include <boost/icl/closed_interval.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -60,69 +62,7 @@
 
 namespace hpx { namespace agas
 {
-struct addressing_service::gva_cache_key
-{ // {{{ gva_cache_key implementation
-  private:
-    typedef boost::icl::closed_interval<naming::gid_type, std::less>
-        key_type;
-
-    key_type key_;
-
-  public:
-    gva_cache_key()
-      : key_()
-    {}
-
-    explicit gva_cache_key(
-        naming::gid_type const& id_
-      , std::uint64_t count_ = 1
-        )
-      : key_(naming::detail::get_stripped_gid(id_)
-           , naming::detail::get_stripped_gid(id_) + (count_ - 1))
-    {
-        HPX_ASSERT(count_);
-    }
-
-    naming::gid_type get_gid() const
-    {
-        return boost::icl::lower(key_);
-    }
-
-    std::uint64_t get_count() const
-    {
-        naming::gid_type const size = boost::icl::length(key_);
-        HPX_ASSERT(size.get_msb() == 0);
-        return size.get_lsb();
-    }
-
-    friend bool operator<(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        return boost::icl::exclusive_less(lhs.key_, rhs.key_);
-    }
-
-    friend bool operator==(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        // Direct hit
-        if(lhs.key_ == rhs.key_)
-            return true;
-
-        // Is lhs in rhs?
-        if (1 == lhs.get_count() && 1 != rhs.get_count())
-            return boost::icl::contains(rhs.key_, lhs.key_);
-
-        // Is rhs in lhs?
-        else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            return boost::icl::contains(lhs.key_, rhs.key_);
-
-        return false;
-    }
-}; // }}}
+std::size_t const addressing_service::num_refcnt_accumulators;
 
 addressing_service::addressing_service(
     parcelset::parcelhandler& ph
@@ -134,6 +74,7 @@ addressing_service::addressing_service(
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
+  , refcnt_accumulators_(new refcnt_accumulator[num_refcnt_accumulators])
   , refcnt_requests_(new refcnt_requests_type)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
@@ -1411,18 +1352,53 @@ void addressing_service::route(
     primary_ns_.route(std::move(p), std::move(f));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    // Each OS-thread is assigned its own table of pending decref requests
+    // (modulo the number of tables) on first use.
+    std::size_t get_refcnt_accumulator_index()
+    {
+        static boost::atomic<std::size_t> next_index(0);
+        static HPX_NATIVE_TLS std::size_t index = std::size_t(-1);
+
+        if (index == std::size_t(-1))
+            index = next_index++;
+        return index;
+    }
+}
+
+addressing_service::refcnt_accumulator&
+addressing_service::get_refcnt_accumulator()
+{
+    return refcnt_accumulators_[
+        get_refcnt_accumulator_index() % num_refcnt_accumulators];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // The parameter 'compensated_credit' holds the amount of credits to be added
 // to the acknowledged number of credits. The compensated credits are non-zero
 // if there was a pending decref request at the point when the incref was sent.
 // The pending decref was subtracted from the amount of credits to incref.
+// The parameter 'pooled_credit' holds the amount of credits which were
+// requested in addition to replenish the local reservoir.
 std::int64_t addressing_service::synchronize_with_async_incref(
     hpx::future<std::int64_t> fut
   , naming::id_type const& id
+  , naming::gid_type const& gid
   , std::int64_t compensated_credit
+  , std::int64_t pooled_credit
     )
 {
-    return fut.get() + compensated_credit;
+    std::int64_t result = fut.get();
+
+    // The additional credits are kept as a pending decref request, those are
+    // either used by subsequent increfs or handed back to AGAS with the next
+    // batch of decref requests.
+    if (pooled_credit != 0)
+        decref(gid, pooled_credit);
+
+    return result + compensated_credit;
 }
 
 lcos::future<std::int64_t> addressing_service::incref_async(
@@ -1456,82 +1432,62 @@ lcos::future<std::int64_t> addressing_service::incref_async(
 
     HPX_ASSERT(keep_alive != naming::invalid_id);
 
-    typedef refcnt_requests_type::value_type mapping;
-
     // Some examples of calculating the compensated credits below
     //
     //  case   pending   credits   remaining   sent to   compensated
     //  no     decref              decrefs     AGAS      credits
     // ------+---------+---------+------------+--------+-------------
-    //   1         0        10        0           0        10
-    //   2        10         9        1           0        10
+    //   1         0        10        0          10         0
+    //   2        10         9        1           0         9
     //   3        10        10        0           0        10
     //   4        10        11        0           1        10
+    //
+    // Only the table of the current OS-thread is looked at, pending decrefs
+    // accumulated by other OS-threads are sent to AGAS with the next batch.
 
-    std::pair<naming::gid_type, std::int64_t> pending_incref;
-    bool has_pending_incref = false;
+    std::int64_t remaining_credit = credit;
     std::int64_t pending_decrefs = 0;
 
     {
-        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
+        refcnt_accumulator& acc = get_refcnt_accumulator();
+        std::lock_guard<mutex_type> l(acc.mtx_);
 
-        typedef refcnt_requests_type::iterator iterator;
-
-        iterator matches = refcnt_requests_->find(raw);
-        if (matches != refcnt_requests_->end())
+        refcnt_requests_type::iterator matches = acc.requests_.find(raw);
+        if (matches != acc.requests_.end())
         {
-            pending_decrefs = matches->second;
-            matches->second += credit;
+            HPX_ASSERT(matches->second < 0);
 
-            // Increment requests need to be handled immediately.
+            pending_decrefs = (std::min)(credit, -matches->second);
 
-            // If the given incref was fully compensated by a pending decref
-            // (i.e. match_data is less than 0) then there is no need
-            // to do anything more.
-            if (matches->second > 0)
-            {
-                // credit > decrefs (case no 4): store the remaining incref to
-                // be handled below.
-                pending_incref = mapping(matches->first, matches->second);
-                has_pending_incref = true;
+            matches->second += pending_decrefs;
+            if (matches->second == 0)
+                acc.requests_.erase(matches);
 
-                refcnt_requests_->erase(matches);
-            }
-            else if (matches->second == 0)
-            {
-                // credit == decref (case no. 3): if the incref offsets any
-                // pending decref, just remove the pending decref request.
-                refcnt_requests_->erase(matches);
-            }
-            else
-            {
-                // credit < decref (case no. 2): do nothing
-            }
-        }
-        else
-        {
-            // case no. 1
-            pending_incref = mapping(raw, credit);
-            has_pending_incref = true;
+            remaining_credit -= pending_decrefs;
         }
     }
 
-    if (!has_pending_incref)
+    if (remaining_credit == 0)
     {
         // no need to talk to AGAS, acknowledge the incref immediately
         return hpx::make_ready_future(pending_decrefs);
     }
 
-    naming::gid_type const e_lower = pending_incref.first;
+    // Request the same amount of credits once more to replenish the local
+    // reservoir, this allows for the next incref for the same id to be
+    // handled locally.
+    std::int64_t pooled_credit = 0;
+    if (enable_refcnt_caching_.load(boost::memory_order_relaxed))
+        pooled_credit = credit;
 
-    lcos::future<std::int64_t> f =
-        primary_ns_.increment_credit(pending_incref.second, e_lower, e_lower);
+    lcos::future<std::int64_t> f = primary_ns_.increment_credit(
+        remaining_credit + pooled_credit, raw, raw);
 
     // pass the amount of compensated decrefs to the callback
     using util::placeholders::_1;
     return f.then(util::bind(
             util::one_shot(&addressing_service::synchronize_with_async_incref),
-            this, _1, keep_alive, pending_decrefs
+            this, _1, keep_alive, raw, pending_decrefs, pooled_credit
         ));
 } // }}}
 
@@ -1571,34 +1527,14 @@ void addressing_service::decref(
     }
 
     try {
-        std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
-
-        // Match the decref request with entries in the incref table
-        typedef refcnt_requests_type::iterator iterator;
-        typedef refcnt_requests_type::value_type mapping;
-
-        iterator matches = refcnt_requests_->find(raw);
-        if (matches != refcnt_requests_->end())
+        // Accumulate the decref request in the table of this OS-thread
         {
-            matches->second -= credit;
-        }
-        else
-        {
-            std::pair<iterator, bool> p =
-                refcnt_requests_->insert(mapping(raw, -credit));
-
-            if (HPX_UNLIKELY(!p.second))
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, bad_parameter
-                  , "addressing_service::decref"
-                  , boost::str(boost::format("couldn't insert decref request "
-                        "for %1% (%2%)") % raw % credit));
-                return;
-            }
+            refcnt_accumulator& acc = get_refcnt_accumulator();
+            std::lock_guard<mutex_type> l(acc.mtx_);
+            acc.requests_[raw] -= credit;
         }
 
+        std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::defer_lock);
         send_refcnt_requests(l, ec);
     }
     catch (hpx::exception const& e) {
@@ -1780,17 +1716,6 @@ bool addressing_service::iterate_ids(
     }
 } // }}}
 
-// This function has to return false if the key is already in the cache (true
-// means go ahead with the cache update).
-bool check_for_collisions(
-    addressing_service::gva_cache_key const& new_key
-  , addressing_service::gva_cache_key const& old_key
-    )
-{
-    return (new_key.get_gid() != old_key.get_gid())
-        || (new_key.get_count() != old_key.get_count());
-}
-
 void addressing_service::update_cache_entry(
     naming::gid_type const& id
   , gva const& g
@@ -1853,36 +1778,18 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid(%1%), count(%2%)"
             ) % gid % count);
 
-        const gva_cache_key key(gid, count);
+        // Figure out who we collided with, if needed.
+        naming::gid_type idbase;
+        std::uint64_t old_count = 0;
 
+        if (!gva_cache_->update_if(gid, count, g, idbase, old_count))
         {
-            std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
-            {
-                if (LAGAS_ENABLED(warning))
-                {
-                    // Figure out who we collided with.
-                    addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
-
-                    if (!gva_cache_->get_entry(key, idbase, e))
-                    {
-                        // This is impossible under sane conditions.
-                        lock.unlock();
-                        HPX_THROWS_IF(ec, invalid_data
-                          , "addressing_service::update_cache_entry"
-                          , "data corruption or lock error occurred in cache");
-                        return;
-                    }
-
-                    LAGAS_(warning) <<
-                        ( boost::format(
-                            "addressing_service::update_cache_entry, "
-                            "aborting update due to key collision in cache, "
-                            "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
-                        ) % gid % count % idbase.get_gid() % idbase.get_count());
-                }
-            }
+            LAGAS_(warning) <<
+                ( boost::format(
+                    "addressing_service::update_cache_entry, "
+                    "aborting update due to key collision in cache, "
+                    "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
+                ) % gid % count % idbase % old_count);
         }
 
         if (&ec != &throws)
@@ -1906,24 +1813,21 @@ bool addressing_service::get_cache_entry(
         return false;
     }
     HPX_ASSERT(hpx::threads::get_self_ptr());
-    gva_cache_key k(gid);
-    gva_cache_key idbase_key;
-
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-    if(gva_cache_->get_entry(k, idbase_key, gva))
+    naming::gid_type idbase_key;
+    if(gva_cache_->get_entry(
+        naming::detail::get_stripped_gid(gid), idbase_key, gva))
     {
         const std::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(gid.get_msb());
 
-        if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
+        if (HPX_UNLIKELY(id_msb != idbase_key.get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
             return false;
         }
-        idbase = idbase_key.get_gid();
+        idbase = idbase_key;
         return true;
     }
 
@@ -1946,8 +1850,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -1993,13 +1895,7 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-        gva_cache_->erase(
-            [&gid](std::pair<gva_cache_key, gva> const& p)
-            {
-                return gid == p.first.get_gid();
-            });
+        gva_cache_->erase(gid);
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -2144,80 +2040,67 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->size();
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().hits(reset);
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().misses(reset);
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().evictions(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_get_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_insert_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_update_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_erase_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_get_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_insert_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_update_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_erase_entry_time(reset);
 }
 
@@ -2423,19 +2306,57 @@ void addressing_service::send_refcnt_requests(
   , error_code& ec
     )
 {
-    if (!l.owns_lock())
+    if (l.owns_lock())
     {
         HPX_THROWS_IF(ec, lock_error
           , "addressing_service::send_refcnt_requests"
-          , "mutex is not locked");
+          , "mutex is already locked");
         return;
     }
 
-    if (!enable_refcnt_caching_ || max_refcnt_requests_ == ++refcnt_requests_count_)
-        send_refcnt_requests_non_blocking(l, ec);
+    if (enable_refcnt_caching_.load(boost::memory_order_relaxed))
+    {
+        // There is no need to compete with a concurrent flush, the requests
+        // accumulated so far will be sent by the next one at the latest.
+        if (++refcnt_requests_count_ < max_refcnt_requests_ || !l.try_lock())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+    }
+    else
+    {
+        l.lock();
+    }
 
-    else if (&ec != &throws)
-        ec = make_success_code();
+    send_refcnt_requests_non_blocking(l, ec);
+}
+
+void addressing_service::merge_refcnt_requests(
+    std::unique_lock<addressing_service::mutex_type>& l
+    )
+{
+    HPX_ASSERT(l.owns_lock());
+
+    for (std::size_t i = 0; i != num_refcnt_accumulators; ++i)
+    {
+        refcnt_requests_type requests;
+        {
+            refcnt_accumulator& acc = refcnt_accumulators_[i];
+            std::lock_guard<mutex_type> al(acc.mtx_);
+            std::swap(requests, acc.requests_);
+        }
+
+        if (refcnt_requests_->empty())
+        {
+            std::swap(*refcnt_requests_, requests);
+            continue;
+        }
+
+        for (refcnt_requests_type::const_reference e : requests)
+            (*refcnt_requests_)[e.first] += e.second;
+    }
 }
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
@@ -2477,6 +2398,7 @@ void addressing_service::send_refcnt_requests_non_blocking(
     HPX_ASSERT(l.owns_lock());
 
     try {
+        merge_refcnt_requests(l);
         if (refcnt_requests_->empty())
         {
             l.unlock();
@@ -2550,6 +2472,7 @@ addressing_service::send_refcnt_requests_async(
 {
     HPX_ASSERT(l.owns_lock());
 
+    merge_refcnt_requests(l);
     if (refcnt_requests_->empty())
     {
         l.unlock();
@@ -0,0 +1,848 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace agas { namespace detail
+{
+    namespace
+    {
+        enum
+        {
+            num_ways = 8,           // number of slots per set
+            num_shards = 64,        // number of locks protecting the sets
+            num_stat_slots = 64     // number of separate statistics records
+        };
+
+        std::size_t get_num_sets(std::size_t max_size)
+        {
+            std::size_t num_sets = 1;
+            while (num_sets * num_ways < max_size)
+                num_sets <<= 1;
+            return num_sets;
+        }
+
+        // Each OS thread is assigned its own statistics record (modulo the
+        // number of available records) on first use.
+        std::size_t get_stat_slot()
+        {
+            static boost::atomic<std::size_t> next_slot(0);
+            static HPX_NATIVE_TLS std::size_t slot = std::size_t(-1);
+
+            if (slot == std::size_t(-1))
+                slot = next_slot++ % num_stat_slots;
+            return slot;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::statistics::data
+    {
+        data()
+          : hits_(0), misses_(0), insertions_(0), evictions_(0)
+        {
+            for (std::size_t i = 0; i != num_methods; ++i)
+            {
+                counts_[i].store(0, boost::memory_order_relaxed);
+                times_[i].store(0, boost::memory_order_relaxed);
+            }
+        }
+
+        boost::atomic<std::int64_t> hits_;
+        boost::atomic<std::int64_t> misses_;
+        boost::atomic<std::int64_t> insertions_;
+        boost::atomic<std::int64_t> evictions_;
+
+        boost::atomic<std::int64_t> counts_[num_methods];
+        boost::atomic<std::int64_t> times_[num_methods];
+
+        char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    // Helper class to update timings and counts on function exit
+    struct gva_cache::statistics::update_on_exit
+    {
+        update_on_exit(statistics& stat, method m)
+          : started_at_(util::high_resolution_clock::now()),
+            data_(stat.get_data()), method_(m)
+        {}
+
+        ~update_on_exit()
+        {
+            data_.times_[method_].fetch_add(static_cast<std::int64_t>(
+                util::high_resolution_clock::now() - started_at_),
+                boost::memory_order_relaxed);
+            data_.counts_[method_].fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        std::uint64_t started_at_;
+        data& data_;
+        method method_;
+    };
+
+    gva_cache::statistics::statistics()
+      : data_(new data[num_stat_slots])
+    {}
+
+    gva_cache::statistics::~statistics()
+    {}
+
+    gva_cache::statistics::data& gva_cache::statistics::get_data()
+    {
+        return data_[get_stat_slot()];
+    }
+
+    std::int64_t gva_cache::statistics::accumulate(
+        boost::atomic<std::int64_t> data::* value, bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_stat_slots; ++i)
+        {
+            boost::atomic<std::int64_t>& v = data_[i].*value;
+            result += reset ? v.exchange(0) :
+                v.load(boost::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::statistics::accumulate(method m, bool count,
+        bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_stat_slots; ++i)
+        {
+            boost::atomic<std::int64_t>& v =
+                count ? data_[i].counts_[m] : data_[i].times_[m];
+            result += reset ? v.exchange(0) :
+                v.load(boost::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    std::size_t gva_cache::statistics::hits(bool reset)
+    {
+        return static_cast<std::size_t>(accumulate(&data::hits_, reset));
+    }
+    std::size_t gva_cache::statistics::misses(bool reset)
+    {
+        return static_cast<std::size_t>(accumulate(&data::misses_, reset));
+    }
+    std::size_t gva_cache::statistics::insertions(bool reset)
+    {
+        return static_cast<std::size_t>(accumulate(&data::insertions_, reset));
+    }
+    std::size_t gva_cache::statistics::evictions(bool reset)
+    {
+        return static_cast<std::size_t>(accumulate(&data::evictions_, reset));
+    }
+
+    std::int64_t gva_cache::statistics::get_get_entry_count(bool reset)
+    {
+        return accumulate(method_get_entry, true, reset);
+    }
+    std::int64_t gva_cache::statistics::get_insert_entry_count(bool reset)
+    {
+        return accumulate(method_insert_entry, true, reset);
+    }
+    std::int64_t gva_cache::statistics::get_update_entry_count(bool reset)
+    {
+        return accumulate(method_update_entry, true, reset);
+    }
+    std::int64_t gva_cache::statistics::get_erase_entry_count(bool reset)
+    {
+        return accumulate(method_erase_entry, true, reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_get_entry_time(bool reset)
+    {
+        return accumulate(method_get_entry, false, reset);
+    }
+    std::int64_t gva_cache::statistics::get_insert_entry_time(bool reset)
+    {
+        return accumulate(method_insert_entry, false, reset);
+    }
+    std::int64_t gva_cache::statistics::get_update_entry_time(bool reset)
+    {
+        return accumulate(method_update_entry, false, reset);
+    }
+    std::int64_t gva_cache::statistics::get_erase_entry_time(bool reset)
+    {
+        return accumulate(method_erase_entry, false, reset);
+    }
+
+    void gva_cache::statistics::got_hit()
+    {
+        get_data().hits_.fetch_add(1, boost::memory_order_relaxed);
+    }
+    void gva_cache::statistics::got_miss()
+    {
+        get_data().misses_.fetch_add(1, boost::memory_order_relaxed);
+    }
+    void gva_cache::statistics::got_insertion()
+    {
+        get_data().insertions_.fetch_add(1, boost::memory_order_relaxed);
+    }
+    void gva_cache::statistics::got_eviction(std::size_t count)
+    {
+        get_data().evictions_.fetch_add(static_cast<std::int64_t>(count),
+            boost::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A slot holds one (single object) entry. All of its members are atomics
+    // as readers access them concurrently with writers. An empty slot holds
+    // the invalid (zero) gid.
+    struct gva_cache::slot
+    {
+        enum { num_data_words = 6 };
+
+        slot()
+          : version_(0), key_msb_(0), key_lsb_(0), referenced_(false)
+        {
+            for (std::size_t i = 0; i != num_data_words; ++i)
+                data_[i].store(0, boost::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            return key_msb_.load(boost::memory_order_relaxed) == 0 &&
+                key_lsb_.load(boost::memory_order_relaxed) == 0;
+        }
+
+        bool holds(naming::gid_type const& key) const
+        {
+            return key_msb_.load(boost::memory_order_relaxed) ==
+                    key.get_msb() &&
+                key_lsb_.load(boost::memory_order_relaxed) == key.get_lsb();
+        }
+
+        naming::gid_type get_key() const
+        {
+            return naming::gid_type(
+                key_msb_.load(boost::memory_order_relaxed),
+                key_lsb_.load(boost::memory_order_relaxed));
+        }
+
+        // Try to read the entry for the given key, retry as long as a
+        // concurrent modification is detected. This never blocks on writers
+        // holding the lock protecting this slot.
+        bool load(naming::gid_type const& key, gva& g) const
+        {
+            std::uint64_t data[num_data_words];
+            while (true)
+            {
+                std::uint64_t version =
+                    version_.load(boost::memory_order_acquire);
+                if (version & 1)
+                    continue;           // writer is active
+
+                if (!holds(key))
+                    return false;
+
+                for (std::size_t i = 0; i != num_data_words; ++i)
+                    data[i] = data_[i].load(boost::memory_order_relaxed);
+
+                boost::atomic_thread_fence(boost::memory_order_acquire);
+                if (version_.load(boost::memory_order_relaxed) == version)
+                    break;
+            }
+
+            g = gva(naming::gid_type(data[0], data[1]),
+                static_cast<gva::component_type>(data[2]), data[3],
+                static_cast<gva::lva_type>(data[4]), data[5]);
+            return true;
+        }
+
+        // The writer has to hold the lock protecting this slot.
+        void store(naming::gid_type const& key, gva const& g)
+        {
+            std::uint64_t version = version_.load(boost::memory_order_relaxed);
+            version_.store(version + 1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_release);
+
+            key_msb_.store(key.get_msb(), boost::memory_order_relaxed);
+            key_lsb_.store(key.get_lsb(), boost::memory_order_relaxed);
+
+            data_[0].store(g.prefix.get_msb(), boost::memory_order_relaxed);
+            data_[1].store(g.prefix.get_lsb(), boost::memory_order_relaxed);
+            data_[2].store(static_cast<std::uint32_t>(g.type),
+                boost::memory_order_relaxed);
+            data_[3].store(g.count, boost::memory_order_relaxed);
+            data_[4].store(g.lva(), boost::memory_order_relaxed);
+            data_[5].store(g.offset, boost::memory_order_relaxed);
+
+            version_.store(version + 2, boost::memory_order_release);
+        }
+
+        void clear()
+        {
+            store(naming::gid_type(), gva());
+            referenced_.store(false, boost::memory_order_relaxed);
+        }
+
+        void touch()
+        {
+            // avoid writing to the cache line if not needed
+            if (!referenced_.load(boost::memory_order_relaxed))
+                referenced_.store(true, boost::memory_order_relaxed);
+        }
+
+        boost::atomic<std::uint64_t> version_;
+        boost::atomic<std::uint64_t> key_msb_;
+        boost::atomic<std::uint64_t> key_lsb_;
+        boost::atomic<std::uint64_t> data_[num_data_words];
+        boost::atomic<bool> referenced_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::table
+    {
+        explicit table(std::size_t num_sets)
+          : num_sets_(num_sets),
+            slots_(new slot[num_sets * num_ways]),
+            hands_(new std::uint8_t[num_sets]())
+        {
+            HPX_ASSERT((num_sets & (num_sets - 1)) == 0);
+        }
+
+        std::size_t get_set(naming::gid_type const& key) const
+        {
+            std::uint64_t h = (key.get_lsb() ^
+                (key.get_msb() * 0x9E3779B97F4A7C15ull)) *
+                    0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(h ^ (h >> 32)) & (num_sets_ - 1);
+        }
+
+        slot* get_slots(std::size_t set) const
+        {
+            return &slots_[set * num_ways];
+        }
+
+        // Find the slot holding the given key, the caller has to hold the
+        // lock protecting the set.
+        slot* find(std::size_t set, naming::gid_type const& key) const
+        {
+            slot* slots = get_slots(set);
+            for (std::size_t i = 0; i != num_ways; ++i)
+            {
+                if (slots[i].holds(key))
+                    return &slots[i];
+            }
+            return nullptr;
+        }
+
+        // Find an empty slot or select a victim using the CLOCK algorithm,
+        // the caller has to hold the lock protecting the set.
+        slot* find_free(std::size_t set, bool& evict)
+        {
+            slot* slots = get_slots(set);
+            for (std::size_t i = 0; i != num_ways; ++i)
+            {
+                if (slots[i].empty())
+                {
+                    evict = false;
+                    return &slots[i];
+                }
+            }
+
+            evict = true;
+            std::uint8_t& hand = hands_[set];
+            for (std::size_t i = 0; i != 2 * num_ways; ++i)
+            {
+                slot& s = slots[hand];
+                hand = static_cast<std::uint8_t>((hand + 1) % num_ways);
+                if (!s.referenced_.exchange(false, boost::memory_order_relaxed))
+                    return &s;
+            }
+            return &slots[hand];
+        }
+
+        std::size_t num_sets_;
+        std::unique_ptr<slot[]> slots_;
+        std::unique_ptr<std::uint8_t[]> hands_;
+    };
+
+    struct gva_cache::shard
+    {
+        mutex_type mtx_;
+        char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    // Readers accessing the table without holding any lock register in the
+    // reader count of their OS thread for the duration of the access.
+    struct gva_cache::reader_count
+    {
+        reader_count()
+          : count_(0)
+        {}
+
+        boost::atomic<std::int64_t> count_;
+        char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    struct gva_cache::reader_guard
+    {
+        explicit reader_guard(reader_count& r)
+          : readers_(r)
+        {
+            readers_.count_.fetch_add(1, boost::memory_order_seq_cst);
+        }
+
+        ~reader_guard()
+        {
+            readers_.count_.fetch_sub(1, boost::memory_order_release);
+        }
+
+        reader_count& readers_;
+    };
+
+    namespace
+    {
+        // Lock all shards of the cache, this blocks all writers.
+        template <typename Shard>
+        struct lock_all_shards
+        {
+            explicit lock_all_shards(Shard* shards)
+              : shards_(shards)
+            {
+                for (std::size_t i = 0; i != num_shards; ++i)
+                    shards_[i].mtx_.lock();
+            }
+
+            ~lock_all_shards()
+            {
+                for (std::size_t i = num_shards; i != 0; --i)
+                    shards_[i - 1].mtx_.unlock();
+            }
+
+            Shard* shards_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache(std::size_t max_size)
+      : max_size_(max_size),
+        table_(new table(get_num_sets(max_size))),
+        readers_(new reader_count[num_stat_slots]),
+        shards_(new shard[num_shards]),
+        size_(0),
+        num_ranges_(0)
+    {}
+
+    gva_cache::~gva_cache()
+    {
+        delete table_.load(boost::memory_order_relaxed);
+    }
+
+    gva_cache::shard& gva_cache::get_shard(std::size_t set)
+    {
+        return shards_[set % num_shards];
+    }
+
+    std::size_t gva_cache::size() const
+    {
+        return size_.load(boost::memory_order_relaxed);
+    }
+
+    std::size_t gva_cache::capacity() const
+    {
+        return max_size_.load(boost::memory_order_relaxed);
+    }
+
+    std::size_t gva_cache::num_retired_tables() const
+    {
+        lock_all_shards<shard> l(shards_.get());
+        return retired_tables_.size();
+    }
+
+    // Free the retired tables if no reader can access them anymore. A reader
+    // registers itself before loading the table pointer, thus any reader
+    // which is not seen here has loaded (or will load) the current table.
+    // The caller has to hold all shard locks.
+    void gva_cache::reclaim_retired_tables()
+    {
+        if (retired_tables_.empty())
+            return;
+
+        for (std::size_t i = 0; i != num_stat_slots; ++i)
+        {
+            if (readers_[i].count_.load(boost::memory_order_seq_cst) != 0)
+                return;         // try again with the next reserve or clear
+        }
+
+        retired_tables_.clear();
+    }
+
+    void gva_cache::reserve(std::size_t max_size)
+    {
+        {
+            lock_all_shards<shard> l(shards_.get());
+
+            max_size_.store(max_size, boost::memory_order_relaxed);
+
+            table* old_table = table_.load(boost::memory_order_relaxed);
+            std::size_t num_sets = get_num_sets(max_size);
+            if (num_sets != old_table->num_sets_)
+            {
+                // move all entries which fit into the new table
+                std::unique_ptr<table> t(new table(num_sets));
+                std::size_t dropped = 0;
+                for (std::size_t i = 0; i != old_table->num_sets_ * num_ways;
+                     ++i)
+                {
+                    slot& s = old_table->slots_[i];
+                    if (s.empty())
+                        continue;
+
+                    naming::gid_type key = s.get_key();
+                    gva g;
+                    if (!s.load(key, g))
+                        continue;
+
+                    bool evict = false;
+                    slot* free_slot = t->find_free(t->get_set(key), evict);
+                    if (evict)
+                    {
+                        ++dropped;
+                        continue;
+                    }
+                    free_slot->store(key, g);
+                }
+
+                table_.store(t.release(), boost::memory_order_seq_cst);
+                retired_tables_.emplace_back(old_table);
+
+                size_ -= dropped;
+                statistics_.got_eviction(dropped);
+            }
+
+            reclaim_retired_tables();
+        }
+
+        std::lock_guard<mutex_type> l(ranges_mtx_);
+        while (ranges_.size() > max_size && !ranges_.empty())
+            evict_range_entry();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::get_single_entry(table const& t,
+        naming::gid_type const& gid, gva& g)
+    {
+        slot* slots = t.get_slots(t.get_set(gid));
+        for (std::size_t i = 0; i != num_ways; ++i)
+        {
+            if (slots[i].load(gid, g))
+            {
+                slots[i].touch();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The caller has to hold the lock protecting the range entries.
+    gva_cache::range_map_type::iterator gva_cache::find_range_entry(
+        naming::gid_type const& gid)
+    {
+        range_map_type::iterator it = ranges_.upper_bound(gid);
+        if (it == ranges_.begin())
+            return ranges_.end();
+
+        --it;
+        if (!(gid < it->first + it->second.count_))
+            return ranges_.end();
+
+        return it;
+    }
+
+    bool gva_cache::get_entry(naming::gid_type const& gid,
+        naming::gid_type& idbase, gva& g)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_get_entry);
+
+        bool found = false;
+        {
+            reader_guard r(readers_[get_stat_slot()]);
+
+            table const* t = table_.load(boost::memory_order_seq_cst);
+            found = get_single_entry(*t, gid, g);
+        }
+
+        if (found)
+        {
+            idbase = gid;
+            statistics_.got_hit();
+            return true;
+        }
+
+        if (num_ranges_.load(boost::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<mutex_type> l(ranges_mtx_);
+
+            range_map_type::iterator it = find_range_entry(gid);
+            if (it != ranges_.end())
+            {
+                it->second.referenced_ = true;
+                idbase = it->first;
+                g = it->second.gva_;
+
+                statistics_.got_hit();
+                return true;
+            }
+        }
+
+        statistics_.got_miss();
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::update_single_entry(naming::gid_type const& gid,
+        gva const& g)
+    {
+        while (true)
+        {
+            std::size_t set = 0;
+            table* t = nullptr;
+            {
+                reader_guard r(readers_[get_stat_slot()]);
+                t = table_.load(boost::memory_order_seq_cst);
+                set = t->get_set(gid);
+            }
+
+            std::lock_guard<mutex_type> l(get_shard(set).mtx_);
+            if (t != table_.load(boost::memory_order_relaxed))
+                continue;       // table was replaced concurrently
+
+            slot* s = t->find(set, gid);
+            if (s != nullptr)
+            {
+                s->store(gid, g);
+                s->touch();
+                return true;
+            }
+
+            bool evict = false;
+            s = t->find_free(set, evict);
+            s->store(gid, g);
+            s->referenced_.store(true, boost::memory_order_relaxed);
+
+            if (evict)
+                statistics_.got_eviction();
+            else
+                ++size_;
+            return false;
+        }
+    }
+
+    void gva_cache::evict_range_entry()
+    {
+        HPX_ASSERT(!ranges_.empty());
+
+        range_map_type::iterator it = ranges_.lower_bound(ranges_hand_);
+        for (std::size_t i = 0; i != 2 * ranges_.size(); ++i)
+        {
+            if (it == ranges_.end())
+                it = ranges_.begin();
+            if (!it->second.referenced_)
+                break;
+            it->second.referenced_ = false;
+            ++it;
+        }
+        if (it == ranges_.end())
+            it = ranges_.begin();
+
+        it = ranges_.erase(it);
+        ranges_hand_ = (it == ranges_.end()) ? naming::gid_type() : it->first;
+
+        --num_ranges_;
+        --size_;
+        statistics_.got_eviction();
+    }
+
+    bool gva_cache::update_range_entry(naming::gid_type const& gid,
+        std::uint64_t count, gva const& g, naming::gid_type& idbase,
+        std::uint64_t& old_count)
+    {
+        std::lock_guard<mutex_type> l(ranges_mtx_);
+
+        // the only existing entry which could overlap is the one with the
+        // largest base gid not beyond the new range
+        range_map_type::iterator it = ranges_.upper_bound(gid + (count - 1));
+        if (it != ranges_.begin())
+        {
+            --it;
+            if (gid < it->first + it->second.count_)
+            {
+                if (it->first != gid || it->second.count_ != count)
+                {
+                    idbase = it->first;
+                    old_count = it->second.count_;
+                    return false;
+                }
+
+                statistics_.got_hit();
+                it->second.gva_ = g;
+                it->second.referenced_ = true;
+                return true;
+            }
+        }
+
+        statistics_.got_miss();
+
+        statistics::update_on_exit update(
+            statistics_, statistics::method_insert_entry);
+
+        if (ranges_.size() >= max_size_.load(boost::memory_order_relaxed) &&
+            !ranges_.empty())
+        {
+            evict_range_entry();
+        }
+
+        range_entry e = { count, g, true };
+        ranges_.insert(range_map_type::value_type(gid, e));
+
+        ++num_ranges_;
+        ++size_;
+        statistics_.got_insertion();
+        return true;
+    }
+
+    bool gva_cache::update_if(naming::gid_type const& gid,
+        std::uint64_t count, gva const& g, naming::gid_type& idbase,
+        std::uint64_t& old_count)
+    {
+        HPX_ASSERT(count != 0);
+
+        statistics::update_on_exit update(
+            statistics_, statistics::method_update_entry);
+
+        if (count != 1)
+            return update_range_entry(gid, count, g, idbase, old_count);
+
+        // a single entry collides with any range entry covering it
+        if (num_ranges_.load(boost::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<mutex_type> l(ranges_mtx_);
+
+            range_map_type::iterator it = find_range_entry(gid);
+            if (it != ranges_.end())
+            {
+                idbase = it->first;
+                old_count = it->second.count_;
+                return false;
+            }
+        }
+
+        if (update_single_entry(gid, g))
+        {
+            statistics_.got_hit();
+        }
+        else
+        {
+            statistics_.got_miss();
+
+            statistics::update_on_exit update(
+                statistics_, statistics::method_insert_entry);
+            statistics_.got_insertion();
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t gva_cache::erase(naming::gid_type const& gid)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_erase_entry);
+
+        std::size_t erased = 0;
+        while (true)
+        {
+            std::size_t set = 0;
+            table* t = nullptr;
+            {
+                reader_guard r(readers_[get_stat_slot()]);
+                t = table_.load(boost::memory_order_seq_cst);
+                set = t->get_set(gid);
+            }
+
+            std::lock_guard<mutex_type> l(get_shard(set).mtx_);
+            if (t != table_.load(boost::memory_order_relaxed))
+                continue;       // table was replaced concurrently
+
+            slot* s = t->find(set, gid);
+            if (s != nullptr)
+            {
+                s->clear();
+                --size_;
+                ++erased;
+            }
+            break;
+        }
+
+        if (num_ranges_.load(boost::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<mutex_type> l(ranges_mtx_);
+            if (ranges_.erase(gid) != 0)
+            {
+                --num_ranges_;
+                --size_;
+                ++erased;
+            }
+        }
+
+        statistics_.got_eviction(erased);
+        return erased;
+    }
+
+    std::size_t gva_cache::clear()
+    {
+        std::size_t erased = 0;
+
+        {
+            lock_all_shards<shard> l(shards_.get());
+
+            table* t = table_.load(boost::memory_order_relaxed);
+            for (std::size_t i = 0; i != t->num_sets_ * num_ways; ++i)
+            {
+                slot& s = t->slots_[i];
+                if (!s.empty())
+                {
+                    s.clear();
+                    ++erased;
+                }
+            }
+
+            reclaim_retired_tables();
+        }
+
+        {
+            std::lock_guard<mutex_type> l(ranges_mtx_);
+            erased += ranges_.size();
+            ranges_.clear();
+            ranges_hand_ = naming::gid_type();
+            num_ranges_.store(0);
+        }
+
+        size_ -= erased;
+        return erased;
+    }
+}}}
@@ -33,6 +33,7 @@
 #include <boost/atomic.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <list>
@@ -60,6 +61,8 @@ naming::id_type bootstrap_primary_namespace_id()
 namespace server
 {
 
+std::size_t const primary_namespace::num_partitions;
+
 // register all performance counter types exposed by this component
 void primary_namespace::register_counter_types(
     error_code& ec
@@ -231,7 +234,8 @@ primary_namespace::begin_migration(naming::gid_type id)
     counter_data_.increment_begin_migration_count();
     using hpx::util::get;
 
-    std::unique_lock<mutex_type> l(mutex_);
+    partition& p = get_partition(id);
+    std::unique_lock<mutex_type> l(p.mutex_);
 
     resolved_type r = resolve_gid_locked(l, id, hpx::throws);
     if (get<0>(r) == naming::invalid_gid)
@@ -245,14 +249,14 @@ primary_namespace::begin_migration(naming::gid_type id)
         return std::make_pair(naming::invalid_id, naming::address());
     }
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end())
+    migration_table_type::iterator it = p.migrating_objects_.find(id);
+    if (it == p.migrating_objects_.end())
     {
-        std::pair<migration_table_type::iterator, bool> p =
-            migrating_objects_.emplace(std::piecewise_construct,
+        std::pair<migration_table_type::iterator, bool> result =
+            p.migrating_objects_.emplace(std::piecewise_construct,
                 std::forward_as_tuple(id), std::forward_as_tuple());
-        HPX_ASSERT(p.second);
-        it = p.first;
+        HPX_ASSERT(result.second);
+        it = result.first;
     }
 
     // flag this id as being migrated
@@ -272,12 +276,13 @@ bool primary_namespace::end_migration(naming::gid_type id)
     );
     counter_data_.increment_end_migration_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    partition& p = get_partition(id);
+    std::unique_lock<mutex_type> l(p.mutex_);
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end() || !get<0>(it->second))
+    migration_table_type::iterator it = p.migrating_objects_.find(id);
+    if (it == p.migrating_objects_.end() || !get<0>(it->second))
         return false;
 
     // ignore before notifying everyone about the ended migration.
@@ -302,15 +307,37 @@ void primary_namespace::wait_for_migration_locked(
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it != migrating_objects_.end() && get<0>(it->second))
+    partition& p = get_partition(id);
+    HPX_ASSERT(l.mutex() == &p.mutex_);
+
+    migration_table_type::iterator it = p.migrating_objects_.find(id);
+    if (it != p.migrating_objects_.end() && get<0>(it->second))
     {
         ++get<1>(it->second);
 
         get<2>(it->second).wait(l, ec);
 
         if (--get<1>(it->second) == 0 && !get<0>(it->second))
-            migrating_objects_.erase(it);
+            p.migrating_objects_.erase(it);
+    }
+}
+
+// lock all partitions storing gids of the range [id, id + count)
+void primary_namespace::lock_partitions(
+    naming::gid_type const& id
+  , std::uint64_t count
+  , std::vector<std::unique_lock<mutex_type> >& locks)
+{
+    std::size_t const first = get_partition_index(id);
+    if (count == 0)
+        count = 1;
+
+    // always lock in ascending order to avoid deadlocks
+    locks.reserve((std::min)(count, std::uint64_t(num_partitions)));
+    for (std::size_t i = 0; i != num_partitions; ++i)
+    {
+        if (((i - first) & (num_partitions - 1)) < count)
+            locks.emplace_back(partitions_[i].mutex_);
     }
 }
 
@@ -328,27 +355,46 @@ bool primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    std::uint64_t const count = (g.count != 0) ? g.count : 1;
+
+    std::vector<std::unique_lock<mutex_type> > locks;
+    lock_partitions(id, count, locks);
+
+    auto unlock_all = [&locks]()
+    {
+        for (std::unique_lock<mutex_type>& l : locks)
+            l.unlock();
+    };
 
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    partition& p = get_partition(id);
 
-    if (it != end)
+    gva_table_type::iterator it = p.gvas_.upper_bound(id);
+    if (it != p.gvas_.begin())
     {
-        // If we got an exact match, this is a request to update an existing
-        // binding (e.g. move semantics).
-        if (it->first == id)
+        --it;
+
+        gva_table_data_type& data = it->second;
+        if ((data.base_ + data.gva_.count) > id)
         {
-            gva& gaddr = it->second.first;
-            naming::gid_type& loc = it->second.second;
+            // If we got an exact match, this is a request to update an
+            // existing binding (e.g. move semantics).
+            if (HPX_UNLIKELY(data.base_ != id))
+            {
+                // Check that a previous range doesn't cover the new id.
+                // REVIEW: Is this the right error code to use?
+                unlock_all();
+
+                HPX_THROW_EXCEPTION(bad_parameter
+                  , "primary_namespace::bind_gid"
+                  , "the new GID is contained in an existing range");
+            }
 
             // Check for count mismatch (we can't change block sizes of
             // existing bindings).
-            if (HPX_UNLIKELY(gaddr.count != g.count))
+            if (HPX_UNLIKELY(data.gva_.count != g.count))
             {
                 // REVIEW: Is this the right error code to use?
-                l.unlock();
+                unlock_all();
 
                 HPX_THROW_EXCEPTION(bad_parameter
                   , "primary_namespace::bind_gid"
@@ -357,7 +403,7 @@ bool primary_namespace::bind_gid(
 
             if (HPX_UNLIKELY(components::component_invalid == g.type))
             {
-                l.unlock();
+                unlock_all();
 
                 HPX_THROW_EXCEPTION(bad_parameter
                   , "primary_namespace::bind_gid"
@@ -369,7 +415,7 @@ bool primary_namespace::bind_gid(
 
             if (HPX_UNLIKELY(!locality))
             {
-                l.unlock();
+                unlock_all();
 
                 HPX_THROW_EXCEPTION(bad_parameter
                   , "primary_namespace::bind_gid"
@@ -379,14 +425,27 @@ bool primary_namespace::bind_gid(
                         % id % g % locality));
             }
 
-            // Store the new endpoint and offset
-            gaddr.prefix = g.prefix;
-            gaddr.type   = g.type;
-            gaddr.lva(g.lva());
-            gaddr.offset = g.offset;
-            loc = locality;
+            // Store the new endpoint and offset in all partitions holding
+            // this range
+            std::uint64_t const n =
+                (std::min)(count, std::uint64_t(num_partitions));
+            for (std::uint64_t i = 0; i != n; ++i)
+            {
+                naming::gid_type const key = id + i;
+
+                gva_table_type& gvas = get_partition(key).gvas_;
+                gva_table_type::iterator entry = gvas.find(key);
+                HPX_ASSERT(entry != gvas.end() && entry->second.base_ == id);
+
+                gva& gaddr = entry->second.gva_;
+                gaddr.prefix = g.prefix;
+                gaddr.type   = g.type;
+                gaddr.lva(g.lva());
+                gaddr.offset = g.offset;
+                entry->second.locality_ = locality;
+            }
 
-            l.unlock();
+            unlock_all();
 
             LAGAS_(info) << (boost::format(
                 "primary_namespace::bind_gid, gid(%1%), gva(%2%), "
@@ -395,47 +454,13 @@ bool primary_namespace::bind_gid(
 
             return false;
         }
-
-        // We're about to decrement the iterator it - first, we
-        // check that it's safe to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Check that a previous range doesn't cover the new id.
-            if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-            {
-                // REVIEW: Is this the right error code to use?
-                l.unlock();
-
-                HPX_THROW_EXCEPTION(bad_parameter
-                  , "primary_namespace::bind_gid"
-                  , "the new GID is contained in an existing range");
-            }
-        }
-    }
-
-    else if (HPX_LIKELY(!gvas_.empty()))
-    {
-        --it;
-
-        // Check that a previous range doesn't cover the new id.
-        if ((it->first + it->second.first.count) > id)
-        {
-            // REVIEW: Is this the right error code to use?
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(bad_parameter
-              , "primary_namespace::bind_gid"
-              , "the new GID is contained in an existing range");
-        }
     }
 
     naming::gid_type upper_bound(id + (g.count - 1));
 
     if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
     {
-        l.unlock();
+        unlock_all();
 
         HPX_THROW_EXCEPTION(internal_server_error
           , "primary_namespace::bind_gid"
@@ -444,7 +469,7 @@ bool primary_namespace::bind_gid(
 
     if (HPX_UNLIKELY(components::component_invalid == g.type))
     {
-        l.unlock();
+        unlock_all();
 
         HPX_THROW_EXCEPTION(bad_parameter
           , "primary_namespace::bind_gid"
@@ -454,21 +479,29 @@ bool primary_namespace::bind_gid(
                 % id % g % locality));
     }
 
-    // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
-            std::make_pair(id, std::make_pair(g, locality))))))
+    // Insert a GID -> GVA entry into the GVA table of each partition the
+    // range has gids in, keyed by the first of those gids.
+    gva_table_data_type const data = { id, g, locality };
+
+    std::uint64_t const n = (std::min)(count, std::uint64_t(num_partitions));
+    for (std::uint64_t i = 0; i != n; ++i)
     {
-        l.unlock();
+        naming::gid_type const key = id + i;
+        if (HPX_UNLIKELY(!util::insert_checked(get_partition(key).gvas_.insert(
+                std::make_pair(key, data)))))
+        {
+            unlock_all();
 
-        HPX_THROW_EXCEPTION(lock_error
-          , "primary_namespace::bind_gid"
-          , boost::str(boost::format(
-                "GVA table insertion failed due to a locking error or "
-                "memory corruption, gid(%1%), gva(%2%)")
-                % id % g % locality));
+            HPX_THROW_EXCEPTION(lock_error
+              , "primary_namespace::bind_gid"
+              , boost::str(boost::format(
+                    "GVA table insertion failed due to a locking error or "
+                    "memory corruption, gid(%1%), gva(%2%)")
+                    % id % g % locality));
+        }
     }
 
-    l.unlock();
+    unlock_all();
 
     LAGAS_(info) << (boost::format(
         "primary_namespace::bind_gid, gid(%1%), gva(%2%), locality(%3%)")
@@ -488,7 +521,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
     resolved_type r;
 
     {
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(get_partition(id).mutex_);
 
         // wait for any migration to be completed
         wait_for_migration_locked(l, id, hpx::throws);
@@ -532,16 +565,23 @@ naming::address primary_namespace::unbind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    std::vector<std::unique_lock<mutex_type> > locks;
+    lock_partitions(id, count, locks);
 
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    auto unlock_all = [&locks]()
+    {
+        for (std::unique_lock<mutex_type>& l : locks)
+            l.unlock();
+    };
 
-    if (it != end)
+    gva_table_type& gvas = get_partition(id).gvas_;
+    gva_table_type::iterator it = gvas.find(id);
+
+    if (it != gvas.end() && it->second.base_ == id)
     {
-        if (HPX_UNLIKELY(it->second.first.count != count))
+        if (HPX_UNLIKELY(it->second.gva_.count != count))
         {
-            l.unlock();
+            unlock_all();
 
             HPX_THROW_EXCEPTION(bad_parameter
               , "primary_namespace::unbind_gid"
@@ -550,19 +590,26 @@ naming::address primary_namespace::unbind_gid(
 
         gva_table_data_type data = it->second;
 
-        gvas_.erase(it);
+        // remove the entries from all partitions holding this range
+        std::uint64_t const n = (std::min)(
+            (count != 0) ? count : 1, std::uint64_t(num_partitions));
+        for (std::uint64_t i = 0; i != n; ++i)
+        {
+            naming::gid_type const key = id + i;
+            get_partition(key).gvas_.erase(key);
+        }
 
-        l.unlock();
+        unlock_all();
         LAGAS_(info) << (boost::format(
             "primary_namespace::unbind_gid, gid(%1%), count(%2%), gva(%3%), "
             "locality_id(%4%)")
-            % id % count % data.first % data.second);
+            % id % count % data.gva_ % data.locality_);
 
-        gva g = data.first;
+        gva g = data.gva_;
         return naming::address(g.prefix, g.type, g.lva());
     }
 
-    l.unlock();
+    unlock_all();
 
     LAGAS_(info) << (boost::format(
         "primary_namespace::unbind_gid, gid(%1%), count(%2%), "
@@ -624,7 +671,7 @@ std::vector<std::int64_t> primary_namespace::decrement_credit(
     {
         std::int64_t credits = hpx::util::get<0>(req);
         naming::gid_type lower = hpx::util::get<1>(req);
-        naming::gid_type upper = hpx::util::get<1>(req);
+        naming::gid_type upper = hpx::util::get<2>(req);
 
         naming::detail::strip_internal_bits_from_gid(lower);
         naming::detail::strip_internal_bits_from_gid(upper);
@@ -717,8 +764,7 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
+        partition& p
       , naming::gid_type const& lower
       , naming::gid_type const& upper
       , std::unique_lock<mutex_type>& l
@@ -727,30 +773,45 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
     { // dump_refcnt_matches implementation
         HPX_ASSERT(l.owns_lock());
 
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         ss << (boost::format(
               "%1%, dumping server-side refcnt table matches, lower(%2%), "
               "upper(%3%):")
               % func_name % lower % upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        // lower is the first gid of the range stored in this partition
+        for (naming::gid_type raw = lower; raw < upper; raw += num_partitions)
         {
+            refcnt_table_type::iterator it = p.refcnts_.find(raw);
+            if (it == p.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             ss << (boost::format(
                    "\n  [server] lower(%1%), credits(%2%)")
-                   % lower_it->first
-                   % lower_it->second);
+                   % it->first
+                   % it->second);
         }
 
         LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Returns the number of partitions holding gids of the range [lower, upper).
+// The i-th of those partitions holds the gids lower + i + k * num_partitions.
+std::uint64_t primary_namespace::get_partition_count(
+    naming::gid_type const& lower
+  , naming::gid_type const& upper
+    )
+{
+    naming::gid_type const size = upper - lower;
+    if (size.get_msb() != 0)
+        return num_partitions;
+    return (std::min)(size.get_lsb(), std::uint64_t(num_partitions));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::increment(
     naming::gid_type const& lower
@@ -759,30 +820,6 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
-#if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    if (LAGAS_ENABLED(debug))
-    {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
-    }
-#endif
 
     // TODO: Whine loudly if a reference count overflows. We reserve ~0 for
     // internal bookkeeping in the decrement algorithm, so the maximum global
@@ -794,39 +831,57 @@ void primary_namespace::increment(
     // allocate/bind them, so if a GID is not in the refcnt table, we know that
     // it's global reference count is the initial global reference count.
 
-    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    std::uint64_t const n = get_partition_count(lower, upper);
+    for (std::uint64_t i = 0; i != n; ++i)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        naming::gid_type const first = lower + i;
+
+        partition& p = get_partition(first);
+        std::unique_lock<mutex_type> l(p.mutex_);
+
+#if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
+        if (LAGAS_ENABLED(debug))
         {
-            std::int64_t count =
-                std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
+            dump_refcnt_matches(p, first, upper, l,
+                "primary_namespace::increment");
+        }
+#endif
 
-            std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
-            if (!p.second)
+        for (naming::gid_type raw = first; raw < upper; raw += num_partitions)
+        {
+            refcnt_table_type::iterator it = p.refcnts_.find(raw);
+            if (it == p.refcnts_.end())
             {
-                l.unlock();
+                std::int64_t count =
+                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
-                HPX_THROWS_IF(ec, invalid_data
-                    , "primary_namespace::increment"
-                    , boost::str(boost::format(
-                        "couldn't create entry in reference count table, "
-                        "raw(%1%), ref-count(%3%)")
-                        % raw % count));
-                return;
+                std::pair<refcnt_table_type::iterator, bool> result =
+                    p.refcnts_.insert(
+                        refcnt_table_type::value_type(raw, count));
+                if (!result.second)
+                {
+                    l.unlock();
+
+                    HPX_THROWS_IF(ec, invalid_data
+                        , "primary_namespace::increment"
+                        , boost::str(boost::format(
+                            "couldn't create entry in reference count table, "
+                            "raw(%1%), ref-count(%3%)")
+                            % raw % count));
+                    return;
+                }
+
+                it = result.first;
+            }
+            else
+            {
+                it->second += credits;
             }
 
-            it = p.first;
-        }
-        else
-        {
-            it->second += credits;
+            LAGAS_(info) << (boost::format(
+                "primary_namespace::increment, raw(%1%), refcnt(%2%)")
+                % lower % it->second);
         }
-
-        LAGAS_(info) << (boost::format(
-            "primary_namespace::increment, raw(%1%), refcnt(%2%)")
-            % lower % it->second);
     }
 
     if (&ec != &throws)
@@ -836,7 +891,8 @@ void primary_namespace::increment(
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
     std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+  , partition& p
+  , std::list<naming::gid_type> const& free_list
   , std::list<free_entry>& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
@@ -847,15 +903,8 @@ void primary_namespace::resolve_free_list(
 
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
-
         // wait for any migration to be completed
         wait_for_migration_locked(l, gid, ec);
 
@@ -919,7 +968,7 @@ void primary_namespace::resolve_free_list(
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
 
         // remove this entry from the refcnt table
-        refcnts_.erase(it);
+        p.refcnts_.erase(gid);
     }
 }
 
@@ -939,46 +988,37 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]),
+    // one partition at a time.
+
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
+
+    std::uint64_t const n = get_partition_count(lower, upper);
+    for (std::uint64_t i = 0; i != n; ++i)
     {
-        std::unique_lock<mutex_type> l(mutex_);
+        naming::gid_type const first = lower + i;
+
+        partition& p = get_partition(first);
+        std::unique_lock<mutex_type> l(p.mutex_);
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
         if (LAGAS_ENABLED(debug))
         {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
+            dump_refcnt_matches(p, first, upper, l,
                 "primary_namespace::decrement_sweep");
         }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
-
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
-
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
+        std::list<naming::gid_type> free_list;
+        for (naming::gid_type raw = first; raw < upper; raw += num_partitions)
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            refcnt_table_type::iterator it = p.refcnts_.find(raw);
+            if (it == p.refcnts_.end())
             {
                 if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
                 {
@@ -997,9 +1037,10 @@ void primary_namespace::decrement_sweep(
                 std::int64_t count =
                     std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
 
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
+                std::pair<refcnt_table_type::iterator, bool> result =
+                    p.refcnts_.insert(
+                        refcnt_table_type::value_type(raw, count));
+                if (!result.second)
                 {
                     l.unlock();
 
@@ -1012,7 +1053,7 @@ void primary_namespace::decrement_sweep(
                     return;
                 }
 
-                it = p.first;
+                it = result.first;
             }
             else
             {
@@ -1035,11 +1076,12 @@ void primary_namespace::decrement_sweep(
 
             // this objects needs to be deleted
             if (it->second == 0)
-                free_list.push_back(it);
+                free_list.push_back(raw);
         }
 
         // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
+        resolve_free_list(l, p, free_list, free_entry_list, lower, upper, ec);
+        if (ec) return;
 
     } // Unlock the mutex.
 
@@ -1120,60 +1162,22 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
-
-    if (it != end)
-    {
-        // Check for exact match
-        if (it->first == id)
-        {
-            if (&ec != &throws)
-                ec = make_success_code();
-
-            gva_table_data_type const& data = it->second;
-            return resolved_type(it->first, data.first, data.second);
-        }
-
-        // We need to decrement the iterator, first we check that it's safe
-        // to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
-            {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, internal_server_error
-                      , "primary_namespace::resolve_gid_locked"
-                      , "MSBs of lower and upper range bound do not match");
-                    return resolved_type(naming::invalid_gid, gva(),
-                        naming::invalid_gid);
-                }
-
-                if (&ec != &throws)
-                    ec = make_success_code();
-
-                return resolved_type(it->first, data.first, data.second);
-            }
-        }
-    }
+    // The partition of the gid holds an entry for each range which has gids
+    // in this partition, keyed by the first of those gids. The closest entry
+    // at or before the gid is the only candidate for a range covering it.
+    gva_table_type const& gvas = get_partition(id).gvas_;
+    HPX_ASSERT(l.mutex() == &get_partition(id).mutex_);
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    gva_table_type::const_iterator it = gvas.upper_bound(id);
+    if (it != gvas.begin())
     {
         --it;
 
         // Found the GID in a range
         gva_table_data_type const& data = it->second;
-        if ((it->first + data.first.count) > id)
+        if ((data.base_ + data.gva_.count) > id)
         {
-            if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
+            if (HPX_UNLIKELY(id.get_msb() != data.base_.get_msb()))
             {
                 l.unlock();
 
@@ -1187,7 +1191,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
             if (&ec != &throws)
                 ec = make_success_code();
 
-            return resolved_type(it->first, data.first, data.second);
+            return resolved_type(data.base_, data.gva_, data.locality_);
         }
     }
 
@@ -41,7 +41,7 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
+            std::unique_lock<mutex_type> l(get_partition(gid).mutex_);
 
             // wait for any migration to be completed
             wait_for_migration_locked(l, gid, ec);
@@ -877,6 +877,24 @@ namespace hpx { namespace parcelset
         return pp ? pp->get_message_receive_count(reset) : 0;
     }
 
+    // number of received actions executed without a separate HPX-thread
+    std::int64_t parcelhandler::get_inlined_action_count(
+        std::string const& pp_type, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_inlined_action_count(reset) : 0;
+    }
+
+    // number of received actions executed on a new HPX-thread
+    std::int64_t parcelhandler::get_spawned_action_count(
+        std::string const& pp_type, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_spawned_action_count(reset) : 0;
+    }
+
     // the total time it took for all sends, from async_write to the
     // completion handler (nanoseconds)
     std::int64_t parcelhandler::get_sending_time(
@@ -978,6 +996,16 @@ namespace hpx { namespace parcelset
         return pp ? pp->get_connection_cache_statistics(stat_type, reset) : 0;
     }
 
+    // receive buffer pool statistics
+    std::int64_t parcelhandler::get_buffer_pool_statistics(
+        std::string const& pp_type,
+        parcelport::buffer_pool_statistics_type stat_type, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_buffer_pool_statistics(stat_type, reset) : 0;
+    }
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     // same as above, just separated data for each action
     // number of parcels sent
@@ -1045,6 +1073,7 @@ namespace hpx { namespace parcelset
         {
             register_counter_types(pp.second->type());
             register_connection_cache_counter_types(pp.second->type());
+            register_buffer_pool_counter_types(pp.second->type());
         }
 
         using util::placeholders::_1;
@@ -1132,6 +1161,13 @@ namespace hpx { namespace parcelset
             util::bind(&parcelhandler::get_message_receive_count, this,
                 pp_type, _1));
 
+        util::function_nonser<std::int64_t(bool)> num_inlined_actions(
+            util::bind(&parcelhandler::get_inlined_action_count, this,
+                pp_type, _1));
+        util::function_nonser<std::int64_t(bool)> num_spawned_actions(
+            util::bind(&parcelhandler::get_spawned_action_count, this,
+                pp_type, _1));
+
         util::function_nonser<std::int64_t(bool)> sending_time(
             util::bind(&parcelhandler::get_sending_time, this,
                 pp_type, _1));
@@ -1261,6 +1297,30 @@ namespace hpx { namespace parcelset
               &performance_counters::locality_counter_discoverer,
               ""
             },
+            { boost::str(boost::format("/parcels/count/%s/inlined") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of actions received using the %s "
+                  "connection type which were executed without creating a "
+                  "separate thread for each of them") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(num_inlined_actions), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { boost::str(boost::format("/parcels/count/%s/spawned") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of actions received using the %s "
+                  "connection type which were executed on a newly created "
+                  "thread") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(num_spawned_actions), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
 
             { boost::str(boost::format("/data/time/%s/sent") % pp_type),
               performance_counters::counter_raw,
@@ -1524,6 +1584,105 @@ namespace hpx { namespace parcelset
 #endif
     }
 
+    // register connection specific performance counters related to the pool
+    // of receive buffers
+    void parcelhandler::register_buffer_pool_counter_types(
+        std::string const& pp_type)
+    {
+        using hpx::util::placeholders::_1;
+        using hpx::util::placeholders::_2;
+
+#if defined(HPX_HAVE_NETWORKING)
+        util::function_nonser<std::int64_t(bool)> pool_allocations(
+            util::bind(&parcelhandler::get_buffer_pool_statistics,
+                this, pp_type, parcelport::buffer_pool_allocations, _1));
+        util::function_nonser<std::int64_t(bool)> pool_reuses(
+            util::bind(&parcelhandler::get_buffer_pool_statistics,
+                this, pp_type, parcelport::buffer_pool_reuses, _1));
+        util::function_nonser<std::int64_t(bool)> pool_reclaims(
+            util::bind(&parcelhandler::get_buffer_pool_statistics,
+                this, pp_type, parcelport::buffer_pool_reclaims, _1));
+        util::function_nonser<std::int64_t(bool)> pool_releases(
+            util::bind(&parcelhandler::get_buffer_pool_statistics,
+                this, pp_type, parcelport::buffer_pool_releases, _1));
+        util::function_nonser<std::int64_t(bool)> pool_cached_bytes(
+            util::bind(&parcelhandler::get_buffer_pool_statistics,
+                this, pp_type, parcelport::buffer_pool_cached_bytes, _1));
+
+        performance_counters::generic_counter_type_data const
+            buffer_pool_types[] =
+        {
+            { boost::str(boost::format(
+                  "/parcelport/count/%s/buffer-pool-allocations") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of receive buffers for the %s connection "
+                  "type which had to be allocated by the buffer pool on the "
+                  "referenced locality") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_allocations), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { boost::str(boost::format(
+                  "/parcelport/count/%s/buffer-pool-reuses") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of receive buffers for the %s connection "
+                  "type which were reused from the buffer pool on the "
+                  "referenced locality") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_reuses), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { boost::str(boost::format(
+                  "/parcelport/count/%s/buffer-pool-reclaims") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of receive buffers for the %s connection "
+                  "type which were handed back to the buffer pool on the "
+                  "referenced locality") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_reclaims), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { boost::str(boost::format(
+                  "/parcelport/count/%s/buffer-pool-releases") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of receive buffers for the %s connection "
+                  "type which were released by the buffer pool on the "
+                  "referenced locality") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_releases), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { boost::str(boost::format(
+                  "/parcelport/count/%s/buffer-pool-cached-bytes") % pp_type),
+              performance_counters::counter_raw,
+              boost::str(boost::format(
+                  "returns the number of bytes currently held by the buffer "
+                  "pool for the %s connection type on the referenced "
+                  "locality") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_cached_bytes), _2),
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
+            }
+        };
+        performance_counters::install_counter_types(buffer_pool_types,
+            sizeof(buffer_pool_types)/sizeof(buffer_pool_types[0]));
+#endif
+    }
+
     std::vector<plugins::parcelport_factory_base *> &
     parcelhandler::get_parcelport_factories()
     {
@@ -1586,6 +1745,7 @@ namespace hpx { namespace parcelset
             "array_optimization = ${HPX_PARCEL_ARRAY_OPTIMIZATION:1}",
             "zero_copy_optimization = ${HPX_PARCEL_ZERO_COPY_OPTIMIZATION:"
                 "$[hpx.parcel.array_optimization]}",
+            "integer_compression = ${HPX_PARCEL_INTEGER_COMPRESSION:1}",
             "enable_security = ${HPX_PARCEL_ENABLE_SECURITY:0}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
@@ -11,6 +11,7 @@
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/threads/thread.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
@@ -23,26 +24,37 @@
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <string>
 #include <utility>
 
 namespace hpx { namespace parcelset
 {
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t const parcelport::num_pending_parcels_shards;
+
     ///////////////////////////////////////////////////////////////////////////
     parcelport::parcelport(util::runtime_configuration const& ini,
             locality const & here, std::string const& type)
       : applier_(nullptr),
         num_parcel_destinations_(0),
+        next_pending_parcels_shard_(0),
         here_(here),
         max_inbound_message_size_(ini.get_max_inbound_message_size()),
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
+        actions_inlined_(0),
+        actions_spawned_(0),
         allow_array_optimizations_(true),
         allow_zero_copy_optimizations_(true),
+        allow_integer_compression_(true),
         enable_security_(false),
         async_serialization_(false),
         priority_(hpx::util::get_entry_as<int>(ini,
             "hpx.parcel." + type + ".priority", "0")),
-        type_(type)
+        type_(type),
+        buffer_pool_(std::make_shared<buffer_pool_type>(
+            hpx::util::get_entry_as<std::size_t>(ini,
+                "hpx.parcel." + type + ".buffer_pool_size", "16777216")))
     {
         std::string key("hpx.parcel.");
         key += type;
@@ -62,6 +74,12 @@ namespace hpx { namespace parcelset
             }
         }
 
+        if (hpx::util::get_entry_as<int>(
+                ini, key + ".integer_compression", "1") == 0)
+        {
+            allow_integer_compression_ = false;
+        }
+
         if (hpx::util::get_entry_as<int>(
                 ini, key + ".enable_security", "0") != 0)
         {
@@ -180,6 +198,18 @@ namespace hpx { namespace parcelset
         return parcels_received_.total_raw_bytes(reset);
     }
 
+    // number of received actions executed without a separate HPX-thread
+    std::int64_t parcelport::get_inlined_action_count(bool reset)
+    {
+        return util::get_and_reset_value(actions_inlined_, reset);
+    }
+
+    // number of received actions executed on a new HPX-thread
+    std::int64_t parcelport::get_spawned_action_count(bool reset)
+    {
+        return util::get_and_reset_value(actions_spawned_, reset);
+    }
+
     std::int64_t parcelport::get_buffer_allocate_time_sent(bool reset)
     {
         return parcels_sent_.total_buffer_allocate_time(reset);
@@ -190,16 +220,48 @@ namespace hpx { namespace parcelset
         return parcels_received_.total_buffer_allocate_time(reset);
     }
 
+    std::int64_t parcelport::get_buffer_pool_statistics(
+        buffer_pool_statistics_type t, bool reset)
+    {
+        switch (t) {
+            case buffer_pool_allocations:
+                return buffer_pool_->get_allocations(reset);
+
+            case buffer_pool_reuses:
+                return buffer_pool_->get_reuses(reset);
+
+            case buffer_pool_reclaims:
+                return buffer_pool_->get_reclaims(reset);
+
+            case buffer_pool_releases:
+                return buffer_pool_->get_releases(reset);
+
+            case buffer_pool_cached_bytes:
+                return static_cast<std::int64_t>(buffer_pool_->cached_bytes());
+
+            default:
+                break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "parcelport::get_buffer_pool_statistics",
+            "invalid buffer pool statistics type");
+        return 0;
+    }
+
     std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
     {
-        std::lock_guard<lcos::local::spinlock> l(mtx_);
         std::int64_t count = 0;
-        for (auto && p : pending_parcels_)
+        for (pending_parcels_shard& shard : pending_parcels_shards_)
         {
-            count += hpx::util::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second).size() ==
-                hpx::util::get<1>(p.second).size());
+            std::lock_guard<lcos::local::spinlock> l(shard.mtx_);
+            for (auto && p : shard.pending_parcels_)
+            {
+                count += hpx::util::get<0>(p.second).size();
+                HPX_ASSERT(
+                    hpx::util::get<0>(p.second).size() ==
+                    hpx::util::get<1>(p.second).size());
+            }
         }
         return count;
     }
@@ -11,6 +11,7 @@
 #include <hpx/exception.hpp>
 #include <hpx/util/static.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace hpx { namespace serialization { namespace detail
@@ -31,16 +32,18 @@ namespace hpx { namespace serialization { namespace detail
                 , "Cannot register a factory with an empty name");
         }
 
-        auto it = map_.find(name);
-        if (it == map_.end())
-        {
-            map_.emplace(name, fun);
-        }
+        map_.insert(polymorphic_type_hash(name), name, fun);
     }
 
-    void* polymorphic_intrusive_factory::create(
-        std::string const& name) const
+    void* polymorphic_intrusive_factory::create(std::uint64_t hash) const
     {
-        return map_.at(name)();
+        ctor_type const* fun = map_.find(hash);
+        if (fun == nullptr)
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+                , "polymorphic_intrusive_factory::create"
+                , "Unknown type hash " + std::to_string(hash));
+        }
+        return (*fun)();
     }
 }}}
@@ -8,6 +8,11 @@
 
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 
+#include <hpx/throw_exception.hpp>
+
+#include <cstdint>
+#include <string>
+
 namespace hpx { namespace serialization { namespace detail
 {
     polymorphic_nonintrusive_factory& polymorphic_nonintrusive_factory::instance()
@@ -15,5 +20,18 @@ namespace hpx { namespace serialization { namespace detail
         hpx::util::static_<polymorphic_nonintrusive_factory> factory;
         return factory.get();
     }
+
+    function_bunch_type const& polymorphic_nonintrusive_factory::get_bunch(
+        std::uint64_t hash) const
+    {
+        function_bunch_type const* bunch = map_.find(hash);
+        if (bunch == nullptr)
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::get_bunch"
+              , "Unknown type hash " + std::to_string(hash));
+        }
+        return *bunch;
+    }
 }}}
 
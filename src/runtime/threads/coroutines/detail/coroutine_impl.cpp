@@ -90,7 +90,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
                 {
                     coroutine_self* old_self = coroutine_self::get_self();
-                    coroutine_self self(this, old_self);
+                    coroutine_stackful_self self(this, old_self);
                     reset_self_on_exit on_exit(&self, old_self);
 
                     this->m_result_last = m_fun(*this->args());
@@ -0,0 +1,526 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    namespace
+    {
+        enum { max_numa_domains = 8 };
+
+        // Return the NUMA domain the calling OS thread is running on. Stacks
+        // are first touched by the thread allocating them, thus keeping
+        // separate pools per domain keeps the stack memory local. The domain
+        // is determined once per OS thread, as HPX worker threads are usually
+        // bound to a processing unit.
+        std::size_t query_numa_domain()
+        {
+#if defined(SYS_getcpu)
+            unsigned cpu = 0, node = 0;
+            if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+                return node % max_numa_domains;
+#endif
+            return 0;
+        }
+
+        static HPX_NATIVE_TLS std::size_t numa_domain = std::size_t(-1);
+
+        std::size_t get_numa_domain()
+        {
+            if (HPX_UNLIKELY(numa_domain == std::size_t(-1)))
+                numa_domain = query_numa_domain();
+            return numa_domain;
+        }
+
+        std::size_t get_guard_size()
+        {
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+            return use_guard_pages ? EXEC_PAGESIZE : 0;
+#else
+            return 0;
+#endif
+        }
+
+        // Free stacks are linked through a node stored at the very top of the
+        // stack. The topmost page of a stack is never given back to the
+        // system.
+        struct free_stack_node
+        {
+            free_stack_node* next_;
+        };
+
+        free_stack_node* get_node(void* stack, std::size_t size)
+        {
+            return reinterpret_cast<free_stack_node*>(
+                static_cast<char*>(stack) + size) - 1;
+        }
+
+        void* get_stack(free_stack_node* node, std::size_t size)
+        {
+            return reinterpret_cast<char*>(node + 1) - size;
+        }
+
+        // Each slab starts with a header page recording the NUMA domain owning
+        // its stacks. Slabs are aligned to their (power of two) size, which
+        // allows to find the header of any stack from its address.
+        struct slab_header
+        {
+            std::size_t domain_;
+        };
+
+        std::size_t get_slab_size(std::size_t stride,
+            stack_pool_parameters const& p)
+        {
+            std::size_t const min_size =
+                (std::max)(p.slab_size_, stride + EXEC_PAGESIZE);
+
+            std::size_t size = EXEC_PAGESIZE;
+            while (size < min_size)
+                size <<= 1;
+            return size;
+        }
+
+        std::size_t get_owning_domain(void* stack, std::size_t slab_size)
+        {
+            std::uintptr_t const slab =
+                reinterpret_cast<std::uintptr_t>(stack) & ~(slab_size - 1);
+            return reinterpret_cast<slab_header const*>(slab)->domain_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Keeps track of the number of stacks handed out by and held available
+        // by the pool and of the extrema of those since the last reset. There
+        // is one instance per size class, shared by all NUMA domains, and one
+        // for the whole pool, which keeps the extrema exact.
+        class stack_usage
+        {
+        public:
+            stack_usage()
+              : total_(nullptr), in_use_(0), free_(0), max_in_use_(0),
+                min_free_(0)
+            {}
+
+            void set_total(stack_usage* total)
+            {
+                total_ = total;
+            }
+
+            void on_allocate(bool reused)
+            {
+                update_max(max_in_use_, ++in_use_);
+                if (reused)
+                    update_min(min_free_, --free_);
+
+                if (total_ != nullptr)
+                    total_->on_allocate(reused);
+            }
+
+            void on_deallocate()
+            {
+                --in_use_;
+                ++free_;
+
+                if (total_ != nullptr)
+                    total_->on_deallocate();
+            }
+
+            std::int64_t get_in_use() const
+            {
+                return in_use_.load(boost::memory_order_relaxed);
+            }
+
+            std::int64_t get_free() const
+            {
+                return free_.load(boost::memory_order_relaxed);
+            }
+
+            std::int64_t get_max_in_use(bool reset)
+            {
+                if (reset)
+                {
+                    return max_in_use_.exchange(
+                        in_use_.load(boost::memory_order_relaxed));
+                }
+                return max_in_use_.load(boost::memory_order_relaxed);
+            }
+
+            std::int64_t get_min_free(bool reset)
+            {
+                if (reset)
+                {
+                    return min_free_.exchange(
+                        free_.load(boost::memory_order_relaxed));
+                }
+                return min_free_.load(boost::memory_order_relaxed);
+            }
+
+        private:
+            static void update_max(boost::atomic<std::int64_t>& extremum,
+                std::int64_t value)
+            {
+                std::int64_t current =
+                    extremum.load(boost::memory_order_relaxed);
+                while (current < value &&
+                    !extremum.compare_exchange_weak(current, value))
+                {
+                }
+            }
+
+            static void update_min(boost::atomic<std::int64_t>& extremum,
+                std::int64_t value)
+            {
+                std::int64_t current =
+                    extremum.load(boost::memory_order_relaxed);
+                while (current > value &&
+                    !extremum.compare_exchange_weak(current, value))
+                {
+                }
+            }
+
+            stack_usage* total_;
+
+            boost::atomic<std::int64_t> in_use_;
+            boost::atomic<std::int64_t> free_;
+            boost::atomic<std::int64_t> max_in_use_;
+            boost::atomic<std::int64_t> min_free_;
+
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // All stacks of one size class owned by one NUMA domain.
+        class stack_list
+        {
+            typedef hpx::util::spinlock mutex_type;
+
+        public:
+            stack_list()
+              : domain_(0), usage_(nullptr), committed_(nullptr),
+                decommitted_(nullptr), num_committed_(0),
+                slab_current_(nullptr), slab_end_(nullptr)
+            {}
+
+            void set_domain(std::size_t domain, stack_usage& usage)
+            {
+                domain_ = domain;
+                usage_ = &usage;
+            }
+
+            void* allocate(std::size_t size, stack_pool_parameters const& p)
+            {
+                std::size_t const guard_size = get_guard_size();
+                void* stack = nullptr;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    // prefer stacks which still have memory attached
+                    free_stack_node* node = committed_;
+                    if (node != nullptr)
+                    {
+                        committed_ = node->next_;
+                        --num_committed_;
+                        usage_->on_allocate(true);
+                        return get_stack(node, size);
+                    }
+
+                    node = decommitted_;
+                    if (node != nullptr)
+                    {
+                        decommitted_ = node->next_;
+                        usage_->on_allocate(true);
+                        return get_stack(node, size);
+                    }
+
+                    // carve a new stack from the current slab
+                    if (slab_current_ == slab_end_)
+                        map_slab(size + guard_size, p);
+
+                    stack = slab_current_ + guard_size;
+                    slab_current_ += size + guard_size;
+                    usage_->on_allocate(false);
+                }
+
+                // Guard pages are established when a stack is handed out for
+                // the first time, which avoids touching the whole slab when
+                // it is mapped.
+                if (guard_size != 0)
+                {
+                    ::mprotect(static_cast<char*>(stack) - guard_size,
+                        guard_size, PROT_NONE);
+                }
+                return stack;
+            }
+
+            void deallocate(void* stack, std::size_t size,
+                stack_pool_parameters const& p)
+            {
+                free_stack_node* node = get_node(stack, size);
+
+                std::unique_lock<mutex_type> l(mtx_);
+
+                bool const keep_committed = num_committed_ < p.max_idle_stacks_;
+                if (keep_committed)
+                    ++num_committed_;       // reserve the slot
+
+                l.unlock();
+
+                if (keep_committed)
+                {
+                    // release the pages of stacks which have grown beyond
+                    // their first page, just as recycled threads do
+                    reset_stack(stack, size);
+                }
+                else
+                {
+                    // enough idle stacks are around, give the memory back
+                    ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+                }
+
+                l.lock();
+
+                free_stack_node*& head = keep_committed ? committed_ : decommitted_;
+                node->next_ = head;
+                head = node;
+
+                usage_->on_deallocate();
+            }
+
+        private:
+            void map_slab(std::size_t stride, stack_pool_parameters const& p)
+            {
+                std::size_t const slab_size = get_slab_size(stride, p);
+
+                // over-allocate the address range to be able to align the
+                // slab to its size
+                void* range = ::mmap(nullptr, 2 * slab_size,
+                    PROT_EXEC | PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+                if (range == MAP_FAILED)
+                {
+                    if (ENOMEM == errno)
+                        throw std::runtime_error("mmap() failed to allocate "
+                            "thread stack slab due to insufficient resources, "
+                            "decrease hpx.stacks.pool_slab_size or add "
+                            "-Ihpx.stacks.use_pool=0 to the command line");
+                    else
+                        throw std::runtime_error(
+                            "mmap() failed to allocate thread stack slab");
+                }
+
+                char* begin = static_cast<char*>(range);
+                char* slab = reinterpret_cast<char*>(
+                    (reinterpret_cast<std::uintptr_t>(begin) + slab_size - 1) &
+                        ~(slab_size - 1));
+
+                if (slab != begin)
+                    ::munmap(begin, slab - begin);
+                ::munmap(slab + slab_size, begin + slab_size - slab);
+
+#if defined(MADV_HUGEPAGE)
+                if (p.use_huge_pages_)
+                    ::madvise(slab, slab_size, MADV_HUGEPAGE);
+#endif
+
+                reinterpret_cast<slab_header*>(slab)->domain_ = domain_;
+
+                std::size_t const count = (slab_size - EXEC_PAGESIZE) / stride;
+                slab_current_ = slab + EXEC_PAGESIZE;
+                slab_end_ = slab_current_ + count * stride;
+            }
+
+            std::size_t domain_;
+            stack_usage* usage_;
+            mutex_type mtx_;
+            free_stack_node* committed_;
+            free_stack_node* decommitted_;
+            std::size_t num_committed_;
+            char* slab_current_;
+            char* slab_end_;
+
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class stack_pool
+        {
+        public:
+            stack_pool()
+            {
+                for (std::size_t i = 0; i != num_stack_size_classes; ++i)
+                    usage_[i].set_total(&total_usage_);
+
+                for (std::size_t d = 0; d != max_numa_domains; ++d)
+                {
+                    for (std::size_t i = 0; i != num_stack_size_classes; ++i)
+                        lists_[d][i].set_domain(d, usage_[i]);
+                }
+            }
+
+            static stack_pool& get()
+            {
+                static stack_pool pool;
+                return pool;
+            }
+
+            // Note: the address ranges of the slabs are never unmapped as
+            // contexts might be destroyed during static destruction.
+
+            void configure(stack_pool_parameters const& params)
+            {
+                params_ = params;
+            }
+
+            void* allocate(std::size_t size)
+            {
+                std::size_t size_class = get_size_class(size);
+                if (size_class == num_stack_size_classes)
+                    return alloc_stack(size);
+
+                return lists_[get_numa_domain()][size_class].allocate(
+                    size, params_);
+            }
+
+            void deallocate(void* stack, std::size_t size)
+            {
+                std::size_t size_class = get_size_class(size);
+                if (size_class == num_stack_size_classes)
+                {
+                    free_stack(stack, size);
+                    return;
+                }
+
+                // Stacks are returned to the domain they were allocated from,
+                // independently of the releasing OS thread.
+                std::size_t const slab_size =
+                    get_slab_size(size + get_guard_size(), params_);
+                lists_[get_owning_domain(stack, slab_size)][size_class]
+                    .deallocate(stack, size, params_);
+            }
+
+            // size_class == num_stack_size_classes refers to all stacks
+            stack_usage& get_usage(std::size_t size_class)
+            {
+                if (size_class == num_stack_size_classes)
+                    return total_usage_;
+                return usage_[size_class];
+            }
+
+        private:
+            // returns num_stack_size_classes for stacks not handled by the pool
+            std::size_t get_size_class(std::size_t size) const
+            {
+                if (params_.enabled_)
+                {
+                    for (std::size_t i = 0; i != num_stack_size_classes; ++i)
+                    {
+                        if (params_.stack_sizes_[i] == size)
+                            return i;
+                    }
+                }
+                return num_stack_size_classes;
+            }
+
+            stack_pool_parameters params_;
+            stack_list lists_[max_numa_domains][num_stack_size_classes];
+            stack_usage usage_[num_stack_size_classes];
+            stack_usage total_usage_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void configure_stack_pool(stack_pool_parameters const& params)
+    {
+        stack_pool::get().configure(params);
+    }
+
+    void* alloc_pooled_stack(std::size_t size)
+    {
+        return stack_pool::get().allocate(size);
+    }
+
+    void free_pooled_stack(void* stack, std::size_t size)
+    {
+        stack_pool::get().deallocate(stack, size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t get_stack_pool_in_use_count(std::size_t size_class, bool)
+    {
+        HPX_ASSERT(size_class < num_stack_size_classes);
+        return stack_pool::get().get_usage(size_class).get_in_use();
+    }
+
+    std::int64_t get_stack_pool_in_use_count_all(bool)
+    {
+        return stack_pool::get().get_usage(num_stack_size_classes)
+            .get_in_use();
+    }
+
+    std::int64_t get_stack_pool_free_count(std::size_t size_class, bool)
+    {
+        HPX_ASSERT(size_class < num_stack_size_classes);
+        return stack_pool::get().get_usage(size_class).get_free();
+    }
+
+    std::int64_t get_stack_pool_free_count_all(bool)
+    {
+        return stack_pool::get().get_usage(num_stack_size_classes)
+            .get_free();
+    }
+
+    std::int64_t get_stack_pool_max_in_use_count(std::size_t size_class,
+        bool reset)
+    {
+        HPX_ASSERT(size_class < num_stack_size_classes);
+        return stack_pool::get().get_usage(size_class).get_max_in_use(reset);
+    }
+
+    std::int64_t get_stack_pool_max_in_use_count_all(bool reset)
+    {
+        return stack_pool::get().get_usage(num_stack_size_classes)
+            .get_max_in_use(reset);
+    }
+
+    std::int64_t get_stack_pool_min_free_count(std::size_t size_class,
+        bool reset)
+    {
+        HPX_ASSERT(size_class < num_stack_size_classes);
+        return stack_pool::get().get_usage(size_class).get_min_free(reset);
+    }
+
+    std::int64_t get_stack_pool_min_free_count_all(bool reset)
+    {
+        return stack_pool::get().get_usage(num_stack_size_classes)
+            .get_min_free(reset);
+    }
+}
+}}}}
+
+#endif
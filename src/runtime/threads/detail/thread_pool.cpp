@@ -496,7 +496,7 @@ namespace hpx { namespace threads { namespace detail
             sched_.set_all_states(state_stopping);
 
             // make sure we're not waiting
-            sched_.Scheduler::do_some_work(std::size_t(-1));
+            sched_.Scheduler::wake_all_idle();
 
             if (blocking) {
                 for (std::size_t i = 0; i != threads_.size(); ++i)
@@ -506,7 +506,7 @@ namespace hpx { namespace threads { namespace detail
                         << "thread_pool::stop: " << pool_name_
                         << " notify_all";
 
-                    sched_.Scheduler::do_some_work(std::size_t(-1));
+                    sched_.Scheduler::wake_all_idle();
 
                     LTM_(info) //-V128
                         << "thread_pool::stop: " << pool_name_
@@ -1409,6 +1409,29 @@ namespace hpx { namespace threads { namespace detail
     }
 #endif
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_idle_parks(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_idle_parks(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_idle_wakeups(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_idle_wakeups(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_idle_spurious_wakeups(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_idle_spurious_wakeups(num, reset);
+    }
+#endif
+
     template <typename Scheduler>
     std::int64_t thread_pool<Scheduler>::get_idle_loop_count(std::size_t num) const
     {
@@ -1461,6 +1484,11 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::local_priority_queue_scheduler<
         hpx::compat::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        hpx::compat::mutex, hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::detail::thread_pool<
@@ -0,0 +1,325 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/threads/policies/parking_lot.hpp>
+
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/smart_ptr/detail/spinlock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace hpx { namespace threads { namespace policies
+{
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    namespace detail
+    {
+        // the futex operates on the representation of the slot state
+        static_assert(sizeof(boost::atomic<std::uint32_t>) ==
+            sizeof(std::uint32_t), "boost::atomic<std::uint32_t> must have "
+            "the same size as std::uint32_t to be used as a futex");
+
+        inline void futex_wait(boost::atomic<std::uint32_t>& word,
+            std::uint32_t expected, std::chrono::microseconds timeout)
+        {
+            struct timespec ts;
+            ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+            ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+        }
+
+        inline void futex_wake(boost::atomic<std::uint32_t>& word)
+        {
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    parking_lot::slot::slot()
+      : state_(active)
+      , core_(std::size_t(-1))
+      , domain_(std::size_t(-1))
+      , backoff_(0)
+      , parks_(0)
+      , wakeups_(0)
+      , spurious_wakeups_(0)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    parking_lot::parking_lot(std::size_t num_threads)
+      : num_threads_(num_threads)
+      , slots_(new slot[num_threads])
+      , num_parked_(0)
+      , next_(0)
+      , spin_count_(hpx::util::safe_lexical_cast<std::size_t>(
+            hpx::get_config_entry("hpx.max_idle_spin_count",
+                HPX_IDLE_SPIN_COUNT_MAX)))
+      , min_timeout_(100)
+      , max_timeout_((std::max)(std::size_t(100),
+            hpx::util::safe_lexical_cast<std::size_t>(
+                hpx::get_config_entry("hpx.max_idle_backoff_time",
+                    HPX_IDLE_BACKOFF_TIME_MAX))))
+    {}
+
+    parking_lot::~parking_lot()
+    {
+        HPX_ASSERT(num_parked_.load() == 0);
+    }
+
+    void parking_lot::set_location(std::size_t num_thread, std::size_t core,
+        std::size_t domain)
+    {
+        HPX_ASSERT(num_thread < num_threads_);
+        slots_[num_thread].core_.store(core, boost::memory_order_relaxed);
+        slots_[num_thread].domain_.store(domain, boost::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void parking_lot::pause()
+    {
+#if defined(BOOST_SMT_PAUSE)
+        BOOST_SMT_PAUSE
+#endif
+    }
+
+    void parking_lot::reset_backoff(std::size_t num_thread)
+    {
+        slots_[num_thread].backoff_ = 0;
+    }
+
+    void parking_lot::prepare_park(std::size_t num_thread)
+    {
+        slot& s = slots_[num_thread];
+        s.state_.store(parked, boost::memory_order_seq_cst);
+        num_parked_.fetch_add(1, boost::memory_order_seq_cst);
+
+        // pairs with the fence in unpark_near/unpark_all: either the worker
+        // sees the new work or the notifier sees the worker being parked
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+    }
+
+    void parking_lot::cancel_park(std::size_t num_thread)
+    {
+        slot& s = slots_[num_thread];
+        s.state_.exchange(active, boost::memory_order_acq_rel);
+        num_parked_.fetch_sub(1, boost::memory_order_relaxed);
+        s.backoff_ = 0;
+    }
+
+    bool parking_lot::wait(std::size_t num_thread)
+    {
+        slot& s = slots_[num_thread];
+
+        // grow the timeout exponentially while the worker stays idle, it
+        // still has to wake up eventually as some work (timers, background
+        // work) is not announced through the parking lot
+        std::size_t const shift = (std::min)(s.backoff_, std::size_t(16));
+        std::chrono::microseconds const timeout(
+            (std::min)(min_timeout_ << shift, max_timeout_));
+
+        s.parks_.fetch_add(1, boost::memory_order_relaxed);
+
+        typedef std::chrono::steady_clock clock_type;
+        clock_type::time_point const start = clock_type::now();
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        detail::futex_wait(s.state_, parked, timeout);
+#else
+        {
+            std::unique_lock<compat::mutex> l(s.mtx_);
+            if (s.state_.load(boost::memory_order_acquire) == parked)
+                s.cond_.wait_for(l, timeout);
+        }
+#endif
+
+        std::uint32_t const prev =
+            s.state_.exchange(active, boost::memory_order_acq_rel);
+        num_parked_.fetch_sub(1, boost::memory_order_relaxed);
+
+        if (prev == notified)
+        {
+            s.wakeups_.fetch_add(1, boost::memory_order_relaxed);
+            s.backoff_ = 0;
+            return true;
+        }
+
+        if (clock_type::now() - start < timeout)
+            s.spurious_wakeups_.fetch_add(1, boost::memory_order_relaxed);
+        else
+            ++s.backoff_;
+
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void parking_lot::wake(slot& s)
+    {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        detail::futex_wake(s.state_);
+#else
+        // acquiring the lock ensures that the worker is either waiting on the
+        // condition variable or has not yet checked its state
+        {
+            std::lock_guard<compat::mutex> l(s.mtx_);
+        }
+        s.cond_.notify_one();
+#endif
+    }
+
+    bool parking_lot::unpark(slot& s)
+    {
+        std::uint32_t expected = parked;
+        if (!s.state_.compare_exchange_strong(expected, notified,
+                boost::memory_order_acq_rel))
+        {
+            return false;
+        }
+
+        wake(s);
+        return true;
+    }
+
+    bool parking_lot::unpark(std::size_t num_thread)
+    {
+        HPX_ASSERT(num_thread < num_threads_);
+        return unpark(slots_[num_thread]);
+    }
+
+    bool parking_lot::unpark_near(std::size_t num_thread)
+    {
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (num_parked_.load(boost::memory_order_relaxed) == 0)
+            return false;
+
+        if (num_thread >= num_threads_)
+        {
+            num_thread = hpx::get_worker_thread_num();
+            if (num_thread >= num_threads_)
+            {
+                num_thread = next_.fetch_add(1, boost::memory_order_relaxed) %
+                    num_threads_;
+            }
+        }
+
+        if (unpark(slots_[num_thread]))
+            return true;
+
+        // prefer workers on the same core, then on the same NUMA domain
+        std::size_t const core =
+            slots_[num_thread].core_.load(boost::memory_order_relaxed);
+        std::size_t const domain =
+            slots_[num_thread].domain_.load(boost::memory_order_relaxed);
+
+        std::size_t same_domain = std::size_t(-1);
+        std::size_t other = std::size_t(-1);
+
+        for (std::size_t i = 1; i != num_threads_; ++i)
+        {
+            std::size_t const n = (num_thread + i) % num_threads_;
+            slot& s = slots_[n];
+
+            if (s.state_.load(boost::memory_order_relaxed) != parked)
+                continue;
+
+            if (core != std::size_t(-1) &&
+                s.core_.load(boost::memory_order_relaxed) == core)
+            {
+                if (unpark(s))
+                    return true;
+            }
+            else if (domain != std::size_t(-1) &&
+                s.domain_.load(boost::memory_order_relaxed) == domain)
+            {
+                if (same_domain == std::size_t(-1))
+                    same_domain = n;
+            }
+            else if (other == std::size_t(-1))
+            {
+                other = n;
+            }
+        }
+
+        if (same_domain != std::size_t(-1) && unpark(slots_[same_domain]))
+            return true;
+        if (other != std::size_t(-1) && unpark(slots_[other]))
+            return true;
+
+        // the candidates were woken up concurrently, take whoever is left
+        for (std::size_t i = 1; i != num_threads_; ++i)
+        {
+            if (unpark(slots_[(num_thread + i) % num_threads_]))
+                return true;
+        }
+        return false;
+    }
+
+    void parking_lot::unpark_all()
+    {
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (num_parked_.load(boost::memory_order_relaxed) == 0)
+            return;
+
+        for (std::size_t i = 0; i != num_threads_; ++i)
+            unpark(slots_[i]);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t parking_lot::accumulate(
+        boost::atomic<std::int64_t> slot::* counter, std::size_t num_thread,
+        bool reset)
+    {
+        if (num_thread != std::size_t(-1))
+        {
+            HPX_ASSERT(num_thread < num_threads_);
+            boost::atomic<std::int64_t>& c = slots_[num_thread].*counter;
+            return reset ? c.exchange(0) : c.load();
+        }
+
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_threads_; ++i)
+        {
+            boost::atomic<std::int64_t>& c = slots_[i].*counter;
+            result += reset ? c.exchange(0) : c.load();
+        }
+        return result;
+    }
+
+    std::int64_t parking_lot::get_num_parks(std::size_t num_thread,
+        bool reset)
+    {
+        return accumulate(&slot::parks_, num_thread, reset);
+    }
+
+    std::int64_t parking_lot::get_num_wakeups(std::size_t num_thread,
+        bool reset)
+    {
+        return accumulate(&slot::wakeups_, num_thread, reset);
+    }
+
+    std::int64_t parking_lot::get_num_spurious_wakeups(std::size_t num_thread,
+        bool reset)
+    {
+        return accumulate(&slot::spurious_wakeups_, num_thread, reset);
+    }
+}}}
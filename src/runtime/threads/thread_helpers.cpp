@@ -506,6 +506,17 @@ namespace hpx { namespace this_thread
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
 
+        // stackless threads can't be woken up by a timer
+        if (HPX_UNLIKELY(id->is_stackless()))
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "this_thread::suspend",
+                "attempting to suspend a stackless HPX thread until a given "
+                "point in time, threads which may suspend have to be created "
+                "with a stack (see threads::thread_stacksize)");
+            return threads::wait_unknown;
+        }
+
         // let the thread manager do other things while waiting
         threads::thread_state_ex_enum statex = threads::wait_unknown;
 
@@ -575,6 +586,12 @@ namespace hpx { namespace this_thread
         return (std::numeric_limits<std::ptrdiff_t>::max)();
     }
 
+    bool can_suspend()
+    {
+        threads::thread_self* self = threads::get_self_ptr();
+        return self != nullptr && !self->is_stackless();
+    }
+
     bool has_sufficient_stack_space(std::size_t space_needed)
     {
         if (nullptr == hpx::threads::get_self_ptr())
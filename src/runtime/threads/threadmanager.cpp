@@ -12,6 +12,7 @@
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads/threadmanager_impl.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
@@ -35,6 +36,7 @@
 #include <mutex>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <utility>
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -139,6 +141,12 @@ namespace hpx { namespace threads
             return "unknown";
 
         util::runtime_configuration const& rtcfg = hpx::get_config();
+        if (size == thread_stacksize_nostack ||
+            rtcfg.get_stack_size(thread_stacksize_nostack) == size)
+        {
+            return "nostack";
+        }
+
         if (rtcfg.get_stack_size(thread_stacksize_small) == size)
             size = thread_stacksize_small;
         else if (rtcfg.get_stack_size(thread_stacksize_medium) == size)
@@ -537,12 +545,16 @@ namespace hpx { namespace threads
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    bool locality_allocator_counter_discoverer(
+    // discover counters with instances '<instancename>#0' to
+    // '<instancename>#<count-1>' in addition to the 'total' instance
+    bool locality_indexed_counter_discoverer(
         performance_counters::counter_info const& info,
         performance_counters::discover_counter_func const& f,
-        performance_counters::discover_counters_mode mode, error_code& ec)
+        performance_counters::discover_counters_mode mode, error_code& ec,
+        char const* instancename, std::size_t count)
     {
         performance_counters::counter_info i = info;
+        std::string const all_instances = std::string(instancename) + "#*";
 
         // compose the counter name templates
         performance_counters::counter_path_elements p;
@@ -569,13 +581,13 @@ namespace hpx { namespace threads
             if (!status_is_valid(status) || !f(i, ec) || ec)
                 return false;
 
-            p.instancename_ = "allocator#*";
+            p.instancename_ = all_instances;
             p.instanceindex_ = -1;
 
             if (mode == performance_counters::discover_counters_full) {
-                for (std::size_t t = 0; t != HPX_COROUTINE_NUM_ALL_HEAPS; ++t)
+                for (std::size_t t = 0; t != count; ++t)
                 {
-                    p.instancename_ = "allocator";
+                    p.instancename_ = instancename;
                     p.instanceindex_ = static_cast<std::int32_t>(t);
                     status = get_counter_name(p, i.fullname_, ec);
                     if (!status_is_valid(status) || !f(i, ec) || ec)
@@ -594,10 +606,10 @@ namespace hpx { namespace threads
             if (!status_is_valid(status) || !f(i, ec) || ec)
                 return false;
         }
-        else if (p.instancename_ == "allocator#*") {
-            for (std::size_t t = 0; t != HPX_COROUTINE_NUM_ALL_HEAPS; ++t)
+        else if (p.instancename_ == all_instances) {
+            for (std::size_t t = 0; t != count; ++t)
             {
-                p.instancename_ = "allocator";
+                p.instancename_ = instancename;
                 p.instanceindex_ = static_cast<std::int32_t>(t);
                 status = get_counter_name(p, i.fullname_, ec);
                 if (!status_is_valid(status) || !f(i, ec) || ec)
@@ -614,6 +626,26 @@ namespace hpx { namespace threads
         return true;
     }
 
+    bool locality_allocator_counter_discoverer(
+        performance_counters::counter_info const& info,
+        performance_counters::discover_counter_func const& f,
+        performance_counters::discover_counters_mode mode, error_code& ec)
+    {
+        return locality_indexed_counter_discoverer(info, f, mode, ec,
+            "allocator", HPX_COROUTINE_NUM_ALL_HEAPS);
+    }
+
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+    bool locality_stack_class_counter_discoverer(
+        performance_counters::counter_info const& info,
+        performance_counters::discover_counter_func const& f,
+        performance_counters::discover_counters_mode mode, error_code& ec)
+    {
+        return locality_indexed_counter_discoverer(info, f, mode, ec,
+            "stack-class", coroutines::detail::posix::num_stack_size_classes);
+    }
+#endif
+
 #ifdef HPX_HAVE_THREAD_IDLE_RATES
     ///////////////////////////////////////////////////////////////////////////
     // idle rate counter creation function
@@ -903,6 +935,42 @@ namespace hpx { namespace threads
               util::bind(&coroutine_type::impl_type::get_stack_unbind_count, _1),
               util::function_nonser<std::uint64_t(bool)>(), "", 0
             },
+#endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+            // /threads{locality#%d/total}/count/stacks-in-use
+            // /threads{locality#%d/stack-class%d}/count/stacks-in-use
+            { "count/stacks-in-use",
+              &coroutines::detail::posix::get_stack_pool_in_use_count_all,
+              util::bind(&coroutines::detail::posix::get_stack_pool_in_use_count,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "stack-class", coroutines::detail::posix::num_stack_size_classes
+            },
+            // /threads{locality#%d/total}/count/stacks-free
+            // /threads{locality#%d/stack-class%d}/count/stacks-free
+            { "count/stacks-free",
+              &coroutines::detail::posix::get_stack_pool_free_count_all,
+              util::bind(&coroutines::detail::posix::get_stack_pool_free_count,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "stack-class", coroutines::detail::posix::num_stack_size_classes
+            },
+            // /threads{locality#%d/total}/count/stacks-in-use-max
+            // /threads{locality#%d/stack-class%d}/count/stacks-in-use-max
+            { "count/stacks-in-use-max",
+              &coroutines::detail::posix::get_stack_pool_max_in_use_count_all,
+              util::bind(
+                  &coroutines::detail::posix::get_stack_pool_max_in_use_count,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "stack-class", coroutines::detail::posix::num_stack_size_classes
+            },
+            // /threads{locality#%d/total}/count/stacks-free-min
+            // /threads{locality#%d/stack-class%d}/count/stacks-free-min
+            { "count/stacks-free-min",
+              &coroutines::detail::posix::get_stack_pool_min_free_count_all,
+              util::bind(
+                  &coroutines::detail::posix::get_stack_pool_min_free_count,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "stack-class", coroutines::detail::posix::num_stack_size_classes
+            },
 #endif
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
@@ -912,6 +980,35 @@ namespace hpx { namespace threads
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "allocator", HPX_COROUTINE_NUM_ALL_HEAPS
             },
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            // /threads{locality#%d/total}/count/idle-parks
+            // /threads{locality#%d/worker-thread%d}/count/idle-parks
+            { "count/idle-parks",
+              util::bind(&spt::get_num_idle_parks, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_idle_parks, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/idle-wakeups
+            // /threads{locality#%d/worker-thread%d}/count/idle-wakeups
+            { "count/idle-wakeups",
+              util::bind(&spt::get_num_idle_wakeups, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_idle_wakeups, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/idle-spurious-wakeups
+            // /threads{locality#%d/worker-thread%d}/count/idle-spurious-wakeups
+            { "count/idle-spurious-wakeups",
+              util::bind(&spt::get_num_idle_spurious_wakeups, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_idle_spurious_wakeups, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+#endif
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
             // /threads{locality#%d/total}/count/pending-misses
             // /threads{locality#%d/worker-thread%d}/count/pending-misses
@@ -1167,6 +1264,44 @@ namespace hpx { namespace threads
               counts_creator, &performance_counters::locality_counter_discoverer,
               ""
             },
+#endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+            { "/threads/count/stacks-in-use", performance_counters::counter_raw,
+              "returns the number of HPX-thread stacks currently handed out by "
+              "the stack pool for the referenced locality (instances "
+              "stack-class#0 to stack-class#3 refer to the small, medium, large "
+              "and huge stack sizes)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &locality_stack_class_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stacks-free", performance_counters::counter_raw,
+              "returns the number of HPX-thread stacks currently available from "
+              "the stack pool for the referenced locality (instances "
+              "stack-class#0 to stack-class#3 refer to the small, medium, large "
+              "and huge stack sizes)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &locality_stack_class_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stacks-in-use-max",
+              performance_counters::counter_raw,
+              "returns the maximal number of HPX-thread stacks handed out by "
+              "the stack pool at the same time since the counter was last "
+              "reset for the referenced locality (instances stack-class#0 to "
+              "stack-class#3 refer to the small, medium, large and huge stack "
+              "sizes)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &locality_stack_class_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stacks-free-min",
+              performance_counters::counter_raw,
+              "returns the minimal number of HPX-thread stacks available from "
+              "the stack pool since the counter was last reset for the "
+              "referenced locality (instances stack-class#0 to stack-class#3 "
+              "refer to the small, medium, large and huge stack sizes)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &locality_stack_class_counter_discoverer,
+              ""
+            },
 #endif
             { "/threads/count/objects", performance_counters::counter_raw,
               "returns the overall number of created HPX-thread objects for "
@@ -1220,6 +1355,31 @@ namespace hpx { namespace threads
               &performance_counters::locality_thread_counter_discoverer,
               ""
             },
+#endif
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            { "/threads/count/idle-parks", performance_counters::counter_raw,
+              "returns the overall number of times worker threads were parked "
+              "because they ran out of work for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/idle-wakeups", performance_counters::counter_raw,
+              "returns the overall number of times parked worker threads were "
+              "woken up because of new work for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/idle-spurious-wakeups",
+              performance_counters::counter_raw,
+              "returns the overall number of times parked worker threads woke "
+              "up without being notified and before their timeout expired for "
+              "the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
 #endif
             // scheduler utilization
             { "/scheduler/utilization/instantaneous", performance_counters::counter_raw,
@@ -1428,6 +1588,11 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         hpx::compat::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        hpx::compat::mutex, hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
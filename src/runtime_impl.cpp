@@ -28,6 +28,7 @@
 #include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/set_thread_name.hpp>
 #include <hpx/util/thread_mapper.hpp>
+#include <hpx/util/thread_trace.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -490,6 +491,11 @@ namespace hpx {
         parcel_handler_.stop(blocking);     // stops parcel pools as well
         io_pool_.stop();                    // stops io_pool_ as well
 
+#if defined(HPX_HAVE_THREAD_TRACE)
+        // all threads are stopped, write the recorded events, if requested
+        util::thread_trace::dump_at_shutdown();
+#endif
+
         deinit_tss();
     }
 
@@ -695,6 +701,9 @@ namespace hpx {
 #if defined(HPX_HAVE_APEX)
             if (std::strstr(name, "worker") != nullptr)
                 apex::register_thread(name);
+#endif
+#if defined(HPX_HAVE_THREAD_TRACE)
+            util::thread_trace::register_thread(name);
 #endif
         }
 
@@ -869,6 +878,11 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         hpx::compat::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        hpx::compat::mutex, hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::runtime_impl<
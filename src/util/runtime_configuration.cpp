@@ -9,6 +9,7 @@
 #include <hpx/config/defaults.hpp>
 // TODO: move parcel ports into plugins
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
 #include <hpx/util/filesystem_compatibility.hpp>
@@ -18,6 +19,7 @@
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/register_locks_globally.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/thread_trace.hpp>
 #include <hpx/version.hpp>
 
 #include <boost/detail/endian.hpp>
@@ -194,12 +196,21 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_LOOP_COUNT_MAX)) "}",
             "max_busy_loop_count = ${HPX_MAX_BUSY_LOOP_COUNT:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_BUSY_LOOP_COUNT_MAX)) "}",
+            "max_idle_spin_count = ${HPX_MAX_IDLE_SPIN_COUNT:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_SPIN_COUNT_MAX)) "}",
+            "max_idle_backoff_time = ${HPX_MAX_IDLE_BACKOFF_TIME:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_BACKOFF_TIME_MAX)) "}",
 
             // arity for collective operations implemented in a tree fashion
             "[hpx.lcos.collectives]",
             "arity = ${HPX_LCOS_COLLECTIVES_ARITY:32}",
             "cut_off = ${HPX_LCOS_COLLECTIVES_CUT_OFF:-1}",
 
+            // batching of the asynchronous output sent by hpx::cout et.al.
+            "[hpx.iostreams]",
+            "batch_size = ${HPX_IOSTREAMS_BATCH_SIZE:4096}",
+            "batch_delay = ${HPX_IOSTREAMS_BATCH_DELAY:1000}",
+
             // connect back to the given latch if specified
             "[hpx.on_startup]",
             "wait_on_latch = ${HPX_ON_STARTUP_WAIT_ON_LATCH}",
@@ -222,6 +233,19 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
 #endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+            "use_pool = ${HPX_USE_STACK_POOL:1}",
+            "use_huge_pages = ${HPX_USE_HUGE_PAGE_STACKS:0}",
+            "pool_slab_size = ${HPX_STACK_POOL_SLAB_SIZE:0x1000000}",
+            "pool_max_idle = ${HPX_STACK_POOL_MAX_IDLE:256}",
+#endif
+
+#if defined(HPX_HAVE_THREAD_TRACE)
+            "[hpx.trace]",
+            "enabled = ${HPX_TRACE_ENABLED:0}",
+            "buffer_size = ${HPX_TRACE_BUFFER_SIZE:65536}",
+            "destination = ${HPX_TRACE_DESTINATION:}",
+#endif
 
             "[hpx.threadpools]",
             "io_pool_size = ${HPX_NUM_IO_POOL_SIZE:"
@@ -496,6 +520,12 @@ namespace hpx { namespace util
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
 #endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+        init_stack_pool();
+#endif
+#if defined(HPX_HAVE_THREAD_TRACE)
+        init_thread_trace();
+#endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
             util::enable_lock_detection();
@@ -557,6 +587,12 @@ namespace hpx { namespace util
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
 #endif
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+        init_stack_pool();
+#endif
+#if defined(HPX_HAVE_THREAD_TRACE)
+        init_thread_trace();
+#endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
             util::enable_lock_detection();
@@ -934,6 +970,61 @@ namespace hpx { namespace util
     }
 #endif
 
+#if defined(HPX_HAVE_THREAD_STACK_POOL)
+    void runtime_configuration::init_stack_pool() const
+    {
+        threads::coroutines::detail::posix::stack_pool_parameters params;
+
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                params.enabled_ = hpx::util::get_entry_as<int>(
+                    *sec, "use_pool", "1") != 0;
+                params.use_huge_pages_ = hpx::util::get_entry_as<int>(
+                    *sec, "use_huge_pages", "0") != 0;
+                params.max_idle_stacks_ = hpx::util::get_entry_as<std::size_t>(
+                    *sec, "pool_max_idle", "256");
+            }
+        }
+
+        params.slab_size_ = static_cast<std::size_t>(
+            init_stack_size("pool_slab_size", "0x1000000", 0x1000000));
+
+        params.stack_sizes_[threads::coroutines::detail::posix::
+            stack_size_class_small] = static_cast<std::size_t>(small_stacksize);
+        params.stack_sizes_[threads::coroutines::detail::posix::
+            stack_size_class_medium] = static_cast<std::size_t>(medium_stacksize);
+        params.stack_sizes_[threads::coroutines::detail::posix::
+            stack_size_class_large] = static_cast<std::size_t>(large_stacksize);
+        params.stack_sizes_[threads::coroutines::detail::posix::
+            stack_size_class_huge] = static_cast<std::size_t>(huge_stacksize);
+
+        threads::coroutines::detail::posix::configure_stack_pool(params);
+    }
+#endif
+
+#if defined(HPX_HAVE_THREAD_TRACE)
+    void runtime_configuration::init_thread_trace() const
+    {
+        bool enabled = false;
+        std::size_t buffer_size = 65536;
+        std::string destination;
+
+        if (has_section("hpx.trace")) {
+            util::section const* sec = get_section("hpx.trace");
+            if (nullptr != sec) {
+                enabled = hpx::util::get_entry_as<int>(
+                    *sec, "enabled", "0") != 0;
+                buffer_size = hpx::util::get_entry_as<std::size_t>(
+                    *sec, "buffer_size", "65536");
+                destination = sec->get_entry("destination", "");
+            }
+        }
+
+        util::thread_trace::configure(enabled, buffer_size, destination);
+    }
+#endif
+
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
     {
         return init_stack_size("small_size",
@@ -1025,6 +1116,9 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        case threads::thread_stacksize_nostack:
+            return (std::numeric_limits<std::ptrdiff_t>::max)();
+
         default:
         case threads::thread_stacksize_small:
             break;
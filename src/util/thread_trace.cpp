@@ -0,0 +1,440 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_THREAD_TRACE)
+#include <hpx/error_code.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/naming_fwd.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+#include <hpx/util/thread_trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace thread_trace
+{
+    namespace detail
+    {
+        std::atomic<bool> enabled(false);
+
+        ///////////////////////////////////////////////////////////////////////
+        // The description is copied into the event as the string it was
+        // taken from might not be alive anymore once the events are written.
+        std::size_t const max_description_length = 40;
+
+        struct event
+        {
+            std::uint64_t timestamp_;
+            void const* id_;
+            std::uint64_t data_;
+            event_type type_;
+            char desc_[max_description_length];
+        };
+
+        // Each OS-thread owns exactly one ring, which is written by this
+        // thread only. Readers take a snapshot and discard all entries which
+        // might have been overwritten while the snapshot was taken.
+        struct ring
+        {
+            ring(std::string name, std::size_t capacity)
+              : name_(std::move(name)), capacity_(capacity), head_(0), tail_(0)
+            {}
+
+            void push(event const& e)
+            {
+                if (HPX_UNLIKELY(!events_))
+                    events_.reset(new event[capacity_]);
+
+                std::uint64_t head = head_.load(std::memory_order_relaxed);
+                events_[head & (capacity_ - 1)] = e;
+                head_.store(head + 1, std::memory_order_release);
+            }
+
+            void snapshot(std::vector<event>& events) const
+            {
+                std::uint64_t head = head_.load(std::memory_order_acquire);
+                std::uint64_t first = tail_.load(std::memory_order_relaxed);
+                if (head > capacity_ && first < head - capacity_)
+                    first = head - capacity_;
+                if (first >= head)
+                    return;
+
+                std::size_t start = events.size();
+                for (std::uint64_t i = first; i != head; ++i)
+                    events.push_back(events_[i & (capacity_ - 1)]);
+
+                // drop the entries the writer might have overwritten in the
+                // meantime, including the one it might be writing right now
+                std::atomic_thread_fence(std::memory_order_acquire);
+                std::uint64_t current = head_.load(std::memory_order_relaxed);
+                if (current + 1 > capacity_ + first)
+                {
+                    std::size_t overwritten = static_cast<std::size_t>(
+                        (std::min)(current + 1 - capacity_ - first,
+                            head - first));
+                    events.erase(events.begin() + start,
+                        events.begin() + start + overwritten);
+                }
+            }
+
+            void clear()
+            {
+                tail_.store(head_.load(std::memory_order_acquire),
+                    std::memory_order_relaxed);
+            }
+
+            std::string name_;
+            std::size_t capacity_;
+            std::unique_ptr<event[]> events_;
+            std::atomic<std::uint64_t> head_;
+            std::atomic<std::uint64_t> tail_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct registry
+        {
+            registry()
+              : buffer_size_(65536)
+            {}
+
+            ring* add_ring(char const* name)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+
+                std::string ringname;
+                if (name != nullptr && *name)
+                    ringname = name;
+                else
+                    ringname = "thread#" + std::to_string(rings_.size());
+
+                rings_.emplace_back(new ring(std::move(ringname), buffer_size_));
+                return rings_.back().get();
+            }
+
+            std::mutex mtx_;
+            std::vector<std::unique_ptr<ring> > rings_;
+            std::size_t buffer_size_;
+            std::string destination_;
+        };
+
+        registry& get_registry()
+        {
+            static registry r;
+            return r;
+        }
+
+        static HPX_NATIVE_TLS ring* current_ring = nullptr;
+
+        ring& get_ring(char const* name = nullptr)
+        {
+            if (HPX_UNLIKELY(current_ring == nullptr))
+                current_ring = get_registry().add_ring(name);
+            return *current_ring;
+        }
+
+        void record(event_type type, void const* id, char const* desc,
+            std::uint64_t data)
+        {
+            event e = { high_resolution_clock::now(), id, data, type, {} };
+            if (desc != nullptr)
+            {
+                std::size_t len = std::strlen(desc);
+                if (len >= max_description_length)
+                    len = max_description_length - 1;
+                std::memcpy(e.desc_, desc, len);
+            }
+            get_ring().push(e);
+        }
+
+        void record(event_type type, void const* id,
+            util::thread_description const& desc, std::uint64_t data)
+        {
+            if (desc.kind() == util::thread_description::data_type_description)
+            {
+                detail::record(type, id, desc.get_description(), data);
+                return;
+            }
+
+            // label the thread with the address of the function it executes
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%#zx",
+                desc.get_address());
+            detail::record(type, id, buffer, data);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void write_string(std::ostream& os, char const* str)
+        {
+            os << '"';
+            for (/**/; *str; ++str)
+            {
+                char c = *str;
+                switch (c)
+                {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n"; break;
+                case '\r': os << "\\r"; break;
+                case '\t': os << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x",
+                            static_cast<unsigned>(c));
+                        os << buffer;
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                    break;
+                }
+            }
+            os << '"';
+        }
+
+        // Chrome expects the time stamps in microseconds
+        void write_timestamp(std::ostream& os, std::uint64_t ns)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%llu.%03u",
+                static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned>(ns % 1000));
+            os << buffer;
+        }
+
+        void write_header(std::ostream& os, char const* name, char const* cat,
+            char const* ph, event const& e, std::uint32_t pid, std::size_t tid)
+        {
+            os << ",\n{\"name\":";
+            write_string(os, name);
+            os << ",\"cat\":\"" << cat << "\",\"ph\":\"" << ph << "\",\"ts\":";
+            write_timestamp(os, e.timestamp_);
+            os << ",\"pid\":" << pid << ",\"tid\":" << tid;
+        }
+
+        void write_id(std::ostream& os, void const* id)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "\"%p\"", id);
+            os << buffer;
+        }
+
+        char const* get_description(event const& e)
+        {
+            return e.desc_[0] != '\0' ? e.desc_ : "<unknown>";
+        }
+
+        void write_events(std::ostream& os, std::vector<event> const& events,
+            std::uint32_t pid, std::size_t tid)
+        {
+            // a thread_run event opens a slice which is closed by the
+            // corresponding thread_suspend or thread_terminate event
+            bool running = false;
+            for (event const& e : events)
+            {
+                switch (e.type_)
+                {
+                case thread_create:
+                    write_header(os, "create", "thread", "i", e, pid, tid);
+                    os << ",\"s\":\"t\",\"args\":{\"id\":";
+                    write_id(os, e.id_);
+                    os << ",\"description\":";
+                    write_string(os, get_description(e));
+                    os << "}}";
+                    break;
+
+                case thread_run:
+                    if (running)
+                    {
+                        // the closing event got lost, close the slice here
+                        write_header(os, "", "thread", "E", e, pid, tid);
+                        os << "}";
+                    }
+                    write_header(os, get_description(e), "thread", "B", e,
+                        pid, tid);
+                    os << ",\"args\":{\"id\":";
+                    write_id(os, e.id_);
+                    os << ",\"phase\":" << e.data_ << "}}";
+                    running = true;
+                    break;
+
+                case thread_suspend:
+                case thread_terminate:
+                    // the opening event might have been overwritten already
+                    if (running)
+                    {
+                        write_header(os, "", "thread", "E", e, pid, tid);
+                        os << ",\"args\":{\"state\":\""
+                           << (e.type_ == thread_suspend ?
+                                  "suspended" : "terminated")
+                           << "\"}}";
+                        running = false;
+                    }
+                    break;
+
+                case thread_steal:
+                    write_header(os, "steal", "scheduler", "i", e, pid, tid);
+                    os << ",\"s\":\"t\",\"args\":{\"id\":";
+                    write_id(os, e.id_);
+                    os << ",\"victim\":" << e.data_ << "}}";
+                    break;
+
+                case parcel_send:
+                case parcel_receive:
+                    write_header(os,
+                        e.type_ == parcel_send ? "send" : "receive",
+                        "parcel", "i", e, pid, tid);
+                    os << ",\"s\":\"t\",\"args\":{\"bytes\":" << e.data_
+                       << "}}";
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        std::uint32_t get_pid()
+        {
+            error_code ec(lightweight);
+            std::uint32_t locality_id = hpx::get_locality_id(ec);
+            if (ec || locality_id == naming::invalid_locality_id)
+                return 0;
+            return locality_id;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void enable(bool enabled)
+    {
+        detail::enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void configure(bool enabled, std::size_t buffer_size,
+        std::string const& destination)
+    {
+        detail::registry& r = detail::get_registry();
+        {
+            std::lock_guard<std::mutex> l(r.mtx_);
+
+            // the ring buffers rely on their capacity being a power of two
+            std::size_t size = 1;
+            while (size < buffer_size)
+                size <<= 1;
+
+            r.buffer_size_ = size;
+            r.destination_ = destination;
+        }
+        enable(enabled);
+    }
+
+    void register_thread(char const* name)
+    {
+        detail::get_ring(name);
+    }
+
+    void dump(std::ostream& os)
+    {
+        detail::registry& r = detail::get_registry();
+        std::uint32_t pid = detail::get_pid();
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+           << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+           << ",\"tid\":0,\"args\":{\"name\":\"locality#" << pid << "\"}}";
+
+        std::lock_guard<std::mutex> l(r.mtx_);
+
+        std::vector<detail::event> events;
+        for (std::size_t tid = 0; tid != r.rings_.size(); ++tid)
+        {
+            detail::ring const& ring = *r.rings_[tid];
+
+            os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+               << ",\"tid\":" << tid << ",\"args\":{\"name\":";
+            detail::write_string(os, ring.name_.c_str());
+            os << "}}";
+
+            events.clear();
+            ring.snapshot(events);
+            detail::write_events(os, events, pid, tid);
+        }
+
+        os << "\n]}\n";
+    }
+
+    bool dump(std::string const& filename)
+    {
+        std::ofstream out(filename.c_str());
+        if (!out)
+        {
+            std::cerr << "hpx::util::thread_trace::dump: could not open '"
+                      << filename << "' for writing" << std::endl;
+            return false;
+        }
+
+        dump(out);
+        return true;
+    }
+
+    void dump_at_shutdown()
+    {
+        std::string filename;
+        {
+            detail::registry& r = detail::get_registry();
+            std::lock_guard<std::mutex> l(r.mtx_);
+            filename = r.destination_;
+        }
+
+        if (filename.empty())
+            return;
+
+        // every locality writes its own file
+        if (hpx::get_initial_num_localities() > 1)
+        {
+            std::string suffix = "." + std::to_string(detail::get_pid());
+
+            std::string::size_type dot = filename.find_last_of('.');
+            std::string::size_type sep = filename.find_last_of("/\\");
+            if (dot != std::string::npos &&
+                (sep == std::string::npos || dot > sep))
+            {
+                filename.insert(dot, suffix);
+            }
+            else
+            {
+                filename += suffix;
+            }
+        }
+
+        dump(filename);
+    }
+
+    void clear()
+    {
+        detail::registry& r = detail::get_registry();
+        std::lock_guard<std::mutex> l(r.mtx_);
+        for (std::unique_ptr<detail::ring>& ring : r.rings_)
+            ring->clear();
+    }
+}}}
+
+#endif
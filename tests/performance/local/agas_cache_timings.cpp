@@ -11,103 +11,26 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
-#include <hpx/util/cache/entries/lfu_entry.hpp>
-#include <hpx/util/cache/local_cache.hpp>
-#include <hpx/util/cache/statistics/local_full_statistics.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
 #include <hpx/util/histogram.hpp>
 
 #include <boost/program_options.hpp>
-#include <boost/icl/closed_interval.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iomanip>
 #include <iostream>
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
-// Below is a copy of the original AGAS cache
-typedef hpx::util::cache::entries::lfu_entry<hpx::agas::gva> gva_entry_type;
-
-struct gva_cache_key
-{
-private:
-    typedef boost::icl::closed_interval<hpx::naming::gid_type, std::less>
-        key_type;
-
-    key_type key_;
-
-public:
-    gva_cache_key()
-      : key_()
-    {}
-
-    explicit gva_cache_key(hpx::naming::gid_type const& id, std::uint64_t count)
-      : key_(hpx::naming::detail::get_stripped_gid(id),
-             hpx::naming::detail::get_stripped_gid(id) + (count - 1))
-    {
-        HPX_ASSERT(count);
-    }
-
-    hpx::naming::gid_type get_gid() const
-    {
-        return boost::icl::lower(key_);
-    }
-
-    std::uint64_t get_count() const
-    {
-        hpx::naming::gid_type const size = boost::icl::length(key_);
-        HPX_ASSERT(size.get_msb() == 0);
-        return size.get_lsb();
-    }
-
-    friend bool operator<(gva_cache_key const& lhs, gva_cache_key const& rhs)
-    {
-        return boost::icl::exclusive_less(lhs.key_, rhs.key_);
-    }
-
-    friend bool operator==(gva_cache_key const& lhs, gva_cache_key const& rhs)
-    {
-        // Is lhs in rhs?
-        if (1 == lhs.get_count() && 1 != rhs.get_count())
-            return boost::icl::contains(rhs.key_, lhs.key_);
-
-        // Is rhs in lhs?
-        else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            return boost::icl::contains(lhs.key_, rhs.key_);
-
-        // Direct hit
-        return lhs.key_ == rhs.key_;
-    }
-};
-
-struct gva_erase_policy
-{
-    gva_erase_policy(hpx::naming::gid_type const& id, std::uint64_t count)
-      : entry(id, count)
-    {}
-
-    typedef std::pair<gva_cache_key, gva_entry_type> entry_type;
-
-    bool operator()(entry_type const& p) const
-    {
-        return p.first == entry;
-    }
-
-    gva_cache_key entry;
-};
-
-typedef hpx::util::cache::local_cache<
-    gva_cache_key, gva_entry_type, std::less<gva_entry_type>,
-    hpx::util::cache::policies::always<gva_entry_type>,
-    std::map<gva_cache_key, gva_entry_type>,
-    hpx::util::cache::statistics::local_full_statistics
-> gva_cache_type;
+typedef hpx::agas::detail::gva_cache gva_cache_type;
 
 ///////////////////////////////////////////////////////////////////////////////
 void calculate_histogram(std::string const& prefix,
@@ -158,12 +81,16 @@ void test_insert(gva_cache_type& cache, std::size_t num_entries)
 
     for (std::size_t i = 0; i != num_entries; ++i)
     {
-        gva_cache_key key(hpx::detail::get_next_id(), 1);
+        hpx::naming::gid_type key(hpx::naming::detail::get_stripped_gid(
+            hpx::detail::get_next_id()));
         hpx::agas::gva value(locality, ct, 1, std::uint64_t(0), 0);
 
+        hpx::naming::gid_type idbase;
+        std::uint64_t count = 0;
+
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
-        cache.insert(key, value);
+        cache.update_if(key, 1, value, idbase, count);
 
         timings.push_back(hpx::util::high_resolution_clock::now() - t);
     }
@@ -178,9 +105,10 @@ void test_get(gva_cache_type& cache, hpx::naming::gid_type first_key)
 
     for (std::size_t i = 0; i != cache.size(); ++i)
     {
-        gva_cache_key key(++first_key, 1);
-        gva_cache_key idbase;
-        gva_cache_type::entry_type e;
+        hpx::naming::gid_type key(
+            hpx::naming::detail::get_stripped_gid(++first_key));
+        hpx::naming::gid_type idbase;
+        hpx::agas::gva e;
 
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
@@ -202,12 +130,16 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
 
     for (std::size_t i = 0; i != cache.size(); ++i)
     {
-        gva_cache_key key(++first_key, 1);
+        hpx::naming::gid_type key(
+            hpx::naming::detail::get_stripped_gid(++first_key));
         hpx::agas::gva value(locality, ct, 1, std::uint64_t(1), 1);
 
+        hpx::naming::gid_type idbase;
+        std::uint64_t count = 0;
+
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
-        cache.update(key, value);
+        cache.update_if(key, 1, value, idbase, count);
 
         timings.push_back(hpx::util::high_resolution_clock::now() - t);
     }
@@ -215,6 +147,56 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Measure the throughput of concurrent lookups while using 1..N worker
+// threads, each of the threads looks up all entries of the cache.
+void read_entries(gva_cache_type& cache, hpx::naming::gid_type first_key,
+    std::size_t num_entries, std::size_t num_iterations)
+{
+    for (std::size_t j = 0; j != num_iterations; ++j)
+    {
+        hpx::naming::gid_type key = first_key;
+        for (std::size_t i = 0; i != num_entries; ++i)
+        {
+            hpx::naming::gid_type idbase;
+            hpx::agas::gva e;
+
+            cache.get_entry(
+                hpx::naming::detail::get_stripped_gid(++key), idbase, e);
+        }
+    }
+}
+
+void test_get_scaling(gva_cache_type& cache, hpx::naming::gid_type first_key,
+    std::size_t num_entries, std::size_t num_iterations)
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    for (std::size_t n = 1; n <= num_threads; ++n)
+    {
+        std::vector<hpx::future<void> > results;
+        results.reserve(n);
+
+        std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            hpx::threads::executors::default_executor exec(i);
+            results.push_back(hpx::async(exec, &read_entries,
+                std::ref(cache), first_key, num_entries, num_iterations));
+        }
+        hpx::wait_all(results);
+
+        double elapsed =
+            double(hpx::util::high_resolution_clock::now() - t) * 1e-9;
+        double lookups = double(n * num_entries * num_iterations);
+
+        std::cout << "   get (" << std::setw(3) << n << " threads): "
+                  << std::setprecision(3) << std::setw(8)
+                  << (lookups / elapsed) * 1e-6 << " Mlookups/s"
+                  << std::endl;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -226,6 +208,10 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (vm.count("num_entries"))
         num_entries = vm["num_entries"].as<std::size_t>();
 
+    std::size_t num_iterations = 100;
+    if (vm.count("num_iterations"))
+        num_iterations = vm["num_iterations"].as<std::size_t>();
+
     gva_cache_type cache;
     cache.reserve(cache_size);
 
@@ -234,6 +220,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_insert(cache, num_entries);
     test_get(cache, first_key);
     test_update(cache, first_key);
+    test_get_scaling(cache, first_key, num_entries, num_iterations);
 
     return hpx::finalize();
 }
@@ -250,6 +237,9 @@ int main(int argc, char* argv[])
          HPX_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("num_iterations", value<std::size_t>(),
+         "number of times each thread looks up all items while measuring "
+         "the scaling of concurrent lookups (default: 100)")
         ;
 
     // Initialize and run HPX
@@ -6,6 +6,7 @@
 // TODO: Update
 
 #include <hpx/hpx_init.hpp>
+#include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/wait_each.hpp>
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
@@ -121,6 +122,94 @@ void measure_function_futures(std::uint64_t count, bool csv)
               << flush;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The following measure the shared state of the futures alone, without any
+// thread being created or suspended (no contention on the shared state).
+void print_result(char const* what, std::uint64_t count, double duration,
+    bool csv)
+{
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("%1% %2% futures in %3% seconds\n")
+                % what
+                % count
+                % duration)
+              << flush;
+}
+
+// promise::set_value followed by future::is_ready and future::get
+void measure_set_value(std::uint64_t count, bool csv)
+{
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::lcos::local::promise<double> p;
+        future<double> f = p.get_future();
+
+        p.set_value(double(i));
+        if (f.is_ready())
+            global_scratch += f.get();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    print_result("set value of", count, duration, csv);
+}
+
+// future::then attached before the value is set, the continuation runs
+// synchronously on the thread setting the value
+void measure_then(std::uint64_t count, bool csv)
+{
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::lcos::local::promise<double> p;
+        future<void> f = p.get_future().then(hpx::launch::sync, scratcher());
+
+        p.set_value(double(i));
+        f.get();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    print_result("attached continuations to", count, duration, csv);
+}
+
+// future::is_ready on futures which are not ready yet
+void measure_is_ready(std::uint64_t count, bool csv)
+{
+    hpx::lcos::local::promise<double> p;
+    future<double> f = p.get_future();
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    std::uint64_t ready = 0;
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        if (f.is_ready())
+            ++ready;
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    p.set_value(double(ready));
+    global_scratch += f.get();
+
+    print_result("checked readiness of", count, duration, csv);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -136,6 +225,10 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+
+        measure_set_value(count, vm.count("csv") != 0);
+        measure_then(count, vm.count("csv") != 0);
+        measure_is_ready(count, vm.count("csv") != 0);
     }
 
     finalize();
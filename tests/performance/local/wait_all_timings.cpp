@@ -17,6 +17,8 @@
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
+bool use_promises = false;
+
 std::vector<hpx::future<void> >
 create_tasks(std::size_t num_tasks, std::size_t delay)
 {
@@ -24,7 +26,15 @@ create_tasks(std::size_t num_tasks, std::size_t delay)
     tasks.reserve(num_tasks);
     for (std::size_t i = 0; i != num_tasks; ++i)
     {
-        if (delay == 0)
+        if (use_promises)
+        {
+            // the value is set through the shared state instead of
+            // creating the future in the ready state
+            hpx::lcos::local::promise<void> p;
+            tasks.push_back(p.get_future());
+            p.set_value();
+        }
+        else if (delay == 0)
         {
             tasks.push_back(hpx::make_ready_future());
         }
@@ -99,6 +109,8 @@ int hpx_main(boost::program_options::variables_map& vm)
         num_chunks = vm["chunks"].as<std::size_t>();
     if (vm.count("delay"))
         delay = vm["delay"].as<std::size_t>();
+    if (vm.count("promises"))
+        use_promises = true;
 
     if (num_chunks == 0)
         num_chunks = 1;
@@ -156,6 +168,8 @@ int main(int argc, char* argv[])
          "number of iterations in the delay loop")
         ("no-header,n", po::value<bool>()->default_value(true),
          "do not print out the csv header row")
+        ("promises,p",
+         "make the futures ready by setting the value of a promise")
         ;
 
     // Initialize and run HPX.
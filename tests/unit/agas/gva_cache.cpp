@@ -0,0 +1,271 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using hpx::agas::gva;
+using hpx::agas::detail::gva_cache;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+gva make_gva(std::uint64_t lva, std::uint64_t count = 1)
+{
+    return gva(gid_type(0x100000001ULL, 0), 42, count, lva, 8);
+}
+
+void test_single_entries()
+{
+    gva_cache cache(64);
+    HPX_TEST_EQ(cache.capacity(), std::size_t(64));
+
+    gid_type idbase;
+    std::uint64_t old_count = 0;
+    gva g;
+
+    for (std::uint64_t i = 1; i <= 32; ++i)
+    {
+        HPX_TEST(cache.update_if(gid_type(1, i), 1, make_gva(i),
+            idbase, old_count));
+    }
+    HPX_TEST_EQ(cache.size(), std::size_t(32));
+
+    for (std::uint64_t i = 1; i <= 32; ++i)
+    {
+        HPX_TEST(cache.get_entry(gid_type(1, i), idbase, g));
+        HPX_TEST_EQ(idbase, gid_type(1, i));
+        HPX_TEST_EQ(g, make_gva(i));
+    }
+    HPX_TEST(!cache.get_entry(gid_type(1, 100), idbase, g));
+
+    // update an existing entry
+    HPX_TEST(cache.update_if(gid_type(1, 1), 1, make_gva(100),
+        idbase, old_count));
+    HPX_TEST(cache.get_entry(gid_type(1, 1), idbase, g));
+    HPX_TEST_EQ(g, make_gva(100));
+    HPX_TEST_EQ(cache.size(), std::size_t(32));
+
+    HPX_TEST_EQ(cache.erase(gid_type(1, 1)), std::size_t(1));
+    HPX_TEST(!cache.get_entry(gid_type(1, 1), idbase, g));
+    HPX_TEST_EQ(cache.size(), std::size_t(31));
+
+    gva_cache::statistics& stats = cache.get_statistics();
+    HPX_TEST_EQ(stats.hits(false), std::size_t(32 + 1 + 1));
+    HPX_TEST_EQ(stats.misses(false), std::size_t(32 + 1 + 1));
+    HPX_TEST_EQ(stats.insertions(false), std::size_t(32));
+    HPX_TEST_EQ(stats.get_get_entry_count(true), std::int64_t(32 + 1 + 1 + 1));
+    HPX_TEST_EQ(stats.get_get_entry_count(false), std::int64_t(0));
+
+    HPX_TEST_EQ(cache.clear(), std::size_t(31));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+}
+
+void test_eviction()
+{
+    gva_cache cache(64);
+
+    gid_type idbase;
+    std::uint64_t old_count = 0;
+
+    for (std::uint64_t i = 1; i <= 1024; ++i)
+    {
+        HPX_TEST(cache.update_if(gid_type(1, i), 1, make_gva(i),
+            idbase, old_count));
+    }
+
+    // the cache never holds more entries than it has slots
+    HPX_TEST(cache.size() <= std::size_t(64));
+    HPX_TEST_EQ(cache.get_statistics().insertions(false), std::size_t(1024));
+    HPX_TEST_EQ(cache.get_statistics().evictions(false),
+        std::size_t(1024) - cache.size());
+
+    // all remaining entries are still valid
+    std::size_t found = 0;
+    for (std::uint64_t i = 1; i <= 1024; ++i)
+    {
+        gva g;
+        if (cache.get_entry(gid_type(1, i), idbase, g))
+        {
+            HPX_TEST_EQ(g, make_gva(i));
+            ++found;
+        }
+    }
+    HPX_TEST_EQ(found, cache.size());
+
+    // growing the cache keeps the existing entries
+    std::size_t size = cache.size();
+    cache.reserve(1024);
+    HPX_TEST_EQ(cache.size(), size);
+}
+
+void test_range_entries()
+{
+    gva_cache cache(64);
+
+    gid_type idbase;
+    std::uint64_t old_count = 0;
+    gva g;
+
+    HPX_TEST(cache.update_if(gid_type(1, 100), 10, make_gva(1000, 10),
+        idbase, old_count));
+
+    for (std::uint64_t i = 100; i != 110; ++i)
+    {
+        HPX_TEST(cache.get_entry(gid_type(1, i), idbase, g));
+        HPX_TEST_EQ(idbase, gid_type(1, 100));
+        HPX_TEST_EQ(g, make_gva(1000, 10));
+    }
+    HPX_TEST(!cache.get_entry(gid_type(1, 99), idbase, g));
+    HPX_TEST(!cache.get_entry(gid_type(1, 110), idbase, g));
+
+    // overlapping entries are rejected
+    HPX_TEST(!cache.update_if(gid_type(1, 105), 1, make_gva(1),
+        idbase, old_count));
+    HPX_TEST_EQ(idbase, gid_type(1, 100));
+    HPX_TEST_EQ(old_count, std::uint64_t(10));
+
+    HPX_TEST(!cache.update_if(gid_type(1, 95), 10, make_gva(1, 10),
+        idbase, old_count));
+    HPX_TEST_EQ(idbase, gid_type(1, 100));
+
+    // the same range can be updated
+    HPX_TEST(cache.update_if(gid_type(1, 100), 10, make_gva(2000, 10),
+        idbase, old_count));
+    HPX_TEST(cache.get_entry(gid_type(1, 109), idbase, g));
+    HPX_TEST_EQ(g, make_gva(2000, 10));
+
+    HPX_TEST_EQ(cache.erase(gid_type(1, 100)), std::size_t(1));
+    HPX_TEST(!cache.get_entry(gid_type(1, 105), idbase, g));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+}
+
+void test_concurrent_access()
+{
+    std::size_t const num_entries = 256;
+    std::size_t const num_threads = 4;
+
+    gva_cache cache(num_entries);
+
+    gid_type idbase;
+    std::uint64_t old_count = 0;
+    for (std::uint64_t i = 1; i <= num_entries; ++i)
+        cache.update_if(gid_type(1, i), 1, make_gva(i), idbase, old_count);
+
+    // readers must never observe partially written entries
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&cache, t, num_entries]()
+            {
+                gid_type idbase;
+                std::uint64_t old_count = 0;
+                for (std::size_t n = 0; n != 10000; ++n)
+                {
+                    std::uint64_t i = (n * (t + 1)) % num_entries + 1;
+                    if (t == 0)
+                    {
+                        cache.update_if(gid_type(1, i), 1, make_gva(n % 2 ? i : 0),
+                            idbase, old_count);
+                        continue;
+                    }
+
+                    gva g;
+                    if (cache.get_entry(gid_type(1, i), idbase, g))
+                    {
+                        HPX_TEST(g == make_gva(i) || g == make_gva(0));
+                    }
+                }
+            });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+}
+
+void test_repeated_resize()
+{
+    std::size_t const num_entries = 256;
+    std::size_t const num_threads = 4;
+
+    gva_cache cache(num_entries);
+
+    gid_type idbase;
+    std::uint64_t old_count = 0;
+    for (std::uint64_t i = 1; i <= num_entries; ++i)
+        cache.update_if(gid_type(1, i), 1, make_gva(i), idbase, old_count);
+
+    // replaced tables are freed once no reader accesses the cache anymore
+    for (std::size_t n = 0; n != 1000; ++n)
+    {
+        cache.reserve(n % 2 ? num_entries : 2 * num_entries);
+        HPX_TEST_EQ(cache.num_retired_tables(), std::size_t(0));
+    }
+
+    // resize and flush the cache while other threads keep reading from it
+    boost::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&cache, &done, t, num_entries]()
+            {
+                gid_type idbase;
+                std::uint64_t old_count = 0;
+                for (std::size_t n = 0; !done.load(); ++n)
+                {
+                    std::uint64_t i = (n * (t + 1)) % num_entries + 1;
+                    if (n % 8 == 0)
+                    {
+                        cache.update_if(gid_type(1, i), 1, make_gva(i),
+                            idbase, old_count);
+                        continue;
+                    }
+
+                    gva g;
+                    if (cache.get_entry(gid_type(1, i), idbase, g))
+                    {
+                        HPX_TEST_EQ(g, make_gva(i));
+                    }
+                }
+            });
+    }
+
+    for (std::size_t n = 0; n != 1000; ++n)
+    {
+        cache.reserve(n % 2 ? num_entries : 2 * num_entries);
+        if (n % 10 == 0)
+            cache.clear();
+    }
+
+    done = true;
+    for (std::thread& t : threads)
+        t.join();
+
+    // the next flush reclaims all tables which were still in use before
+    cache.clear();
+    HPX_TEST_EQ(cache.num_retired_tables(), std::size_t(0));
+}
+
+int main()
+{
+    test_single_entries();
+    test_eviction();
+    test_range_entries();
+    test_concurrent_access();
+    test_repeated_resize();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,178 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Increfs may be satisfied from the pending decrefs of the OS-thread issuing
+// them. Concurrently interleaving increfs and decrefs for the same object
+// from many HPX-threads must leave its global credit count balanced: the
+// object has to stay alive as long as it is referenced and has to be
+// deleted once the last reference goes out of scope.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tests/unit/agas/components/simple_refcnt_checker.hpp>
+#include <tests/unit/agas/components/managed_refcnt_checker.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::init;
+using hpx::finalize;
+using hpx::find_here;
+
+using std::chrono::milliseconds;
+
+using hpx::naming::id_type;
+using hpx::naming::gid_type;
+using hpx::naming::get_management_type_name;
+
+using hpx::agas::garbage_collect;
+
+using hpx::test::simple_refcnt_monitor;
+using hpx::test::managed_refcnt_monitor;
+
+using hpx::util::report_errors;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 16;
+std::size_t const num_iterations = 100;
+
+// Each iteration increfs the object and decrefs it by the same amount. The
+// decrefs are accumulated locally, the increfs of subsequent iterations are
+// (partially) satisfied from those.
+void incref_decref(id_type const& id, std::size_t task)
+{
+    gid_type const gid = id.get_gid();
+
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        std::int64_t const credit = std::int64_t((task + i) % 7 + 1);
+
+        hpx::agas::incref(gid, credit, id).get();
+
+        if (i % 3 == 0)
+        {
+            // hand back the credits in several pieces
+            hpx::agas::decref(gid, 1);
+            if (credit > 1)
+                hpx::agas::decref(gid, credit - 1);
+        }
+        else
+        {
+            hpx::agas::decref(gid, credit);
+        }
+
+        if (i % 10 == 0)
+            hpx::this_thread::yield();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <
+    typename Client
+>
+void hpx_test_main(
+    variables_map& vm
+    )
+{
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+
+    {
+        Client monitor(find_here());
+
+        cout << "id: " << monitor.get_id() << " "
+             << get_management_type_name
+                    (monitor.get_id().get_management_type()) << "\n"
+             << flush;
+
+        {
+            // Detach the reference.
+            id_type id = monitor.detach().get();
+
+            std::vector<hpx::future<void> > tasks;
+            tasks.reserve(num_tasks);
+            for (std::size_t task = 0; task != num_tasks; ++task)
+            {
+                tasks.push_back(hpx::async(&incref_decref, id, task));
+            }
+            hpx::wait_all(tasks);
+
+            // Flush pending reference counting operations.
+            garbage_collect();
+            garbage_collect();
+
+            // All increfs were balanced by decrefs, the reference we hold
+            // keeps the component alive.
+            HPX_TEST_EQ(false, monitor.is_ready(milliseconds(delay)));
+        }
+
+        // Flush pending reference counting operations.
+        garbage_collect();
+        garbage_collect();
+
+        // The component should be out of scope now.
+        HPX_TEST_EQ(true, monitor.is_ready(milliseconds(delay)));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    {
+        cout << std::string(80, '#') << "\n"
+             << "simple component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<simple_refcnt_monitor>(vm);
+
+        cout << std::string(80, '#') << "\n"
+             << "managed component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<managed_refcnt_monitor>(vm);
+    }
+
+    finalize();
+    return report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "delay"
+        , value<std::uint64_t>()->default_value(500)
+        , "number of milliseconds to wait for object destruction")
+        ;
+
+    // We need to explicitly enable the test components used by this test.
+    std::vector<std::string> const cfg = {
+        "hpx.components.simple_refcnt_checker.enabled! = 1",
+        "hpx.components.managed_refcnt_checker.enabled! = 1"
+    };
+
+    // Initialize and run HPX.
+    return init(cmdline, argc, argv, cfg);
+}
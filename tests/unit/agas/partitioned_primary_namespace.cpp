@@ -0,0 +1,128 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The tables of the primary namespace are split into partitions, a range of
+// gids is stored in all partitions it has gids in. Concurrently binding,
+// resolving, reference counting and unbinding ranges spanning more than one
+// round of partitions from many HPX-threads must keep all tables consistent.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime/agas/server/primary_namespace.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using hpx::agas::gva;
+using hpx::agas::server::primary_namespace;
+
+using hpx::naming::gid_type;
+
+using hpx::util::get;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 16;
+std::size_t const num_iterations = 50;
+
+// the ranges are larger than the number of partitions (32 by default) and
+// don't cover all partitions the same number of times
+std::uint64_t const range_size = 37;
+std::uint64_t const range_stride = 1024;
+
+void bind_resolve_unbind(primary_namespace& pns, gid_type const& locality,
+    std::size_t task)
+{
+    gid_type const base(0x1, 0x10000 + task * range_stride);
+    gid_type const upper = base + range_size;
+
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        gva const g(locality, hpx::components::component_base_lco_with_value,
+            range_size, std::uint64_t(0x1000 * (i + 1)), 8);
+
+        HPX_TEST(pns.bind_gid(g, base, locality));
+
+        // every gid of the range resolves to the range
+        for (std::uint64_t k = 0; k != range_size; ++k)
+        {
+            primary_namespace::resolved_type r = pns.resolve_gid(base + k);
+            HPX_TEST_EQ(get<0>(r), base);
+            HPX_TEST_EQ(get<1>(r).count, range_size);
+            HPX_TEST_EQ(get<1>(r).lva(), g.lva());
+            HPX_TEST_EQ(get<2>(r), locality);
+        }
+
+        // gids just outside of the range are not bound by this task
+        HPX_TEST_EQ(get<0>(pns.resolve_gid(upper)), hpx::naming::invalid_gid);
+
+        // balanced increments and decrements of the whole range and of a
+        // part of it, none of the gids may be freed
+        std::int64_t const credits = std::int64_t(i % 7 + 1);
+        pns.increment_credit(credits, base, upper);
+        pns.increment_credit(credits, base + 1, upper - 1);
+
+        std::vector<
+            hpx::util::tuple<std::int64_t, gid_type, gid_type>
+        > requests;
+        requests.push_back(hpx::util::make_tuple(-credits, base, upper));
+        requests.push_back(
+            hpx::util::make_tuple(-credits, base + 1, upper - 1));
+
+        std::vector<std::int64_t> result = pns.decrement_credit(requests);
+        HPX_TEST_EQ(result.size(), requests.size());
+
+        hpx::naming::address addr = pns.unbind_gid(range_size, base);
+        HPX_TEST_EQ(addr.address_, g.lva());
+
+        for (std::uint64_t k = 0; k != range_size; ++k)
+        {
+            HPX_TEST_EQ(get<0>(pns.resolve_gid(base + k)),
+                hpx::naming::invalid_gid);
+        }
+
+        if (i % 10 == 0)
+            hpx::this_thread::yield();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    gid_type const locality = hpx::find_here().get_gid();
+
+    primary_namespace pns;
+    pns.set_local_locality(locality);
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t task = 0; task != num_tasks; ++task)
+    {
+        tasks.push_back(hpx::async(&bind_resolve_unbind, std::ref(pns),
+            locality, task));
+    }
+    hpx::wait_all(tasks);
+
+    for (hpx::future<void>& f : tasks)
+        f.get();
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
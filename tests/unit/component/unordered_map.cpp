@@ -4,11 +4,13 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/threads.hpp>
 #include <hpx/include/traits.hpp>
 #include <hpx/include/unordered_map.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <iostream>
@@ -149,6 +151,107 @@ void trivial_tests()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename DistPolicy>
+void batch_tests(DistPolicy const& policy, bool use_cache)
+{
+    hpx::unordered_map<Key, Value> m(policy);
+    if (use_cache)
+        m.enable_cache(16, std::chrono::seconds(60));
+
+    std::vector<Key> keys;
+    std::vector<Value> vals;
+    for (std::size_t i = 0; i != 107; ++i)
+    {
+        keys.push_back(std::to_string(i));
+        vals.push_back(Value(i));
+    }
+
+    m.insert_many(hpx::launch::sync, keys, vals);
+    HPX_TEST_EQ(m.size(), keys.size());
+
+    // look up the keys in reverse order, add some keys which don't exist
+    std::vector<Key> lookup(keys.rbegin(), keys.rend());
+    lookup.push_back("missing");
+    lookup.push_back("42");
+
+    for (int iteration = 0; iteration != 2; ++iteration)
+    {
+        std::vector<std::pair<bool, Value> > found =
+            m.find_many(hpx::launch::sync, lookup);
+        HPX_TEST_EQ(found.size(), lookup.size());
+
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            HPX_TEST(found[i].first);
+            HPX_TEST_EQ(found[i].second, Value(keys.size() - i - 1));
+        }
+        HPX_TEST(!found[keys.size()].first);
+        HPX_TEST(found[keys.size() + 1].first);
+        HPX_TEST_EQ(found[keys.size() + 1].second, Value(42));
+    }
+
+    // overwrite some of the values, the cache has to pick up the new ones
+    std::vector<Key> update_keys(keys.begin(), keys.begin() + 10);
+    std::vector<Value> update_vals(10, Value(-1));
+    m.insert_many(hpx::launch::sync, update_keys, update_vals);
+    HPX_TEST_EQ(m.size(), keys.size());
+
+    std::vector<std::pair<bool, Value> > found =
+        m.find_many(hpx::launch::sync, update_keys);
+    for (std::size_t i = 0; i != update_keys.size(); ++i)
+    {
+        HPX_TEST(found[i].first);
+        HPX_TEST_EQ(found[i].second, Value(-1));
+    }
+
+    // erase some of the keys, erasing keys twice has no effect
+    std::vector<Key> erase_keys(keys.begin(), keys.begin() + 20);
+    erase_keys.push_back("missing");
+    erase_keys.push_back("0");
+
+    HPX_TEST_EQ(m.erase_many(hpx::launch::sync, erase_keys), std::size_t(20));
+    HPX_TEST_EQ(m.size(), keys.size() - 20);
+
+    found = m.find_many(hpx::launch::sync, keys);
+    for (std::size_t i = 0; i != keys.size(); ++i)
+    {
+        HPX_TEST_EQ(found[i].first, i >= 20);
+    }
+
+    HPX_TEST(m.find_many(hpx::launch::sync, std::vector<Key>()).empty());
+    HPX_TEST_EQ(m.erase_many(hpx::launch::sync, std::vector<Key>()),
+        std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void cache_expiry_tests()
+{
+    hpx::unordered_map<Key, Value> m(hpx::container_layout(3));
+    m.enable_cache(16, std::chrono::milliseconds(10));
+
+    std::vector<Key> keys;
+    for (std::size_t i = 0; i != 10; ++i)
+        keys.push_back(std::to_string(i));
+
+    m.insert_many(hpx::launch::sync, keys, std::vector<Value>(10, Value(1)));
+
+    // expired values are fetched from the partitions again
+    for (int iteration = 0; iteration != 2; ++iteration)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        std::vector<std::pair<bool, Value> > found =
+            m.find_many(hpx::launch::sync, keys);
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            HPX_TEST(found[i].first);
+            HPX_TEST_EQ(found[i].second, Value(1));
+        }
+    }
+}
+
 int main()
 {
     trivial_tests<std::string, double>();
@@ -160,6 +263,13 @@ int main()
     trivial_tests<std::string, double>(hpx::container_layout(3, localities));
     trivial_tests<std::string, double>(hpx::container_layout(localities));
 
+    batch_tests<std::string, double>(hpx::container_layout(3), false);
+    batch_tests<std::string, double>(hpx::container_layout(localities), false);
+    batch_tests<std::string, double>(
+        hpx::container_layout(3, localities), true);
+
+    cache_expiry_tests<std::string, double>();
+
     return 0;
 }
 
@@ -0,0 +1,155 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Output written using hpx::async_endl is batched by the ostream. This
+// verifies that batched output is eventually written without any explicit
+// flush and that the order of the output of each thread is preserved.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/io_service_pool.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_lines = 1000;
+
+// Read the console output from the (single) thread of the io pool, which is
+// where the console stream is written to.
+std::string read_console_output()
+{
+    std::shared_ptr<hpx::lcos::local::promise<std::string> > p =
+        std::make_shared<hpx::lcos::local::promise<std::string> >();
+    hpx::future<std::string> f = p->get_future();
+
+    hpx::get_thread_pool("io_pool")->get_io_service().post(
+        [p]()
+        {
+            p->set_value(hpx::get_consolestream().str());
+        });
+
+    return f.get();
+}
+
+// Wait for the console output to reach the given size.
+std::string wait_for_console_output(std::size_t size)
+{
+    std::string output = read_console_output();
+    for (int i = 0; output.size() < size && i != 1000; ++i)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        output = read_console_output();
+    }
+    return output;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_delayed_flush()
+{
+    std::string const before = read_console_output();
+
+    // the output is smaller than the batch size and will be sent only once
+    // the batch delay has expired
+    std::string expected;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::string line = "line " + std::to_string(i);
+        expected += line + "\n";
+
+        hpx::consolestream << line << hpx::async_endl;
+    }
+
+    std::string output =
+        wait_for_console_output(before.size() + expected.size());
+    HPX_TEST_EQ(output, before + expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void write_lines(std::size_t thread)
+{
+    for (std::size_t i = 0; i != num_lines; ++i)
+    {
+        hpx::consolestream << thread << " " << i << hpx::async_endl;
+    }
+}
+
+void test_concurrent_small_chunks()
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::string const before = read_console_output();
+
+    std::size_t expected_size = 0;
+    for (std::size_t thread = 0; thread != num_threads; ++thread)
+    {
+        for (std::size_t i = 0; i != num_lines; ++i)
+        {
+            expected_size += std::to_string(thread).size() + 1 +
+                std::to_string(i).size() + 1;
+        }
+    }
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t thread = 0; thread != num_threads; ++thread)
+    {
+        threads.push_back(hpx::async(&write_lines, thread));
+    }
+    hpx::wait_all(threads);
+
+    std::string output = wait_for_console_output(before.size() + expected_size);
+    HPX_TEST_EQ(output.size(), before.size() + expected_size);
+    HPX_TEST_EQ(output.substr(0, before.size()), before);
+
+    // each thread's lines have to appear in the order they were written
+    std::vector<std::size_t> next_line(num_threads, 0);
+    std::istringstream strm(output.substr(before.size()));
+
+    std::size_t thread = 0, line = 0;
+    while (strm >> thread >> line)
+    {
+        HPX_TEST(thread < num_threads);
+        if (thread >= num_threads)
+            break;
+
+        HPX_TEST_EQ(line, next_line[thread]);
+        next_line[thread] = line + 1;
+    }
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        HPX_TEST_EQ(next_line[i], num_lines);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_delayed_flush();
+    test_concurrent_small_chunks();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // use a batch size which is exceeded by the concurrent output only, make
+    // sure the console stream is written by a single OS thread
+    std::vector<std::string> const cfg = {
+        "hpx.iostreams.batch_size=1024",
+        "hpx.iostreams.batch_delay=1000",
+        "hpx.threadpools.io_pool_size=1"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
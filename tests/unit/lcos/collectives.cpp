@@ -0,0 +1,136 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/collectives.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+HPX_REGISTER_COLLECTIVES(std::size_t, test_collectives);
+
+///////////////////////////////////////////////////////////////////////////////
+// Run all collective operations with a given number of sites, all of which
+// live on this locality.
+void test_local_sites(std::size_t num_sites, std::size_t generation)
+{
+    std::size_t const root = num_sites / 2;
+    std::size_t const sum = num_sites * (num_sites + 1) / 2;
+
+    std::vector<hpx::future<void> > sites;
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        sites.push_back(hpx::async([=]()
+        {
+            using namespace hpx::lcos::collectives;
+
+            std::size_t value = site + 1;
+
+            std::vector<std::size_t> gathered = gather("/test/gather/",
+                value, num_sites, generation, site, root).get();
+            if (site == root)
+            {
+                HPX_TEST_EQ(gathered.size(), num_sites);
+                for (std::size_t i = 0; i != gathered.size(); ++i)
+                    HPX_TEST_EQ(gathered[i], i + 1);
+            }
+            else
+            {
+                HPX_TEST(gathered.empty());
+            }
+
+            std::vector<std::size_t> all = all_gather("/test/all_gather/",
+                value, num_sites, generation, site).get();
+            HPX_TEST_EQ(all.size(), num_sites);
+            for (std::size_t i = 0; i != all.size(); ++i)
+                HPX_TEST_EQ(all[i], i + 1);
+
+            std::vector<std::size_t> values;
+            if (site == root)
+            {
+                for (std::size_t i = 0; i != num_sites; ++i)
+                    values.push_back(2 * i);
+            }
+            std::size_t scattered = scatter("/test/scatter/",
+                std::move(values), num_sites, generation, site, root).get();
+            HPX_TEST_EQ(scattered, 2 * site);
+
+            std::size_t reduced = reduce("/test/reduce/", value,
+                std::plus<std::size_t>(), num_sites, generation, site,
+                root).get();
+            if (site == root)
+                HPX_TEST_EQ(reduced, sum);
+
+            std::size_t all_reduced = all_reduce("/test/all_reduce/", value,
+                std::plus<std::size_t>(), num_sites, generation, site).get();
+            HPX_TEST_EQ(all_reduced, sum);
+
+            // the combined result has to respect the site order
+            std::size_t ordered = all_reduce("/test/all_reduce_ordered/",
+                value,
+                [](std::size_t lhs, std::size_t rhs)
+                {
+                    return lhs * 100 + rhs;
+                },
+                num_sites, generation, site).get();
+            std::size_t expected = 1;
+            for (std::size_t i = 2; i <= num_sites; ++i)
+                expected = expected * 100 + i;
+            HPX_TEST_EQ(ordered, expected);
+        }));
+    }
+    hpx::wait_all(sites);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Run the operations once per locality using the default site numbers.
+void test_localities(std::size_t generation)
+{
+    using namespace hpx::lcos::collectives;
+
+    std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t here = hpx::get_locality_id();
+
+    std::size_t all_reduced = all_reduce("/test/localities/all_reduce/",
+        here, std::plus<std::size_t>(), std::size_t(-1), generation).get();
+    HPX_TEST_EQ(all_reduced, num_localities * (num_localities - 1) / 2);
+
+    std::vector<std::size_t> all = all_gather("/test/localities/all_gather/",
+        here, std::size_t(-1), generation).get();
+    HPX_TEST_EQ(all.size(), num_localities);
+    for (std::size_t i = 0; i != all.size(); ++i)
+        HPX_TEST_EQ(all[i], i);
+}
+
+int hpx_main()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        std::size_t generation = 0;
+        for (std::size_t num_sites : { 1, 2, 3, 5, 8, 13 })
+            test_local_sites(num_sites, generation++);
+    }
+
+    for (std::size_t i = 0; i != 10; ++i)
+        test_localities(i);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,122 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Threads repeatedly giving up waiting for a future (by polling it using
+// wait_for) must not make the shared state accumulate their wait entries.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// count the number of currently live allocations
+boost::atomic<std::int64_t> live_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    ++live_allocations;
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        --live_allocations;
+        std::free(p);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_iterations = 10000;
+
+void poll(hpx::shared_future<void> f)
+{
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        HPX_TEST(f.wait_for(std::chrono::microseconds(1)) ==
+            hpx::lcos::future_status::timeout);
+    }
+}
+
+void test_polling_single_thread()
+{
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> f = p.get_future();
+
+    // warm up thread and timer bookkeeping
+    poll(f);
+
+    std::int64_t before = live_allocations.load();
+    poll(f);
+    std::int64_t after = live_allocations.load();
+
+    // each abandoned entry would leave one allocation behind
+    HPX_TEST_LTE(after - before, std::int64_t(num_iterations / 10));
+
+    p.set_value();
+    HPX_TEST(f.wait_for(std::chrono::microseconds(1)) ==
+        hpx::lcos::future_status::ready);
+}
+
+void test_polling_concurrently()
+{
+    std::size_t const num_threads = hpx::get_os_thread_count() * 2;
+
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> f = p.get_future();
+
+    // continuations registered in between the waiting threads have to
+    // survive the removal of abandoned entries
+    boost::atomic<std::size_t> continuations(0);
+    std::vector<hpx::future<void> > pollers;
+    std::vector<hpx::future<void> > results;
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        results.push_back(f.then(
+            [&continuations](hpx::shared_future<void> &&)
+            {
+                ++continuations;
+            }));
+        pollers.push_back(hpx::async(&poll, f));
+    }
+
+    hpx::wait_all(pollers);
+    HPX_TEST_EQ(continuations.load(), std::size_t(0));
+
+    p.set_value();
+    hpx::wait_all(results);
+    HPX_TEST_EQ(continuations.load(), num_threads);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_polling_single_thread();
+    test_polling_concurrently();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -12,6 +12,7 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -378,6 +379,63 @@ void test_copies_of_shared_future_become_ready_together()
     HPX_TEST_EQ(i, 42);
 }
 
+void test_continuations_run_in_order_of_attachment()
+{
+    hpx::lcos::local::promise<int> pi;
+    hpx::lcos::shared_future<int> sf = pi.get_future();
+
+    std::vector<int> order;
+    std::vector<hpx::lcos::future<void> > continuations;
+    for (int i = 0; i != 10; ++i)
+    {
+        continuations.push_back(sf.then(hpx::launch::sync,
+            [&order, i](hpx::lcos::shared_future<int> f)
+            {
+                HPX_TEST_EQ(f.get(), 42);
+                order.push_back(i);
+            }));
+    }
+
+    HPX_TEST(order.empty());
+    pi.set_value(42);
+
+    hpx::wait_all(continuations);
+    HPX_TEST_EQ(order.size(), std::size_t(10));
+    for (int i = 0; i != 10; ++i)
+        HPX_TEST_EQ(order[i], i);
+}
+
+void test_concurrent_waiters_and_continuations()
+{
+    std::size_t const num_tasks = 16;
+
+    for (int iteration = 0; iteration != 100; ++iteration)
+    {
+        hpx::lcos::local::promise<int> pi;
+        hpx::lcos::shared_future<int> sf = pi.get_future();
+
+        std::vector<hpx::lcos::future<int> > results;
+        for (std::size_t t = 0; t != num_tasks; ++t)
+        {
+            if (t % 2)
+            {
+                results.push_back(hpx::async(
+                    [sf]() { return sf.get(); }));
+            }
+            else
+            {
+                results.push_back(sf.then(
+                    [](hpx::lcos::shared_future<int> f) { return f.get(); }));
+            }
+        }
+
+        hpx::apply([&pi]() { pi.set_value(42); });
+
+        for (auto& f : results)
+            HPX_TEST_EQ(f.get(), 42);
+    }
+}
+
 void test_shared_future_can_be_move_assigned_from_shared_future()
 {
     hpx::lcos::local::packaged_task<int()> pt(make_int);
@@ -1560,6 +1618,8 @@ int hpx_main(variables_map&)
         test_task_returning_reference();
         test_shared_future();
         test_copies_of_shared_future_become_ready_together();
+        test_continuations_run_in_order_of_attachment();
+        test_concurrent_waiters_and_continuations();
         test_shared_future_can_be_move_assigned_from_shared_future();
         test_shared_future_void();
         test_shared_future_ref();
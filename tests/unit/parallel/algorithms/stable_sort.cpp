@@ -0,0 +1,248 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_STABLE_SORT_TEST_SIZE   50000
+#else
+#define HPX_STABLE_SORT_TEST_SIZE   1000000
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Values with a small number of distinct keys, the index is used to verify
+// that the relative order of equal keys is preserved.
+struct element
+{
+    int key;
+    std::size_t index;
+};
+
+struct compare_key
+{
+    bool operator()(element const& lhs, element const& rhs) const
+    {
+        return lhs.key < rhs.key;
+    }
+};
+
+std::vector<element> make_elements(std::size_t size, int num_keys)
+{
+    std::vector<element> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        c[i].key = std::rand() % num_keys;
+        c[i].index = i;
+    }
+    return c;
+}
+
+bool is_stably_sorted(std::vector<element> const& c)
+{
+    for (std::size_t i = 1; i < c.size(); ++i)
+    {
+        if (c[i].key < c[i - 1].key)
+            return false;
+        if (c[i].key == c[i - 1].key && c[i].index < c[i - 1].index)
+            return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_stable_sort_stability(ExPolicy && policy, int num_keys)
+{
+    std::vector<element> c =
+        make_elements(HPX_STABLE_SORT_TEST_SIZE, num_keys);
+
+    hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), compare_key());
+
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_stability_async(ExPolicy && policy, int num_keys)
+{
+    std::vector<element> c =
+        make_elements(HPX_STABLE_SORT_TEST_SIZE, num_keys);
+
+    auto f = hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), compare_key());
+    HPX_TEST(f.get() == c.end());
+
+    HPX_TEST(is_stably_sorted(c));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Compare the result against std::stable_sort, this verifies the handling
+// of negative numbers by the radix sort as well
+template <typename T>
+std::vector<T> make_values(std::size_t size)
+{
+    std::vector<T> c(size);
+    for (auto& v : c)
+    {
+        v = static_cast<T>(std::rand() % 20001 - 10000);
+        if (std::is_floating_point<T>::value)
+            v /= T(7);
+    }
+    return c;
+}
+
+template <typename ExPolicy, typename T>
+void test_stable_sort(ExPolicy && policy, T)
+{
+    std::vector<T> c = make_values<T>(HPX_STABLE_SORT_TEST_SIZE);
+    std::vector<T> d = c;
+
+    hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end());
+    std::stable_sort(d.begin(), d.end());
+
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy, typename T, typename Compare>
+void test_stable_sort_comp(ExPolicy && policy, T, Compare comp)
+{
+    std::vector<T> c = make_values<T>(HPX_STABLE_SORT_TEST_SIZE);
+    std::vector<T> d = c;
+
+    hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), comp);
+    std::stable_sort(d.begin(), d.end(), comp);
+
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy, typename T>
+void test_stable_sort_async(ExPolicy && policy, T)
+{
+    std::vector<T> c = make_values<T>(HPX_STABLE_SORT_TEST_SIZE);
+    std::vector<T> d = c;
+
+    auto f = hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end());
+    HPX_TEST(f.get() == c.end());
+    std::stable_sort(d.begin(), d.end());
+
+    HPX_TEST(c == d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Sort inputs with many duplicates, this exercises the equality buckets of
+// the sample sort used by hpx::parallel::sort
+template <typename ExPolicy>
+void test_sort_duplicates(ExPolicy && policy, int num_keys)
+{
+    std::vector<std::string> c(HPX_STABLE_SORT_TEST_SIZE / 4);
+    for (auto& s : c)
+        s = std::to_string(std::rand() % num_keys);
+    std::vector<std::string> d = c;
+
+    hpx::parallel::sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), std::greater<std::string>());
+    std::sort(d.begin(), d.end(), std::greater<std::string>());
+
+    HPX_TEST(c == d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_stable_sort()
+{
+    using namespace hpx::parallel;
+
+    // merge sort
+    test_stable_sort_stability(execution::seq, 100);
+    test_stable_sort_stability(execution::par, 100);
+    test_stable_sort_stability(execution::par_unseq, 100);
+    test_stable_sort_stability(execution::par, 1);
+    test_stable_sort_stability(execution::par, 1000000);
+
+    test_stable_sort_stability_async(execution::seq(execution::task), 100);
+    test_stable_sort_stability_async(execution::par(execution::task), 100);
+
+    test_stable_sort_comp(execution::par, int(), std::greater<int>());
+    test_stable_sort_comp(execution::par, double(), std::greater<double>());
+
+    // radix sort
+    test_stable_sort(execution::seq, int());
+    test_stable_sort(execution::par, int());
+    test_stable_sort(execution::par_unseq, int());
+    test_stable_sort(execution::par, char());
+    test_stable_sort(execution::par, unsigned());
+    test_stable_sort(execution::par, std::int64_t());
+    test_stable_sort(execution::par, float());
+    test_stable_sort(execution::par, double());
+
+    test_stable_sort_async(execution::seq(execution::task), int());
+    test_stable_sort_async(execution::par(execution::task), int());
+    test_stable_sort_async(execution::par(execution::task), double());
+
+    test_stable_sort_comp(execution::par, int(), std::less<int>());
+    test_stable_sort_comp(execution::par, double(), std::less<double>());
+
+    // sample sort
+    test_sort_duplicates(execution::par, 1);
+    test_sort_duplicates(execution::par, 3);
+    test_sort_duplicates(execution::par, 1000);
+    test_sort_duplicates(execution::par(execution::task), 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    test_stable_sort();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,181 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_all_any_none_of.hpp>
+#include <hpx/include/parallel_equal.hpp>
+#include <hpx/include/parallel_find.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+template <typename T>
+struct cmp
+{
+    cmp(T const& val = T()) : value_(val) {}
+
+    template <typename T_>
+    bool operator()(T_ const& val) const
+    {
+        return val == value_;
+    }
+
+    T value_;
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned version)
+    {
+        ar & value_;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void initialize(hpx::partitioned_vector<T>& v)
+{
+    for (std::size_t i = 0; i != v.size(); ++i)
+        v.set_value(hpx::launch::sync, i, T(i));
+}
+
+template <typename ExPolicy, typename T>
+void test_find(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    typedef typename hpx::partitioned_vector<T>::iterator iterator;
+
+    std::size_t size = v.size();
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        iterator it = hpx::parallel::find(policy, v.begin(), v.end(), T(i));
+        HPX_TEST(it == v.begin() + i);
+
+        it = hpx::parallel::find_if(policy, v.begin(), v.end(), cmp<T>(T(i)));
+        HPX_TEST(it == v.begin() + i);
+    }
+
+    HPX_TEST(hpx::parallel::find(policy, v.begin(), v.end(), T(size)) ==
+        v.end());
+    HPX_TEST(hpx::parallel::find_if_not(policy, v.begin(), v.end(),
+        cmp<T>(T(0))) == v.begin() + 1);
+
+    // search a range which starts and ends in the middle of a partition
+    HPX_TEST(hpx::parallel::find(policy, v.begin() + 1, v.end() - 1, T(0)) ==
+        v.end() - 1);
+}
+
+template <typename ExPolicy, typename T>
+void test_find_async(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    typedef typename hpx::partitioned_vector<T>::iterator iterator;
+
+    std::size_t size = v.size();
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        iterator it =
+            hpx::parallel::find(policy, v.begin(), v.end(), T(i)).get();
+        HPX_TEST(it == v.begin() + i);
+    }
+
+    HPX_TEST(hpx::parallel::find(policy, v.begin(), v.end(), T(size)).get() ==
+        v.end());
+}
+
+template <typename ExPolicy, typename T>
+void test_all_any_none(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    std::size_t size = v.size();
+
+    HPX_TEST(hpx::parallel::any_of(policy, v.begin(), v.end(),
+        cmp<T>(T(size - 1))));
+    HPX_TEST(!hpx::parallel::any_of(policy, v.begin(), v.end(),
+        cmp<T>(T(size))));
+
+    HPX_TEST(hpx::parallel::none_of(policy, v.begin(), v.end(),
+        cmp<T>(T(size))));
+    HPX_TEST(!hpx::parallel::none_of(policy, v.begin(), v.end(),
+        cmp<T>(T(0))));
+
+    HPX_TEST(!hpx::parallel::all_of(policy, v.begin(), v.end(),
+        cmp<T>(T(0))));
+    HPX_TEST(hpx::parallel::all_of(policy, v.begin(), v.begin() + 1,
+        cmp<T>(T(0))));
+}
+
+template <typename ExPolicy, typename T>
+void test_equal(ExPolicy && policy, hpx::partitioned_vector<T>& v1,
+    hpx::partitioned_vector<T>& v2)
+{
+    HPX_TEST(hpx::parallel::equal(policy, v1.begin(), v1.end(), v2.begin()));
+    HPX_TEST(hpx::parallel::equal(policy, v1.begin(), v1.end(),
+        v2.begin(), v2.end()));
+    HPX_TEST(!hpx::parallel::equal(policy, v1.begin(), v1.end(),
+        v2.begin(), v2.end() - 1));
+
+    // segments are not aligned
+    HPX_TEST(!hpx::parallel::equal(policy, v1.begin() + 1, v1.end(),
+        v2.begin()));
+
+    v2.set_value(hpx::launch::sync, v2.size() - 1, T(0));
+    HPX_TEST(!hpx::parallel::equal(policy, v1.begin(), v1.end(), v2.begin()));
+    v2.set_value(hpx::launch::sync, v2.size() - 1, T(v2.size() - 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void find_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const length = 12;
+
+    {
+        hpx::partitioned_vector<T> v;
+        HPX_TEST(hpx::parallel::find(hpx::parallel::execution::seq,
+            v.begin(), v.end(), T(0)) == v.end());
+        HPX_TEST(hpx::parallel::find(hpx::parallel::execution::par,
+            v.begin(), v.end(), T(0)) == v.end());
+        HPX_TEST(hpx::parallel::all_of(hpx::parallel::execution::par,
+            v.begin(), v.end(), cmp<T>(T(0))));
+        HPX_TEST(!hpx::parallel::any_of(hpx::parallel::execution::par,
+            v.begin(), v.end(), cmp<T>(T(0))));
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0),
+            hpx::container_layout(localities));
+        initialize(v);
+
+        test_find(hpx::parallel::execution::seq, v);
+        test_find(hpx::parallel::execution::par, v);
+        test_find_async(
+            hpx::parallel::execution::seq(hpx::parallel::execution::task), v);
+        test_find_async(
+            hpx::parallel::execution::par(hpx::parallel::execution::task), v);
+
+        test_all_any_none(hpx::parallel::execution::seq, v);
+        test_all_any_none(hpx::parallel::execution::par, v);
+
+        hpx::partitioned_vector<T> v2(length, T(0),
+            hpx::container_layout(localities));
+        initialize(v2);
+
+        test_equal(hpx::parallel::execution::seq, v, v2);
+        test_equal(hpx::parallel::execution::par, v, v2);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    find_tests<int>(localities);
+    find_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -9,6 +9,7 @@
 
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <vector>
@@ -103,8 +104,54 @@ void handle_values_tests_distributed_access(hpx::partitioned_vector<T>& v)
     compare_vectors(values2, result2);
 }
 
-///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void handle_values_tests_unordered_access(hpx::partitioned_vector<T>& v)
+{
+    fill_vector(v, T(42));
+
+    // positions in descending order, interleaving all partitions
+    std::size_t const size = v.size();
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i != size; i += 2)
+        positions.push_back(size - 1 - i);
+    for (std::size_t i = 1; i < size; i += 2)
+        positions.push_back(size - 1 - i);
 
+    std::vector<T> values(positions.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        values[i] = T(positions[i]);
+
+    v.set_values(hpx::launch::sync, positions, values);
+    std::vector<T> result = v.get_values(hpx::launch::sync, positions);
+    compare_vectors(values, result);
+
+    // duplicate positions accumulate all their values
+    std::vector<std::size_t> reduce_positions(positions);
+    reduce_positions.insert(reduce_positions.end(),
+        positions.begin(), positions.end());
+    std::vector<T> ones(reduce_positions.size(), T(1));
+
+    v.reduce_values(hpx::launch::sync, reduce_positions, ones,
+        hpx::partitioned_vector_reduction::plus);
+    result = v.get_values(hpx::launch::sync, positions);
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        HPX_TEST_EQ(result[i], T(positions[i] + 2));
+
+    std::vector<T> limits(positions.size(), T(5));
+    v.reduce_values(hpx::launch::sync, positions, limits,
+        hpx::partitioned_vector_reduction::min);
+    v.reduce_values(hpx::launch::sync, positions, std::vector<T>(
+            positions.size(), T(3)),
+        hpx::partitioned_vector_reduction::max);
+    result = v.get_values(hpx::launch::sync, positions);
+    for (std::size_t i = 0; i != positions.size(); ++i)
+    {
+        HPX_TEST_EQ(result[i], T((std::max)((std::min)(
+            positions[i] + 2, std::size_t(5)), std::size_t(3))));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
 template <typename T, typename DistPolicy>
 void handle_values_tests_with_policy(std::size_t size, std::size_t localities,
     DistPolicy const& policy)
@@ -118,6 +165,11 @@ void handle_values_tests_with_policy(std::size_t size, std::size_t localities,
         hpx::partitioned_vector<T> v(size, policy);
         handle_values_tests_distributed_access(v);
     }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        handle_values_tests_unordered_access(v);
+    }
 }
 
 template <typename T>
@@ -138,6 +190,10 @@ void handle_values_tests()
         hpx::partitioned_vector<T> v(length, T(42));
         handle_values_tests(v);
     }
+    {
+        hpx::partitioned_vector<T> v(length);
+        handle_values_tests_unordered_access(v);
+    }
 
     handle_values_tests_with_policy<T>(length, 1, hpx::container_layout);
     handle_values_tests_with_policy<T>(length, 3, hpx::container_layout(3));
@@ -0,0 +1,139 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_sort.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct greater
+{
+    template <typename T>
+    bool operator()(T const& lhs, T const& rhs) const
+    {
+        return lhs > rhs;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Fill the vector with values in [0, range), small ranges produce many
+// duplicates which exercise the handling of ties between the segments.
+template <typename T>
+std::vector<T> initialize(hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> expected(v.size());
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        expected[i] = T(std::rand() % range);
+        v.set_value(hpx::launch::sync, i, expected[i]);
+    }
+    return expected;
+}
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    HPX_TEST_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i != expected.size(); ++i)
+    {
+        HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), expected[i]);
+    }
+}
+
+template <typename ExPolicy, typename T>
+void test_sort(ExPolicy && policy, hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> expected = initialize(v, range);
+    std::sort(expected.begin(), expected.end());
+
+    hpx::parallel::sort(policy, v.begin(), v.end());
+    verify_values(v, expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<T>());
+
+    hpx::parallel::sort(policy, v.begin(), v.end(), greater());
+    verify_values(v, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = initialize(v, range);
+    std::sort(expected.begin(), expected.end());
+
+    HPX_TEST(hpx::parallel::sort(policy, v.begin(), v.end()).get() ==
+        v.end());
+    verify_values(v, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_subrange(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    // sort a range which starts and ends in the middle of a partition
+    std::vector<T> expected = initialize(v, range);
+    std::sort(expected.begin() + 1, expected.end() - 1);
+
+    hpx::parallel::sort(policy, v.begin() + 1, v.end() - 1);
+    verify_values(v, expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void sort_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const length = 1000;
+
+    {
+        hpx::partitioned_vector<T> v;
+        hpx::parallel::sort(hpx::parallel::execution::seq, v.begin(), v.end());
+        hpx::parallel::sort(hpx::parallel::execution::par, v.begin(), v.end());
+        hpx::parallel::sort(
+            hpx::parallel::execution::par(hpx::parallel::execution::task),
+            v.begin(), v.end()).get();
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0),
+            hpx::container_layout(2 * localities.size(), localities));
+
+        for (int range : { 1, 3, 10000 })
+        {
+            test_sort(hpx::parallel::execution::seq, v, range);
+            test_sort(hpx::parallel::execution::par, v, range);
+            test_sort_async(
+                hpx::parallel::execution::seq(hpx::parallel::execution::task),
+                v, range);
+            test_sort_async(
+                hpx::parallel::execution::par(hpx::parallel::execution::task),
+                v, range);
+            test_sort_subrange(hpx::parallel::execution::par, v, range);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    sort_tests<int>(localities);
+    sort_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,178 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Drive parcels from many concurrently running HPX-threads through the
+// (striped) coalescing message handler and verify the counters it exposes.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/parcel_coalescing.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 16;
+std::size_t const num_parcels_per_task = 500;
+
+std::int64_t const min_boundary = 0;
+std::int64_t const max_boundary = 100;
+std::int64_t const num_buckets = 20;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t coalesced(std::size_t i)
+{
+    return i;
+}
+HPX_DECLARE_PLAIN_ACTION(coalesced, coalesced_action);
+HPX_ACTION_USES_MESSAGE_COALESCING(coalesced_action);
+HPX_PLAIN_ACTION(coalesced, coalesced_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void send_parcels(hpx::id_type const& id, std::size_t task)
+{
+    std::vector<hpx::future<std::size_t> > results;
+    results.reserve(num_parcels_per_task);
+
+    for (std::size_t i = 0; i != num_parcels_per_task; ++i)
+    {
+        results.push_back(hpx::async<coalesced_action>(id,
+            task * num_parcels_per_task + i));
+    }
+
+    for (std::size_t i = 0; i != num_parcels_per_task; ++i)
+    {
+        HPX_TEST_EQ(results[i].get(), task * num_parcels_per_task + i);
+    }
+}
+
+void test_concurrent_parcels(hpx::id_type const& id)
+{
+    // send the parcels from as many OS threads as possible, this makes
+    // the handler use all of its buffer stripes
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+
+    for (std::size_t task = 0; task != num_tasks; ++task)
+    {
+        tasks.push_back(hpx::async(&send_parcels, id, task));
+    }
+    hpx::wait_all(tasks);
+
+    for (hpx::future<void>& f : tasks)
+        f.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t query_counter(std::string const& name)
+{
+    hpx::performance_counters::performance_counter c(name);
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+void test_counters()
+{
+    std::string const instance("/coalescing{locality#0/total}/count/");
+
+    // every parcel has to be accounted for exactly once, no matter which
+    // stripe it was buffered in
+    std::int64_t const num_parcels = num_tasks * num_parcels_per_task;
+    std::int64_t const parcels =
+        query_counter(instance + "parcels@coalesced_action");
+    HPX_TEST_EQ(parcels, num_parcels);
+
+    std::int64_t const messages =
+        query_counter(instance + "messages@coalesced_action");
+    HPX_TEST_LTE(std::int64_t(1), messages);
+    HPX_TEST_LTE(messages, parcels);
+
+    // the histogram reports the histogram parameters followed by the
+    // per-mille of messages which fall into each of the buckets
+    hpx::performance_counters::performance_counter histogram(
+        instance + "parcels-per-message-histogram@coalesced_action," +
+        std::to_string(min_boundary) + "," + std::to_string(max_boundary) +
+        "," + std::to_string(num_buckets));
+
+    std::vector<std::int64_t> values =
+        histogram.get_counter_values_array(hpx::launch::sync, false).values_;
+
+    HPX_TEST_EQ(values.size(), std::size_t(3 + num_buckets));
+    if (values.size() != std::size_t(3 + num_buckets))
+        return;
+
+    HPX_TEST_EQ(values[0], min_boundary);
+    HPX_TEST_EQ(values[1], max_boundary);
+    HPX_TEST_EQ(values[2], num_buckets);
+
+    // each bucket is rounded down
+    std::int64_t sum = 0;
+    for (std::size_t i = 3; i != values.size(); ++i)
+    {
+        HPX_TEST_LTE(std::int64_t(0), values[i]);
+        sum += values[i];
+    }
+    HPX_TEST_LTE(std::int64_t(1000) - num_buckets, sum);
+    HPX_TEST_LTE(sum, std::int64_t(1000));
+
+    // all messages together have carried all parcels, the lower boundaries
+    // of the buckets give a lower bound for the average message size
+    std::int64_t const bucket_size =
+        (max_boundary - min_boundary) / num_buckets;
+    std::int64_t weighted_min = 0;
+    for (std::int64_t i = 0; i != num_buckets; ++i)
+    {
+        weighted_min += values[std::size_t(3 + i)] *
+            (min_boundary + i * bucket_size);
+    }
+    HPX_TEST_LTE(weighted_min, (parcels * 1000) / messages);
+
+    // resetting the histogram starts over
+    histogram.get_counter_values_array(hpx::launch::sync, true);
+    values =
+        histogram.get_counter_values_array(hpx::launch::sync, false).values_;
+    for (std::size_t i = 3; i != values.size(); ++i)
+    {
+        HPX_TEST_EQ(values[i], std::int64_t(0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    if (!localities.empty())
+    {
+        test_concurrent_parcels(localities[0]);
+        test_counters();
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // explicitly enable message handlers (parcel coalescing)
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.message_handlers=1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,139 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Send many small direct actions to a remote locality. The receiving side
+// executes those in batches without creating a thread for each of them. An
+// action which suspends or throws in the middle of a batch must not prevent
+// the remaining actions of that batch from being executed.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 8;
+std::size_t const num_parcels_per_task = 1000;
+
+// every suspend_every'th action suspends, every throw_every'th action throws
+std::size_t const suspend_every = 97;
+std::size_t const throw_every = 101;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t small_direct(std::size_t i)
+{
+    if (i % throw_every == throw_every - 1)
+        throw std::runtime_error("small_direct");
+
+    if (i % suspend_every == suspend_every - 1)
+        hpx::this_thread::suspend(std::chrono::microseconds(100));
+
+    return i;
+}
+HPX_PLAIN_DIRECT_ACTION(small_direct, small_direct_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void send_parcels(hpx::id_type const& id, std::size_t task)
+{
+    std::vector<hpx::future<std::size_t> > results;
+    results.reserve(num_parcels_per_task);
+
+    for (std::size_t i = 0; i != num_parcels_per_task; ++i)
+    {
+        results.push_back(hpx::async<small_direct_action>(id,
+            task * num_parcels_per_task + i));
+    }
+
+    // all actions complete, the throwing ones report their error back
+    hpx::wait_all(results);
+    for (std::size_t i = 0; i != num_parcels_per_task; ++i)
+    {
+        std::size_t const value = task * num_parcels_per_task + i;
+        if (value % throw_every == throw_every - 1)
+        {
+            HPX_TEST(results[i].has_exception());
+        }
+        else
+        {
+            HPX_TEST_EQ(results[i].get(), value);
+        }
+    }
+}
+
+void test_direct_actions(hpx::id_type const& id)
+{
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+
+    for (std::size_t task = 0; task != num_tasks; ++task)
+    {
+        tasks.push_back(hpx::async(&send_parcels, id, task));
+    }
+    hpx::wait_all(tasks);
+
+    for (hpx::future<void>& f : tasks)
+        f.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t query_counter(std::string const& name)
+{
+    hpx::performance_counters::performance_counter c(name);
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+void test_counters(std::uint32_t locality_id)
+{
+    std::string const instance("/parcels{locality#" +
+        std::to_string(locality_id) + "/total}/count/tcp/");
+
+    // each received action is counted exactly once, either as being
+    // executed inline or on a new thread (this includes other actions
+    // received in the meantime, e.g. AGAS requests)
+    std::int64_t const num_parcels = num_tasks * num_parcels_per_task;
+    std::int64_t const inlined = query_counter(instance + "inlined");
+    std::int64_t const spawned = query_counter(instance + "spawned");
+
+    HPX_TEST_LTE(std::int64_t(1), inlined);
+    HPX_TEST_LTE(std::int64_t(0), spawned);
+    HPX_TEST_LTE(num_parcels, inlined + spawned);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    if (!localities.empty())
+    {
+        test_direct_actions(localities[0]);
+        test_counters(hpx::naming::get_locality_id_from_id(localities[0]));
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -9,10 +9,13 @@
 
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 
 #include <boost/cstdint.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <vector>
 
 template <typename T>
@@ -99,11 +102,11 @@ void test_bool()
 }
 
 template <typename T>
-void test(T min, T max)
+void test(T min, T max, std::uint32_t flags)
 {
     {
         std::vector<char> buffer;
-        hpx::serialization::output_archive oarchive(buffer);
+        hpx::serialization::output_archive oarchive(buffer, flags);
         for(T c = min; c < max; ++c)
         {
             oarchive << c;
@@ -117,7 +120,7 @@ void test(T min, T max)
     }
     {
         std::vector<char> buffer;
-        hpx::serialization::output_archive oarchive(buffer);
+        hpx::serialization::output_archive oarchive(buffer, flags);
         for(T c = min; c < max; ++c)
         {
             A<T> cc = c;
@@ -132,6 +135,50 @@ void test(T min, T max)
     }
 }
 
+template <typename T>
+void test(T min, T max)
+{
+    test(min, max, 0U);
+    test(min, max, hpx::serialization::enable_integer_compression);
+    test(min, max, hpx::serialization::enable_integer_compression |
+        hpx::serialization::endian_big);
+}
+
+void test_integer_compression()
+{
+    std::size_t sizes[2] = { 0, 0 };
+    std::uint32_t const flags[2] =
+    {
+        hpx::serialization::no_archive_flags,
+        hpx::serialization::enable_integer_compression
+    };
+
+    for (int i = 0; i != 2; ++i)
+    {
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer, flags[i]);
+
+        std::vector<int> v = { 0, 1, -1, 63, -64, 64, 1000, -1000 };
+        std::uint64_t big = (std::numeric_limits<std::uint64_t>::max)();
+        std::int64_t small = (std::numeric_limits<std::int64_t>::min)();
+        oarchive << v << big << small;
+        sizes[i] = oarchive.bytes_written();
+
+        hpx::serialization::input_archive iarchive(buffer);
+        std::vector<int> vv;
+        std::uint64_t big_in = 0;
+        std::int64_t small_in = 0;
+        iarchive >> vv >> big_in >> small_in;
+
+        HPX_TEST(v == vv);
+        HPX_TEST_EQ(big, big_in);
+        HPX_TEST_EQ(small, small_in);
+    }
+
+    // small values and container sizes take a single byte each
+    HPX_TEST_LT(sizes[1], sizes[0]);
+}
+
 template <typename T>
 void test_fp(T min, T max)
 {
@@ -169,6 +216,7 @@ void test_fp(T min, T max)
 int main()
 {
     test_bool();
+    test_integer_compression();
     test<char>((std::numeric_limits<char>::min)(),
         (std::numeric_limits<char>::max)());
     test<int>((std::numeric_limits<int>::min)(),
@@ -0,0 +1,103 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/serialization/serialize.hpp>
+
+#include <hpx/runtime/serialization/detail/polymorphic_type_hash.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using hpx::serialization::detail::polymorphic_type_hash;
+using hpx::serialization::detail::polymorphic_type_map;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_hash()
+{
+    // the hash of a literal is available at compile time
+    HPX_CONSTEXPR std::uint64_t hash = polymorphic_type_hash("A");
+    HPX_TEST_NEQ(hash, std::uint64_t(0));
+
+    HPX_TEST_EQ(hash, polymorphic_type_hash(std::string("A")));
+    HPX_TEST_NEQ(hash, polymorphic_type_hash("B"));
+
+    // FNV-1a reference value
+    HPX_TEST_EQ(polymorphic_type_hash("a"), std::uint64_t(0xaf63dc4c8601ec8cull));
+}
+
+void test_map()
+{
+    polymorphic_type_map<int> map;
+
+    for (int i = 0; i != 1000; ++i)
+    {
+        std::string name = "type" + std::to_string(i);
+        HPX_TEST(map.insert(polymorphic_type_hash(name), name, i));
+    }
+    HPX_TEST_EQ(map.size(), std::size_t(1000));
+
+    // registering the same name again is not an error
+    HPX_TEST(!map.insert(polymorphic_type_hash("type42"), "type42", 0));
+    HPX_TEST_EQ(map.size(), std::size_t(1000));
+
+    for (int i = 0; i != 1000; ++i)
+    {
+        int const* value = map.find(polymorphic_type_hash(
+            "type" + std::to_string(i)));
+        HPX_TEST(value != nullptr);
+        if (value != nullptr)
+            HPX_TEST_EQ(*value, i);
+    }
+    HPX_TEST(map.find(polymorphic_type_hash("unknown")) == nullptr);
+
+    // a different name with the same hash is detected
+    bool caught_collision = false;
+    try {
+        map.insert(polymorphic_type_hash("type42"), "other", 0);
+    }
+    catch (...) {
+        caught_collision = true;
+    }
+    HPX_TEST(caught_collision);
+}
+
+void test_archive()
+{
+    std::uint32_t const flags[] =
+    {
+        hpx::serialization::no_archive_flags,
+        hpx::serialization::endian_big,
+        hpx::serialization::enable_integer_compression
+    };
+
+    for (std::uint32_t f : flags)
+    {
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer, f);
+
+        std::uint64_t hash = polymorphic_type_hash("A");
+        std::size_t pos = oarchive.bytes_written();
+        hpx::serialization::detail::save_polymorphic_type_hash(oarchive, hash);
+        HPX_TEST_EQ(oarchive.bytes_written() - pos, sizeof(std::uint64_t));
+
+        hpx::serialization::input_archive iarchive(buffer);
+        HPX_TEST_EQ(
+            hpx::serialization::detail::load_polymorphic_type_hash(iarchive),
+            hash);
+    }
+}
+
+int main()
+{
+    test_hash();
+    test_map();
+    test_archive();
+
+    return hpx::util::report_errors();
+}
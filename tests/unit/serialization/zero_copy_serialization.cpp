@@ -11,11 +11,15 @@
 #include <hpx/runtime/serialization/array.hpp>
 #include <hpx/runtime/serialization/serialize_buffer.hpp>
 #include <hpx/runtime/serialization/detail/preprocess.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
+#include <hpx/util/buffer_pool.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -347,6 +351,203 @@ void test_zero_copy_serialization(double d, T1& arg1, std::string const& s,
     test_parcel_serialization(std::move(outp), out_archive_flags, true);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Simulate a parcelport which receives the zero-copy chunks into separate
+// buffers and allows for those to be adopted by the de-serialized objects
+struct received_chunks : hpx::serialization::adoptable_chunks
+{
+    std::shared_ptr<void> adopt(std::size_t chunk)
+    {
+        std::shared_ptr<void> result = std::move(buffers_[chunk]);
+        buffers_[chunk].reset();
+        return result;
+    }
+
+    std::vector<std::shared_ptr<std::vector<char> > > buffers_;
+};
+
+void test_adopted_chunks(std::size_t size)
+{
+    typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+    std::vector<double> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = double(i);
+
+    buffer_type outb(data.data(), data.size(), buffer_type::reference);
+
+    // compose archive flags
+    unsigned out_archive_flags = 0U;
+#ifdef BOOST_BIG_ENDIAN
+    out_archive_flags |= hpx::serialization::endian_big;
+#else
+    out_archive_flags |= hpx::serialization::endian_little;
+#endif
+
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    std::vector<char> out_buffer;
+    std::size_t arg_size = 0;
+    {
+        hpx::serialization::output_archive archive(
+            out_buffer, out_archive_flags, &chunks);
+        archive << outb;
+        arg_size = archive.bytes_written();
+    }
+
+    // 'receive' all pointer chunks into separate buffers
+    received_chunks received;
+    received.buffers_.resize(chunks.size());
+
+    char const* received_data = nullptr;
+    for (std::size_t i = 0; i != chunks.size(); ++i)
+    {
+        hpx::serialization::serialization_chunk& c = chunks[i];
+        if (c.type_ != hpx::serialization::chunk_type_pointer)
+            continue;
+
+        char const* p = static_cast<char const*>(c.data_.cpos_);
+        received.buffers_[i] =
+            std::make_shared<std::vector<char> >(p, p + c.size_);
+
+        c.data_.pos_ = received.buffers_[i]->data();
+        received_data = received.buffers_[i]->data();
+    }
+
+    buffer_type inb;
+    {
+        hpx::serialization::input_archive archive(
+            out_buffer, arg_size, &chunks, &received);
+        archive >> inb;
+    }
+
+    HPX_TEST_EQ(inb.size(), size);
+    HPX_TEST(std::equal(data.begin(), data.end(), inb.data()));
+
+    if (size * sizeof(double) >= HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+    {
+        // the received chunk was adopted, it is kept alive by the buffer only
+        HPX_TEST(received_data != nullptr);
+        HPX_TEST_EQ(reinterpret_cast<char const*>(inb.data()), received_data);
+        for (std::shared_ptr<std::vector<char> > const& b : received.buffers_)
+            HPX_TEST(!b);
+    }
+    else
+    {
+        HPX_TEST(reinterpret_cast<char const*>(inb.data()) != received_data);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Receive the zero-copy chunks into buffers taken from a buffer pool, the way
+// the TCP and MPI parcelports do. Adopted chunks have to be handed back to
+// the pool once the de-serialized object releases them.
+void test_pooled_chunks(std::size_t size)
+{
+    typedef hpx::serialization::serialize_buffer<double> buffer_type;
+    typedef hpx::parcelset::parcel_buffer<
+            std::vector<char>, std::vector<char>
+        > parcel_buffer_type;
+    typedef hpx::util::buffer_pool<char> pool_type;
+
+    std::vector<double> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = double(i);
+
+    buffer_type outb(data.data(), data.size(), buffer_type::reference);
+
+    // compose archive flags
+    unsigned out_archive_flags = 0U;
+#ifdef BOOST_BIG_ENDIAN
+    out_archive_flags |= hpx::serialization::endian_big;
+#else
+    out_archive_flags |= hpx::serialization::endian_little;
+#endif
+
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    std::vector<char> out_buffer;
+    std::size_t arg_size = 0;
+    {
+        hpx::serialization::output_archive archive(
+            out_buffer, out_archive_flags, &chunks);
+        archive << outb;
+        arg_size = archive.bytes_written();
+    }
+
+    std::shared_ptr<pool_type> pool = std::make_shared<pool_type>();
+
+    // 'receive' all pointer chunks into buffers taken from the pool
+    parcel_buffer_type received;
+    for (std::size_t i = 0; i != chunks.size(); ++i)
+    {
+        hpx::serialization::serialization_chunk& c = chunks[i];
+        if (c.type_ != hpx::serialization::chunk_type_pointer)
+            continue;
+
+        char const* p = static_cast<char const*>(c.data_.cpos_);
+        std::vector<char> chunk = pool->get_buffer(c.size_);
+        chunk.assign(p, p + c.size_);
+
+        c.data_.pos_ = chunk.data();
+        received.chunks_.push_back(std::move(chunk));
+        received.transmission_chunks_.push_back(
+            parcel_buffer_type::transmission_chunk_type(i, c.size_));
+    }
+    received.num_chunks_ = parcel_buffer_type::count_chunks_type(
+        received.chunks_.size(), chunks.size() - received.chunks_.size());
+
+    bool const adopted =
+        size * sizeof(double) >= HPX_ZERO_COPY_SERIALIZATION_THRESHOLD;
+    {
+        hpx::parcelset::detail::adoptable_buffer_chunks<parcel_buffer_type>
+            adoptable(received, pool);
+
+        buffer_type inb;
+        {
+            hpx::serialization::input_archive archive(
+                out_buffer, arg_size, &chunks, &adoptable);
+            archive >> inb;
+        }
+
+        HPX_TEST_EQ(inb.size(), size);
+        HPX_TEST(std::equal(data.begin(), data.end(), inb.data()));
+
+        // the adopted chunk is still in use
+        HPX_TEST_EQ(pool->get_reclaims(false), std::int64_t(0));
+    }
+
+    // releasing the de-serialized buffer hands the chunk back to the pool
+    std::int64_t const returned =
+        pool->get_reclaims(false) + pool->get_releases(false);
+    HPX_TEST_EQ(returned, std::int64_t(adopted ? 1 : 0));
+
+    // a chunk outliving the pool is simply deallocated
+    if (adopted)
+    {
+        std::shared_ptr<void> owner;
+        {
+            std::weak_ptr<pool_type> weak_pool;
+            {
+                std::shared_ptr<pool_type> p = std::make_shared<pool_type>();
+                weak_pool = p;
+
+                received.chunks_.assign(1, p->get_buffer(16));
+                received.transmission_chunks_.assign(1,
+                    parcel_buffer_type::transmission_chunk_type(0, 16));
+                received.num_chunks_ =
+                    parcel_buffer_type::count_chunks_type(1, 0);
+
+                hpx::parcelset::detail::adoptable_buffer_chunks<
+                        parcel_buffer_type
+                    > adoptable(received, p);
+                owner = adoptable.adopt(0);
+                HPX_TEST(owner);
+            }
+            HPX_TEST(weak_pool.expired());
+        }
+        owner.reset();
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -376,6 +577,9 @@ int hpx_main(boost::program_options::variables_map& vm)
         data_buffer<double> buffer3(size << i);
         test_normal_serialization<test_action4>(buffer3);
         test_zero_copy_serialization<test_action4>(buffer3);
+
+        test_adopted_chunks(size << i);
+        test_pooled_chunks(size << i);
     }
 
     return hpx::finalize();
@@ -0,0 +1,160 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/program_options.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace compat = hpx::compat;
+
+std::uint64_t thieves = 3;
+std::uint64_t items = 500000;
+
+boost::lockfree::chase_lev_deque<std::uint64_t> deque;
+std::vector<boost::atomic<std::uint64_t> > seen;
+boost::atomic<std::uint64_t> taken(0);
+
+void record(std::uint64_t item)
+{
+    BOOST_TEST(item < items);
+    if (item < items)
+        ++seen[item];
+    ++taken;
+}
+
+void owner_thread()
+{
+    // interleave pushes and pops, the owner always takes the most recently
+    // pushed element
+    for (std::uint64_t i = 0; i < items; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0)
+        {
+            std::uint64_t item = 0;
+            if (deque.pop(item))
+                record(item);
+        }
+    }
+
+    std::uint64_t item = 0;
+    while (deque.pop(item))
+        record(item);
+}
+
+void thief_thread()
+{
+    while (taken.load() != items)
+    {
+        std::uint64_t item = 0;
+        if (deque.steal(item))
+            record(item);
+    }
+}
+
+void test_sequential()
+{
+    boost::lockfree::chase_lev_deque<std::uint64_t> d(4);
+    BOOST_TEST(d.empty());
+
+    // force the underlying array to grow a couple of times
+    for (std::uint64_t i = 0; i != 100; ++i)
+        d.push(i);
+    BOOST_TEST_EQ(d.size(), std::size_t(100));
+
+    std::uint64_t item = 0;
+
+    // thieves take the oldest element
+    BOOST_TEST(d.steal(item));
+    BOOST_TEST_EQ(item, std::uint64_t(0));
+
+    // the owner takes the newest element
+    BOOST_TEST(d.pop(item));
+    BOOST_TEST_EQ(item, std::uint64_t(99));
+
+    for (std::uint64_t i = 98; i != 0; --i)
+    {
+        BOOST_TEST(d.pop(item));
+        BOOST_TEST_EQ(item, i);
+    }
+
+    BOOST_TEST(d.empty());
+    BOOST_TEST(!d.pop(item));
+    BOOST_TEST(!d.steal(item));
+}
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("thieves,t", value<std::uint64_t>(&thieves)->default_value(3),
+         "the number of threads stealing from the deque")
+        ("items,i", value<std::uint64_t>(&items)->default_value(500000),
+         "the number of items to push into the deque")
+    ;
+
+    store(
+        command_line_parser(argc,
+            argv).options(desc_cmdline).allow_unregistered().run(),vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return boost::report_errors();
+    }
+
+    test_sequential();
+
+    seen = std::vector<boost::atomic<std::uint64_t> >(items);
+    for (boost::atomic<std::uint64_t>& s : seen)
+        s.store(0);
+
+    {
+        std::vector<compat::thread> tg;
+
+        tg.push_back(compat::thread(&owner_thread));
+        for (std::uint64_t i = 0; i != thieves; ++i)
+            tg.push_back(compat::thread(&thief_thread));
+
+        for (compat::thread& t : tg)
+        {
+            if (t.joinable())
+                t.join();
+        }
+    }
+
+    // every item has to be taken exactly once
+    BOOST_TEST_EQ(taken.load(), items);
+    for (std::uint64_t i = 0; i < items; ++i)
+        BOOST_TEST_EQ(seen[i].load(), std::uint64_t(1));
+
+    BOOST_TEST(deque.empty());
+
+    return boost::report_errors();
+}
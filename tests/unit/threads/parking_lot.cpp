@@ -0,0 +1,121 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/runtime/threads/policies/parking_lot.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compat = hpx::compat;
+
+std::size_t const num_workers = 4;
+std::int64_t const num_items = 20000;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sequential()
+{
+    hpx::threads::policies::parking_lot lot(num_workers);
+    HPX_TEST_EQ(lot.size(), num_workers);
+    HPX_TEST_EQ(lot.num_parked(), std::size_t(0));
+
+    // nobody is parked, nobody can be woken up
+    HPX_TEST(!lot.unpark(0));
+    HPX_TEST(!lot.unpark_near(0));
+    HPX_TEST(!lot.unpark_near(std::size_t(-1)));
+    lot.unpark_all();
+
+    // a worker which has work does not get parked
+    HPX_TEST(!lot.park(0, []() { return true; }));
+    HPX_TEST_EQ(lot.get_num_parks(0, false), std::int64_t(0));
+
+    // a worker without work times out eventually
+    HPX_TEST(!lot.park(1, []() { return false; }));
+    HPX_TEST_EQ(lot.get_num_parks(1, false), std::int64_t(1));
+    HPX_TEST_EQ(lot.get_num_parks(std::size_t(-1), true), std::int64_t(1));
+    HPX_TEST_EQ(lot.get_num_parks(std::size_t(-1), false), std::int64_t(0));
+    HPX_TEST_EQ(lot.get_num_wakeups(std::size_t(-1), false), std::int64_t(0));
+    HPX_TEST_EQ(lot.num_parked(), std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent()
+{
+    hpx::threads::policies::parking_lot lot(num_workers);
+    for (std::size_t i = 0; i != num_workers; ++i)
+        lot.set_location(i, i / 2, 0);
+
+    std::vector<boost::atomic<std::int64_t> > work(num_workers);
+    for (boost::atomic<std::int64_t>& w : work)
+        w.store(0);
+
+    boost::atomic<std::int64_t> done(0);
+    boost::atomic<bool> stop(false);
+
+    std::vector<compat::thread> workers;
+    for (std::size_t n = 0; n != num_workers; ++n)
+    {
+        workers.push_back(compat::thread(
+            [&, n]()
+            {
+                while (true)
+                {
+                    std::int64_t w = work[n].load();
+                    if (w > 0)
+                    {
+                        if (work[n].compare_exchange_strong(w, w - 1))
+                            ++done;
+                        continue;
+                    }
+                    if (stop.load())
+                        break;
+
+                    lot.park(n,
+                        [&]() { return work[n].load() != 0 || stop.load(); });
+                }
+            }));
+    }
+
+    // every item has to be picked up by the worker it was scheduled for,
+    // which is woken up if it was parked
+    for (std::int64_t i = 0; i != num_items; ++i)
+    {
+        std::size_t n = static_cast<std::size_t>(i) % num_workers;
+        ++work[n];
+        lot.unpark_near(n);
+
+        if (i % 64 == 0)
+            compat::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    while (done.load() != num_items)
+        compat::this_thread::yield();
+
+    stop.store(true);
+    lot.unpark_all();
+
+    for (compat::thread& t : workers)
+        t.join();
+
+    HPX_TEST_EQ(done.load(), num_items);
+    HPX_TEST_EQ(lot.num_parked(), std::size_t(0));
+    HPX_TEST(lot.get_num_wakeups(std::size_t(-1), false) <=
+        lot.get_num_parks(std::size_t(-1), false));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_sequential();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,187 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace compat = hpx::compat;
+namespace posix = hpx::threads::coroutines::detail::posix;
+
+std::size_t const small_size = 0x10000;
+std::size_t const num_stacks = 40;
+
+///////////////////////////////////////////////////////////////////////////////
+void configure()
+{
+    posix::stack_pool_parameters params;
+    params.slab_size_ = 0x80000;        // force stacks to span several slabs
+    params.max_idle_stacks_ = 8;
+    params.stack_sizes_[posix::stack_size_class_small] = small_size;
+    params.stack_sizes_[posix::stack_size_class_medium] = 2 * small_size;
+    params.stack_sizes_[posix::stack_size_class_large] = 8 * small_size;
+    params.stack_sizes_[posix::stack_size_class_huge] = 32 * small_size;
+    posix::configure_stack_pool(params);
+}
+
+std::int64_t in_use()
+{
+    return posix::get_stack_pool_in_use_count(
+        posix::stack_size_class_small, false);
+}
+
+std::int64_t free_stacks()
+{
+    return posix::get_stack_pool_free_count(
+        posix::stack_size_class_small, false);
+}
+
+std::int64_t max_in_use(bool reset = false)
+{
+    return posix::get_stack_pool_max_in_use_count(
+        posix::stack_size_class_small, reset);
+}
+
+std::int64_t min_free_stacks(bool reset = false)
+{
+    return posix::get_stack_pool_min_free_count(
+        posix::stack_size_class_small, reset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<void*> allocate_stacks(std::size_t count)
+{
+    std::vector<void*> stacks;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        void* stack = posix::alloc_pooled_stack(small_size);
+        HPX_TEST(stack != nullptr);
+
+        // the whole stack has to be usable
+        std::memset(stack, static_cast<int>(i), small_size);
+        stacks.push_back(stack);
+    }
+    return stacks;
+}
+
+void test_allocate_free()
+{
+    std::vector<void*> stacks = allocate_stacks(num_stacks);
+
+    // no two stacks overlap
+    std::vector<void*> sorted(stacks);
+    std::sort(sorted.begin(), sorted.end(), std::less<void*>());
+    for (std::size_t i = 1; i != sorted.size(); ++i)
+    {
+        HPX_TEST(static_cast<char*>(sorted[i - 1]) + small_size <=
+            static_cast<char*>(sorted[i]));
+    }
+
+    HPX_TEST_EQ(in_use(), std::int64_t(num_stacks));
+    HPX_TEST_EQ(free_stacks(), std::int64_t(0));
+    HPX_TEST_EQ(max_in_use(true), std::int64_t(num_stacks));
+    HPX_TEST_EQ(min_free_stacks(true), std::int64_t(0));
+
+    // stacks are released from a different OS thread than the one which
+    // allocated them, they still have to be accounted for by their owner
+    compat::thread t(
+        [&stacks]()
+        {
+            for (void* stack : stacks)
+                posix::free_pooled_stack(stack, small_size);
+        });
+    t.join();
+
+    HPX_TEST_EQ(in_use(), std::int64_t(0));
+    HPX_TEST_EQ(free_stacks(), std::int64_t(num_stacks));
+
+    // the extrema are reported since the last reset
+    HPX_TEST_EQ(max_in_use(true), std::int64_t(num_stacks));
+    HPX_TEST_EQ(max_in_use(), std::int64_t(0));
+    HPX_TEST_EQ(min_free_stacks(true), std::int64_t(0));
+    HPX_TEST_EQ(min_free_stacks(), std::int64_t(num_stacks));
+
+    // released stacks are reused
+    std::vector<void*> reused = allocate_stacks(num_stacks);
+    std::sort(reused.begin(), reused.end(), std::less<void*>());
+    HPX_TEST(reused == sorted);
+
+    HPX_TEST_EQ(in_use(), std::int64_t(num_stacks));
+    HPX_TEST_EQ(free_stacks(), std::int64_t(0));
+
+    for (void* stack : reused)
+        posix::free_pooled_stack(stack, small_size);
+
+    HPX_TEST_EQ(in_use(), std::int64_t(0));
+    HPX_TEST_EQ(free_stacks(), std::int64_t(num_stacks));
+    HPX_TEST_EQ(max_in_use(true), std::int64_t(num_stacks));
+    HPX_TEST_EQ(min_free_stacks(true), std::int64_t(0));
+}
+
+void test_unpooled_size()
+{
+    std::int64_t const free_count = free_stacks();
+
+    // stacks of a size which is not one of the size classes bypass the pool
+    std::size_t const size = 3 * small_size;
+    void* stack = posix::alloc_pooled_stack(size);
+    HPX_TEST(stack != nullptr);
+    std::memset(stack, 0, size);
+    posix::free_pooled_stack(stack, size);
+
+    HPX_TEST_EQ(in_use(), std::int64_t(0));
+    HPX_TEST_EQ(free_stacks(), free_count);
+}
+
+void test_concurrent()
+{
+    std::size_t const num_threads = 4;
+
+    std::vector<compat::thread> threads;
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        threads.emplace_back(
+            []()
+            {
+                for (int j = 0; j != 100; ++j)
+                {
+                    std::vector<void*> stacks = allocate_stacks(10);
+                    for (void* stack : stacks)
+                        posix::free_pooled_stack(stack, small_size);
+                }
+            });
+    }
+
+    for (compat::thread& t : threads)
+        t.join();
+
+    // the peak is tracked for the whole pool, not per NUMA domain
+    std::int64_t peak = max_in_use(true);
+    HPX_TEST_LTE(std::int64_t(10), peak);
+    HPX_TEST_LTE(peak, std::int64_t(num_threads * 10));
+    HPX_TEST_EQ(in_use(), std::int64_t(0));
+    HPX_TEST_EQ(posix::get_stack_pool_in_use_count_all(false),
+        std::int64_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    configure();
+
+    test_allocate_free();
+    test_unpooled_size();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
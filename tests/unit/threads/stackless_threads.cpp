@@ -0,0 +1,183 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> count_invocations(0);
+
+void test_stackless()
+{
+    hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+    HPX_TEST(id);
+
+    // the thread reports that it doesn't have any stack of its own
+    HPX_TEST_EQ(id->get_stack_size(),
+        hpx::threads::get_stack_size(hpx::threads::thread_stacksize_nostack));
+    HPX_TEST(id->is_stackless());
+    HPX_TEST_EQ(std::strcmp(
+        hpx::threads::get_stack_size_name(id->get_stack_size()), "nostack"), 0);
+
+    ++count_invocations;
+}
+
+void test_stackless_suspend()
+{
+    // suspending until being woken up is not possible without a stack
+    bool caught_exception = false;
+    try {
+        hpx::this_thread::suspend(hpx::threads::suspended);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // neither is being woken up by a timer
+    caught_exception = false;
+    try {
+        hpx::this_thread::suspend(std::chrono::milliseconds(1));
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    hpx::error_code ec(hpx::lightweight);
+    HPX_TEST_EQ(hpx::this_thread::suspend(std::chrono::milliseconds(1),
+        "test_stackless_suspend", ec), hpx::threads::wait_unknown);
+    HPX_TEST_EQ(ec.value(), hpx::invalid_status);
+
+    // yielding backs off by yielding the worker's OS thread instead
+    HPX_TEST(!hpx::this_thread::can_suspend());
+    hpx::this_thread::yield();
+    hpx::this_thread::suspend(hpx::threads::pending_boost);
+
+    ++count_invocations;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::lcos::local::spinlock mtx;
+std::size_t protected_count = 0;
+
+void test_stackless_contended_lock()
+{
+    // a contended spinlock backs off on the OS thread while waiting for the
+    // lock
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+        ++protected_count;
+    }
+
+    ++count_invocations;
+}
+
+void hold_lock()
+{
+    std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+
+    // keep the lock without suspending
+    hpx::util::steady_clock::time_point start =
+        hpx::util::steady_clock::now();
+    while (hpx::util::steady_clock::now() - start <
+        std::chrono::milliseconds(10))
+    {
+    }
+}
+
+int test_regular()
+{
+    hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+    HPX_TEST(!id->is_stackless());
+
+    // make sure this thread can suspend
+    HPX_TEST(hpx::this_thread::can_suspend());
+    hpx::this_thread::yield();
+    hpx::this_thread::suspend(std::chrono::milliseconds(1));
+    return 42;
+}
+
+hpx::future<int> test_spawn_from_stackless()
+{
+    // threads created using the stack size of the current (stackless) thread
+    // have to be given a stack
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_current);
+    return hpx::async(exec, &test_regular);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    std::size_t const num_threads = 100;
+    {
+        std::vector<hpx::future<void> > results;
+        results.reserve(2 * num_threads);
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            results.push_back(hpx::async(exec, &test_stackless));
+            results.push_back(hpx::async(exec, &test_stackless_suspend));
+        }
+        hpx::wait_all(results);
+    }
+    HPX_TEST_EQ(count_invocations.load(), 2 * num_threads);
+
+    {
+        count_invocations = 0;
+
+        std::vector<hpx::future<void> > results;
+        results.reserve(num_threads + 1);
+
+        results.push_back(hpx::async(&hold_lock));
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            results.push_back(
+                hpx::async(exec, &test_stackless_contended_lock));
+        }
+        hpx::wait_all(results);
+
+        for (hpx::future<void>& f : results)
+            HPX_TEST(!f.has_exception());
+
+        HPX_TEST_EQ(count_invocations.load(), num_threads);
+        HPX_TEST_EQ(protected_count, 100 * num_threads);
+    }
+
+    {
+        hpx::future<hpx::future<int> > f =
+            hpx::async(exec, &test_spawn_from_stackless);
+        HPX_TEST_EQ(f.get().get(), 42);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
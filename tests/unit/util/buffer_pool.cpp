@@ -0,0 +1,154 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/buffer_pool.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+typedef hpx::util::buffer_pool<char> pool_type;
+typedef pool_type::buffer_type buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    pool_type pool;
+
+    buffer_type b = pool.get_buffer(1000);
+    HPX_TEST(b.empty());
+    HPX_TEST(b.capacity() >= std::size_t(1000));
+    HPX_TEST_EQ(pool.get_allocations(false), std::int64_t(1));
+
+    char const* data = b.data();
+    b.resize(1000);
+    pool.reclaim_buffer(std::move(b));
+    HPX_TEST_EQ(pool.get_reclaims(false), std::int64_t(1));
+    HPX_TEST(pool.cached_bytes() >= std::size_t(1000));
+
+    // a request from the same size class gets the cached buffer
+    buffer_type b1 = pool.get_buffer(900);
+    HPX_TEST(b1.empty());
+    HPX_TEST_EQ(b1.data(), data);
+    HPX_TEST_EQ(pool.get_reuses(false), std::int64_t(1));
+    HPX_TEST_EQ(pool.cached_bytes(), std::size_t(0));
+
+    // a buffer which is too small is never handed out
+    pool.reclaim_buffer(std::move(b1));
+    buffer_type b2 = pool.get_buffer(4000);
+    HPX_TEST(b2.capacity() >= std::size_t(4000));
+    HPX_TEST_EQ(pool.get_allocations(true), std::int64_t(2));
+    HPX_TEST_EQ(pool.get_allocations(false), std::int64_t(0));
+
+    // small buffers are not cached
+    pool.reclaim_buffer(buffer_type(10));
+    HPX_TEST_EQ(pool.get_reclaims(false), std::int64_t(2));
+
+    HPX_TEST_EQ(pool.clear(), std::size_t(1));
+    HPX_TEST_EQ(pool.cached_bytes(), std::size_t(0));
+}
+
+void test_size_classes()
+{
+    pool_type pool;
+
+    // each request gets a buffer of at least the requested size, buffers
+    // handed back are reused for any request they are large enough for
+    for (std::size_t size = 1; size < 100000; size = size * 5 / 4 + 1)
+    {
+        buffer_type b = pool.get_buffer(size);
+        HPX_TEST(b.capacity() >= size);
+        b.resize(size);
+        pool.reclaim_buffer(std::move(b));
+
+        buffer_type b1 = pool.get_buffer(size);
+        HPX_TEST(b1.capacity() >= size);
+        pool.reclaim_buffer(std::move(b1));
+    }
+}
+
+void test_high_watermark()
+{
+    std::size_t const high_watermark = 64 * 1024;
+    pool_type pool(high_watermark);
+    HPX_TEST_EQ(pool.high_watermark(), high_watermark);
+
+    std::vector<buffer_type> buffers;
+    for (std::size_t i = 0; i != 64; ++i)
+        buffers.push_back(pool.get_buffer(4096));
+
+    for (buffer_type& b : buffers)
+    {
+        pool.reclaim_buffer(std::move(b));
+        HPX_TEST(pool.cached_bytes() <= high_watermark);
+    }
+    HPX_TEST(pool.get_releases(false) != 0);
+
+    // buffers exceeding the high watermark are never cached
+    pool.reclaim_buffer(buffer_type(2 * high_watermark));
+    HPX_TEST(pool.cached_bytes() <= high_watermark);
+
+    pool.set_high_watermark(4096);
+    HPX_TEST(pool.cached_bytes() <= std::size_t(4096));
+
+    pool.trim(0);
+    HPX_TEST_EQ(pool.cached_bytes(), std::size_t(0));
+}
+
+void test_concurrent_access()
+{
+    std::size_t const num_threads = 4;
+
+    pool_type pool(1024 * 1024);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&pool, t]()
+            {
+                std::vector<buffer_type> buffers;
+                for (std::size_t n = 0; n != 10000; ++n)
+                {
+                    std::size_t size = 64 + (n * (t + 1) * 97) % 16384;
+                    buffer_type b = pool.get_buffer(size);
+                    HPX_TEST(b.empty());
+                    HPX_TEST(b.capacity() >= size);
+                    b.resize(size, char(t));
+                    buffers.push_back(std::move(b));
+
+                    // hand back the buffers in batches, this makes other
+                    // threads pick them up
+                    if (buffers.size() == 8)
+                    {
+                        for (buffer_type& b : buffers)
+                            pool.reclaim_buffer(std::move(b));
+                        buffers.clear();
+                    }
+                }
+            });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    HPX_TEST_EQ(
+        pool.get_allocations(false) + pool.get_reuses(false),
+        std::int64_t(num_threads * 10000));
+}
+
+int main()
+{
+    test_reuse();
+    test_size_classes();
+    test_high_watermark();
+    test_concurrent_access();
+
+    return hpx::util::report_errors();
+}
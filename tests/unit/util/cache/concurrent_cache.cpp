@@ -0,0 +1,234 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/cache/concurrent_cache.hpp>
+#include <hpx/util/cache/entries/lfu_entry.hpp>
+#include <hpx/util/cache/entries/lru_entry.hpp>
+#include <hpx/util/cache/statistics/concurrent_statistics.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct data
+{
+    data(char const* const k, char const* const v)
+      : key(k), value(v)
+    {}
+
+    char const* const key;
+    char const* const value;
+};
+
+data cache_entries[] =
+{
+    data ("white", "255,255,255"),
+    data ("yellow", "255,255,0"),
+    data ("green", "0,255,0"),
+    data ("blue", "0,0,255"),
+    data ("magenta", "255,0,255"),
+    data ("black", "0,0,0"),
+    data (nullptr, nullptr)
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_lru_insert_with_touch()
+{
+    typedef hpx::util::cache::entries::lru_entry<std::string> entry_type;
+    typedef hpx::util::cache::concurrent_cache<std::string, entry_type>
+        cache_type;
+
+    cache_type c(3);
+
+    HPX_TEST(3 == c.capacity());
+    HPX_TEST(1 == c.num_shards());
+
+    // insert 3 items into the cache
+    int i = 0;
+    data* d = &cache_entries[0];
+
+    for (/**/; i < 3 && d->key != nullptr; ++d, ++i) {
+        HPX_TEST(c.insert(d->key, d->value));
+        HPX_TEST(3 >= c.size());
+    }
+
+    HPX_TEST(3 == c.size());
+
+    // now touch the first item
+    std::string white;
+    HPX_TEST(c.get_entry("white", white));
+    HPX_TEST(white == "255,255,255");
+
+    // add two more items
+    for (i = 0; i < 2 && d->key != nullptr; ++d, ++i) {
+        HPX_TEST(c.insert(d->key, d->value));
+        HPX_TEST(3 == c.size());
+    }
+
+    // there should be 3 items in the cache, and white should be there as well
+    HPX_TEST(3 == c.size());
+    HPX_TEST(c.holds_key("white"));
+
+    c.clear();
+    HPX_TEST(0 == c.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct erase_func
+{
+    erase_func(std::string const& key)
+      : key_(key)
+    {}
+
+    template <typename Entry>
+    bool operator()(Entry const& e) const
+    {
+        return key_ == e.first;
+    }
+
+    std::string key_;
+};
+
+void test_lru_erase_update()
+{
+    typedef hpx::util::cache::entries::lru_entry<std::string> entry_type;
+    typedef hpx::util::cache::concurrent_cache<std::string, entry_type>
+        cache_type;
+
+    cache_type c(4);
+
+    for (data* d = &cache_entries[0]; d->key != nullptr; ++d) {
+        HPX_TEST(c.insert(d->key, d->value));
+        HPX_TEST(4 >= c.size());
+    }
+    HPX_TEST(4 == c.size());
+
+    entry_type black;
+    HPX_TEST(c.get_entry("black", black));
+
+    HPX_TEST(1 == c.erase(erase_func("black")));
+    HPX_TEST(!c.get_entry("black", black));
+    HPX_TEST(3 == c.size());
+
+    HPX_TEST(c.update("black", "255,0,0"));     // isn't in the cache
+    HPX_TEST(4 == c.size());
+
+    HPX_TEST(c.update("black", "0,0,0"));
+    HPX_TEST(4 == c.size());
+
+    std::string value;
+    HPX_TEST(c.get_entry("black", value));
+    HPX_TEST(value == "0,0,0");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_lfu_eviction()
+{
+    // evict the least frequently used entries first
+    typedef hpx::util::cache::entries::lfu_entry<int> entry_type;
+    typedef hpx::util::cache::concurrent_cache<
+            int, entry_type, std::greater<entry_type>
+        > cache_type;
+
+    std::size_t const capacity = 1024;
+    cache_type c(capacity, std::size_t(4));
+
+    HPX_TEST(4 == c.num_shards());
+
+    // insert some entries and access them frequently
+    for (int i = 0; i != 100; ++i)
+    {
+        HPX_TEST(c.insert(i, i));
+
+        int value = 0;
+        for (int j = 0; j != 10; ++j)
+            HPX_TEST(c.get_entry(i, value));
+    }
+
+    // fill the cache with entries which are never accessed
+    for (int i = 100; i != 10000; ++i)
+    {
+        HPX_TEST(c.insert(i, i));
+        HPX_TEST(capacity >= c.size());
+    }
+
+    // the frequently accessed entries should still be there
+    for (int i = 0; i != 100; ++i)
+        HPX_TEST(c.holds_key(i));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent_access()
+{
+    typedef hpx::util::cache::entries::lru_entry<int> entry_type;
+    typedef hpx::util::cache::concurrent_cache<
+            int, entry_type, std::less<entry_type>,
+            hpx::util::cache::policies::always<entry_type>, std::hash<int>,
+            hpx::util::cache::statistics::concurrent_statistics
+        > cache_type;
+
+    std::size_t const capacity = 4096;
+    std::size_t const num_tasks = 16;
+    std::size_t const num_accesses = 10000;
+    int const num_keys = 16384;
+
+    cache_type c(capacity);
+    HPX_TEST(1 < c.num_shards());
+
+    std::vector<hpx::future<std::size_t> > tasks;
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async(
+            [&c, t]() -> std::size_t
+            {
+                std::size_t wrong_values = 0;
+                unsigned int state = static_cast<unsigned int>(t);
+                for (std::size_t i = 0; i != num_accesses; ++i)
+                {
+                    state = state * 1103515245u + 12345u;
+                    int key = static_cast<int>(state >> 8) & (num_keys - 1);
+
+                    int value = 0;
+                    if (c.get_entry(key, value))
+                    {
+                        if (value != 2 * key)
+                            ++wrong_values;
+                    }
+                    else
+                    {
+                        c.insert(key, 2 * key);
+                    }
+                }
+                return wrong_values;
+            }));
+    }
+    hpx::wait_all(tasks);
+
+    for (auto& f : tasks)
+        HPX_TEST_EQ(f.get(), std::size_t(0));
+
+    HPX_TEST(capacity >= c.size());
+
+    auto& stats = c.get_statistics();
+    HPX_TEST_EQ(stats.hits() + stats.misses(), num_tasks * num_accesses);
+    HPX_TEST_EQ(stats.insertions() - stats.evictions(), c.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_lru_insert_with_touch();
+    test_lru_erase_update();
+    test_lfu_eviction();
+    test_concurrent_access();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,216 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/connection_cache.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct connection
+{
+    explicit connection(int dest)
+      : dest_(dest)
+    {}
+
+    int dest_;
+};
+
+typedef hpx::util::connection_cache<connection, int> cache_type;
+typedef cache_type::connection_type connection_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    cache_type cache(8, 2);
+
+    // the first request for a destination reserves space for a connection
+    connection_type conn;
+    HPX_TEST(cache.get_or_reserve(1, conn));
+    HPX_TEST(!conn);
+    HPX_TEST_EQ(cache.get_cache_insertions(false), std::int64_t(1));
+
+    conn = std::make_shared<connection>(1);
+    cache.reclaim(1, conn);
+    HPX_TEST_EQ(cache.get_cache_reclaims(false), std::int64_t(1));
+
+    // the reclaimed connection is handed out again
+    connection_type conn1;
+    HPX_TEST(cache.get_or_reserve(1, conn1));
+    HPX_TEST_EQ(conn1, conn);
+    HPX_TEST_EQ(cache.get_cache_hits(false), std::int64_t(1));
+
+    // no cached connection for this destination
+    HPX_TEST(!cache.get(2));
+    HPX_TEST_EQ(cache.get_cache_misses(true), std::int64_t(1));
+    HPX_TEST_EQ(cache.get_cache_misses(false), std::int64_t(0));
+
+    cache.reclaim(1, conn1);
+    HPX_TEST_EQ(cache.get(1), conn);
+    cache.reclaim(1, conn);
+}
+
+void test_per_locality_limit()
+{
+    cache_type cache(8, 2);
+
+    connection_type conn1, conn2, conn3;
+    HPX_TEST(cache.get_or_reserve(1, conn1));
+    HPX_TEST(cache.get_or_reserve(1, conn2));
+    HPX_TEST(cache.full(1));
+    HPX_TEST(!cache.full(2));
+
+    // both connections are checked out
+    HPX_TEST(!cache.get_or_reserve(1, conn3));
+
+    // unless forced
+    HPX_TEST(cache.get_or_reserve(1, conn3, true));
+
+    cache.clear(1, conn3);
+    HPX_TEST_EQ(cache.get_cache_evictions(false), std::int64_t(1));
+
+    cache.clear(1);
+    HPX_TEST(!cache.full(1));
+}
+
+void test_eviction()
+{
+    std::size_t const max_connections = 4;
+    cache_type cache(max_connections, 2);
+
+    // fill the cache with idle connections
+    for (int i = 0; i != int(max_connections); ++i)
+    {
+        connection_type conn;
+        HPX_TEST(cache.get_or_reserve(i, conn));
+        cache.reclaim(i, std::make_shared<connection>(i));
+    }
+    HPX_TEST(cache.full());
+
+    // requests for new destinations evict idle connections, possibly from
+    // other stripes
+    for (int i = max_connections; i != int(2 * max_connections); ++i)
+    {
+        connection_type conn;
+        HPX_TEST(cache.get_or_reserve(i, conn));
+        HPX_TEST(!conn);
+        cache.reclaim(i, std::make_shared<connection>(i));
+    }
+    HPX_TEST(cache.full());
+    HPX_TEST_EQ(cache.get_cache_evictions(false),
+        std::int64_t(max_connections));
+
+    cache.clear();
+    HPX_TEST(!cache.full());
+    HPX_TEST_EQ(cache.get_cache_evictions(false), std::int64_t(0));
+}
+
+void test_concurrent()
+{
+    std::size_t const num_threads = 4;
+    std::size_t const num_iterations = 10000;
+    int const num_destinations = 32;
+
+    cache_type cache(num_destinations * 4, 2);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&cache, t]()
+            {
+                for (std::size_t i = 0; i != num_iterations; ++i)
+                {
+                    int dest = int((t * num_iterations + i) % num_destinations);
+
+                    connection_type conn;
+                    if (!cache.get_or_reserve(dest, conn))
+                        continue;
+
+                    if (!conn)
+                        conn = std::make_shared<connection>(dest);
+
+                    HPX_TEST_EQ(conn->dest_, dest);
+                    cache.reclaim(dest, conn);
+                }
+            });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    HPX_TEST_EQ(
+        cache.get_cache_hits(false) + cache.get_cache_insertions(false),
+        cache.get_cache_reclaims(false) + cache.get_cache_evictions(false));
+}
+
+void test_concurrent_limit()
+{
+    std::size_t const num_threads = 8;
+    std::size_t const num_iterations = 100;
+    std::size_t const max_connections = 8;
+    int const num_destinations = 4;
+
+    cache_type cache(max_connections, max_connections / 2);
+
+    // keep one connection checked out for each destination, further
+    // connections to those may not exceed the overall limit
+    std::vector<connection_type> initial(num_destinations);
+    for (int dest = 0; dest != num_destinations; ++dest)
+    {
+        HPX_TEST(cache.get_or_reserve(dest, initial[dest]));
+        initial[dest] = std::make_shared<connection>(dest);
+    }
+
+    // none of the reserved connections is handed back, thus nothing can be
+    // evicted
+    std::atomic<std::size_t> reserved(0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&cache, &reserved, t]()
+            {
+                for (std::size_t i = 0; i != num_iterations; ++i)
+                {
+                    int dest = int((t + i) % num_destinations);
+
+                    connection_type conn;
+                    if (cache.get_or_reserve(dest, conn))
+                    {
+                        HPX_TEST(!conn);
+                        ++reserved;
+                    }
+                }
+            });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    HPX_TEST_EQ(reserved.load(), max_connections - num_destinations);
+    HPX_TEST(cache.full());
+
+    cache.clear();
+    HPX_TEST(!cache.full());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_reuse();
+    test_per_locality_limit();
+    test_eviction();
+    test_concurrent();
+    test_concurrent_limit();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,88 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/thread_trace.hpp>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int test_function(int i)
+{
+    hpx::this_thread::yield();
+    return i;
+}
+
+void test_record()
+{
+    hpx::util::thread_trace::enable();
+    HPX_TEST(hpx::util::thread_trace::is_enabled());
+
+    std::vector<hpx::future<int> > futures;
+    for (int i = 0; i != 100; ++i)
+        futures.push_back(hpx::async(&test_function, i));
+    hpx::wait_all(futures);
+
+    hpx::util::thread_trace::enable(false);
+    HPX_TEST(!hpx::util::thread_trace::is_enabled());
+
+    std::ostringstream strm;
+    hpx::util::thread_trace::dump(strm);
+
+    std::string trace = strm.str();
+    HPX_TEST(trace.find("\"traceEvents\"") != std::string::npos);
+    HPX_TEST(trace.find("\"thread_name\"") != std::string::npos);
+    HPX_TEST(trace.find("\"name\":\"create\"") != std::string::npos);
+    HPX_TEST(trace.find("\"ph\":\"B\"") != std::string::npos);
+    HPX_TEST(trace.find("\"state\":\"suspended\"") != std::string::npos);
+    HPX_TEST(trace.find("\"state\":\"terminated\"") != std::string::npos);
+
+    // nothing is recorded after clearing the buffers while disabled
+    hpx::util::thread_trace::clear();
+    hpx::async(&test_function, 0).get();
+
+    strm.str("");
+    hpx::util::thread_trace::dump(strm);
+
+    trace = strm.str();
+    HPX_TEST(trace.find("\"ph\":\"B\"") == std::string::npos);
+}
+
+void test_description_lifetime()
+{
+    hpx::util::thread_trace::clear();
+    hpx::util::thread_trace::enable();
+
+    // the description is copied, the string it was taken from does not
+    // need to stay alive
+    {
+        std::string desc("transient_description");
+        hpx::util::thread_trace::record(
+            hpx::util::thread_trace::thread_create, &desc, desc.c_str());
+        desc.assign(desc.size(), 'x');
+    }
+
+    hpx::util::thread_trace::enable(false);
+
+    std::ostringstream strm;
+    hpx::util::thread_trace::dump(strm);
+
+    std::string trace = strm.str();
+    HPX_TEST(trace.find("\"transient_description\"") != std::string::npos);
+    HPX_TEST(trace.find("xxxxxxxx") == std::string::npos);
+}
+
+int main()
+{
+    test_record();
+    test_description_lifetime();
+    return hpx::util::report_errors();
+}